@@ -4,10 +4,16 @@
 #include "katana/analytics/betweenness_centrality/betweenness_centrality.h"
 #include "katana/analytics/bfs/bfs.h"
 #include "katana/analytics/connected_components/connected_components.h"
+#include "katana/analytics/graph_coloring/graph_coloring.h"
 #include "katana/analytics/jaccard/jaccard.h"
 #include "katana/analytics/k_core/k_core.h"
 #include "katana/analytics/k_truss/k_truss.h"
+#include "katana/analytics/louvain_clustering/louvain_clustering.h"
+#include "katana/analytics/matrix_completion/matrix_completion.h"
+#include "katana/analytics/minimum_spanning_forest/minimum_spanning_forest.h"
 #include "katana/analytics/pagerank/pagerank.h"
+#include "katana/analytics/partition/partition.h"
+#include "katana/analytics/random_walks/random_walks.h"
 #include "katana/analytics/sssp/sssp.h"
 #include "katana/analytics/triangle_count/triangle_count.h"
 
@@ -26,7 +26,7 @@ using NullMaps = std::pair<
     std::unordered_map<int, std::shared_ptr<arrow::Array>>,
     std::unordered_map<int, std::shared_ptr<arrow::Array>>>;
 
-enum SourceType { kGraphml, kKatana };
+enum SourceType { kGraphml, kKatana, kEdgeList };
 enum SourceDatabase { kNone, kNeo4j, kMongodb, kMysql };
 enum ImportDataType {
   kString,
@@ -148,6 +148,8 @@ struct GraphComponents {
   GraphComponent nodes;
   GraphComponent edges;
   std::shared_ptr<katana::GraphTopology> topology;
+  /// Set instead of topology when node ids do not fit in 32 bits
+  std::shared_ptr<katana::WideGraphTopology> wide_topology;
 
   GraphComponents(
       GraphComponent nodes_, GraphComponent edges_,
@@ -165,6 +167,11 @@ struct GraphComponents {
     std::cout << edges.properties->ToString() << "\n";
     std::cout << edges.labels->ToString() << "\n";
 
+    if (wide_topology) {
+      std::cout << wide_topology->out_indices->ToString() << "\n";
+      std::cout << wide_topology->out_dests->ToString() << "\n";
+      return;
+    }
     std::cout << topology->out_indices->ToString() << "\n";
     std::cout << topology->out_dests->ToString() << "\n";
   }
@@ -0,0 +1,320 @@
+#ifndef KATANA_LIBGALOIS_KATANA_COMPRESSEDTOPOLOGY_H_
+#define KATANA_LIBGALOIS_KATANA_COMPRESSEDTOPOLOGY_H_
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include <arrow/api.h>
+
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Range.h"
+#include "katana/config.h"
+#include "tsuba/FileView.h"
+
+namespace katana {
+
+/// An edge decoded from a CompressedGraphTopology. The id indexes edge
+/// properties as in the uncompressed topology.
+struct CompressedEdge {
+  GraphTopology::Edge id;
+  GraphTopology::Node dest;
+};
+
+namespace internal {
+
+/// Decode the variable-length byte code at *code and advance *code past it.
+/// Each byte holds 7 bits of the value, least significant first, and its high
+/// bit is set if more bytes follow.
+inline uint64_t
+DecodeByteCode(const uint8_t** code) {
+  const uint8_t* p = *code;
+  uint64_t value = *p & 0x7f;
+  unsigned shift = 7;
+  while (*p++ & 0x80) {
+    value |= static_cast<uint64_t>(*p & 0x7f) << shift;
+    shift += 7;
+  }
+  *code = p;
+  return value;
+}
+
+/// The destination of the first edge of a block, which is coded as the
+/// zigzag-encoded difference from the source
+inline GraphTopology::Node
+DecodeFirstDest(GraphTopology::Node src, const uint8_t** code) {
+  uint64_t zigzag = DecodeByteCode(code);
+  int64_t diff = static_cast<int64_t>(zigzag >> 1) ^
+                 -static_cast<int64_t>(zigzag & 1);
+  return static_cast<GraphTopology::Node>(static_cast<int64_t>(src) + diff);
+}
+
+}  // namespace internal
+
+/// A CompressedGraphTopology is a read-only GraphTopology whose destinations
+/// are delta-encoded with byte codes, as in Ligra+. It is meant for
+/// traversal-only kernels that are bound by memory bandwidth: the edges of a
+/// node are decoded on the fly, and the destinations of most sparse graphs take
+/// one or two bytes instead of four.
+///
+/// The edges of each node are split into blocks of block_size() edges. The
+/// first destination of a block is coded relative to the source node and the
+/// others relative to the previous destination, so blocks decode
+/// independently, and nodes with several blocks start with a table of the
+/// offsets of their blocks. Large nodes can thus be decoded in parallel with
+/// ForEachEdgeInBlock.
+///
+/// Edge ids are the same as in the uncompressed topology, so edge properties
+/// can be used with a compressed topology. Edges must be sorted by destination
+/// (see SortAllEdgesByDest).
+///
+/// A compressed topology file is laid out as:
+///
+///   tsuba::CompressedCSRTopologyHeader header
+///   uint64_t[num_nodes] out_indices: end of the edges of each node
+///   uint64_t[num_nodes] code_indices: end of the codes of each node
+///   uint8_t[num_code_bytes] codes
+class KATANA_EXPORT CompressedGraphTopology {
+public:
+  using Node = GraphTopology::Node;
+  using Edge = GraphTopology::Edge;
+  using node_iterator = GraphTopology::node_iterator;
+  using edges_range = GraphTopology::edges_range;
+  using iterator = node_iterator;
+
+  static constexpr uint32_t kDefaultBlockSize = 64;
+
+  /// A forward iterator that decodes the edges of a node as it advances
+  class decoded_edge_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = CompressedEdge;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const CompressedEdge*;
+    using reference = const CompressedEdge&;
+
+    decoded_edge_iterator() = default;
+
+    reference operator*() const { return edge_; }
+    pointer operator->() const { return &edge_; }
+
+    decoded_edge_iterator& operator++() {
+      ++edge_.id;
+      if (edge_.id != end_) {
+        Decode();
+      }
+      return *this;
+    }
+
+    decoded_edge_iterator operator++(int) {
+      decoded_edge_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const decoded_edge_iterator& other) const {
+      return edge_.id == other.edge_.id;
+    }
+    bool operator!=(const decoded_edge_iterator& other) const {
+      return !(*this == other);
+    }
+
+  private:
+    friend class CompressedGraphTopology;
+
+    decoded_edge_iterator(
+        const uint8_t* code, Node src, Edge begin, Edge end,
+        uint32_t block_size)
+        : code_(code),
+          src_(src),
+          begin_(begin),
+          end_(end),
+          block_size_(block_size),
+          edge_{begin, 0} {
+      if (begin != end) {
+        Decode();
+      }
+    }
+
+    void Decode() {
+      if ((edge_.id - begin_) % block_size_ == 0) {
+        edge_.dest = internal::DecodeFirstDest(src_, &code_);
+      } else {
+        edge_.dest += internal::DecodeByteCode(&code_);
+      }
+    }
+
+    const uint8_t* code_{nullptr};
+    Node src_{0};
+    Edge begin_{0};
+    Edge end_{0};
+    uint32_t block_size_{1};
+    CompressedEdge edge_{0, 0};
+  };
+
+  using decoded_edges_range = StandardRange<decoded_edge_iterator>;
+
+  CompressedGraphTopology() = default;
+
+  /// Compress topology, which must have its edges sorted by destination. The
+  /// out_indices of topology are shared rather than copied.
+  static Result<CompressedGraphTopology> Make(
+      const GraphTopology& topology, uint32_t block_size = kDefaultBlockSize);
+
+  /// Map the compressed topology file at uri, as written by Write.
+  static Result<CompressedGraphTopology> Load(const std::string& uri);
+
+  /// Write this topology to a compressed topology file at uri.
+  Result<void> Write(const std::string& uri) const;
+
+  /// Decode this topology into an uncompressed topology.
+  Result<GraphTopology> Decompress() const;
+
+  uint64_t num_nodes() const {
+    return out_indices_ ? out_indices_->length() : 0;
+  }
+
+  uint64_t num_edges() const { return num_edges_; }
+
+  /// The number of edges in each block of a node
+  uint32_t block_size() const { return block_size_; }
+
+  /// The number of bytes taken by the codes of all destinations
+  uint64_t num_code_bytes() const { return codes_ ? codes_->length() : 0; }
+
+  /// The number of bytes read by a full traversal, i.e., the size of
+  /// out_indices, code_indices and the codes. The same traversal of a
+  /// GraphTopology reads 8 bytes per node and 4 bytes per edge.
+  uint64_t size_in_bytes() const {
+    return 2 * num_nodes() * sizeof(uint64_t) + num_code_bytes();
+  }
+
+  std::pair<Edge, Edge> edge_range(Node node) const {
+    return std::make_pair(
+        node > 0 ? out_indices_values_[node - 1] : 0,
+        out_indices_values_[node]);
+  }
+
+  /// The ids of the edges of node, to index edge properties
+  edges_range edges(Node node) const {
+    auto [begin_edge, end_edge] = edge_range(node);
+    return MakeStandardRange<GraphTopology::edge_iterator>(
+        begin_edge, end_edge);
+  }
+
+  uint64_t degree(Node node) const {
+    auto [begin_edge, end_edge] = edge_range(node);
+    return end_edge - begin_edge;
+  }
+
+  /// The edges of node, decoded as the range is iterated
+  decoded_edges_range DecodedEdges(Node node) const {
+    auto [begin_edge, end_edge] = edge_range(node);
+    return MakeStandardRange(
+        decoded_edge_iterator(
+            FirstBlock(node, end_edge - begin_edge), node, begin_edge,
+            end_edge, block_size_),
+        decoded_edge_iterator(
+            nullptr, node, end_edge, end_edge, block_size_));
+  }
+
+  /// Call fn(edge_id, dest) for every edge of node, in order. This is the
+  /// fastest way to decode all the edges of a node.
+  template <typename F>
+  void ForEachEdge(Node node, const F& fn) const {
+    auto [begin_edge, end_edge] = edge_range(node);
+    const uint8_t* code = FirstBlock(node, end_edge - begin_edge);
+    for (Edge block_begin = begin_edge; block_begin < end_edge;
+         block_begin += block_size_) {
+      DecodeBlock(
+          node, code, block_begin,
+          std::min<Edge>(block_begin + block_size_, end_edge), fn, &code);
+    }
+  }
+
+  /// The number of blocks of the edges of node
+  uint64_t num_blocks(Node node) const {
+    return (degree(node) + block_size_ - 1) / block_size_;
+  }
+
+  /// Call fn(edge_id, dest) for every edge in the given block of node, in
+  /// order. Different blocks of a node may be decoded concurrently.
+  template <typename F>
+  void ForEachEdgeInBlock(Node node, uint64_t block, const F& fn) const {
+    KATANA_LOG_DEBUG_ASSERT(block < num_blocks(node));
+    auto [begin_edge, end_edge] = edge_range(node);
+    const uint8_t* code = FirstBlock(node, end_edge - begin_edge);
+    if (block > 0) {
+      uint32_t offset;
+      std::memcpy(
+          &offset, NodeCodes(node) + (block - 1) * sizeof(uint32_t),
+          sizeof(offset));
+      code = NodeCodes(node) + offset;
+    }
+    Edge block_begin = begin_edge + block * block_size_;
+    DecodeBlock(
+        node, code, block_begin,
+        std::min<Edge>(block_begin + block_size_, end_edge), fn, &code);
+  }
+
+  // Standard container concepts
+
+  node_iterator begin() const { return node_iterator(0); }
+
+  node_iterator end() const { return node_iterator(num_nodes()); }
+
+  size_t size() const { return num_nodes(); }
+
+  bool empty() const { return num_nodes() == 0; }
+
+private:
+  CompressedGraphTopology(
+      std::shared_ptr<arrow::UInt64Array> out_indices,
+      std::shared_ptr<arrow::UInt64Array> code_indices,
+      std::shared_ptr<arrow::UInt8Array> codes, uint64_t num_edges,
+      uint32_t block_size, std::shared_ptr<tsuba::FileView> storage = nullptr);
+
+  const uint8_t* NodeCodes(Node node) const {
+    return codes_values_ + (node > 0 ? code_indices_values_[node - 1] : 0);
+  }
+
+  /// The codes of the first block of node, after its block offset table
+  const uint8_t* FirstBlock(Node node, uint64_t degree) const {
+    uint64_t num_node_blocks = (degree + block_size_ - 1) / block_size_;
+    uint64_t table_size =
+        num_node_blocks > 1 ? (num_node_blocks - 1) * sizeof(uint32_t) : 0;
+    return NodeCodes(node) + table_size;
+  }
+
+  template <typename F>
+  static void DecodeBlock(
+      Node node, const uint8_t* code, Edge begin, Edge end, const F& fn,
+      const uint8_t** code_end) {
+    Node dest = internal::DecodeFirstDest(node, &code);
+    fn(begin, dest);
+    for (Edge e = begin + 1; e < end; ++e) {
+      dest += internal::DecodeByteCode(&code);
+      fn(e, dest);
+    }
+    *code_end = code;
+  }
+
+  std::shared_ptr<arrow::UInt64Array> out_indices_;
+  std::shared_ptr<arrow::UInt64Array> code_indices_;
+  std::shared_ptr<arrow::UInt8Array> codes_;
+  // The file that the arrays above point into, if they were loaded
+  std::shared_ptr<tsuba::FileView> storage_;
+
+  const uint64_t* out_indices_values_{nullptr};
+  const uint64_t* code_indices_values_{nullptr};
+  const uint8_t* codes_values_{nullptr};
+  uint64_t num_edges_{0};
+  uint32_t block_size_{kDefaultBlockSize};
+};
+
+}  // namespace katana
+
+#endif
@@ -0,0 +1,236 @@
+#ifndef KATANA_LIBGALOIS_KATANA_EDGEBALANCEDRANGE_H_
+#define KATANA_LIBGALOIS_KATANA_EDGEBALANCEDRANGE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include "katana/PropertyGraph.h"
+#include "katana/Range.h"
+#include "katana/ThreadPool.h"
+#include "katana/config.h"
+
+/// \file EdgeBalancedRange.h
+///
+/// Ranges over the nodes of a graph whose per-thread portions have roughly
+/// equal numbers of edges rather than equal numbers of nodes.
+///
+/// katana::iterate(graph) gives each thread the same number of nodes. On
+/// graphs with skewed degree distributions, the thread that gets a hub does
+/// most of the work of a loop over edges, and stealing can only partly
+/// recover because it moves nodes, not edges.
+///
+///   katana::do_all(katana::iterate_edge_balanced(*pg), [&](Node n) { ... });
+///
+/// When a single node has more edges than a thread should do alone,
+/// iterate_edge_balanced_split_hubs goes further and iterates over
+/// NodeEdgeRanges, which split the edges of each hub into several items that
+/// different threads can process:
+///
+///   katana::do_all(
+///       katana::iterate_edge_balanced_split_hubs(*pg),
+///       [&](const katana::NodeEdgeRange& r) {
+///         for (auto e = r.begin; e != r.end; ++e) { ... }
+///       });
+///
+/// Operators over split hubs must tolerate several threads visiting the same
+/// node concurrently.
+
+namespace katana {
+
+/// The out-edges [begin, end) of node. Unless node was split, these are all
+/// of its out-edges.
+struct NodeEdgeRange {
+  GraphTopology::Node node;
+  GraphTopology::Edge begin;
+  GraphTopology::Edge end;
+};
+
+/// An EdgeBalancedPartition numbers the work items of a topology, i.e., its
+/// nodes with hubs split into several items, and divides them into one
+/// contiguous block per thread with roughly equal weight. The weight of an
+/// item is one plus its number of edges.
+///
+/// Partitions are computed from the prefix sum of degrees already in
+/// GraphTopology::out_indices and are cached, so repeated loops over the same
+/// topology with the same number of threads share one partition. Like the
+/// topology arrays themselves, a partition must not be used after its
+/// topology is destroyed.
+class KATANA_EXPORT EdgeBalancedPartition {
+public:
+  /// Do not split any node
+  static constexpr uint64_t kNoSplit = UINT64_MAX;
+
+  /// Return the partition of topology into blocks for the current number of
+  /// active threads. Nodes with more than max_hub_edges out-edges are split
+  /// into items of at most max_hub_edges edges each.
+  static std::shared_ptr<const EdgeBalancedPartition> Get(
+      const GraphTopology& topology, uint64_t max_hub_edges = kNoSplit);
+
+  /// A hub threshold that lets several threads share a hub
+  static uint64_t DefaultMaxHubEdges(const GraphTopology& topology);
+
+  uint64_t num_items() const { return num_items_; }
+
+  uint64_t num_nodes() const { return num_nodes_; }
+
+  /// The first item of the block of thread tid
+  uint64_t thread_begin(unsigned tid) const {
+    return tid < thread_beginnings_.size() ? thread_beginnings_[tid]
+                                           : num_items_;
+  }
+
+  /// The node and edges of an item
+  NodeEdgeRange item(uint64_t i) const {
+    // The last hub that starts at or before i
+    auto it = std::upper_bound(
+        hubs_.begin(), hubs_.end(), i,
+        [](uint64_t index, const Hub& hub) { return index < hub.first_item; });
+    if (it == hubs_.begin()) {
+      return WholeNode(i);
+    }
+    --it;
+    uint64_t piece = i - it->first_item;
+    if (piece >= it->num_pieces) {
+      // Each hub before this node adds num_pieces - 1 items
+      uint64_t extra = it->first_item - it->node + it->num_pieces - 1;
+      return WholeNode(i - extra);
+    }
+    uint64_t begin = EdgeBegin(it->node) + piece * max_hub_edges_;
+    return NodeEdgeRange{
+        .node = it->node,
+        .begin = begin,
+        .end = std::min(begin + max_hub_edges_, EdgeEnd(it->node)),
+    };
+  }
+
+  EdgeBalancedPartition(
+      const GraphTopology& topology, uint64_t max_hub_edges,
+      unsigned num_threads);
+
+private:
+  struct Hub {
+    GraphTopology::Node node;
+    uint64_t first_item;
+    uint64_t num_pieces;
+  };
+
+  uint64_t EdgeBegin(GraphTopology::Node node) const {
+    return node > 0 ? indices_[node - 1] : 0;
+  }
+
+  uint64_t EdgeEnd(GraphTopology::Node node) const { return indices_[node]; }
+
+  NodeEdgeRange WholeNode(uint64_t node) const {
+    auto n = static_cast<GraphTopology::Node>(node);
+    return NodeEdgeRange{.node = n, .begin = EdgeBegin(n), .end = EdgeEnd(n)};
+  }
+
+  /// The weight of the items before item i
+  uint64_t WeightBefore(uint64_t i) const;
+
+  const uint64_t* indices_{};
+  uint64_t num_nodes_{};
+  uint64_t num_items_{};
+  uint64_t max_hub_edges_{};
+  std::vector<Hub> hubs_;
+  std::vector<uint64_t> thread_beginnings_;
+};
+
+/// An iterator over the items of an EdgeBalancedPartition
+class NodeEdgeRangeIterator
+    : public boost::iterator_facade<
+          NodeEdgeRangeIterator, NodeEdgeRange,
+          std::random_access_iterator_tag, NodeEdgeRange> {
+public:
+  NodeEdgeRangeIterator() = default;
+  NodeEdgeRangeIterator(const EdgeBalancedPartition* partition, uint64_t i)
+      : partition_(partition), i_(i) {}
+
+private:
+  friend class boost::iterator_core_access;
+
+  NodeEdgeRange dereference() const { return partition_->item(i_); }
+  bool equal(const NodeEdgeRangeIterator& other) const {
+    return i_ == other.i_;
+  }
+  void increment() { ++i_; }
+  void decrement() { --i_; }
+  void advance(std::ptrdiff_t n) { i_ += n; }
+  std::ptrdiff_t distance_to(const NodeEdgeRangeIterator& other) const {
+    return static_cast<std::ptrdiff_t>(other.i_ - i_);
+  }
+
+  const EdgeBalancedPartition* partition_{};
+  uint64_t i_{};
+};
+
+/// EdgeBalancedRange is a range whose local ranges are the blocks of an
+/// EdgeBalancedPartition.
+template <typename IterTy>
+class EdgeBalancedRange {
+public:
+  typedef IterTy iterator;
+  typedef iterator local_iterator;
+  typedef typename std::iterator_traits<iterator>::value_type value_type;
+
+  EdgeBalancedRange(
+      std::shared_ptr<const EdgeBalancedPartition> partition, IterTy begin)
+      : partition_(std::move(partition)), begin_(begin) {}
+
+  iterator begin() const { return begin_; }
+  iterator end() const { return begin_ + partition_->num_items(); }
+
+  local_iterator local_begin() const {
+    return begin_ + partition_->thread_begin(ThreadPool::getTID());
+  }
+  local_iterator local_end() const {
+    return begin_ + partition_->thread_begin(ThreadPool::getTID() + 1);
+  }
+
+private:
+  std::shared_ptr<const EdgeBalancedPartition> partition_;
+  IterTy begin_;
+};
+
+/// Iterate over the nodes of topology, giving each thread a contiguous block
+/// of nodes with roughly equal numbers of edges
+inline EdgeBalancedRange<GraphTopology::node_iterator>
+iterate_edge_balanced(const GraphTopology& topology) {
+  return EdgeBalancedRange<GraphTopology::node_iterator>(
+      EdgeBalancedPartition::Get(topology), topology.begin());
+}
+
+inline EdgeBalancedRange<GraphTopology::node_iterator>
+iterate_edge_balanced(const PropertyGraph& pg) {
+  return iterate_edge_balanced(pg.topology());
+}
+
+/// Iterate over the nodes of topology like iterate_edge_balanced but split
+/// the edges of nodes with more than max_hub_edges out-edges into several
+/// NodeEdgeRanges. If max_hub_edges is zero, a threshold is chosen from the
+/// number of edges and threads.
+inline EdgeBalancedRange<NodeEdgeRangeIterator>
+iterate_edge_balanced_split_hubs(
+    const GraphTopology& topology, uint64_t max_hub_edges = 0) {
+  if (max_hub_edges == 0) {
+    max_hub_edges = EdgeBalancedPartition::DefaultMaxHubEdges(topology);
+  }
+  auto partition = EdgeBalancedPartition::Get(topology, max_hub_edges);
+  NodeEdgeRangeIterator begin(partition.get(), 0);
+  return EdgeBalancedRange<NodeEdgeRangeIterator>(std::move(partition), begin);
+}
+
+inline EdgeBalancedRange<NodeEdgeRangeIterator>
+iterate_edge_balanced_split_hubs(
+    const PropertyGraph& pg, uint64_t max_hub_edges = 0) {
+  return iterate_edge_balanced_split_hubs(pg.topology(), max_hub_edges);
+}
+
+}  // namespace katana
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef KATANA_LIBGALOIS_KATANA_EDGELISTIMPORT_H_
+#define KATANA_LIBGALOIS_KATANA_EDGELISTIMPORT_H_
+
+/// Bulk import of delimited edge lists (CSV, TSV, whitespace separated) into
+/// the components of a PropertyGraph.
+///
+/// Unlike PropertyGraphBuilder, which builds a graph one element at a time,
+/// the importer works on whole files in parallel:
+///
+/// 1. Each input is split into chunks on line boundaries and chunks are
+///    parsed concurrently.
+/// 2. External node ids are hashed into shards, deduplicated per shard in
+///    parallel and given dense ids in order of first appearance.
+/// 3. The CSR topology is built with a parallel counting sort directly into
+///    Arrow buffers.
+///
+/// When the input is larger than EdgeListImportOptions::memory_budget, it is
+/// processed in waves and the parsed edges are staged in a temporary file
+/// instead of memory.
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "katana/BuildGraph.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+struct EdgeListImportOptions {
+  /// Field separator. ' ' splits fields on any run of spaces and tabs.
+  char delimiter{','};
+  /// Lines whose first non-blank character is comment are skipped
+  char comment{'#'};
+  /// Skip the first line of every file
+  bool has_header{false};
+  /// Zero-based indexes of the fields holding the source and destination
+  uint32_t src_column{0};
+  uint32_t dst_column{1};
+  /// If set, this field is parsed as a double edge property named
+  /// weight_name
+  std::optional<uint32_t> weight_column;
+  std::string weight_name{"weight"};
+  /// If true, node ids are unsigned integers and are stored in a uint64 node
+  /// property; otherwise they are arbitrary strings stored in a large string
+  /// node property. The property is named id_name.
+  bool numeric_ids{false};
+  std::string id_name{"id"};
+  /// Input bytes parsed as one unit of parallel work
+  uint64_t chunk_size{UINT64_C(32) << 20};
+  /// Input size in bytes above which parsed edges are spilled to a temporary
+  /// file in spill_dir. Zero means never spill.
+  uint64_t memory_budget{0};
+  std::string spill_dir{"/tmp"};
+};
+
+/// Build graph components from the edge lists in paths, which may be local
+/// files or any URI tsuba can read. Nodes are numbered densely in order of
+/// first appearance and the edges of each node are sorted by destination.
+KATANA_EXPORT Result<GraphComponents> ImportEdgeList(
+    const std::vector<std::string>& paths, const EdgeListImportOptions& opts);
+
+}  // namespace katana
+
+#endif
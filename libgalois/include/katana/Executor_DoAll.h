@@ -30,6 +30,7 @@
 #include "katana/TerminationDetection.h"
 #include "katana/ThreadPool.h"
 #include "katana/Timer.h"
+#include "katana/Tracing.h"
 #include "katana/config.h"
 #include "katana/gIO.h"
 
@@ -410,6 +411,7 @@ public:
   }
 
   void operator()(void) {
+    TraceScope trace("loop", loopname);
     ThreadContext& ctx = *workers.getLocal();
     totalTime.start();
 
@@ -488,6 +490,7 @@ struct ChooseDoAllImpl<false> {
               NEED_STATS && has_trait<more_stats_tag, ArgsT>();
 
           const char* const loopname = katana::internal::getLoopName(argsTuple);
+          TraceScope trace("loop", loopname);
 
           PerThreadTimer<MORE_STATS> totalTime(loopname, "Total");
           PerThreadTimer<MORE_STATS> initTime(loopname, "Init");
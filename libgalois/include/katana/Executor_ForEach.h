@@ -38,6 +38,7 @@
 #include "katana/ThreadTimer.h"
 #include "katana/Threads.h"
 #include "katana/Timer.h"
+#include "katana/Tracing.h"
 #include "katana/Traits.h"
 #include "katana/UserContextAccess.h"
 #include "katana/config.h"
@@ -400,6 +401,7 @@ public:
   }
 
   void operator()() {
+    TraceScope trace("loop", loopname);
     bool isLeader = ThreadPool::isLeader();
     bool couldAbort = needsAborts && activeThreads > 1;
     if (couldAbort && isLeader)
@@ -25,6 +25,7 @@
 #include "katana/ThreadTimer.h"
 #include "katana/Threads.h"
 #include "katana/Timer.h"
+#include "katana/Tracing.h"
 #include "katana/Traits.h"
 #include "katana/config.h"
 #include "katana/gIO.h"
@@ -53,7 +54,12 @@ on_each_impl(FunctionTy&& fn, const ArgsTy& argsTuple) {
 
   OperatorReferenceType<decltype(std::forward<FunctionTy>(fn))> fn_ref = fn;
 
+  // Anonymous on_each loops are the per-thread parts of other loops, which
+  // trace themselves
+  const char* const trace_name = NEEDS_STATS ? loopname : nullptr;
+
   auto runFun = [&] {
+    TraceScope trace("loop", trace_name);
     execTime.start();
 
     fn_ref(ThreadPool::getTID(), numT);
@@ -20,20 +20,342 @@
 #ifndef KATANA_LIBGALOIS_KATANA_EXECUTORORDERED_H_
 #define KATANA_LIBGALOIS_KATANA_EXECUTORORDERED_H_
 
+#include <algorithm>
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include "katana/Executor_Deterministic.h"
+#include "katana/LoopsDecl.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/PriorityQueue.h"
+#include "katana/Range.h"
+#include "katana/Statistics.h"
+#include "katana/Threads.h"
+#include "katana/Traits.h"
+#include "katana/UserContextAccess.h"
 #include "katana/config.h"
+#include "katana/gstl.h"
 
 namespace katana {
 
-// TODO(ddn): Pull in and integrate in executors from exp
+namespace internal {
+
+//! Options consumed by DeterministicContext when it is reused by the ordered
+//! executor. Ordered tasks have no local state and an implicit neighborhood.
+template <typename T>
+struct OrderedOptions {
+  typedef T value_type;
+  static constexpr bool useLocalState = false;
+  static constexpr bool hasFixedNeighborhood = false;
+  static constexpr bool hasIntentToRead = false;
+};
+
+//! Stability test used by the stable-source variant of for_each_ordered: all
+//! sources are stable.
+struct AlwaysStable {
+  template <typename T>
+  bool operator()(const T&) const {
+    return true;
+  }
+};
+
+/**
+ * Windowed implicit KDG executor for ordered algorithms.
+ *
+ * Pending tasks live in per-thread min-heaps. Each round, the smallest tasks
+ * across all heaps are drawn into a window and sorted by priority; a task's
+ * position in the window is its id. Neighborhoods are then expanded in
+ * parallel with the deterministic executor's conflict detection
+ * (DeterministicContext), so a lockable ends up owned by the earliest task
+ * that touches it. Tasks that own their whole neighborhood are sources.
+ *
+ * A source may still be preceded by a task that does not exist yet: one that
+ * an earlier task of the window creates, directly or through a chain of
+ * tasks, and that reaches into the neighborhood of the source. So sources
+ * are executed in window order, in waves of sources of equal priority that
+ * run in parallel, and the round ends at the first task that is not a source
+ * or that is later than some task pushed by an earlier wave. Everything not
+ * executed is returned to the heaps. The window grows and shrinks with the
+ * commit ratio, like WindowManager.
+ *
+ * For unstable-source algorithms, a source that fails the stability test is
+ * treated like a task that is not a source, unless it is the earliest task in
+ * the window, which is always safe to execute.
+ */
+template <
+    typename T, typename Cmp, typename NhFunc, typename OpFunc,
+    typename StableTest>
+class OrderedExecutor {
+  typedef OrderedOptions<T> OptionsTy;
+  typedef DItem<OptionsTy> Item;
+  typedef DeterministicContext<OptionsTy> Context;
+  typedef MinHeap<T, Cmp, std::vector<T>> Heap;
+
+  static constexpr size_t kInitialDelta = 4;
+  static constexpr size_t kMaxDelta = 1 << 16;
+  static constexpr float kTargetCommitRatio = 0.95;
+
+  struct ThreadLocalData {
+    Heap reserve;
+    //! Tasks drawn from reserve this round, in priority order
+    std::vector<T> drawn;
+    //! Contexts must not move once created because lockables point to them
+    std::deque<Context> contexts;
+    UserContextAccess<T> facing;
+    //! The earliest task pushed during the current wave
+    std::optional<T> min_pushed;
+    size_t committed{0};
+    size_t iterations{0};
+    size_t offset{0};
+
+    explicit ThreadLocalData(const Cmp& cmp) : reserve(cmp) {}
+  };
+
+  Cmp cmp_;
+  NhFunc nh_func_;
+  OpFunc op_func_;
+  StableTest stability_test_;
+  const char* loopname_;
+
+  PerThreadStorage<ThreadLocalData> data_;
+  std::vector<T> window_;
+  //! The context of each task in the window, indexed by id
+  std::vector<Context*> contexts_;
+  size_t delta_{kInitialDelta};
+
+  template <typename Iter>
+  void AddInitialWork(Iter b, Iter e) {
+    katana::on_each([&](unsigned tid, unsigned total) {
+      ThreadLocalData& local = *data_.getLocal();
+      auto range = katana::block_range(b, e, tid, total);
+      for (auto ii = range.first; ii != range.second; ++ii) {
+        local.reserve.push(*ii);
+      }
+    });
+  }
+
+  //! Draw the next window from the reserves. Every task left in a reserve is
+  //! not earlier than any task in the window. Returns the window size.
+  size_t DrawWindow() {
+    katana::on_each([&](unsigned, unsigned) {
+      ThreadLocalData& local = *data_.getLocal();
+      local.drawn.clear();
+      for (size_t i = 0; i < delta_ && !local.reserve.empty(); ++i) {
+        local.drawn.push_back(local.reserve.pop());
+      }
+    });
+
+    // The latest task that is safe to put in the window is the earliest of
+    // the last tasks drawn by threads that have tasks left in their reserve.
+    const T* limit = nullptr;
+    for (unsigned i = 0; i < getActiveThreads(); ++i) {
+      ThreadLocalData& r = *data_.getRemote(i);
+      if (r.reserve.empty() || r.drawn.empty()) {
+        continue;
+      }
+      if (!limit || cmp_(r.drawn.back(), *limit)) {
+        limit = &r.drawn.back();
+      }
+    }
+
+    if (limit) {
+      T limit_value = *limit;
+      katana::on_each([&](unsigned, unsigned) {
+        ThreadLocalData& local = *data_.getLocal();
+        while (!local.drawn.empty() && cmp_(limit_value, local.drawn.back())) {
+          local.reserve.push(local.drawn.back());
+          local.drawn.pop_back();
+        }
+      });
+    }
+
+    size_t size = 0;
+    for (unsigned i = 0; i < getActiveThreads(); ++i) {
+      ThreadLocalData& r = *data_.getRemote(i);
+      r.offset = size;
+      size += r.drawn.size();
+    }
+
+    window_.resize(size);
+    katana::on_each([&](unsigned, unsigned) {
+      ThreadLocalData& local = *data_.getLocal();
+      std::copy(
+          local.drawn.begin(), local.drawn.end(),
+          window_.begin() + local.offset);
+    });
+    katana::ParallelSTL::sort(window_.begin(), window_.end(), cmp_);
+
+    return size;
+  }
+
+  //! Expand the neighborhood of every task in the window. Conflicts are
+  //! resolved in favor of the task with the smaller id, i.e., the earlier
+  //! task.
+  void ExpandNeighborhoods() {
+    katana::do_all(
+        katana::iterate(size_t{0}, window_.size()),
+        [&](size_t i) {
+          ThreadLocalData& local = *data_.getLocal();
+          Context& ctx = local.contexts.emplace_back(Item(window_[i], i));
+          ctx.startIteration();
+          ctx.setFirstPass();
+          setThreadContext(&ctx);
+          nh_func_(ctx.item.val);
+          ctx.resetFirstPass();
+          setThreadContext(nullptr);
+        },
+        katana::steal(), katana::no_stats());
+  }
+
+  bool IsSource(Context& ctx) {
+    return ctx.isReady() && (ctx.item.id == 0 || stability_test_(ctx.item.val));
+  }
+
+  void ExecuteTask(ThreadLocalData* local, const T& val) {
+    ++local->committed;
+    local->facing.resetPushBuffer();
+    op_func_(val, local->facing.data());
+    for (auto& item : local->facing.getPushBuffer()) {
+      if (!local->min_pushed || cmp_(item, *local->min_pushed)) {
+        local->min_pushed = item;
+      }
+      local->reserve.push(item);
+    }
+    local->facing.resetPushBuffer();
+  }
+
+  //! Execute the longest prefix of the window that is safe to execute and
+  //! return everything else, including new work, to the reserves.
+  void ExecuteSources() {
+    contexts_.resize(window_.size());
+    katana::on_each([&](unsigned, unsigned) {
+      ThreadLocalData& local = *data_.getLocal();
+      for (Context& ctx : local.contexts) {
+        contexts_[ctx.item.id] = &ctx;
+        ++local.iterations;
+      }
+    });
+
+    // The earliest task pushed by the waves executed so far
+    std::optional<T> bound;
+    size_t begin = 0;
+    while (begin < contexts_.size()) {
+      const T& first = contexts_[begin]->item.val;
+      if (!IsSource(*contexts_[begin]) || (bound && cmp_(*bound, first))) {
+        break;
+      }
+      // The window is sorted, so the tasks equal to first follow it
+      size_t end = begin + 1;
+      while (end < contexts_.size() &&
+             !cmp_(first, contexts_[end]->item.val) &&
+             IsSource(*contexts_[end])) {
+        ++end;
+      }
+
+      if (end - begin == 1) {
+        ThreadLocalData& local = *data_.getLocal();
+        ExecuteTask(&local, first);
+      } else {
+        katana::do_all(
+            katana::iterate(begin, end),
+            [&](size_t i) {
+              ExecuteTask(data_.getLocal(), contexts_[i]->item.val);
+            },
+            katana::no_stats());
+      }
+
+      for (unsigned i = 0; i < getActiveThreads(); ++i) {
+        ThreadLocalData& r = *data_.getRemote(i);
+        if (r.min_pushed && (!bound || cmp_(*r.min_pushed, *bound))) {
+          bound = r.min_pushed;
+        }
+        r.min_pushed.reset();
+      }
+      begin = end;
+    }
+
+    // Locks may be stolen across threads, so only release them after every
+    // task has been executed.
+    katana::on_each([&](unsigned, unsigned) {
+      ThreadLocalData& local = *data_.getLocal();
+      for (Context& ctx : local.contexts) {
+        if (ctx.item.id >= begin) {
+          local.reserve.push(ctx.item.val);
+        }
+        ctx.commitIteration();
+      }
+      local.contexts.clear();
+    });
+  }
+
+  void CalculateWindow(size_t* total_committed, size_t* total_iterations) {
+    size_t committed = 0;
+    size_t iterations = 0;
+    for (unsigned i = 0; i < getActiveThreads(); ++i) {
+      ThreadLocalData& r = *data_.getRemote(i);
+      committed += r.committed;
+      iterations += r.iterations;
+      r.committed = r.iterations = 0;
+    }
+    *total_committed += committed;
+    *total_iterations += iterations;
+
+    float commit_ratio = iterations > 0 ? committed / (float)iterations : 0.0;
+    if (commit_ratio >= kTargetCommitRatio) {
+      delta_ = std::min(delta_ + delta_, kMaxDelta);
+    } else {
+      delta_ = std::max<size_t>(commit_ratio / kTargetCommitRatio * delta_, 1);
+    }
+  }
+
+public:
+  OrderedExecutor(
+      const Cmp& cmp, const NhFunc& nh_func, const OpFunc& op_func,
+      const StableTest& stability_test, const char* loopname)
+      : cmp_(cmp),
+        nh_func_(nh_func),
+        op_func_(op_func),
+        stability_test_(stability_test),
+        loopname_(loopname ? loopname : "for_each_ordered"),
+        data_(cmp) {
+    Context::initialize();
+  }
+
+  template <typename Iter>
+  void Execute(Iter b, Iter e) {
+    AddInitialWork(b, e);
+
+    size_t rounds = 0;
+    size_t committed = 0;
+    size_t iterations = 0;
+
+    while (DrawWindow() > 0) {
+      ++rounds;
+      ExpandNeighborhoods();
+      ExecuteSources();
+      CalculateWindow(&committed, &iterations);
+    }
+
+    ReportStatSingle(loopname_, "RoundsExecuted", rounds);
+    ReportStatSingle(loopname_, "Iterations", iterations);
+    ReportStatSingle(loopname_, "Commits", committed);
+    ReportStatSingle(loopname_, "Conflicts", iterations - committed);
+  }
+};
+
+}  // namespace internal
 
 template <typename Iter, typename Cmp, typename NhFunc, typename OpFunc>
 void
 for_each_ordered_impl(
-    [[maybe_unused]] Iter beg, [[maybe_unused]] Iter end,
-    [[maybe_unused]] const Cmp& cmp, [[maybe_unused]] const NhFunc& nhFunc,
-    [[maybe_unused]] const OpFunc& opFunc,
-    [[maybe_unused]] const char* loopname) {
-  KATANA_DIE("not yet implemented");
+    Iter beg, Iter end, const Cmp& cmp, const NhFunc& nhFunc,
+    const OpFunc& opFunc, const char* loopname) {
+  typedef typename std::iterator_traits<Iter>::value_type T;
+  internal::OrderedExecutor<T, Cmp, NhFunc, OpFunc, internal::AlwaysStable> e(
+      cmp, nhFunc, opFunc, internal::AlwaysStable(), loopname);
+  e.Execute(beg, end);
 }
 
 template <
@@ -41,12 +363,13 @@ template <
     typename StableTest>
 void
 for_each_ordered_impl(
-    [[maybe_unused]] Iter beg, [[maybe_unused]] Iter end,
-    [[maybe_unused]] const Cmp& cmp, [[maybe_unused]] const NhFunc& nhFunc,
-    [[maybe_unused]] const OpFunc& opFunc,
-    [[maybe_unused]] const StableTest& stabilityTest,
-    [[maybe_unused]] const char* loopname) {
-  KATANA_DIE("not yet implemented");
+    Iter beg, Iter end, const Cmp& cmp, const NhFunc& nhFunc,
+    const OpFunc& opFunc, const StableTest& stabilityTest,
+    const char* loopname) {
+  typedef typename std::iterator_traits<Iter>::value_type T;
+  internal::OrderedExecutor<T, Cmp, NhFunc, OpFunc, StableTest> e(
+      cmp, nhFunc, opFunc, stabilityTest, loopname);
+  e.Execute(beg, end);
 }
 
 }  // end namespace katana
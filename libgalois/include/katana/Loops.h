@@ -94,9 +94,10 @@ on_each(FunctionTy&& fn, Args&&... args) {
  * Operator should conform to <code>fn(item, UserContext<T>&)</code> where item
  * is a value from the iteration range and T is the type of item. Comparison
  * function should conform to <code>bool r = cmp(item1, item2)</code> where r is
- * true if item1 is less than or equal to item2. Neighborhood function should
- * conform to <code>nhFunc(item)</code> and should visit every element in the
- * neighborhood of active element item.
+ * true if item1 must be executed before item2, i.e., a strict weak ordering.
+ * Neighborhood function should conform to <code>nhFunc(item)</code> and should
+ * acquire every element in the neighborhood of active element item, e.g.,
+ * with <code>katana::acquire(lockable, katana::MethodFlag::WRITE)</code>.
  *
  * @param b begining of range of initial items
  * @param e end of range of initial items
@@ -119,11 +120,12 @@ for_each_ordered(
  * Operator should conform to <code>fn(item, UserContext<T>&)</code> where item
  * is a value from the iteration range and T is the type of item. Comparison
  * function should conform to <code>bool r = cmp(item1, item2)</code> where r is
- * true if item1 is less than or equal to item2. Neighborhood function should
- * conform to <code>nhFunc(item)</code> and should visit every element in the
- * neighborhood of active element item. The stability test should conform to
- * <code>bool r = stabilityTest(item)</code> where r is true if item is a stable
- * source.
+ * true if item1 must be executed before item2, i.e., a strict weak ordering.
+ * Neighborhood function should conform to <code>nhFunc(item)</code> and should
+ * acquire every element in the neighborhood of active element item, e.g.,
+ * with <code>katana::acquire(lockable, katana::MethodFlag::WRITE)</code>. The
+ * stability test should conform to <code>bool r = stabilityTest(item)</code>
+ * where r is true if item is a stable source.
  *
  * @param b begining of range of initial items
  * @param e end of range of initial items
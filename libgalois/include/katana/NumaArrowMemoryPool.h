@@ -0,0 +1,96 @@
+#ifndef KATANA_LIBGALOIS_KATANA_NUMAARROWMEMORYPOOL_H_
+#define KATANA_LIBGALOIS_KATANA_NUMAARROWMEMORYPOOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include <arrow/memory_pool.h>
+
+#include "katana/config.h"
+
+namespace katana {
+
+/// NumaArrowMemoryPool is an arrow::MemoryPool that places large buffers
+/// (property columns, topology arrays) across NUMA nodes the same way
+/// LargeArray does.
+///
+/// Allocations of at least Options::min_numa_size bytes are mapped directly
+/// from huge pages (see allocPages) and faulted in by the active threads
+/// according to the placement policy. Smaller allocations are forwarded to a
+/// fallback pool.
+///
+/// The thread pool can only fault pages in while the memory pool is attached
+/// (SharedMemSys attaches the global pool), from the attaching thread and
+/// outside of parallel loops. Large allocations made elsewhere are left
+/// unfaulted and are placed by first touch.
+class KATANA_EXPORT NumaArrowMemoryPool : public arrow::MemoryPool {
+public:
+  enum class Policy {
+    /// Round-robin pages over the active threads
+    kInterleaved,
+    /// Give each active thread one contiguous block of pages
+    kBlocked,
+    /// Fault every page in on the allocating thread
+    kLocal,
+  };
+
+  struct Options {
+    Policy policy{Policy::kInterleaved};
+    int64_t min_numa_size{INT64_C(8) << 20};
+  };
+
+  /// Default options, overridden by the environment variables
+  /// KATANA_NUMA_POOL_POLICY (interleaved, blocked or local) and
+  /// KATANA_NUMA_POOL_MIN_SIZE (in bytes)
+  static Options DefaultOptions();
+
+  explicit NumaArrowMemoryPool(
+      const Options& opts = DefaultOptions(),
+      arrow::MemoryPool* fallback = arrow::default_memory_pool());
+
+  arrow::Status Allocate(int64_t size, uint8_t** out) override;
+  arrow::Status Reallocate(
+      int64_t old_size, int64_t new_size, uint8_t** ptr) override;
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  int64_t bytes_allocated() const override { return bytes_allocated_; }
+  int64_t max_memory() const override { return max_memory_; }
+  std::string backend_name() const override;
+
+  const Options& options() const { return opts_; }
+
+  /// Allow the thread pool to fault pages in for allocations made by the
+  /// calling thread. The thread pool must outlive the attachment.
+  void Attach() { owner_ = std::this_thread::get_id(); }
+  void Detach() { owner_ = std::thread::id(); }
+
+  /// Report allocation counters to the statistics manager under region
+  void ReportStats(const std::string& region) const;
+
+private:
+  bool IsNuma(int64_t size) const { return size >= opts_.min_numa_size; }
+  /// Returns nullptr if the memory cannot be mapped
+  uint8_t* AllocateNuma(int64_t size);
+  void Account(int64_t delta);
+
+  Options opts_;
+  arrow::MemoryPool* fallback_;
+  std::atomic<std::thread::id> owner_;
+
+  std::atomic<int64_t> bytes_allocated_{0};
+  std::atomic<int64_t> max_memory_{0};
+  std::atomic<int64_t> num_allocations_{0};
+  std::atomic<int64_t> num_numa_allocations_{0};
+  std::atomic<int64_t> numa_bytes_mapped_{0};
+};
+
+/// Return the process-wide NumaArrowMemoryPool, creating it with
+/// DefaultOptions on first use. It is never destroyed so that buffers may
+/// outlive SharedMemSys.
+KATANA_EXPORT NumaArrowMemoryPool* GetNumaArrowMemoryPool();
+
+}  // namespace katana
+
+#endif
@@ -45,6 +45,14 @@ KATANA_EXPORT LAptr largeMallocInterleaved(size_t bytes, unsigned numThreads);
 // fault in block interleaved mapping
 KATANA_EXPORT LAptr largeMallocBlocked(size_t bytes, unsigned numThreads);
 
+// as above, but return an empty pointer instead of aborting if the memory
+// cannot be mapped
+KATANA_EXPORT LAptr tryLargeMallocLocal(size_t bytes);
+KATANA_EXPORT LAptr tryLargeMallocFloating(size_t bytes);
+KATANA_EXPORT LAptr
+tryLargeMallocInterleaved(size_t bytes, unsigned numThreads);
+KATANA_EXPORT LAptr tryLargeMallocBlocked(size_t bytes, unsigned numThreads);
+
 // fault in specified regions for each thread (threadRanges)
 template <typename RangeArrayTy>
 LAptr largeMallocSpecified(
@@ -32,6 +32,10 @@ KATANA_EXPORT size_t allocSize();
 // allocate contiguous pages, optionally faulting them in
 KATANA_EXPORT void* allocPages(unsigned num, bool preFault);
 
+// as allocPages, but return nullptr instead of aborting if the pages cannot be
+// mapped
+KATANA_EXPORT void* tryAllocPages(size_t num, bool preFault);
+
 // free page range
 KATANA_EXPORT void freePages(void* ptr, unsigned num);
 
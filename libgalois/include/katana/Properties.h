@@ -10,6 +10,7 @@
 #include <arrow/type_fwd.h>
 #include <arrow/type_traits.h>
 
+#include "katana/ArrowInterchange.h"
 #include "katana/ErrorCode.h"
 #include "katana/Logging.h"
 #include "katana/Result.h"
@@ -395,9 +396,8 @@ AllocateTable(uint64_t num_rows, const std::vector<std::string>& names) {
   std::shared_ptr<arrow::Table> table;
   std::vector<katana::PropertyArrowTuple<Props>> rows(num_rows);
   KATANA_LOG_ASSERT(names.size() == num_tuple_elem);
-  // TODO(gill): Replace this with NUMA allocated buffers.
   if (auto r = arrow::stl::TableFromTupleRange(
-          arrow::default_memory_pool(), std::move(rows), names, &table);
+          GetPropertyMemoryPool(), std::move(rows), names, &table);
       !r.ok()) {
     KATANA_LOG_DEBUG("arrow error: {}", r);
     return katana::ErrorCode::ArrowError;
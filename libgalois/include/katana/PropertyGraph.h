@@ -1,7 +1,9 @@
 #ifndef KATANA_LIBGALOIS_KATANA_PROPERTYGRAPH_H_
 #define KATANA_LIBGALOIS_KATANA_PROPERTYGRAPH_H_
 
+#include <limits>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -19,23 +21,33 @@ namespace katana {
 
 /// A graph topology represents the adjacency information for a graph in CSR
 /// format.
-struct KATANA_EXPORT GraphTopology {
-  using Node = uint32_t;
+///
+/// \tparam NodeIdTy The type of node ids. Graphs with fewer than 2^32 nodes use
+///     the compact uint32_t layout (\ref GraphTopology); larger graphs use
+///     uint64_t (\ref WideGraphTopology).
+template <typename NodeIdTy>
+struct BasicGraphTopology {
+  static_assert(
+      std::is_same_v<NodeIdTy, uint32_t> || std::is_same_v<NodeIdTy, uint64_t>,
+      "node ids must be uint32_t or uint64_t");
+
+  using Node = NodeIdTy;
   using Edge = uint64_t;
   using node_iterator = boost::counting_iterator<Node>;
   using edge_iterator = boost::counting_iterator<Edge>;
   using nodes_range = StandardRange<node_iterator>;
   using edges_range = StandardRange<edge_iterator>;
   using iterator = node_iterator;
+  using DestArray = typename arrow::CTypeTraits<NodeIdTy>::ArrayType;
 
   std::shared_ptr<arrow::UInt64Array> out_indices;
-  std::shared_ptr<arrow::UInt32Array> out_dests;
+  std::shared_ptr<DestArray> out_dests;
 
   uint64_t num_nodes() const { return out_indices ? out_indices->length() : 0; }
 
   uint64_t num_edges() const { return out_dests ? out_dests->length() : 0; }
 
-  bool Equals(const GraphTopology& other) const {
+  bool Equals(const BasicGraphTopology& other) const {
     return out_indices->Equals(*other.out_indices) &&
            out_dests->Equals(*other.out_dests);
   }
@@ -65,6 +77,14 @@ struct KATANA_EXPORT GraphTopology {
     return MakeStandardRange<edge_iterator>(begin_edge, end_edge);
   }
 
+  /// Gets the destination for an edge.
+  ///
+  /// \param edge edge iterator to get the destination of
+  /// \returns node iterator to the edge destination
+  node_iterator GetEdgeDest(const edge_iterator& edge) const {
+    return node_iterator(out_dests->Value(*edge));
+  }
+
   nodes_range nodes(Node begin, Node end) const {
     return MakeStandardRange<node_iterator>(begin, end);
   }
@@ -80,6 +100,51 @@ struct KATANA_EXPORT GraphTopology {
   bool empty() const { return num_nodes() == 0; }
 };
 
+/// The compact topology, for graphs with fewer than 2^32 nodes
+using GraphTopology = BasicGraphTopology<uint32_t>;
+
+/// The topology of graphs with 2^32 or more nodes
+using WideGraphTopology = BasicGraphTopology<uint64_t>;
+
+/// An in-edge topology represents the adjacency information of the transpose
+/// of a graph in CSR format, i.e., the graph in CSC format. It does not copy
+/// edge properties; instead each in-edge records the id of the out-edge it
+/// mirrors, which is the index to use for edge property lookups.
+///
+/// In-edges of a node are ordered by their out-edge id, and so by source.
+struct KATANA_EXPORT InEdgeTopology {
+  using Node = GraphTopology::Node;
+  using Edge = GraphTopology::Edge;
+  using edge_iterator = GraphTopology::edge_iterator;
+  using edges_range = GraphTopology::edges_range;
+
+  std::shared_ptr<arrow::UInt64Array> in_indices;
+  std::shared_ptr<arrow::UInt32Array> in_sources;
+  std::shared_ptr<arrow::UInt64Array> in_edge_ids;
+
+  uint64_t num_nodes() const { return in_indices ? in_indices->length() : 0; }
+
+  uint64_t num_edges() const { return in_sources ? in_sources->length() : 0; }
+
+  bool empty() const { return in_indices == nullptr; }
+
+  bool Equals(const InEdgeTopology& other) const {
+    return in_indices->Equals(*other.in_indices) &&
+           in_sources->Equals(*other.in_sources) &&
+           in_edge_ids->Equals(*other.in_edge_ids);
+  }
+
+  /// Gets the in-edge range of some node.
+  ///
+  /// \param node node to get the in-edge range of
+  /// \returns iterable in-edge range for node.
+  edges_range in_edges(Node node) const {
+    auto edge_start = node > 0 ? in_indices->Value(node - 1) : 0;
+    auto edge_end = in_indices->Value(node);
+    return MakeStandardRange<edge_iterator>(edge_start, edge_end);
+  }
+};
+
 /// A property graph is a graph that has properties associated with its nodes
 /// and edges. A property has a name and value. Its value may be a primitive
 /// type, a list of values or a composition of properties.
@@ -107,8 +172,14 @@ class KATANA_EXPORT PropertyGraph {
   std::unique_ptr<tsuba::RDGFile> file_;
 
   // The topology is either backed by rdg_ or shared with the
-  // caller of SetTopology.
+  // caller of SetTopology. Only one of topology_ and wide_topology_ is set,
+  // depending on the width of node ids.
   GraphTopology topology_;
+  WideGraphTopology wide_topology_;
+
+  // The in-edge topology is either backed by rdg_, built by BuildInEdges or
+  // empty.
+  InEdgeTopology in_topology_;
 
   // Keep partition_metadata, master_nodes, mirror_nodes out of the public interface,
   // while allowing Distribution to read/write it for RDG
@@ -412,8 +483,32 @@ public:
     return rdg_.MarkEdgePropertiesPersistent(persist_edge_props);
   }
 
+  /// The compact topology. Empty if has_wide_node_ids().
   const GraphTopology& topology() const { return topology_; }
 
+  /// The topology of a graph with 64-bit node ids. Empty unless
+  /// has_wide_node_ids().
+  const WideGraphTopology& wide_topology() const { return wide_topology_; }
+
+  /// \returns true if this graph has a wide topology. Graphs whose node ids
+  /// do not fit in 32 bits are only accessible through wide_topology() or a
+  /// TypedPropertyGraph with uint64_t node ids; the Node-based accessors of
+  /// PropertyGraph require that node ids fit in Node.
+  bool has_wide_node_ids() const {
+    return wide_topology_.out_indices != nullptr;
+  }
+
+  /// The topology with node ids of type NodeIdTy, for code templated on the
+  /// width of node ids.
+  template <typename NodeIdTy>
+  const BasicGraphTopology<NodeIdTy>& GetTopology() const {
+    if constexpr (std::is_same_v<NodeIdTy, uint64_t>) {
+      return wide_topology_;
+    } else {
+      return topology_;
+    }
+  }
+
   Result<void> AddNodeProperties(const std::shared_ptr<arrow::Table>& props);
   Result<void> AddEdgeProperties(const std::shared_ptr<arrow::Table>& props);
 
@@ -448,6 +543,22 @@ public:
   }
 
   Result<void> SetTopology(const GraphTopology& topology);
+  Result<void> SetTopology(const WideGraphTopology& topology);
+
+  const InEdgeTopology& in_topology() const { return in_topology_; }
+
+  /// \returns true if in-edges are available, i.e., if they were loaded with
+  /// the graph or constructed by BuildInEdges.
+  bool has_in_edges() const { return !in_topology_.empty(); }
+
+  /// Construct the in-edge topology of this graph in parallel if it is not
+  /// already available. The in-edge topology is persisted along with the
+  /// graph by Write and Commit, and it is loaded by Make if present.
+  Result<void> BuildInEdges();
+
+  /// Discard the in-edge topology. Call this after modifying the topology in
+  /// place; SetTopology does it automatically.
+  Result<void> DropInEdges();
 
   /// Return the node property table for local nodes
   const std::shared_ptr<arrow::Table>& node_properties() const {
@@ -469,26 +580,41 @@ public:
 
   // Standard container concepts
 
-  node_iterator begin() const { return topology().begin(); }
+  node_iterator begin() const { return node_iterator(0); }
 
-  node_iterator end() const { return topology().end(); }
+  node_iterator end() const {
+    KATANA_LOG_VASSERT(
+        num_nodes() <= std::numeric_limits<Node>::max(),
+        "{} nodes do not fit in 32-bit node ids; use wide_topology()",
+        num_nodes());
+    return node_iterator(num_nodes());
+  }
 
   /// Return the number of local nodes
-  size_t size() const { return topology().size(); }
+  size_t size() const { return num_nodes(); }
 
-  bool empty() const { return topology().empty(); }
+  bool empty() const { return num_nodes() == 0; }
 
   /// Return the number of local nodes
   ///  num_nodes in repartitioner is of type LocalNodeID
-  uint64_t num_nodes() const { return topology().num_nodes(); }
+  uint64_t num_nodes() const {
+    return has_wide_node_ids() ? wide_topology_.num_nodes()
+                               : topology_.num_nodes();
+  }
   /// Return the number of local edges
-  uint64_t num_edges() const { return topology().num_edges(); }
+  uint64_t num_edges() const {
+    return has_wide_node_ids() ? wide_topology_.num_edges()
+                               : topology_.num_edges();
+  }
 
   /// Gets the edge range of some node.
   ///
   /// \param node node to get the edge range of
   /// \returns iterable edge range for node.
-  edges_range edges(Node node) const { return topology().edges(node); }
+  edges_range edges(Node node) const {
+    return has_wide_node_ids() ? wide_topology_.edges(node)
+                               : topology_.edges(node);
+  }
 
   /**
    * Gets the destination for an edge.
@@ -497,9 +623,40 @@ public:
    * @returns node iterator to the edge destination
    */
   node_iterator GetEdgeDest(const edge_iterator& edge) const {
-    auto node_id = topology().out_dests->Value(*edge);
+    if (has_wide_node_ids()) {
+      // Nodes from begin() and end() fit in Node, so do their neighbors
+      return node_iterator(wide_topology_.out_dests->Value(*edge));
+    }
+    return topology_.GetEdgeDest(edge);
+  }
+
+  /// Gets the in-edge range of some node. Requires has_in_edges().
+  ///
+  /// \param node node to get the in-edge range of
+  /// \returns iterable in-edge range for node.
+  edges_range in_edges(Node node) const {
+    KATANA_LOG_DEBUG_ASSERT(has_in_edges());
+    return in_topology_.in_edges(node);
+  }
+
+  /// Gets the source of an in-edge.
+  ///
+  /// \param in_edge in-edge iterator to get the source of
+  /// \returns node iterator to the in-edge source
+  node_iterator GetInEdgeSource(const edge_iterator& in_edge) const {
+    auto node_id = in_topology_.in_sources->Value(*in_edge);
     return node_iterator(node_id);
   }
+
+  /// Gets the out-edge that an in-edge mirrors. Edge properties are only
+  /// stored for out-edges, so use the result to look up properties of
+  /// in-edges.
+  ///
+  /// \param in_edge in-edge iterator to map
+  /// \returns edge iterator to the corresponding out-edge
+  edge_iterator InEdgeToOutEdge(const edge_iterator& in_edge) const {
+    return edge_iterator(in_topology_.in_edge_ids->Value(*in_edge));
+  }
 };
 
 /// SortAllEdgesByDest sorts edges for each node by destination
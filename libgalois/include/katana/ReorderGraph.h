@@ -0,0 +1,102 @@
+#ifndef KATANA_LIBGALOIS_KATANA_REORDERGRAPH_H_
+#define KATANA_LIBGALOIS_KATANA_REORDERGRAPH_H_
+
+#include <string>
+
+#include "katana/PropertyGraph.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// A plan for ReorderGraph, specifying the node order to compute and any
+/// parameters associated with it.
+class KATANA_EXPORT ReorderPlan {
+public:
+  enum Algorithm {
+    kDegreeSort,
+    kHubCluster,
+    kReverseCuthillMcKee,
+    kGorder,
+  };
+
+  static constexpr uint32_t kDefaultNumGroups = 8;
+  static constexpr uint32_t kDefaultWindowSize = 5;
+
+private:
+  Algorithm algorithm_;
+  uint32_t num_groups_;
+  uint32_t window_size_;
+
+  ReorderPlan(Algorithm algorithm, uint32_t num_groups, uint32_t window_size)
+      : algorithm_(algorithm),
+        num_groups_(num_groups),
+        window_size_(window_size) {}
+
+public:
+  ReorderPlan() : ReorderPlan{kDegreeSort, 0, 0} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  /// The number of degree groups of HubCluster
+  uint32_t num_groups() const { return num_groups_; }
+  /// The number of recently placed nodes that Gorder scores against
+  uint32_t window_size() const { return window_size_; }
+
+  /// Order nodes by decreasing out-degree, like SortNodesByDegree.
+  static ReorderPlan DegreeSort() { return {kDegreeSort, 0, 0}; }
+
+  /// Degree-based grouping. Nodes are grouped by out-degree relative to the
+  /// average degree, with groups that double in range, and the groups of
+  /// higher degree come first. Nodes keep their relative order within a
+  /// group, so most of the locality of the original order survives while the
+  /// hubs are packed together.
+  /// [1] P. Faldu, J. Diamond and B. Grot, "A Closer Look at Lightweight
+  /// Graph Reordering," IISWC 2019.
+  static ReorderPlan HubCluster(uint32_t num_groups = kDefaultNumGroups) {
+    return {kHubCluster, num_groups, 0};
+  }
+
+  /// Reverse Cuthill-McKee. Each component is traversed breadth first from
+  /// a node of minimum degree, visiting the neighbors of each node in order
+  /// of increasing degree, and the whole order is reversed. This reduces the
+  /// bandwidth of the adjacency matrix of symmetric graphs, so the neighbors
+  /// of a node have nearby ids. Each BFS level is ordered in parallel.
+  /// [1] K. I. Karantasis, A. Lenharth, D. Nguyen, M. J. Garzarán and
+  /// K. Pingali, "Parallelization of Reordering Algorithms for Bandwidth and
+  /// Wavefront Reduction," SC '14.
+  static ReorderPlan ReverseCuthillMcKee() {
+    return {kReverseCuthillMcKee, 0, 0};
+  }
+
+  /// A lightweight Gorder. Nodes are placed one at a time; the next node is
+  /// the unplaced node that shares the most neighbors and edges with the
+  /// last window_size placed nodes. Neighbors shared through nodes of degree
+  /// above the square root of the number of nodes are not counted, and a
+  /// lazy max-heap replaces the unit heap of the original. The greedy
+  /// placement is serial; scoring it costs about the sum over nodes of the
+  /// squared degree.
+  /// [1] H. Wei, J. X. Yu, C. Lu and X. Lin, "Speedup Graph Processing by
+  /// Graph Ordering," SIGMOD 2016.
+  static ReorderPlan Gorder(uint32_t window_size = kDefaultWindowSize) {
+    return {kGorder, 0, window_size};
+  }
+};
+
+/// ReorderGraph relabels the nodes of pg in the order computed by plan to
+/// improve the cache locality of analytics on it.
+///
+/// Unlike SortNodesByDegree, every node property and edge property is
+/// permuted along with the topology. The edges of a node keep their order.
+/// If original_id_property_name is not empty, the property of that name holds
+/// the id of each node before any reordering: it is created as a uint64
+/// property if it does not exist, and otherwise permuted like the others, so
+/// that it keeps mapping to the ids before the first reordering.
+///
+/// The permuted properties replace the old ones in memory and are not
+/// persistent until marked so. In-edges are dropped.
+KATANA_EXPORT Result<void> ReorderGraph(
+    PropertyGraph* pg, const std::string& original_id_property_name,
+    ReorderPlan plan = ReorderPlan());
+
+}  // namespace katana
+
+#endif
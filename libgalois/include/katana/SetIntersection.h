@@ -0,0 +1,92 @@
+#ifndef KATANA_LIBGALOIS_KATANA_SETINTERSECTION_H_
+#define KATANA_LIBGALOIS_KATANA_SETINTERSECTION_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "katana/PropertyGraph.h"
+#include "katana/config.h"
+
+/// \file SetIntersection.h
+///
+/// Kernels that count the common elements of sorted sets of node ids, such as
+/// the adjacency lists of a graph whose edges are sorted by destination.
+///
+/// All sets are arrays of node ids in strictly increasing order. Results are
+/// unspecified if a set contains duplicates.
+
+namespace katana {
+
+/// The merge kernels available to CountIntersection, from narrowest to widest
+enum class SimdLevel {
+  kScalar,
+  kSSE2,
+  kAVX2,
+  kAVX512,
+};
+
+/// The widest merge kernel the running CPU supports
+KATANA_EXPORT SimdLevel GetSimdLevel();
+
+KATANA_EXPORT const char* SimdLevelName(SimdLevel level);
+
+/// Count the values that occur in both a and b.
+///
+/// When one set is much larger than the other, this searches the larger set
+/// for each value of the smaller one with galloping (exponential) search;
+/// otherwise, it merges the two with the widest SIMD kernel the CPU supports.
+KATANA_EXPORT uint64_t CountIntersection(
+    const uint32_t* a, uint64_t a_size, const uint32_t* b, uint64_t b_size);
+
+/// CountIntersection by merging with a specific kernel, which the CPU must
+/// support
+KATANA_EXPORT uint64_t CountIntersectionMerge(
+    const uint32_t* a, uint64_t a_size, const uint32_t* b, uint64_t b_size,
+    SimdLevel level);
+
+/// CountIntersection by galloping search for each value of a in b
+KATANA_EXPORT uint64_t CountIntersectionGallop(
+    const uint32_t* a, uint64_t a_size, const uint32_t* b, uint64_t b_size);
+
+/// IntersectionBitmap is a dense copy of a set for intersecting it with many
+/// other sets in time proportional to the size of each other set, e.g., the
+/// neighbors of a hub node with the neighbors of each of its neighbors.
+///
+/// Memory is proportional to the range of values in the set, so a bitmap
+/// should only be built for sets where IsWorthwhile holds.
+class KATANA_EXPORT IntersectionBitmap {
+public:
+  /// The smallest set for which a bitmap pays off
+  static constexpr uint64_t kMinSize = 512;
+  /// The lowest density (set size over range of values) worth a bitmap
+  static constexpr uint64_t kMaxSparsity = 64;
+
+  static bool IsWorthwhile(const uint32_t* values, uint64_t size) {
+    return size >= kMinSize &&
+           values[size - 1] - values[0] < kMaxSparsity * size;
+  }
+
+  /// Replace the contents of the bitmap with values, reusing its memory
+  void Assign(const uint32_t* values, uint64_t size);
+
+  /// Count the values of b that are in the bitmap
+  uint64_t CountIntersection(const uint32_t* b, uint64_t b_size) const;
+
+private:
+  uint32_t first_{};
+  uint64_t num_bits_{};
+  std::vector<uint64_t> words_;
+};
+
+/// The destinations of the out-edges of node as an array
+inline std::pair<const uint32_t*, const uint32_t*>
+OutDestinations(const GraphTopology& topology, GraphTopology::Node node) {
+  auto [begin, end] = topology.edge_range(node);
+  const uint32_t* dests = topology.out_dests->raw_values();
+  return std::make_pair(dests + begin, dests + end);
+}
+
+}  // namespace katana
+
+#endif
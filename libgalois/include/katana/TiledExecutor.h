@@ -20,6 +20,12 @@
 #ifndef KATANA_LIBGALOIS_KATANA_TILEDEXECUTOR_H_
 #define KATANA_LIBGALOIS_KATANA_TILEDEXECUTOR_H_
 
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include <boost/iterator/transform_iterator.hpp>
+
 #include "katana/Galois.h"
 #include "katana/LargeArray.h"
 #include "katana/NoDerefIterator.h"
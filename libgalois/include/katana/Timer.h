@@ -64,6 +64,7 @@ class KATANA_EXPORT StatTimer : public TimeAccumulator {
   gstl::Str name_;
   gstl::Str region_;
   bool valid_;
+  int64_t trace_begin_ns_{-1};
 
 public:
   StatTimer(const char* name, const char* region);
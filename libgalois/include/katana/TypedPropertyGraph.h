@@ -1,7 +1,9 @@
 #ifndef KATANA_LIBGALOIS_KATANA_TYPEDPROPERTYGRAPH_H_
 #define KATANA_LIBGALOIS_KATANA_TYPEDPROPERTYGRAPH_H_
 
+#include <climits>
 #include <tuple>
+#include <type_traits>
 
 #include <arrow/type_fwd.h>
 #include <boost/iterator/counting_iterator.hpp>
@@ -29,8 +31,12 @@ namespace katana {
 ///
 /// \tparam NodeProps A tuple of property types (\ref Properties.h) for nodes
 /// \tparam EdgeProps A tuple of property types for edges
-template <typename NodeProps, typename EdgeProps>
+/// \tparam NodeIdTy The type of node ids; uint64_t views graphs for which
+///     PropertyGraph::has_wide_node_ids() is true
+template <typename NodeProps, typename EdgeProps, typename NodeIdTy = uint32_t>
 class TypedPropertyGraph {
+  using Topology = BasicGraphTopology<NodeIdTy>;
+
   using NodeView = PropertyViewTuple<NodeProps>;
   using EdgeView = PropertyViewTuple<EdgeProps>;
 
@@ -39,6 +45,10 @@ class TypedPropertyGraph {
   NodeView node_view_;
   EdgeView edge_view_;
 
+  const Topology& topology() const {
+    return pfg_->template GetTopology<NodeIdTy>();
+  }
+
   TypedPropertyGraph(PropertyGraph* pg, NodeView node_view, EdgeView edge_view)
       : pfg_(pg),
         node_view_(std::move(node_view)),
@@ -47,22 +57,22 @@ class TypedPropertyGraph {
 public:
   using node_properties = NodeProps;
   using edge_properties = EdgeProps;
-  using node_iterator = GraphTopology::node_iterator;
-  using edge_iterator = GraphTopology::edge_iterator;
-  using edges_range = GraphTopology::edges_range;
-  using iterator = GraphTopology::iterator;
-  using Node = GraphTopology::Node;
-  using Edge = GraphTopology::Edge;
+  using node_iterator = typename Topology::node_iterator;
+  using edge_iterator = typename Topology::edge_iterator;
+  using edges_range = typename Topology::edges_range;
+  using iterator = typename Topology::iterator;
+  using Node = typename Topology::Node;
+  using Edge = typename Topology::Edge;
 
   // Standard container concepts
 
-  node_iterator begin() const { return pfg_->begin(); }
+  node_iterator begin() const { return topology().begin(); }
 
-  node_iterator end() const { return pfg_->end(); }
+  node_iterator end() const { return topology().end(); }
 
-  size_t size() const { return pfg_->size(); }
+  size_t size() const { return topology().size(); }
 
-  bool empty() const { return pfg_->empty(); }
+  bool empty() const { return topology().empty(); }
 
   // Graph accessors
 
@@ -131,11 +141,11 @@ public:
    * @returns node iterator to the edge destination
    */
   node_iterator GetEdgeDest(const edge_iterator& edge) const {
-    return pfg_->GetEdgeDest(edge);
+    return topology().GetEdgeDest(edge);
   }
 
-  uint64_t num_nodes() const { return pfg_->num_nodes(); }
-  uint64_t num_edges() const { return pfg_->num_edges(); }
+  uint64_t num_nodes() const { return topology().num_nodes(); }
+  uint64_t num_edges() const { return topology().num_edges(); }
 
   /**
    * Gets the edge range of some node.
@@ -143,7 +153,7 @@ public:
    * @param node node to get the edge range of
    * @returns iterable edge range for node.
    */
-  edges_range edges(Node node) const { return pfg_->edges(node); }
+  edges_range edges(Node node) const { return topology().edges(node); }
 
   /**
    * Gets the edge range of some node.
@@ -151,7 +161,9 @@ public:
    * @param node node to get the edge range of
    * @returns iterable edge range for node.
    */
-  edges_range edges(node_iterator node) const { return pfg_->edges(*node); }
+  edges_range edges(node_iterator node) const {
+    return topology().edges(*node);
+  }
   // TODO(amp): [[deprecated("use edges(Node node)")]]
 
   /**
@@ -161,7 +173,7 @@ public:
    * @returns iterator to first edge of node
    */
   edge_iterator edge_begin(Node node) const {
-    return pfg_->edges(node).begin();
+    return topology().edges(node).begin();
   }
   // TODO(amp): [[deprecated("use edges(node)")]]
 
@@ -172,7 +184,9 @@ public:
    * @returns iterator to the end of the edges of node, i.e. the first edge of
    *     the next node (or an "end" iterator if there is no next node)
    */
-  edge_iterator edge_end(Node node) const { return pfg_->edges(node).end(); }
+  edge_iterator edge_end(Node node) const {
+    return topology().edges(node).end();
+  }
   // TODO(amp): [[deprecated("use edges(node)")]]
 
   /**
@@ -183,11 +197,10 @@ public:
   const PropertyGraph& GetPropertyGraph() const { return *pfg_; }
 
   // Graph constructors
-  static Result<TypedPropertyGraph<NodeProps, EdgeProps>> Make(
+  static Result<TypedPropertyGraph> Make(
       PropertyGraph* pg, const std::vector<std::string>& node_properties,
       const std::vector<std::string>& edge_properties);
-  static Result<TypedPropertyGraph<NodeProps, EdgeProps>> Make(
-      PropertyGraph* pg);
+  static Result<TypedPropertyGraph> Make(PropertyGraph* pg);
 };
 
 /**
@@ -208,11 +221,18 @@ FindEdgeSortedByDest(
   return typename GraphTy::edge_iterator(edge_matched);
 }
 
-template <typename NodeProps, typename EdgeProps>
-Result<TypedPropertyGraph<NodeProps, EdgeProps>>
-TypedPropertyGraph<NodeProps, EdgeProps>::Make(
+template <typename NodeProps, typename EdgeProps, typename NodeIdTy>
+Result<TypedPropertyGraph<NodeProps, EdgeProps, NodeIdTy>>
+TypedPropertyGraph<NodeProps, EdgeProps, NodeIdTy>::Make(
     PropertyGraph* pg, const std::vector<std::string>& node_properties,
     const std::vector<std::string>& edge_properties) {
+  if (pg->has_wide_node_ids() != std::is_same_v<NodeIdTy, uint64_t>) {
+    KATANA_LOG_DEBUG(
+        "graph node ids are {} bits but the view expects {} bits",
+        pg->has_wide_node_ids() ? 64 : 32, sizeof(NodeIdTy) * CHAR_BIT);
+    return ErrorCode::InvalidArgument;
+  }
+
   auto node_view_result =
       internal::MakeNodePropertyViews<NodeProps>(pg, node_properties);
   if (!node_view_result) {
@@ -230,10 +250,10 @@ TypedPropertyGraph<NodeProps, EdgeProps>::Make(
       std::move(edge_view_result.value()));
 }
 
-template <typename NodeProps, typename EdgeProps>
-Result<TypedPropertyGraph<NodeProps, EdgeProps>>
-TypedPropertyGraph<NodeProps, EdgeProps>::Make(PropertyGraph* pg) {
-  return TypedPropertyGraph<NodeProps, EdgeProps>::Make(
+template <typename NodeProps, typename EdgeProps, typename NodeIdTy>
+Result<TypedPropertyGraph<NodeProps, EdgeProps, NodeIdTy>>
+TypedPropertyGraph<NodeProps, EdgeProps, NodeIdTy>::Make(PropertyGraph* pg) {
+  return TypedPropertyGraph<NodeProps, EdgeProps, NodeIdTy>::Make(
       pg, pg->node_schema()->field_names(), pg->edge_schema()->field_names());
 }
 
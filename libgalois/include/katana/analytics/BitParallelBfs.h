@@ -0,0 +1,191 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_BITPARALLELBFS_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_BITPARALLELBFS_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "katana/Galois.h"
+#include "katana/LargeArray.h"
+#include "katana/PropertyGraph.h"
+
+namespace katana::analytics {
+
+/// BitParallelBfs runs up to 64 * kWords breadth-first searches in lockstep
+/// (MS-BFS). Search i owns bit i of a fixed-width bitset per node, so one scan
+/// of the out-edges of a node advances every search that reaches the node at
+/// the same level.
+///
+/// [1] M. Then, M. Kaufmann, F. Chirigati, T. Hoang-Vu, K. Pham, A. Kemper,
+/// T. Neumann and H. T. Vo, "The More the Merrier: Efficient Multi-Source
+/// Graph Traversal," PVLDB 8(4), 2014.
+template <size_t kWords>
+class BitParallelBfs {
+public:
+  static constexpr size_t kMaxSources = 64 * kWords;
+
+  using Node = GraphTopology::Node;
+
+  struct Bits {
+    std::array<uint64_t, kWords> words;
+
+    bool any() const {
+      uint64_t any = 0;
+      for (size_t w = 0; w < kWords; ++w) {
+        any |= words[w];
+      }
+      return any != 0;
+    }
+
+    bool test(size_t i) const { return (words[i / 64] >> (i % 64)) & 1; }
+
+    /// Call fn(i) for each set bit i
+    template <typename Fn>
+    void ForEach(Fn fn) const {
+      for (size_t w = 0; w < kWords; ++w) {
+        for (uint64_t word = words[w]; word != 0; word &= word - 1) {
+          fn(w * 64 + __builtin_ctzll(word));
+        }
+      }
+    }
+  };
+
+  /// A node and the searches that reached it at some level
+  struct Visit {
+    Node node;
+    Bits bits;
+  };
+
+  using Frontier = InsertBag<Visit>;
+
+  explicit BitParallelBfs(const GraphTopology& topology)
+      : topology_(topology), frontier_(std::make_unique<Frontier>()) {
+    uint64_t num_nodes = topology.num_nodes();
+    seen_.allocateInterleaved(num_nodes);
+    next_.allocateInterleaved(num_nodes);
+    queued_.allocateInterleaved(num_nodes);
+    do_all(
+        iterate(topology),
+        [&](Node n) {
+          next_[n] = Bits{};
+          queued_[n].store(false, std::memory_order_relaxed);
+        },
+        no_stats());
+  }
+
+  /// Start new searches, search i from sources[i]. The level-0 frontier is
+  /// the sources.
+  void Start(const uint32_t* sources, size_t num_sources) {
+    KATANA_LOG_DEBUG_ASSERT(num_sources <= kMaxSources);
+    do_all(
+        iterate(topology_), [&](Node n) { seen_[n] = Bits{}; }, no_stats());
+
+    InsertBag<Node> reached;
+    for (size_t i = 0; i < num_sources; ++i) {
+      Node source = sources[i];
+      next_[source].words[i / 64] |= uint64_t{1} << (i % 64);
+      if (!queued_[source].exchange(true, std::memory_order_relaxed)) {
+        reached.push(source);
+      }
+    }
+    level_ = 0;
+    frontier_ = Advance(reached);
+  }
+
+  bool Done() const { return frontier_->empty(); }
+
+  /// The level of the current frontier
+  uint32_t level() const { return level_; }
+
+  /// The nodes first reached at the current level, each with the searches
+  /// that reached it
+  const Frontier& frontier() const { return *frontier_; }
+
+  /// The searches that reached n at or before the current level
+  const Bits& seen(Node n) const { return seen_[n]; }
+
+  /// Advance every search by one level and return the previous frontier.
+  ///
+  /// For each edge from src in the frontier to dest that reaches dest for
+  /// some searches for the first time, edge_fn(src, dest, discovered) is
+  /// called with those searches. Several threads may call edge_fn for the
+  /// same dest concurrently.
+  template <typename EdgeFn>
+  std::unique_ptr<Frontier> Step(EdgeFn edge_fn) {
+    InsertBag<Node> reached;
+    const uint32_t* dests = topology_.out_dests->raw_values();
+
+    do_all(
+        iterate(*frontier_),
+        [&](const Visit& visit) {
+          auto [begin, end] = topology_.edge_range(visit.node);
+          for (uint64_t e = begin; e < end; ++e) {
+            Node dest = dests[e];
+            Bits discovered;
+            const Bits& dest_seen = seen_[dest];
+            for (size_t w = 0; w < kWords; ++w) {
+              discovered.words[w] = visit.bits.words[w] & ~dest_seen.words[w];
+            }
+            if (!discovered.any()) {
+              continue;
+            }
+            edge_fn(visit.node, dest, discovered);
+            for (size_t w = 0; w < kWords; ++w) {
+              //! Skip the atomic when the bits are already there, which is
+              //! common for nodes reached by many frontier nodes.
+              uint64_t* next_word = &next_[dest].words[w];
+              if (discovered.words[w] &
+                  ~__atomic_load_n(next_word, __ATOMIC_RELAXED)) {
+                __atomic_fetch_or(
+                    next_word, discovered.words[w], __ATOMIC_RELAXED);
+              }
+            }
+            if (!queued_[dest].load(std::memory_order_relaxed) &&
+                !queued_[dest].exchange(true, std::memory_order_relaxed)) {
+              reached.push(dest);
+            }
+          }
+        },
+        steal(), chunk_size<64>(), loopname("BitParallelBfs"));
+
+    ++level_;
+    std::unique_ptr<Frontier> previous = std::move(frontier_);
+    frontier_ = Advance(reached);
+    return previous;
+  }
+
+  std::unique_ptr<Frontier> Step() {
+    return Step([](Node, Node, const Bits&) {});
+  }
+
+private:
+  /// Turn the searches gathered in next_ into a frontier
+  std::unique_ptr<Frontier> Advance(const InsertBag<Node>& reached) {
+    auto frontier = std::make_unique<Frontier>();
+    do_all(
+        iterate(reached),
+        [&](Node n) {
+          Bits bits = next_[n];
+          for (size_t w = 0; w < kWords; ++w) {
+            seen_[n].words[w] |= bits.words[w];
+          }
+          next_[n] = Bits{};
+          queued_[n].store(false, std::memory_order_relaxed);
+          frontier->push(Visit{n, bits});
+        },
+        no_stats());
+    return frontier;
+  }
+
+  const GraphTopology& topology_;
+  LargeArray<Bits> seen_;
+  LargeArray<Bits> next_;
+  LargeArray<std::atomic<bool>> queued_;
+  std::unique_ptr<Frontier> frontier_;
+  uint32_t level_{0};
+};
+
+}  // namespace katana::analytics
+
+#endif
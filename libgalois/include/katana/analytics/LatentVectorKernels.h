@@ -0,0 +1,257 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_LATENTVECTORKERNELS_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_LATENTVECTORKERNELS_H_
+
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define KATANA_LATENT_VECTOR_KERNELS_X86 1
+#endif
+
+namespace katana::analytics {
+
+// Kernels over the latent vectors of matrix completion. Each kernel is
+// specialized for vectors of kSize floats, or works on the size passed at run
+// time if kSize is 0. The SIMD kernels may only be used if GetSimdLevel
+// reports the matching level; AVX2Kernel also needs FMA.
+
+template <uint32_t kSize>
+struct ScalarKernel {
+  static uint32_t Size(uint32_t size) { return kSize ? kSize : size; }
+
+  static float Dot(const float* a, const float* b, uint32_t size) {
+    float sum = 0;
+    for (uint32_t i = 0; i < Size(size); ++i) {
+      sum += a[i] * b[i];
+    }
+    return sum;
+  }
+
+  /// y += alpha * x
+  static void Axpy(float alpha, const float* x, float* y, uint32_t size) {
+    for (uint32_t i = 0; i < size; ++i) {
+      y[i] += alpha * x[i];
+    }
+  }
+
+  /// Take a gradient step of the squared error of rating and the
+  /// regularization of item and user; returns the error before the step.
+  static float Sgd(
+      float* __restrict__ item, float* __restrict__ user, float rating,
+      float step, float lambda, uint32_t size) {
+    float error = Dot(item, user, size) - rating;
+    for (uint32_t i = 0; i < Size(size); ++i) {
+      float p = item[i];
+      float q = user[i];
+      item[i] -= step * (error * q + lambda * p);
+      user[i] -= step * (error * p + lambda * q);
+    }
+    return error;
+  }
+
+  /// Add x x^T to the upper triangle of the row major gram and rating * x to
+  /// rhs
+  static void AddOuter(
+      float* __restrict__ gram, float* __restrict__ rhs, const float* x,
+      float rating, uint32_t size) {
+    uint32_t n = Size(size);
+    for (uint32_t r = 0; r < n; ++r) {
+      Axpy(x[r], x + r, gram + r * n + r, n - r);
+    }
+    Axpy(rating, x, rhs, n);
+  }
+};
+
+#if KATANA_LATENT_VECTOR_KERNELS_X86
+
+__attribute__((target("avx2,fma"))) inline float
+HorizontalSumAVX2(__m256 v) {
+  __m128 sum =
+      _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+  return _mm_cvtss_f32(sum);
+}
+
+template <uint32_t kSize>
+struct AVX2Kernel {
+  static constexpr uint32_t kWidth = 8;
+
+  static uint32_t Size(uint32_t size) { return kSize ? kSize : size; }
+
+  __attribute__((target("avx2,fma"))) static float Dot(
+      const float* a, const float* b, uint32_t size) {
+    uint32_t n = Size(size);
+    // Two accumulators hide the latency of the FMAs
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    uint32_t i = 0;
+    for (; i + 2 * kWidth <= n; i += 2 * kWidth) {
+      acc0 = _mm256_fmadd_ps(
+          _mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+      acc1 = _mm256_fmadd_ps(
+          _mm256_loadu_ps(a + i + kWidth), _mm256_loadu_ps(b + i + kWidth),
+          acc1);
+    }
+    if (i + kWidth <= n) {
+      acc0 = _mm256_fmadd_ps(
+          _mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+      i += kWidth;
+    }
+    float sum = HorizontalSumAVX2(_mm256_add_ps(acc0, acc1));
+    for (; i < n; ++i) {
+      sum += a[i] * b[i];
+    }
+    return sum;
+  }
+
+  __attribute__((target("avx2,fma"))) static void Axpy(
+      float alpha, const float* x, float* y, uint32_t size) {
+    __m256 va = _mm256_set1_ps(alpha);
+    uint32_t i = 0;
+    for (; i + kWidth <= size; i += kWidth) {
+      _mm256_storeu_ps(
+          y + i,
+          _mm256_fmadd_ps(va, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+    }
+    for (; i < size; ++i) {
+      y[i] += alpha * x[i];
+    }
+  }
+
+  __attribute__((target("avx2,fma"))) static float Sgd(
+      float* __restrict__ item, float* __restrict__ user, float rating,
+      float step, float lambda, uint32_t size) {
+    uint32_t n = Size(size);
+    float error = Dot(item, user, size) - rating;
+    __m256 verror = _mm256_set1_ps(error);
+    __m256 vstep = _mm256_set1_ps(step);
+    __m256 vlambda = _mm256_set1_ps(lambda);
+    uint32_t i = 0;
+    for (; i + kWidth <= n; i += kWidth) {
+      __m256 p = _mm256_loadu_ps(item + i);
+      __m256 q = _mm256_loadu_ps(user + i);
+      __m256 item_gradient =
+          _mm256_fmadd_ps(verror, q, _mm256_mul_ps(vlambda, p));
+      __m256 user_gradient =
+          _mm256_fmadd_ps(verror, p, _mm256_mul_ps(vlambda, q));
+      _mm256_storeu_ps(item + i, _mm256_fnmadd_ps(vstep, item_gradient, p));
+      _mm256_storeu_ps(user + i, _mm256_fnmadd_ps(vstep, user_gradient, q));
+    }
+    for (; i < n; ++i) {
+      float p = item[i];
+      float q = user[i];
+      item[i] -= step * (error * q + lambda * p);
+      user[i] -= step * (error * p + lambda * q);
+    }
+    return error;
+  }
+
+  __attribute__((target("avx2,fma"))) static void AddOuter(
+      float* __restrict__ gram, float* __restrict__ rhs, const float* x,
+      float rating, uint32_t size) {
+    uint32_t n = Size(size);
+    for (uint32_t r = 0; r < n; ++r) {
+      Axpy(x[r], x + r, gram + r * n + r, n - r);
+    }
+    Axpy(rating, x, rhs, n);
+  }
+};
+
+template <uint32_t kSize>
+struct AVX512Kernel {
+  static constexpr uint32_t kWidth = 16;
+
+  static uint32_t Size(uint32_t size) { return kSize ? kSize : size; }
+
+  /// The lanes of the last, partial vector of a loop that stopped at i
+  static __mmask16 TailMask(uint32_t i, uint32_t n) {
+    return static_cast<__mmask16>((1U << (n - i)) - 1);
+  }
+
+  __attribute__((target("avx512f"))) static float Dot(
+      const float* a, const float* b, uint32_t size) {
+    uint32_t n = Size(size);
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    uint32_t i = 0;
+    for (; i + 2 * kWidth <= n; i += 2 * kWidth) {
+      acc0 = _mm512_fmadd_ps(
+          _mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+      acc1 = _mm512_fmadd_ps(
+          _mm512_loadu_ps(a + i + kWidth), _mm512_loadu_ps(b + i + kWidth),
+          acc1);
+    }
+    if (i + kWidth <= n) {
+      acc0 = _mm512_fmadd_ps(
+          _mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+      i += kWidth;
+    }
+    if (i < n) {
+      __mmask16 m = TailMask(i, n);
+      acc1 = _mm512_fmadd_ps(
+          _mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i),
+          acc1);
+    }
+    return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+  }
+
+  __attribute__((target("avx512f"))) static void Axpy(
+      float alpha, const float* x, float* y, uint32_t size) {
+    __m512 va = _mm512_set1_ps(alpha);
+    uint32_t i = 0;
+    for (; i + kWidth <= size; i += kWidth) {
+      _mm512_storeu_ps(
+          y + i,
+          _mm512_fmadd_ps(va, _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i)));
+    }
+    if (i < size) {
+      __mmask16 m = TailMask(i, size);
+      _mm512_mask_storeu_ps(
+          y + i, m,
+          _mm512_fmadd_ps(
+              va, _mm512_maskz_loadu_ps(m, x + i),
+              _mm512_maskz_loadu_ps(m, y + i)));
+    }
+  }
+
+  __attribute__((target("avx512f"))) static float Sgd(
+      float* __restrict__ item, float* __restrict__ user, float rating,
+      float step, float lambda, uint32_t size) {
+    uint32_t n = Size(size);
+    float error = Dot(item, user, size) - rating;
+    __m512 verror = _mm512_set1_ps(error);
+    __m512 vstep = _mm512_set1_ps(step);
+    __m512 vlambda = _mm512_set1_ps(lambda);
+    for (uint32_t i = 0; i < n; i += kWidth) {
+      __mmask16 m = i + kWidth <= n ? __mmask16(0xffff) : TailMask(i, n);
+      __m512 p = _mm512_maskz_loadu_ps(m, item + i);
+      __m512 q = _mm512_maskz_loadu_ps(m, user + i);
+      __m512 item_gradient =
+          _mm512_fmadd_ps(verror, q, _mm512_mul_ps(vlambda, p));
+      __m512 user_gradient =
+          _mm512_fmadd_ps(verror, p, _mm512_mul_ps(vlambda, q));
+      _mm512_mask_storeu_ps(
+          item + i, m, _mm512_fnmadd_ps(vstep, item_gradient, p));
+      _mm512_mask_storeu_ps(
+          user + i, m, _mm512_fnmadd_ps(vstep, user_gradient, q));
+    }
+    return error;
+  }
+
+  __attribute__((target("avx512f"))) static void AddOuter(
+      float* __restrict__ gram, float* __restrict__ rhs, const float* x,
+      float rating, uint32_t size) {
+    uint32_t n = Size(size);
+    for (uint32_t r = 0; r < n; ++r) {
+      Axpy(x[r], x + r, gram + r * n + r, n - r);
+    }
+    Axpy(rating, x, rhs, n);
+  }
+};
+
+#endif
+
+}  // namespace katana::analytics
+
+#endif
@@ -33,6 +33,15 @@ public:
 KATANA_EXPORT bool IsApproximateDegreeDistributionPowerLaw(
     const PropertyGraph& graph);
 
+/// A bijection on 32-bit values that scatters consecutive ids, used to give
+/// nodes priorities that look random but do not depend on the schedule
+inline uint32_t
+HashNodeId(uint32_t val) {
+  val = ((val >> 16) ^ val) * 0x45d9f3b;
+  val = ((val >> 16) ^ val) * 0x45d9f3b;
+  return (val >> 16) ^ val;
+}
+
 template <typename Props>
 std::vector<std::string>
 DefaultPropertyNames() {
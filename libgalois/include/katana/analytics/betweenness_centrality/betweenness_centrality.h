@@ -18,19 +18,33 @@ public:
   enum Algorithm {
     kLevel,
     kOuter,
+    kMultiSource,
+    kApproximate,
     // TODO(gill): Reinstate async and auto once we have bidirectional graphs.
     // kAsynchronous,
     // kAutomatic,
   };
 
+  static constexpr double kDefaultEpsilon = 0.01;
+  static constexpr double kDefaultDelta = 0.1;
+
 private:
   Algorithm algorithm_;
+  double epsilon_;
+  double delta_;
 
-  BetweennessCentralityPlan(Architecture architecture, Algorithm algorithm)
-      : Plan(architecture), algorithm_(algorithm) {}
+  BetweennessCentralityPlan(
+      Architecture architecture, Algorithm algorithm, double epsilon,
+      double delta)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        epsilon_(epsilon),
+        delta_(delta) {}
 
 public:
-  BetweennessCentralityPlan() : BetweennessCentralityPlan{kCPU, kLevel} {}
+  BetweennessCentralityPlan()
+      : BetweennessCentralityPlan{
+            kCPU, kLevel, kDefaultEpsilon, kDefaultDelta} {}
 
   BetweennessCentralityPlan(const katana::PropertyGraph* pg [[maybe_unused]])
       : BetweennessCentralityPlan() {
@@ -50,13 +64,54 @@ public:
   }
 
   Algorithm algorithm() const { return algorithm_; }
+  /// The largest error of the approximate centrality of any node, as a
+  /// fraction of the number of ordered pairs of nodes.
+  double epsilon() const { return epsilon_; }
+  /// The probability that some approximate centrality has a larger error
+  /// than epsilon.
+  double delta() const { return delta_; }
+
+  static BetweennessCentralityPlan Level() {
+    return {kCPU, kLevel, kDefaultEpsilon, kDefaultDelta};
+  }
+
+  static BetweennessCentralityPlan Outer() {
+    return {kCPU, kOuter, kDefaultEpsilon, kDefaultDelta};
+  }
 
-  static BetweennessCentralityPlan Level() { return {kCPU, kLevel}; }
+  /// Brandes' algorithm for batches of 64 sources. Each batch runs a
+  /// multi-source BFS that keeps one bit per source at every node, so one
+  /// scan of the edges of a node serves every source that reaches it at the
+  /// same level. It needs 768 bytes per node for the path counts and
+  /// dependencies of a batch.
+  /// [1] M. Then, M. Kaufmann, F. Chirigati, T. Hoang-Vu, K. Pham, A. Kemper,
+  /// T. Neumann and H. T. Vo, "The More the Merrier: Efficient Multi-Source
+  /// Graph Traversal," PVLDB 8(4), 2014.
+  static BetweennessCentralityPlan MultiSource() {
+    return {kCPU, kMultiSource, kDefaultEpsilon, kDefaultDelta};
+  }
 
-  static BetweennessCentralityPlan Outer() { return {kCPU, kOuter}; }
+  /// Approximate the centrality of every node from shortest paths between
+  /// random pairs of nodes, each found with a balanced bidirectional BFS.
+  /// With probability at least 1 - delta, every node is within
+  /// epsilon * n * (n - 1) of its exact centrality, where n is the number of
+  /// nodes. The number of samples for this bound grows with the logarithm of
+  /// the vertex diameter, which is estimated by a BFS that ignores edge
+  /// directions; the bound is guaranteed for symmetric graphs. Sources are
+  /// ignored, and the number of samples is in
+  /// BetweennessCentralityStatistics::num_samples.
+  /// [1] M. Riondato and E. M. Kornaropoulos, "Fast Approximation of
+  /// Betweenness Centrality through Sampling," WSDM '14, New York, NY, 2014.
+  /// [2] M. Borassi and E. Natale, "KADABRA is an ADaptive Algorithm for
+  /// Betweenness via Random Approximation," ESA '16, Aarhus, Denmark, 2016.
+  static BetweennessCentralityPlan Approximate(
+      double epsilon = kDefaultEpsilon, double delta = kDefaultDelta) {
+    return {kCPU, kApproximate, epsilon, delta};
+  }
 
   static BetweennessCentralityPlan FromAlgorithm(Algorithm algo) {
-    return BetweennessCentralityPlan(kCPU, algo);
+    return BetweennessCentralityPlan(
+        kCPU, algo, kDefaultEpsilon, kDefaultDelta);
   }
 };
 
@@ -98,6 +153,9 @@ struct KATANA_EXPORT BetweennessCentralityStatistics {
   float min_centrality;
   /// The average centrality across all nodes.
   float average_centrality;
+  /// The number of shortest paths sampled to approximate the centrality, or
+  /// 0 if it is exact.
+  uint64_t num_samples;
 
   /// Print the statistics in a human readable form.
   void Print(std::ostream& os = std::cout);
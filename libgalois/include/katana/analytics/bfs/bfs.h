@@ -2,6 +2,8 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_BFS_BFS_H_
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "katana/analytics/Plan.h"
 #include "katana/analytics/Utils.h"
@@ -16,40 +18,80 @@ public:
     kAsynchronousTile = 0,
     kAsynchronous,
     kSynchronousTile,
-    kSynchronous
+    kSynchronous,
+    kDirectionOptimizing,
+    kAutomatic
   };
 
   static const int kDefaultEdgeTileSize = 256;
+  static const uint32_t kDefaultAlpha = 15;
+  static const uint32_t kDefaultBeta = 18;
 
 private:
   Algorithm algorithm_;
   ptrdiff_t edge_tile_size_;
+  uint32_t alpha_;
+  uint32_t beta_;
 
   BfsPlan(
-      Architecture architecture, Algorithm algorithm, ptrdiff_t edge_tile_size)
+      Architecture architecture, Algorithm algorithm, ptrdiff_t edge_tile_size,
+      uint32_t alpha, uint32_t beta)
       : Plan(architecture),
         algorithm_(algorithm),
-        edge_tile_size_(edge_tile_size) {}
+        edge_tile_size_(edge_tile_size),
+        alpha_(alpha),
+        beta_(beta) {}
 
 public:
-  BfsPlan() : BfsPlan{kCPU, kSynchronousTile, kDefaultEdgeTileSize} {}
+  BfsPlan() : BfsPlan{kCPU, kAutomatic, 0, 0, 0} {}
+
+  /// Choose the algorithm based on the degree distribution of pg:
+  /// direction-optimizing for power-law graphs and synchronous tiled
+  /// otherwise.
+  BfsPlan(const katana::PropertyGraph* pg) : Plan(kCPU) {
+    bool isPowerLaw = IsApproximateDegreeDistributionPowerLaw(*pg);
+    if (isPowerLaw) {
+      *this = DirectionOptimizing();
+    } else {
+      *this = SynchronousTile();
+    }
+  }
 
   Algorithm algorithm() const { return algorithm_; }
   ptrdiff_t edge_tile_size() const { return edge_tile_size_; }
+  /// Top-down steps switch to bottom-up steps when the number of edges to
+  /// check from the frontier exceeds 1/alpha of the unexplored edges.
+  uint32_t alpha() const { return alpha_; }
+  /// Bottom-up steps switch back to top-down steps when the frontier shrinks
+  /// and holds fewer than 1/beta of the nodes.
+  uint32_t beta() const { return beta_; }
 
   static BfsPlan AsynchronousTile(
       ptrdiff_t edge_tile_size = kDefaultEdgeTileSize) {
-    return {kCPU, kAsynchronousTile, edge_tile_size};
+    return {kCPU, kAsynchronousTile, edge_tile_size, 0, 0};
   }
 
-  static BfsPlan Asynchronous() { return {kCPU, kAsynchronous, 0}; }
+  static BfsPlan Asynchronous() { return {kCPU, kAsynchronous, 0, 0, 0}; }
 
   static BfsPlan SynchronousTile(
       ptrdiff_t edge_tile_size = kDefaultEdgeTileSize) {
-    return {kCPU, kSynchronousTile, edge_tile_size};
+    return {kCPU, kSynchronousTile, edge_tile_size, 0, 0};
   }
 
-  static BfsPlan Synchronous() { return {kCPU, kSynchronous, 0}; }
+  static BfsPlan Synchronous() { return {kCPU, kSynchronous, 0, 0, 0}; }
+
+  /// Beamer's direction-optimizing BFS, which alternates between top-down
+  /// (push) steps over the out-edges of the frontier and bottom-up (pull)
+  /// steps over the in-edges of unvisited nodes. Both alpha and beta must be
+  /// positive.
+  static BfsPlan DirectionOptimizing(
+      uint32_t alpha = kDefaultAlpha, uint32_t beta = kDefaultBeta) {
+    return {kCPU, kDirectionOptimizing, 0, alpha, beta};
+  }
+
+  /// Choose the algorithm when the graph is known.
+  /// \see BfsPlan(const katana::PropertyGraph*)
+  static BfsPlan Automatic() { return {}; }
 };
 
 /// Compute BFS level of nodes in the graph pg starting from start_node. The
@@ -92,6 +134,34 @@ struct KATANA_EXPORT BfsStatistics {
       katana::PropertyGraph* pg, const std::string& property_name);
 };
 
+/// The largest number of sources that BfsBatch and BfsBatchReduce search
+/// together. More sources are searched in several batches.
+constexpr size_t kBfsBatchMaxSources = 512;
+
+/// Compute the BFS level of nodes in the graph pg from each of sources. The
+/// levels from sources[i] are stored in a property named by
+/// output_property_names[i] with the same values Bfs produces.
+///
+/// The searches run together as a multi-source BFS: each node holds one bit
+/// per search, so one scan of the out-edges of a node advances every search
+/// that reaches it at the same level. This is much faster than separate
+/// searches when the searches overlap, as they do in small-world graphs.
+/// [1] M. Then, M. Kaufmann, F. Chirigati, T. Hoang-Vu, K. Pham, A. Kemper,
+/// T. Neumann and H. T. Vo, "The More the Merrier: Efficient Multi-Source
+/// Graph Traversal," PVLDB 8(4), 2014.
+///
+/// The properties named output_property_names are created by this function
+/// and may not exist before the call.
+KATANA_EXPORT Result<void> BfsBatch(
+    PropertyGraph* pg, const std::vector<uint32_t>& sources,
+    const std::vector<std::string>& output_property_names);
+
+/// Like BfsBatch, but reduce the levels from each source to its statistics
+/// instead of storing them, which needs only a few bits per node and search.
+/// @return the statistics of the search from sources[i] at index i.
+KATANA_EXPORT Result<std::vector<BfsStatistics>> BfsBatchReduce(
+    PropertyGraph* pg, const std::vector<uint32_t>& sources);
+
 }  // namespace katana::analytics
 
 #endif
@@ -0,0 +1,92 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_GRAPHCOLORING_GRAPHCOLORING_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_GRAPHCOLORING_GRAPHCOLORING_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "katana/analytics/Plan.h"
+#include "katana/analytics/Utils.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for GraphColoring, specifying the algorithm and any
+/// parameters associated with it.
+class GraphColoringPlan : public Plan {
+public:
+  /// Algorithm selectors for graph coloring
+  enum Algorithm { kSpeculative, kJonesPlassmann, kLargestDegreeFirst };
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+
+  GraphColoringPlan(Architecture architecture, Algorithm algorithm)
+      : Plan(architecture), algorithm_(algorithm) {}
+
+public:
+  // kChunkSize is a fixed const int (default value: 64)
+  static const int kChunkSize;
+
+  GraphColoringPlan() : GraphColoringPlan{kCPU, kSpeculative} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// Speculative coloring. Every uncolored node takes the smallest color not
+  /// used by its neighbors in parallel, without synchronizing with them;
+  /// then, of every two neighbors that took the same color, the one with the
+  /// larger id is uncolored again for the next round.
+  /// [1] U. V. Catalyurek, J. Feo, A. H. Gebremedhin, M. Halappanavar and
+  /// A. Pothen, "Graph Coloring Algorithms for Multi-core and Massively
+  /// Multithreaded Architectures," Parallel Computing 38(10-11), 2012.
+  static GraphColoringPlan Speculative() { return {kCPU, kSpeculative}; }
+
+  /// Jones-Plassmann coloring. Each round, every uncolored node whose
+  /// uncolored neighbors all have lower random priorities takes the smallest
+  /// color not used by its neighbors. The coloring is deterministic.
+  /// [1] M. T. Jones and P. E. Plassmann, "A Parallel Graph Coloring
+  /// Heuristic," SIAM J. Sci. Comput. 14(3), 1993.
+  static GraphColoringPlan JonesPlassmann() {
+    return {kCPU, kJonesPlassmann};
+  }
+
+  /// Jones-Plassmann with nodes of larger degree first, which usually needs
+  /// fewer colors at the cost of more rounds.
+  static GraphColoringPlan LargestDegreeFirst() {
+    return {kCPU, kLargestDegreeFirst};
+  }
+};
+
+/// Color the nodes of the symmetric graph pg so that no two neighbors have the
+/// same color, and store the color of each node, numbered from 0, in the
+/// uint32 property output_property_name. Self loops are ignored. The number of
+/// colors is reported as the statistic NumColors.
+///
+/// The property named output_property_name is created by this function and
+/// may not exist before the call.
+KATANA_EXPORT Result<void> GraphColoring(
+    PropertyGraph* pg, const std::string& output_property_name,
+    GraphColoringPlan plan = GraphColoringPlan());
+
+/// Check that no two neighbors have the same color in property_name.
+KATANA_EXPORT Result<void> GraphColoringAssertValid(
+    PropertyGraph* pg, const std::string& property_name);
+
+struct KATANA_EXPORT GraphColoringStatistics {
+  /// The number of colors used.
+  uint32_t num_colors;
+  /// The number of nodes of each color.
+  std::vector<uint64_t> color_class_sizes;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<GraphColoringStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+#endif
@@ -2,6 +2,7 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_KCORE_KCORE_H_
 
 #include <iostream>
+#include <vector>
 
 #include <katana/analytics/Plan.h>
 
@@ -68,5 +69,40 @@ struct KATANA_EXPORT KCoreStatistics {
       const std::string& property_name);
 };
 
+/// Compute the core number of every node of pg, i.e., the largest k such
+/// that the node is in the k-core. The pg must be symmetric.
+///
+/// The synchronous algorithm peels nodes level by level, starting from the
+/// nodes of least degree. The asynchronous algorithm repeatedly replaces an
+/// upper bound on the core number of each node with the h-index of the bounds
+/// of its neighbors until no bound changes.
+///
+/// The property named output_property_name is created by this function and
+/// may not exist before the call. It has type uint32.
+KATANA_EXPORT Result<void> KCoreDecomposition(
+    PropertyGraph* pg, const std::string& output_property_name,
+    KCorePlan plan = KCorePlan());
+
+KATANA_EXPORT Result<void> KCoreDecompositionAssertValid(
+    PropertyGraph* pg, const std::string& property_name);
+
+struct KATANA_EXPORT KCoreDecompositionStatistics {
+  /// The largest core number of any node, i.e., the largest k with a
+  /// non-empty k-core
+  uint32_t max_core_number;
+
+  /// The number of nodes with each core number, indexed by core number
+  std::vector<uint64_t> core_number_histogram;
+
+  /// The number of nodes in the k-core
+  uint64_t CoreSize(uint32_t k) const;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<KCoreDecompositionStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& property_name);
+};
+
 }  // namespace katana::analytics
 #endif
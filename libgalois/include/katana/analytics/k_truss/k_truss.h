@@ -2,6 +2,7 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_KTRUSS_KTRUSS_H_
 
 #include <iostream>
+#include <vector>
 
 #include <katana/analytics/Plan.h>
 
@@ -67,5 +68,44 @@ struct KATANA_EXPORT KTrussStatistics {
       const std::string& property_name);
 };
 
+/// Compute the trussness of every edge of pg, i.e., the largest k such that
+/// the edge is in the k-truss. The pg must be symmetric and must not have
+/// duplicate edges. Edges that are in no triangle, including self loops, have
+/// trussness 2. Like KTruss, this sorts the edges of pg by destination.
+///
+/// Edges are peeled in order of increasing support, i.e., the number of
+/// triangles they are in, and edges with the same support are peeled in
+/// parallel.
+///
+/// The property named output_property_name is created by this function and
+/// may not exist before the call. It has type uint32, and both directions of
+/// an edge have the same value.
+KATANA_EXPORT Result<void> KTrussDecomposition(
+    PropertyGraph* pg, const std::string& output_property_name);
+
+/// Check the trussness computed by KTrussDecomposition. The edges of pg must
+/// still be sorted by destination.
+KATANA_EXPORT Result<void> KTrussDecompositionAssertValid(
+    PropertyGraph* pg, const std::string& property_name);
+
+struct KATANA_EXPORT KTrussDecompositionStatistics {
+  /// The largest trussness of any edge, i.e., the largest k with a non-empty
+  /// k-truss
+  uint32_t max_trussness;
+
+  /// The number of edges with each trussness, indexed by trussness. Each
+  /// edge is counted once rather than once per direction.
+  std::vector<uint64_t> trussness_histogram;
+
+  /// The number of edges in the k-truss
+  uint64_t TrussSize(uint32_t k) const;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<KTrussDecompositionStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& property_name);
+};
+
 }  // namespace katana::analytics
 #endif
@@ -0,0 +1,154 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_LOUVAINCLUSTERING_LOUVAINCLUSTERING_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_LOUVAINCLUSTERING_LOUVAINCLUSTERING_H_
+
+#include <iostream>
+#include <string>
+
+#include "katana/analytics/Plan.h"
+#include "katana/analytics/Utils.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for LouvainClustering, specifying the algorithm and
+/// any parameters associated with it.
+class LouvainClusteringPlan : public Plan {
+public:
+  /// Algorithm selectors for Louvain clustering
+  enum Algorithm { kDoAll, kLeiden };
+
+  static constexpr double kDefaultResolution = 1.0;
+  static constexpr uint32_t kDefaultMaxLevels = 10;
+  static constexpr uint32_t kDefaultMaxIterations = 10;
+  static constexpr double kDefaultMinModularityGain = 0.01;
+  static constexpr double kDefaultRandomness = 0.01;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  double resolution_;
+  uint32_t max_levels_;
+  uint32_t max_iterations_;
+  double min_modularity_gain_;
+  double randomness_;
+
+  LouvainClusteringPlan(
+      Architecture architecture, Algorithm algorithm, double resolution,
+      uint32_t max_levels, uint32_t max_iterations, double min_modularity_gain,
+      double randomness)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        resolution_(resolution),
+        max_levels_(max_levels),
+        max_iterations_(max_iterations),
+        min_modularity_gain_(min_modularity_gain),
+        randomness_(randomness) {}
+
+public:
+  // kChunkSize is a fixed const int (default value: 16)
+  static const int kChunkSize;
+
+  LouvainClusteringPlan()
+      : LouvainClusteringPlan{
+            kCPU,
+            kDoAll,
+            kDefaultResolution,
+            kDefaultMaxLevels,
+            kDefaultMaxIterations,
+            kDefaultMinModularityGain,
+            kDefaultRandomness} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// The weight of the expected edges within a cluster in the modularity.
+  /// Larger values favor smaller clusters.
+  double resolution() const { return resolution_; }
+  /// The most levels of coarsening.
+  uint32_t max_levels() const { return max_levels_; }
+  /// The most rounds of moving nodes between clusters in each level.
+  uint32_t max_iterations() const { return max_iterations_; }
+  /// A round of moving nodes, or a level, that improves the modularity by
+  /// less than this ends the clustering.
+  double min_modularity_gain() const { return min_modularity_gain_; }
+  /// How close to uniform the random choices of the Leiden refinement are.
+  /// Smaller values favor the merges that gain the most.
+  double randomness() const { return randomness_; }
+
+  /// Louvain clustering. In each round every node moves in parallel to the
+  /// neighboring cluster that gains the most modularity. Once the rounds stop
+  /// gaining, the clusters are merged into the nodes of a coarser graph, which
+  /// is clustered the same way.
+  /// [1] V. D. Blondel, J.-L. Guillaume, R. Lambiotte and E. Lefebvre, "Fast
+  /// Unfolding of Communities in Large Networks," J. Stat. Mech. P10008, 2008.
+  static LouvainClusteringPlan DoAll(
+      double resolution = kDefaultResolution,
+      uint32_t max_levels = kDefaultMaxLevels,
+      uint32_t max_iterations = kDefaultMaxIterations,
+      double min_modularity_gain = kDefaultMinModularityGain) {
+    return {kCPU,           kDoAll,
+            resolution,     max_levels,
+            max_iterations, min_modularity_gain,
+            kDefaultRandomness};
+  }
+
+  /// Leiden clustering. Like DoAll, but before coarsening each cluster is
+  /// refined into well-connected subclusters, which become the nodes of the
+  /// coarser graph. The coarser graph starts from the unrefined clusters, so
+  /// clusters stay connected and may still split in later levels.
+  /// [1] V. A. Traag, L. Waltman and N. J. van Eck, "From Louvain to Leiden:
+  /// Guaranteeing Well-Connected Communities," Sci. Rep. 9, 5233, 2019.
+  static LouvainClusteringPlan Leiden(
+      double resolution = kDefaultResolution,
+      uint32_t max_levels = kDefaultMaxLevels,
+      uint32_t max_iterations = kDefaultMaxIterations,
+      double min_modularity_gain = kDefaultMinModularityGain,
+      double randomness = kDefaultRandomness) {
+    return {kCPU,           kLeiden,
+            resolution,     max_levels,
+            max_iterations, min_modularity_gain,
+            randomness};
+  }
+};
+
+/// Cluster the nodes of pg to maximize the modularity of the clustering. The
+/// graph must be symmetric. The weight of each edge is in the property named
+/// edge_weight_property_name, which may have any numeric type; if
+/// edge_weight_property_name is empty every edge has weight 1.
+/// The property named output_property_name is created by this function and
+/// may not exist before the call. It has type uint64 and numbers the clusters
+/// from 0.
+KATANA_EXPORT Result<void> LouvainClustering(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name,
+    LouvainClusteringPlan plan = LouvainClusteringPlan());
+
+/// Check that property_name numbers the clusters of pg from 0 without gaps.
+KATANA_EXPORT Result<void> LouvainClusteringAssertValid(
+    PropertyGraph* pg, const std::string& property_name);
+
+struct KATANA_EXPORT LouvainClusteringStatistics {
+  /// Total number of unique clusters in the graph.
+  uint64_t n_clusters;
+  /// Total number of clusters with more than 1 node.
+  uint64_t n_non_trivial_clusters;
+  /// The number of nodes present in the largest cluster.
+  uint64_t largest_cluster_size;
+  /// The proportion of nodes present in the largest cluster.
+  double largest_cluster_proportion;
+  /// The modularity of the clustering, with resolution 1.
+  double modularity;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  /// Compute the statistics of the clusters in property_name with the edge
+  /// weights in edge_weight_property_name, as passed to LouvainClustering.
+  static katana::Result<LouvainClusteringStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+      const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+#endif
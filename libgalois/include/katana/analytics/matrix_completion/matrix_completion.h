@@ -0,0 +1,227 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_MATRIXCOMPLETION_MATRIXCOMPLETION_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_MATRIXCOMPLETION_MATRIXCOMPLETION_H_
+
+#include <iostream>
+#include <string>
+
+#include "katana/analytics/Plan.h"
+#include "katana/analytics/Utils.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for MatrixCompletion, specifying the algorithm and
+/// any parameters associated with it.
+class MatrixCompletionPlan : public Plan {
+public:
+  /// Algorithm selectors for matrix completion
+  enum Algorithm { kSGDByEdges, kSGDByItems, kALS };
+
+  /// How the SGD step size shrinks with each round
+  enum StepFunction { kBottou, kIntel, kInverse, kPurdue };
+
+  static constexpr uint32_t kDefaultLatentVectorSize = 20;
+  static constexpr double kDefaultLearningRate = 0.012;
+  static constexpr double kDefaultDecayRate = 0.015;
+  static constexpr double kDefaultLambda = 0.05;
+  static constexpr StepFunction kDefaultStepFunction = kPurdue;
+  static constexpr double kDefaultTolerance = 0.01;
+  static constexpr uint32_t kDefaultMaxRounds = 100;
+  static constexpr uint32_t kDefaultItemsPerBlock = 350;
+  static constexpr uint32_t kDefaultUsersPerBlock = 2048;
+  static constexpr uint64_t kDefaultSeed = 0;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  uint32_t latent_vector_size_;
+  double learning_rate_;
+  double decay_rate_;
+  double lambda_;
+  StepFunction step_function_;
+  double tolerance_;
+  uint32_t max_rounds_;
+  uint32_t items_per_block_;
+  uint32_t users_per_block_;
+  uint64_t seed_;
+
+  MatrixCompletionPlan(
+      Architecture architecture, Algorithm algorithm,
+      uint32_t latent_vector_size, double learning_rate, double decay_rate,
+      double lambda, StepFunction step_function, double tolerance,
+      uint32_t max_rounds, uint32_t items_per_block, uint32_t users_per_block,
+      uint64_t seed)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        latent_vector_size_(latent_vector_size),
+        learning_rate_(learning_rate),
+        decay_rate_(decay_rate),
+        lambda_(lambda),
+        step_function_(step_function),
+        tolerance_(tolerance),
+        max_rounds_(max_rounds),
+        items_per_block_(items_per_block),
+        users_per_block_(users_per_block),
+        seed_(seed) {}
+
+public:
+  // kChunkSize is a fixed const int (default value: 4)
+  static const int kChunkSize;
+
+  MatrixCompletionPlan()
+      : MatrixCompletionPlan{
+            kCPU,
+            kSGDByEdges,
+            kDefaultLatentVectorSize,
+            kDefaultLearningRate,
+            kDefaultDecayRate,
+            kDefaultLambda,
+            kDefaultStepFunction,
+            kDefaultTolerance,
+            kDefaultMaxRounds,
+            kDefaultItemsPerBlock,
+            kDefaultUsersPerBlock,
+            kDefaultSeed} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// The number of floats in the latent vector of each node. Sizes 16, 32, 64
+  /// and 128 have specialized kernels.
+  uint32_t latent_vector_size() const { return latent_vector_size_; }
+  /// The step size of the first round of SGD (alpha).
+  double learning_rate() const { return learning_rate_; }
+  /// How fast the step size of SGD decays (beta); used by the Intel and
+  /// Purdue step functions.
+  double decay_rate() const { return decay_rate_; }
+  /// The weight of the squared norms of the latent vectors in the objective.
+  double lambda() const { return lambda_; }
+  StepFunction step_function() const { return step_function_; }
+  /// A round that changes the squared error by less than this fraction ends
+  /// the computation.
+  double tolerance() const { return tolerance_; }
+  /// The most rounds, each of which visits every rating once.
+  uint32_t max_rounds() const { return max_rounds_; }
+  /// The number of items in each block of the 2D tiling of SGDByEdges.
+  uint32_t items_per_block() const { return items_per_block_; }
+  /// The number of users in each block of the 2D tiling of SGDByEdges.
+  uint32_t users_per_block() const { return users_per_block_; }
+  /// The seed of the initial latent vectors.
+  uint64_t seed() const { return seed_; }
+
+  /// SGD over the ratings in 2D blocks of items and users, so that threads
+  /// working on different blocks never update the same latent vector.
+  static MatrixCompletionPlan SGDByEdges(
+      uint32_t latent_vector_size = kDefaultLatentVectorSize,
+      double learning_rate = kDefaultLearningRate,
+      double decay_rate = kDefaultDecayRate, double lambda = kDefaultLambda,
+      StepFunction step_function = kDefaultStepFunction,
+      double tolerance = kDefaultTolerance,
+      uint32_t max_rounds = kDefaultMaxRounds,
+      uint32_t items_per_block = kDefaultItemsPerBlock,
+      uint32_t users_per_block = kDefaultUsersPerBlock,
+      uint64_t seed = kDefaultSeed) {
+    return {
+        kCPU,
+        kSGDByEdges,
+        latent_vector_size,
+        learning_rate,
+        decay_rate,
+        lambda,
+        step_function,
+        tolerance,
+        max_rounds,
+        items_per_block,
+        users_per_block,
+        seed};
+  }
+
+  /// SGD over the ratings of each item in parallel, locking the latent vector
+  /// of each user while it is updated.
+  static MatrixCompletionPlan SGDByItems(
+      uint32_t latent_vector_size = kDefaultLatentVectorSize,
+      double learning_rate = kDefaultLearningRate,
+      double decay_rate = kDefaultDecayRate, double lambda = kDefaultLambda,
+      StepFunction step_function = kDefaultStepFunction,
+      double tolerance = kDefaultTolerance,
+      uint32_t max_rounds = kDefaultMaxRounds, uint64_t seed = kDefaultSeed) {
+    return {
+        kCPU,
+        kSGDByItems,
+        latent_vector_size,
+        learning_rate,
+        decay_rate,
+        lambda,
+        step_function,
+        tolerance,
+        max_rounds,
+        kDefaultItemsPerBlock,
+        kDefaultUsersPerBlock,
+        seed};
+  }
+
+  /// Alternating least squares. Each round solves for the latent vectors of
+  /// all items with the users fixed, then for all users with the items fixed.
+  static MatrixCompletionPlan ALS(
+      uint32_t latent_vector_size = kDefaultLatentVectorSize,
+      double lambda = kDefaultLambda, double tolerance = kDefaultTolerance,
+      uint32_t max_rounds = kDefaultMaxRounds, uint64_t seed = kDefaultSeed) {
+    return {
+        kCPU,
+        kALS,
+        latent_vector_size,
+        kDefaultLearningRate,
+        kDefaultDecayRate,
+        lambda,
+        kDefaultStepFunction,
+        tolerance,
+        max_rounds,
+        kDefaultItemsPerBlock,
+        kDefaultUsersPerBlock,
+        seed};
+  }
+};
+
+/// Factor the ratings of a bipartite graph into a latent vector for every
+/// node, such that the dot product of the vectors of an item and a user
+/// approximates the rating of their edge.
+///
+/// Items are the nodes up to the last node with edges, users are the rest, and
+/// every edge goes from an item to a user. SGDByEdges also needs the edges of
+/// each item sorted by destination (see SortAllEdgesByDest). The rating of
+/// each edge is in the property named edge_rating_property_name, which may
+/// have any numeric type.
+///
+/// The property named output_property_name is created by this function and
+/// may not exist before the call. It is a fixed size list of
+/// latent_vector_size floats.
+KATANA_EXPORT Result<void> MatrixCompletion(
+    PropertyGraph* pg, const std::string& edge_rating_property_name,
+    const std::string& output_property_name,
+    MatrixCompletionPlan plan = MatrixCompletionPlan());
+
+/// Check that property_name holds a finite latent vector for every node.
+KATANA_EXPORT Result<void> MatrixCompletionAssertValid(
+    PropertyGraph* pg, const std::string& property_name);
+
+struct KATANA_EXPORT MatrixCompletionStatistics {
+  /// The number of nodes with ratings.
+  uint64_t num_items;
+  /// The number of nodes without ratings.
+  uint64_t num_users;
+  /// The root mean square error of the predicted ratings.
+  double rmse;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  /// Compute the statistics of the latent vectors in property_name with the
+  /// ratings in edge_rating_property_name, as passed to MatrixCompletion.
+  static katana::Result<MatrixCompletionStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& edge_rating_property_name,
+      const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+#endif
@@ -0,0 +1,110 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_MINIMUMSPANNINGFOREST_MINIMUMSPANNINGFOREST_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_MINIMUMSPANNINGFOREST_MINIMUMSPANNINGFOREST_H_
+
+#include <iostream>
+#include <string>
+
+#include "katana/analytics/Plan.h"
+#include "katana/analytics/Utils.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for MinimumSpanningForest, specifying the algorithm
+/// and any parameters associated with it.
+class MinimumSpanningForestPlan : public Plan {
+public:
+  /// Algorithm selectors for minimum spanning forests
+  enum Algorithm { kBoruvka, kFilterKruskal };
+
+  static constexpr uint64_t kDefaultBaseCaseSize = 1 << 16;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  uint64_t base_case_size_;
+
+  MinimumSpanningForestPlan(
+      Architecture architecture, Algorithm algorithm, uint64_t base_case_size)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        base_case_size_(base_case_size) {}
+
+public:
+  // kChunkSize is a fixed const int (default value: 64)
+  static const int kChunkSize;
+
+  MinimumSpanningForestPlan()
+      : MinimumSpanningForestPlan{kCPU, kBoruvka, kDefaultBaseCaseSize} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// The number of edges below which FilterKruskal sorts and scans the edges
+  /// instead of splitting them further.
+  uint64_t base_case_size() const { return base_case_size_; }
+
+  /// Boruvka's algorithm. Each round, every node finds its lightest edge to
+  /// another component in parallel, the lightest of these becomes the edge of
+  /// its component, and the components are merged along those edges with a
+  /// union-find. Nodes whose edges are all inside their component are not
+  /// visited again.
+  static MinimumSpanningForestPlan Boruvka() {
+    return {kCPU, kBoruvka, kDefaultBaseCaseSize};
+  }
+
+  /// Filter-Kruskal. Splits the edges around a pivot weight, solves the light
+  /// half first and drops every heavy edge whose endpoints are already
+  /// connected before solving the heavy half. Usually faster than Boruvka on
+  /// sparse graphs, where most heavy edges are filtered out.
+  /// [1] V. Osipov, P. Sanders and J. Singler, "The Filter-Kruskal Minimum
+  /// Spanning Tree Algorithm," ALENEX 2009.
+  static MinimumSpanningForestPlan FilterKruskal(
+      uint64_t base_case_size = kDefaultBaseCaseSize) {
+    return {kCPU, kFilterKruskal, base_case_size};
+  }
+};
+
+/// Find a minimum spanning forest of the symmetric graph pg, which has a tree
+/// spanning each of its connected components, and mark its edges with 1 in
+/// the uint8 edge property output_property_name and every other edge with 0.
+///
+/// The edge weights are in edge_weight_property_name, which may have any
+/// numeric type, or are all 1 if it is empty. Ties are broken by edge id, so
+/// both algorithms find the same forest. Only one of the two edges of pg
+/// between a pair of nodes is marked. The total weight of the forest is
+/// reported as the statistic TotalWeight.
+///
+/// The property named output_property_name is created by this function and
+/// may not exist before the call.
+KATANA_EXPORT Result<void> MinimumSpanningForest(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name,
+    MinimumSpanningForestPlan plan = MinimumSpanningForestPlan());
+
+/// Check that the edges marked in property_name form a forest and that the
+/// endpoints of every edge of pg are in the same tree of the forest.
+KATANA_EXPORT Result<void> MinimumSpanningForestAssertValid(
+    PropertyGraph* pg, const std::string& property_name);
+
+struct KATANA_EXPORT MinimumSpanningForestStatistics {
+  /// The number of edges in the forest.
+  uint64_t num_edges;
+  /// The number of trees in the forest, including single nodes.
+  uint64_t num_trees;
+  /// The sum of the weights of the edges in the forest.
+  double total_weight;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  /// Compute the statistics of the forest in property_name with the edge
+  /// weights in edge_weight_property_name, as passed to MinimumSpanningForest.
+  static katana::Result<MinimumSpanningForestStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+      const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+#endif
@@ -2,6 +2,8 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_PAGERANK_PAGERANK_H_
 
 #include <iostream>
+#include <utility>
+#include <vector>
 
 #include "katana/Properties.h"
 #include "katana/PropertyGraph.h"
@@ -102,6 +104,39 @@ KATANA_EXPORT Result<void> Pagerank(
     PropertyGraph* pg, const std::string& output_property_name,
     PagerankPlan plan = {});
 
+/// The edges inserted into and deleted from a graph since its Page Rank was
+/// last computed, as (source, destination) pairs of node ids
+struct KATANA_EXPORT PagerankUpdate {
+  std::vector<std::pair<PropertyGraph::Node, PropertyGraph::Node>>
+      inserted_edges;
+  std::vector<std::pair<PropertyGraph::Node, PropertyGraph::Node>>
+      deleted_edges;
+};
+
+/// Bring Page Rank up to date after a batch of edge insertions and deletions.
+///
+/// pg is the graph after the update. The property named previous_property_name
+/// holds the ranks computed before the update by Pagerank with a residual or
+/// push plan, or by an earlier call to this function. Nodes added by the
+/// update must have a previous rank of zero and appear in an inserted edge.
+///
+/// Residuals are seeded only at the neighbors of nodes whose out-edges
+/// changed, and are then pushed asynchronously as in
+/// PagerankPlan::PushAsynchronous, so the work done is proportional to the
+/// size of the update and how far it spreads rather than to the size of the
+/// graph. Only the tolerance and alpha of plan are used. Error below the
+/// tolerance accumulates over successive updates, so ranks should be
+/// recomputed from scratch occasionally.
+///
+/// If output_property_name is previous_property_name, the ranks are updated
+/// in place; otherwise the property named output_property_name is created
+/// with a copy of the previous ranks, which takes time linear in the number of
+/// nodes.
+KATANA_EXPORT Result<void> PagerankIncremental(
+    PropertyGraph* pg, const std::string& previous_property_name,
+    const PagerankUpdate& update, const std::string& output_property_name,
+    PagerankPlan plan = {});
+
 KATANA_EXPORT Result<void> PagerankAssertValid(
     PropertyGraph* pg, const std::string& property_name);
 
@@ -0,0 +1,118 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_PARTITION_PARTITION_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_PARTITION_PARTITION_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "katana/analytics/Plan.h"
+#include "katana/analytics/Utils.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for Partition, specifying the algorithm and any
+/// parameters associated with it.
+class PartitionPlan : public Plan {
+public:
+  /// Algorithm selectors for graph partitioning
+  enum Algorithm { kMultilevelKWay };
+
+  static constexpr double kDefaultImbalance = 0.03;
+  static constexpr uint32_t kDefaultCoarsenTo = 20;
+  static constexpr uint32_t kDefaultMaxRefinementRounds = 8;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  double imbalance_;
+  uint32_t coarsen_to_;
+  uint32_t max_refinement_rounds_;
+
+  PartitionPlan(
+      Architecture architecture, Algorithm algorithm, double imbalance,
+      uint32_t coarsen_to, uint32_t max_refinement_rounds)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        imbalance_(imbalance),
+        coarsen_to_(coarsen_to),
+        max_refinement_rounds_(max_refinement_rounds) {}
+
+public:
+  // kChunkSize is a fixed const int (default value: 64)
+  static const int kChunkSize;
+
+  PartitionPlan()
+      : PartitionPlan{
+            kCPU, kMultilevelKWay, kDefaultImbalance, kDefaultCoarsenTo,
+            kDefaultMaxRefinementRounds} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// How much heavier than the average part a part may be, as a fraction of
+  /// the average part.
+  double imbalance() const { return imbalance_; }
+
+  /// Coarsening stops when the graph has at most this many nodes per part.
+  uint32_t coarsen_to() const { return coarsen_to_; }
+
+  /// The maximum number of rounds of refinement at each level.
+  uint32_t max_refinement_rounds() const { return max_refinement_rounds_; }
+
+  /// Multilevel k-way partitioning, as in METIS. The graph is coarsened by
+  /// merging the nodes of heavy edges, found with a parallel matching, into
+  /// a sequence of smaller graphs. The coarsest graph is split by recursive
+  /// bisection with greedy graph growing. The parts are then projected back
+  /// to each finer graph, where nodes are moved to the parts that most of
+  /// their edges lead to. The result does not depend on the number of
+  /// threads.
+  /// [1] G. Karypis and V. Kumar, "Multilevel k-way Partitioning Scheme for
+  /// Irregular Graphs," J. Parallel Distrib. Comput. 48(1), 1998.
+  static PartitionPlan MultilevelKWay(
+      double imbalance = kDefaultImbalance,
+      uint32_t coarsen_to = kDefaultCoarsenTo,
+      uint32_t max_refinement_rounds = kDefaultMaxRefinementRounds) {
+    return {
+        kCPU, kMultilevelKWay, imbalance, coarsen_to, max_refinement_rounds};
+  }
+};
+
+/// Split the nodes of pg into num_parts parts of about the same size with few
+/// edges between different parts, and store the part of each node, numbered
+/// from 0, in the uint32 property output_property_name. Edges are treated as
+/// undirected. The number of edges between parts is reported as the statistic
+/// EdgeCut.
+///
+/// The property named output_property_name is created by this function and
+/// may not exist before the call.
+KATANA_EXPORT Result<void> Partition(
+    PropertyGraph* pg, uint32_t num_parts,
+    const std::string& output_property_name,
+    PartitionPlan plan = PartitionPlan());
+
+/// Check that every node has a part below num_parts in property_name.
+KATANA_EXPORT Result<void> PartitionAssertValid(
+    PropertyGraph* pg, uint32_t num_parts, const std::string& property_name);
+
+struct KATANA_EXPORT PartitionStatistics {
+  /// The number of parts, one more than the largest part of a node.
+  uint32_t num_parts;
+  /// The number of nodes in each part.
+  std::vector<uint64_t> part_sizes;
+  /// The number of edges of pg between different parts.
+  uint64_t edge_cut;
+  /// How much larger the largest part is than the average part, as a fraction
+  /// of the average part.
+  double imbalance;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<PartitionStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+#endif
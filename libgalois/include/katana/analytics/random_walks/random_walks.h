@@ -0,0 +1,186 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_RANDOMWALKS_RANDOMWALKS_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_RANDOMWALKS_RANDOMWALKS_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <arrow/api.h>
+
+#include "katana/analytics/Plan.h"
+#include "katana/analytics/Utils.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for RandomWalks, specifying the algorithm and any
+/// parameters associated with it.
+class RandomWalksPlan : public Plan {
+public:
+  /// Algorithm selectors for random walks
+  enum Algorithm { kNode2vec, kEdge2vec };
+
+  static constexpr uint32_t kDefaultWalkLength = 10;
+  static constexpr uint32_t kDefaultNumberOfWalks = 1;
+  static constexpr double kDefaultBackwardProbability = 1.0;
+  static constexpr double kDefaultForwardProbability = 1.0;
+  static constexpr uint32_t kDefaultMaxIterations = 10;
+  static constexpr uint64_t kDefaultSeed = 0;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  uint32_t walk_length_;
+  uint32_t number_of_walks_;
+  double backward_probability_;
+  double forward_probability_;
+  uint32_t max_iterations_;
+  uint64_t seed_;
+
+  RandomWalksPlan(
+      Architecture architecture, Algorithm algorithm, uint32_t walk_length,
+      uint32_t number_of_walks, double backward_probability,
+      double forward_probability, uint32_t max_iterations, uint64_t seed)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        walk_length_(walk_length),
+        number_of_walks_(number_of_walks),
+        backward_probability_(backward_probability),
+        forward_probability_(forward_probability),
+        max_iterations_(max_iterations),
+        seed_(seed) {}
+
+public:
+  // kChunkSize is a fixed const int (default value: 64)
+  static const int kChunkSize;
+
+  RandomWalksPlan()
+      : RandomWalksPlan{
+            kCPU,
+            kNode2vec,
+            kDefaultWalkLength,
+            kDefaultNumberOfWalks,
+            kDefaultBackwardProbability,
+            kDefaultForwardProbability,
+            kDefaultMaxIterations,
+            kDefaultSeed} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// The number of nodes in each walk, including the node it starts at.
+  uint32_t walk_length() const { return walk_length_; }
+  /// The number of walks that start at each node.
+  uint32_t number_of_walks() const { return number_of_walks_; }
+  /// The weight of stepping back to the previous node of the walk is divided
+  /// by this (p in node2vec).
+  double backward_probability() const { return backward_probability_; }
+  /// The weight of stepping to a node that is not a neighbor of the previous
+  /// node of the walk is divided by this (q in node2vec).
+  double forward_probability() const { return forward_probability_; }
+  /// The number of rounds of walks that Edge2vec learns edge type transition
+  /// weights from.
+  uint32_t max_iterations() const { return max_iterations_; }
+  /// The seed of the random choices. Walks depend only on the seed, not on
+  /// the number of threads.
+  uint64_t seed() const { return seed_; }
+
+  /// Node2vec walks. Each step picks an edge of the current node with
+  /// probability proportional to its weight, scaled as in node2vec by whether
+  /// its destination is the previous node, a neighbor of the previous node or
+  /// neither. Edges are sampled from per-node alias tables and the scaling is
+  /// applied by rejection.
+  /// [1] A. Grover and J. Leskovec, "node2vec: Scalable Feature Learning for
+  /// Networks," KDD 2016.
+  static RandomWalksPlan Node2vec(
+      uint32_t walk_length = kDefaultWalkLength,
+      uint32_t number_of_walks = kDefaultNumberOfWalks,
+      double backward_probability = kDefaultBackwardProbability,
+      double forward_probability = kDefaultForwardProbability,
+      uint64_t seed = kDefaultSeed) {
+    return {
+        kCPU,
+        kNode2vec,
+        walk_length,
+        number_of_walks,
+        backward_probability,
+        forward_probability,
+        kDefaultMaxIterations,
+        seed};
+  }
+
+  /// Edge2vec walks for graphs with edge types. Like Node2vec, but each step
+  /// is also weighted by how correlated the type of the edge is with the type
+  /// of the previous edge. The correlations are learned from the edge type
+  /// counts of max_iterations rounds of walks, and the walks of the last round
+  /// are returned.
+  /// [1] Z. Gao, G. Fu, C. Ouyang, S. Tsutsui, X. Liu, J. Yang, C. Gessner,
+  /// B. Foote, D. Wild, Y. Ding and Q. Yu, "edge2vec: Representation Learning
+  /// Using Edge Semantics for Biomedical Knowledge Discovery," BMC
+  /// Bioinformatics 20, 306, 2019.
+  static RandomWalksPlan Edge2vec(
+      uint32_t walk_length = kDefaultWalkLength,
+      uint32_t number_of_walks = kDefaultNumberOfWalks,
+      double backward_probability = kDefaultBackwardProbability,
+      double forward_probability = kDefaultForwardProbability,
+      uint32_t max_iterations = kDefaultMaxIterations,
+      uint64_t seed = kDefaultSeed) {
+    return {
+        kCPU,
+        kEdge2vec,
+        walk_length,
+        number_of_walks,
+        backward_probability,
+        forward_probability,
+        max_iterations,
+        seed};
+  }
+};
+
+/// A function that receives the walks of RandomWalksInBatches, in order.
+using RandomWalksConsumer = std::function<Result<void>(
+    const std::shared_ptr<arrow::FixedSizeListArray>&)>;
+
+/// Generate number_of_walks random walks from every node of pg. Walk i starts
+/// at node i % num_nodes.
+///
+/// The weight of each edge is in the property named
+/// edge_weight_property_name, which may have any numeric type; if
+/// edge_weight_property_name is empty every edge has weight 1. Weights must be
+/// non-negative. The type of each edge is in the property named
+/// edge_type_property_name, which must have an integer type with values in
+/// [0, 1024); it is only read by Edge2vec and may be empty otherwise.
+///
+/// The result has one list of walk_length uint32 node ids per walk. A walk
+/// that reaches a node without edges of positive weight stops there, and the
+/// rest of its list is null.
+KATANA_EXPORT Result<std::shared_ptr<arrow::FixedSizeListArray>> RandomWalks(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& edge_type_property_name,
+    RandomWalksPlan plan = RandomWalksPlan());
+
+/// Generate the walks of RandomWalks in batches of at most batch_size walks
+/// and pass each batch to consume as soon as it is generated, so that the
+/// number of walks is not bounded by memory. The concatenation of the batches
+/// is the result of RandomWalks. Stops at the first error returned by consume.
+KATANA_EXPORT Result<void> RandomWalksInBatches(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& edge_type_property_name, uint64_t batch_size,
+    const RandomWalksConsumer& consume,
+    RandomWalksPlan plan = RandomWalksPlan());
+
+/// Write the walks of RandomWalks to a new Parquet file at the local path,
+/// as a column named "walk" with one row group per batch of batch_size walks.
+KATANA_EXPORT Result<void> RandomWalksToParquet(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& edge_type_property_name, const std::string& path,
+    uint64_t batch_size, RandomWalksPlan plan = RandomWalksPlan());
+
+/// Check that every step of every walk in walks follows an edge of pg and that
+/// the nulls of each walk come after its nodes.
+KATANA_EXPORT Result<void> RandomWalksAssertValid(
+    PropertyGraph* pg, const std::shared_ptr<arrow::FixedSizeListArray>& walks);
+
+}  // namespace katana::analytics
+#endif
@@ -0,0 +1,102 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_STRONGLYCONNECTEDCOMPONENTS_STRONGLYCONNECTEDCOMPONENTS_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_STRONGLYCONNECTEDCOMPONENTS_STRONGLYCONNECTEDCOMPONENTS_H_
+
+#include <iostream>
+
+#include "katana/analytics/Plan.h"
+#include "katana/analytics/Utils.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for StronglyConnectedComponents, specifying the
+/// algorithm and any parameters associated with it.
+class StronglyConnectedComponentsPlan : public Plan {
+public:
+  /// Algorithm selectors for Strongly-connected-components
+  enum Algorithm { kSerial, kColoring, kForwardBackward };
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+
+  StronglyConnectedComponentsPlan(
+      Architecture architecture, Algorithm algorithm)
+      : Plan(architecture), algorithm_(algorithm) {}
+
+public:
+  // kChunkSize is a fixed const int (default value: 64)
+  static const int kChunkSize;
+
+  StronglyConnectedComponentsPlan()
+      : StronglyConnectedComponentsPlan{kCPU, kForwardBackward} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// Serial strongly-connected-components algorithm. Uses Tarjan's
+  /// depth-first search.
+  static StronglyConnectedComponentsPlan Serial() { return {kCPU, kSerial}; }
+
+  /// Coloring algorithm. After trimming nodes that trivially form their own
+  /// components, every node takes the largest node id that can reach it.
+  /// Each node whose color is its own id is the root of a component, which
+  /// is the set of nodes of the same color that can reach the root. Claimed
+  /// components are removed and the remaining nodes are recolored until
+  /// every node has a component.
+  /// [1] S. Orzan, "On Distributed Verification and Verified Distribution,"
+  /// PhD thesis, Free University of Amsterdam, 2004.
+  static StronglyConnectedComponentsPlan Coloring() {
+    return {kCPU, kColoring};
+  }
+
+  /// Forward-backward algorithm. After trimming components of size one,
+  /// the nodes that are both reachable from and can reach a high-degree
+  /// pivot form its component, which in skewed graphs is usually the giant
+  /// one. Components of size one and two are trimmed again and the rest are
+  /// found by coloring.
+  /// [1] S. Hong, N. C. Rodia and K. Olukotun, "On Fast Parallel Detection
+  /// of Strongly Connected Components (SCC) in Small-World Graphs," SC '13,
+  /// Denver, CO, 2013.
+  static StronglyConnectedComponentsPlan ForwardBackward() {
+    return {kCPU, kForwardBackward};
+  }
+};
+
+/// Compute the strongly-connected-components of pg. Each node is labeled
+/// with the smallest node id in its component, so every algorithm produces
+/// the same labels. The parallel algorithms follow in-edges and build them
+/// if pg does not have them yet.
+/// The property named output_property_name is created by this function and
+/// may not exist before the call. It has type uint64.
+KATANA_EXPORT Result<void> StronglyConnectedComponents(
+    PropertyGraph* pg, const std::string& output_property_name,
+    StronglyConnectedComponentsPlan plan = StronglyConnectedComponentsPlan());
+
+/// Check that property_name partitions the nodes of pg into its strongly
+/// connected components, by comparing it with the components found serially.
+KATANA_EXPORT Result<void> StronglyConnectedComponentsAssertValid(
+    PropertyGraph* pg, const std::string& property_name);
+
+struct KATANA_EXPORT StronglyConnectedComponentsStatistics {
+  /// Total number of unique components in the graph.
+  uint64_t total_components;
+  /// Total number of components with more than 1 node.
+  uint64_t total_non_trivial_components;
+  /// The number of nodes present in the largest component.
+  uint64_t largest_component_size;
+  /// The ratio of nodes present in the largest component.
+  double largest_component_ratio;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  /// Compute the statistics of the components in property_name, whose values
+  /// must be node ids as StronglyConnectedComponents produces.
+  static katana::Result<StronglyConnectedComponentsStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+#endif
@@ -1791,7 +1791,9 @@ katana::PropertyGraphBuilder::Finish(bool verbose) {
 std::unique_ptr<katana::PropertyGraph>
 katana::MakeGraph(const katana::GraphComponents& graph_comps) {
   auto graph = std::make_unique<katana::PropertyGraph>();
-  auto result = graph->SetTopology(*graph_comps.topology);
+  auto result = graph_comps.wide_topology
+                    ? graph->SetTopology(*graph_comps.wide_topology)
+                    : graph->SetTopology(*graph_comps.topology);
   if (!result) {
     KATANA_LOG_FATAL("Error adding topology: {}", result.error());
   }
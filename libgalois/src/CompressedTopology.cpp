@@ -0,0 +1,324 @@
+#include "katana/CompressedTopology.h"
+
+#include <atomic>
+#include <limits>
+
+#include "katana/Loops.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Result.h"
+#include "tsuba/CSRTopology.h"
+#include "tsuba/Errors.h"
+#include "tsuba/FileFrame.h"
+
+namespace {
+
+using Node = katana::CompressedGraphTopology::Node;
+using Edge = katana::CompressedGraphTopology::Edge;
+
+/// The number of bytes of the byte code of value
+uint64_t
+ByteCodeSize(uint64_t value) {
+  uint64_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++size;
+  }
+  return size;
+}
+
+uint8_t*
+EncodeByteCode(uint64_t value, uint8_t* code) {
+  while (value >= 0x80) {
+    *code++ = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  *code++ = static_cast<uint8_t>(value);
+  return code;
+}
+
+uint64_t
+ZigZag(Node src, Node dest) {
+  int64_t diff = static_cast<int64_t>(dest) - static_cast<int64_t>(src);
+  return (static_cast<uint64_t>(diff) << 1) ^
+         static_cast<uint64_t>(diff >> 63);
+}
+
+/// Walk the codes of the edges [begin, end) of src, whose destinations are
+/// dests: table_fn is called first with the size of the block offset table,
+/// then block_fn with the index of each block and code_fn with the value of
+/// each byte code in the block. Sizing and encoding both walk the codes this
+/// way so that they agree.
+template <typename TableFn, typename BlockFn, typename CodeFn>
+void
+WalkCodes(
+    Node src, const uint32_t* dests, Edge begin, Edge end, uint32_t block_size,
+    TableFn table_fn, BlockFn block_fn, CodeFn code_fn) {
+  uint64_t num_blocks = (end - begin + block_size - 1) / block_size;
+  table_fn(num_blocks > 1 ? (num_blocks - 1) * sizeof(uint32_t) : 0);
+  for (uint64_t block = 0; block < num_blocks; ++block) {
+    Edge block_begin = begin + block * block_size;
+    Edge block_end = std::min<Edge>(block_begin + block_size, end);
+    block_fn(block);
+    code_fn(ZigZag(src, dests[block_begin]));
+    for (Edge e = block_begin + 1; e < block_end; ++e) {
+      code_fn(uint64_t{dests[e]} - dests[e - 1]);
+    }
+  }
+}
+
+template <typename ArrayType>
+katana::Result<void>
+WriteArray(const ArrayType& array, tsuba::FileFrame* ff) {
+  if (array.length() == 0) {
+    return katana::ResultSuccess();
+  }
+  const auto* raw = array.raw_values();
+  auto buf = std::make_shared<arrow::Buffer>(
+      reinterpret_cast<const uint8_t*>(raw), array.length() * sizeof(*raw));
+  arrow::Status aro_sts = ff->Write(buf);
+  if (!aro_sts.ok()) {
+    return tsuba::ArrowToTsuba(aro_sts.code());
+  }
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::CompressedGraphTopology::CompressedGraphTopology(
+    std::shared_ptr<arrow::UInt64Array> out_indices,
+    std::shared_ptr<arrow::UInt64Array> code_indices,
+    std::shared_ptr<arrow::UInt8Array> codes, uint64_t num_edges,
+    uint32_t block_size, std::shared_ptr<tsuba::FileView> storage)
+    : out_indices_(std::move(out_indices)),
+      code_indices_(std::move(code_indices)),
+      codes_(std::move(codes)),
+      storage_(std::move(storage)),
+      num_edges_(num_edges),
+      block_size_(block_size) {
+  if (out_indices_->length() > 0) {
+    out_indices_values_ = out_indices_->raw_values();
+    code_indices_values_ = code_indices_->raw_values();
+  }
+  if (codes_->length() > 0) {
+    codes_values_ = codes_->raw_values();
+  }
+}
+
+katana::Result<katana::CompressedGraphTopology>
+katana::CompressedGraphTopology::Make(
+    const GraphTopology& topology, uint32_t block_size) {
+  if (block_size == 0) {
+    return ErrorCode::InvalidArgument;
+  }
+  uint64_t num_nodes = topology.num_nodes();
+  uint64_t num_edges = topology.num_edges();
+  const uint32_t* out_dests =
+      num_edges ? topology.out_dests->raw_values() : nullptr;
+
+  // Size the codes of each node, then encode them in place once the offsets
+  // are known.
+  arrow::UInt64Builder code_indices_builder;
+  if (!code_indices_builder.Resize(num_nodes).ok()) {
+    return ErrorCode::ArrowError;
+  }
+  // See SortAllEdgesByDest for why writing through this pointer is fine.
+  uint64_t* code_indices = num_nodes ? &code_indices_builder[0] : nullptr;
+
+  std::atomic<bool> unsorted = false;
+  katana::do_all(
+      katana::iterate(topology),
+      [&](Node n) {
+        auto [begin, end] = topology.edge_range(n);
+        for (Edge e = begin + 1; e < end; ++e) {
+          if (out_dests[e] < out_dests[e - 1]) {
+            unsorted.store(true, std::memory_order_relaxed);
+            return;
+          }
+        }
+        uint64_t size = 0;
+        WalkCodes(
+            n, out_dests, begin, end, block_size,
+            [&](uint64_t table_size) { size += table_size; },
+            [](uint64_t) {},
+            [&](uint64_t value) { size += ByteCodeSize(value); });
+        code_indices[n] = size;
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("CompressTopology-Size"));
+  if (unsorted) {
+    KATANA_LOG_DEBUG("edges must be sorted by destination to be compressed");
+    return ErrorCode::InvalidArgument;
+  }
+
+  katana::ParallelSTL::partial_sum(
+      code_indices, code_indices + num_nodes, code_indices);
+  uint64_t num_code_bytes = num_nodes ? code_indices[num_nodes - 1] : 0;
+  if (!code_indices_builder.Advance(num_nodes).ok()) {
+    return ErrorCode::ArrowError;
+  }
+
+  arrow::UInt8Builder codes_builder;
+  if (!codes_builder.Resize(num_code_bytes).ok()) {
+    return ErrorCode::ArrowError;
+  }
+  uint8_t* codes = num_code_bytes ? &codes_builder[0] : nullptr;
+
+  katana::do_all(
+      katana::iterate(topology),
+      [&](Node n) {
+        auto [begin, end] = topology.edge_range(n);
+        uint8_t* node_codes = codes + (n > 0 ? code_indices[n - 1] : 0);
+        uint8_t* code = node_codes;
+        WalkCodes(
+            n, out_dests, begin, end, block_size,
+            [&](uint64_t table_size) { code += table_size; },
+            [&](uint64_t block) {
+              if (block > 0) {
+                auto offset = static_cast<uint32_t>(code - node_codes);
+                std::memcpy(
+                    node_codes + (block - 1) * sizeof(uint32_t), &offset,
+                    sizeof(offset));
+              }
+            },
+            [&](uint64_t value) { code = EncodeByteCode(value, code); });
+        KATANA_LOG_DEBUG_ASSERT(codes + code_indices[n] == code);
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("CompressTopology-Encode"));
+
+  if (!codes_builder.Advance(num_code_bytes).ok()) {
+    return ErrorCode::ArrowError;
+  }
+
+  std::shared_ptr<arrow::UInt64Array> code_indices_array;
+  std::shared_ptr<arrow::UInt8Array> codes_array;
+  if (!code_indices_builder.Finish(&code_indices_array).ok() ||
+      !codes_builder.Finish(&codes_array).ok()) {
+    return ErrorCode::ArrowError;
+  }
+
+  std::shared_ptr<arrow::UInt64Array> out_indices = topology.out_indices;
+  if (!out_indices && !arrow::UInt64Builder().Finish(&out_indices).ok()) {
+    return ErrorCode::ArrowError;
+  }
+
+  return CompressedGraphTopology(
+      std::move(out_indices), std::move(code_indices_array),
+      std::move(codes_array), num_edges, block_size);
+}
+
+katana::Result<katana::CompressedGraphTopology>
+katana::CompressedGraphTopology::Load(const std::string& uri) {
+  auto storage = std::make_shared<tsuba::FileView>();
+  if (auto res = storage->Bind(uri, true); !res) {
+    return res.error();
+  }
+
+  tsuba::CompressedCSRTopologyHeader header;
+  if (storage->size() < sizeof(header)) {
+    return ErrorCode::InvalidArgument;
+  }
+  std::memcpy(&header, storage->ptr<uint8_t>(), sizeof(header));
+  if (header.version != tsuba::kCompressedCSRTopologyVersion ||
+      header.block_size == 0 ||
+      header.block_size > std::numeric_limits<uint32_t>::max()) {
+    return ErrorCode::InvalidArgument;
+  }
+
+  uint64_t indices_size = header.num_nodes * sizeof(uint64_t);
+  uint64_t expected_size =
+      sizeof(header) + 2 * indices_size + header.num_code_bytes;
+  if (storage->size() < expected_size) {
+    return ErrorCode::InvalidArgument;
+  }
+
+  const uint8_t* out_indices = storage->ptr<uint8_t>(sizeof(header));
+  const uint8_t* code_indices = out_indices + indices_size;
+  const uint8_t* codes = code_indices + indices_size;
+
+  auto out_indices_array = std::make_shared<arrow::UInt64Array>(
+      header.num_nodes,
+      std::make_shared<arrow::Buffer>(out_indices, indices_size));
+  auto code_indices_array = std::make_shared<arrow::UInt64Array>(
+      header.num_nodes,
+      std::make_shared<arrow::Buffer>(code_indices, indices_size));
+  auto codes_array = std::make_shared<arrow::UInt8Array>(
+      header.num_code_bytes,
+      std::make_shared<arrow::Buffer>(codes, header.num_code_bytes));
+
+  if (header.num_nodes > 0 &&
+      (out_indices_array->Value(header.num_nodes - 1) != header.num_edges ||
+       code_indices_array->Value(header.num_nodes - 1) !=
+           header.num_code_bytes)) {
+    return ErrorCode::InvalidArgument;
+  }
+
+  return CompressedGraphTopology(
+      std::move(out_indices_array), std::move(code_indices_array),
+      std::move(codes_array), header.num_edges,
+      static_cast<uint32_t>(header.block_size), std::move(storage));
+}
+
+katana::Result<void>
+katana::CompressedGraphTopology::Write(const std::string& uri) const {
+  tsuba::FileFrame ff;
+  if (auto res = ff.Init(); !res) {
+    return res.error();
+  }
+
+  tsuba::CompressedCSRTopologyHeader header{
+      .version = tsuba::kCompressedCSRTopologyVersion,
+      .block_size = block_size_,
+      .num_nodes = num_nodes(),
+      .num_edges = num_edges(),
+      .num_code_bytes = num_code_bytes(),
+  };
+  arrow::Status aro_sts = ff.Write(&header, sizeof(header));
+  if (!aro_sts.ok()) {
+    return tsuba::ArrowToTsuba(aro_sts.code());
+  }
+
+  if (num_nodes() > 0) {
+    if (auto res = WriteArray(*out_indices_, &ff); !res) {
+      return res.error();
+    }
+    if (auto res = WriteArray(*code_indices_, &ff); !res) {
+      return res.error();
+    }
+  }
+  if (num_code_bytes() > 0) {
+    if (auto res = WriteArray(*codes_, &ff); !res) {
+      return res.error();
+    }
+  }
+
+  ff.Bind(uri);
+  return ff.Persist();
+}
+
+katana::Result<katana::GraphTopology>
+katana::CompressedGraphTopology::Decompress() const {
+  arrow::UInt32Builder dests_builder;
+  if (!dests_builder.Resize(num_edges_).ok()) {
+    return ErrorCode::ArrowError;
+  }
+  uint32_t* out_dests = num_edges_ ? &dests_builder[0] : nullptr;
+
+  katana::do_all(
+      katana::iterate(*this),
+      [&](Node n) {
+        ForEachEdge(n, [&](Edge e, Node dest) { out_dests[e] = dest; });
+      },
+      katana::steal(), katana::no_stats());
+
+  if (!dests_builder.Advance(num_edges_).ok()) {
+    return ErrorCode::ArrowError;
+  }
+
+  GraphTopology topology;
+  topology.out_indices = out_indices_;
+  if (!dests_builder.Finish(&topology.out_dests).ok()) {
+    return ErrorCode::ArrowError;
+  }
+  return topology;
+}
@@ -0,0 +1,143 @@
+#include "katana/EdgeBalancedRange.h"
+
+#include <mutex>
+
+#include "katana/Bag.h"
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+
+namespace {
+
+/// Hubs are never split into items smaller than this
+constexpr uint64_t kMinHubEdges = 1024;
+/// With the default threshold, a hub is split once it has more edges than
+/// this fraction of the edges of one thread
+constexpr uint64_t kHubPiecesPerThread = 8;
+
+struct CacheEntry {
+  std::weak_ptr<arrow::UInt64Array> out_indices;
+  uint64_t max_hub_edges;
+  unsigned num_threads;
+  std::shared_ptr<const katana::EdgeBalancedPartition> partition;
+};
+
+std::mutex cache_mutex;
+std::vector<CacheEntry> cache;
+
+}  // namespace
+
+katana::EdgeBalancedPartition::EdgeBalancedPartition(
+    const GraphTopology& topology, uint64_t max_hub_edges,
+    unsigned num_threads)
+    : num_nodes_(topology.num_nodes()), max_hub_edges_(max_hub_edges) {
+  KATANA_LOG_DEBUG_ASSERT(max_hub_edges > 0);
+  KATANA_LOG_DEBUG_ASSERT(num_threads > 0);
+
+  if (num_nodes_ > 0) {
+    indices_ = topology.out_indices->raw_values();
+  }
+
+  if (max_hub_edges != kNoSplit) {
+    katana::InsertBag<GraphTopology::Node> hubs;
+    katana::do_all(
+        katana::iterate(topology),
+        [&](GraphTopology::Node n) {
+          if (EdgeEnd(n) - EdgeBegin(n) > max_hub_edges) {
+            hubs.push(n);
+          }
+        },
+        katana::no_stats(), katana::loopname("EdgeBalancedPartition_Hubs"));
+    for (GraphTopology::Node n : hubs) {
+      hubs_.emplace_back(Hub{.node = n, .first_item = 0, .num_pieces = 0});
+    }
+    std::sort(hubs_.begin(), hubs_.end(), [](const Hub& a, const Hub& b) {
+      return a.node < b.node;
+    });
+  }
+
+  uint64_t extra = 0;
+  for (Hub& hub : hubs_) {
+    uint64_t degree = EdgeEnd(hub.node) - EdgeBegin(hub.node);
+    hub.first_item = hub.node + extra;
+    hub.num_pieces = (degree + max_hub_edges - 1) / max_hub_edges;
+    extra += hub.num_pieces - 1;
+  }
+  num_items_ = num_nodes_ + extra;
+
+  // Each block boundary is the first item at or past its share of the total
+  // weight. WeightBefore is monotonic, so binary search for it.
+  uint64_t total = WeightBefore(num_items_);
+  thread_beginnings_.resize(num_threads + 1);
+  thread_beginnings_[0] = 0;
+  thread_beginnings_[num_threads] = num_items_;
+  for (unsigned t = 1; t < num_threads; ++t) {
+    uint64_t target = (total * t + num_threads - 1) / num_threads;
+    uint64_t lo = thread_beginnings_[t - 1];
+    uint64_t hi = num_items_;
+    while (lo < hi) {
+      uint64_t mid = lo + (hi - lo) / 2;
+      if (WeightBefore(mid) < target) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    thread_beginnings_[t] = lo;
+  }
+}
+
+uint64_t
+katana::EdgeBalancedPartition::WeightBefore(uint64_t i) const {
+  if (i == num_items_) {
+    return num_items_ + (num_nodes_ > 0 ? EdgeEnd(num_nodes_ - 1) : 0);
+  }
+  return i + item(i).begin;
+}
+
+uint64_t
+katana::EdgeBalancedPartition::DefaultMaxHubEdges(
+    const GraphTopology& topology) {
+  uint64_t per_thread = topology.num_edges() / katana::getActiveThreads();
+  return std::max(kMinHubEdges, per_thread / kHubPiecesPerThread);
+}
+
+std::shared_ptr<const katana::EdgeBalancedPartition>
+katana::EdgeBalancedPartition::Get(
+    const GraphTopology& topology, uint64_t max_hub_edges) {
+  unsigned num_threads = katana::getActiveThreads();
+
+  auto matches = [&](const CacheEntry& entry) {
+    return entry.max_hub_edges == max_hub_edges &&
+           entry.num_threads == num_threads &&
+           entry.out_indices.lock() == topology.out_indices;
+  };
+
+  if (topology.out_indices) {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = std::find_if(cache.begin(), cache.end(), matches);
+    if (it != cache.end()) {
+      return it->partition;
+    }
+  }
+
+  auto partition = std::make_shared<const EdgeBalancedPartition>(
+      topology, max_hub_edges, num_threads);
+  if (!topology.out_indices) {
+    return partition;
+  }
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  // Forget partitions of topologies that no longer exist
+  cache.erase(
+      std::remove_if(
+          cache.begin(), cache.end(),
+          [](const CacheEntry& entry) { return entry.out_indices.expired(); }),
+      cache.end());
+  cache.emplace_back(CacheEntry{
+      .out_indices = topology.out_indices,
+      .max_hub_edges = max_hub_edges,
+      .num_threads = num_threads,
+      .partition = partition,
+  });
+  return partition;
+}
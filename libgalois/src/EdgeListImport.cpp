@@ -0,0 +1,839 @@
+#include "katana/EdgeListImport.h"
+
+#include <fcntl.h>
+#include <locale.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <deque>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/ErrorCode.h"
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Uri.h"
+#include "tsuba/file.h"
+
+namespace {
+
+constexpr uint32_t kShardBits = 6;
+constexpr uint32_t kNumShards = UINT32_C(1) << kShardBits;
+
+// Endpoint positions within a wave are encoded as (chunk << kChunkShift) |
+// index so that sorting positions orders endpoints by first appearance
+constexpr uint32_t kChunkShift = 40;
+
+// How far past the end of a chunk to read at a time when looking for the end
+// of its last line
+constexpr uint64_t kOverrun = UINT64_C(64) << 10;
+
+constexpr uint64_t kUnassigned = std::numeric_limits<uint64_t>::max();
+
+/// A byte range of one input file. The chunk owns the lines that start in
+/// [begin, end).
+struct ChunkSpec {
+  size_t file;
+  uint64_t begin;
+  uint64_t end;
+};
+
+template <typename Key>
+struct ParsedChunk {
+  // Backing store for string keys
+  std::string text;
+  std::vector<Key> src;
+  std::vector<Key> dst;
+  std::vector<double> weight;
+};
+
+struct EdgeBlock {
+  std::vector<uint64_t> src;
+  std::vector<uint64_t> dst;
+  std::vector<double> weight;
+};
+
+katana::Result<void>
+AppendFile(
+    const std::string& path, uint64_t begin, uint64_t size, std::string* text) {
+  size_t old_size = text->size();
+  text->resize(old_size + size);
+  return tsuba::FileGet(
+      path, reinterpret_cast<uint8_t*>(&(*text)[old_size]),  // NOLINT
+      begin, size);
+}
+
+/// Read the lines owned by spec into chunk->text and return the offsets in
+/// chunk->text of the first and one past the last byte of those lines
+katana::Result<std::pair<size_t, size_t>>
+ReadChunk(
+    const std::string& path, uint64_t file_size, const ChunkSpec& spec,
+    std::string* text) {
+  // Start one byte early to see whether spec.begin starts a line
+  uint64_t read_begin = spec.begin > 0 ? spec.begin - 1 : 0;
+  uint64_t read_end = std::min(spec.end + kOverrun, file_size);
+  if (auto res = AppendFile(path, read_begin, read_end - read_begin, text);
+      !res) {
+    return res.error();
+  }
+
+  size_t first = 0;
+  if (spec.begin > 0) {
+    // A line starts after every newline in [spec.begin - 1, spec.end - 1)
+    size_t limit = spec.end - 1 - read_begin;
+    size_t nl = text->find('\n');
+    if (nl == std::string::npos || nl >= limit) {
+      return std::make_pair(size_t{0}, size_t{0});
+    }
+    first = nl + 1;
+  }
+
+  // The last owned line ends at the first newline at or after spec.end - 1
+  size_t search_from = spec.end - 1 - read_begin;
+  size_t nl = text->find('\n', search_from);
+  while (nl == std::string::npos && read_end < file_size) {
+    uint64_t next_end = std::min(read_end + kOverrun, file_size);
+    if (auto res = AppendFile(path, read_end, next_end - read_end, text);
+        !res) {
+      return res.error();
+    }
+    read_end = next_end;
+    nl = text->find('\n', search_from);
+  }
+  size_t last = nl == std::string::npos ? text->size() : nl + 1;
+  return std::make_pair(first, last);
+}
+
+bool
+IsBlank(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+std::string_view
+Trim(std::string_view s) {
+  while (!s.empty() && IsBlank(s.front())) {
+    s.remove_prefix(1);
+  }
+  while (!s.empty() && IsBlank(s.back())) {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+/// Split line into fields, stopping once fields holds max_fields entries
+void
+SplitLine(
+    std::string_view line, char delimiter, size_t max_fields,
+    std::vector<std::string_view>* fields) {
+  fields->clear();
+  if (delimiter == ' ') {
+    size_t i = 0;
+    while (i < line.size() && fields->size() < max_fields) {
+      while (i < line.size() && IsBlank(line[i])) {
+        ++i;
+      }
+      size_t start = i;
+      while (i < line.size() && !IsBlank(line[i])) {
+        ++i;
+      }
+      if (i > start) {
+        fields->emplace_back(line.substr(start, i - start));
+      }
+    }
+    return;
+  }
+
+  size_t start = 0;
+  while (fields->size() < max_fields) {
+    size_t pos = line.find(delimiter, start);
+    fields->emplace_back(Trim(line.substr(start, pos - start)));
+    if (pos == std::string_view::npos) {
+      break;
+    }
+    start = pos + 1;
+  }
+}
+
+template <typename Key>
+bool
+ParseKey(std::string_view field, Key* key) {
+  if constexpr (std::is_same_v<Key, std::string_view>) {
+    *key = field;
+    return !field.empty();
+  } else {
+    auto [ptr, ec] =
+        std::from_chars(field.data(), field.data() + field.size(), *key);
+    return ec == std::errc() && ptr == field.data() + field.size();
+  }
+}
+
+/// The C locale, so that weights are parsed the same way whatever the locale
+/// of the process is
+locale_t
+CLocale() {
+  static locale_t c_locale = newlocale(LC_ALL_MASK, "C", nullptr);
+  return c_locale;
+}
+
+bool
+ParseWeight(std::string_view field, double* weight) {
+  // field points into a NUL terminated buffer and strtod_l stops at the
+  // delimiter or newline following it
+  char* end = nullptr;
+  *weight = strtod_l(field.data(), &end, CLocale());
+  return !field.empty() && end == field.data() + field.size();
+}
+
+template <typename Key>
+katana::Result<void>
+ParseChunk(
+    const std::string& path, uint64_t file_size, const ChunkSpec& spec,
+    const katana::EdgeListImportOptions& opts, ParsedChunk<Key>* chunk) {
+  auto range_res = ReadChunk(path, file_size, spec, &chunk->text);
+  if (!range_res) {
+    return range_res.error();
+  }
+  auto [first, last] = range_res.value();
+
+  size_t max_fields = std::max(opts.src_column, opts.dst_column);
+  if (opts.weight_column) {
+    max_fields = std::max<size_t>(max_fields, *opts.weight_column);
+  }
+  max_fields += 1;
+
+  std::string_view text(chunk->text);
+  std::vector<std::string_view> fields;
+  bool skip_header = opts.has_header && spec.begin == 0;
+  for (size_t pos = first; pos < last;) {
+    size_t nl = text.find('\n', pos);
+    size_t line_end = std::min(nl, last);
+    std::string_view line = text.substr(pos, line_end - pos);
+    pos = line_end + 1;
+
+    if (skip_header) {
+      skip_header = false;
+      continue;
+    }
+    std::string_view trimmed = Trim(line);
+    if (trimmed.empty() || trimmed.front() == opts.comment) {
+      continue;
+    }
+
+    SplitLine(line, opts.delimiter, max_fields, &fields);
+    Key src{};
+    Key dst{};
+    double weight = 0;
+    if (fields.size() < max_fields ||
+        !ParseKey(fields[opts.src_column], &src) ||
+        !ParseKey(fields[opts.dst_column], &dst) ||
+        (opts.weight_column &&
+         !ParseWeight(fields[*opts.weight_column], &weight))) {
+      KATANA_LOG_ERROR("{}: malformed line: {}", path, line);
+      return katana::ErrorCode::InvalidArgument;
+    }
+    chunk->src.emplace_back(src);
+    chunk->dst.emplace_back(dst);
+    if (opts.weight_column) {
+      chunk->weight.emplace_back(weight);
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+/// IdMap assigns dense ids to external node ids. Keys are spread over
+/// kNumShards independent hash maps so that they can be deduplicated in
+/// parallel.
+template <typename Key>
+class IdMap {
+  struct Shard {
+    std::unordered_map<Key, uint64_t> ids;
+    // Storage for string keys; deque elements do not move
+    std::deque<std::string> names;
+  };
+
+  struct Fresh {
+    uint64_t pos;
+    uint64_t* id;
+    Key key;
+  };
+
+  std::vector<Shard> shards_ = std::vector<Shard>(kNumShards);
+  uint64_t num_nodes_{0};
+
+  static uint32_t ShardOf(const Key& key) {
+    uint64_t h = std::hash<Key>{}(key);
+    return (h * UINT64_C(0x9E3779B97F4A7C15)) >> (64 - kShardBits);
+  }
+
+  Key Own(Shard* shard, const Key& key) {
+    if constexpr (std::is_same_v<Key, std::string_view>) {
+      shard->names.emplace_back(key);
+      return std::string_view(shard->names.back());
+    } else {
+      return key;
+    }
+  }
+
+public:
+  uint64_t num_nodes() const { return num_nodes_; }
+
+  uint64_t Find(const Key& key) const {
+    const Shard& shard = shards_[ShardOf(key)];
+    auto it = shard.ids.find(key);
+    KATANA_LOG_DEBUG_ASSERT(it != shard.ids.end());
+    return it->second;
+  }
+
+  /// Give ids to the keys in wave that have not been seen before, in order of
+  /// first appearance. The new keys are returned in id order.
+  void AddWave(
+      const std::vector<ParsedChunk<Key>>& wave, std::vector<Key>* new_keys);
+};
+
+template <typename Key>
+void
+IdMap<Key>::AddWave(
+    const std::vector<ParsedChunk<Key>>& wave, std::vector<Key>* new_keys) {
+  // Scatter endpoints to shards, keeping per-chunk buckets so that each shard
+  // sees its keys in input order
+  std::vector<std::vector<std::vector<std::pair<uint64_t, Key>>>> buckets(
+      wave.size());
+  katana::do_all(
+      katana::iterate(size_t{0}, wave.size()),
+      [&](size_t c) {
+        const ParsedChunk<Key>& chunk = wave[c];
+        auto& chunk_buckets = buckets[c];
+        chunk_buckets.resize(kNumShards);
+        for (size_t e = 0; e < chunk.src.size(); ++e) {
+          uint64_t pos = (static_cast<uint64_t>(c) << kChunkShift) | (2 * e);
+          chunk_buckets[ShardOf(chunk.src[e])].emplace_back(pos, chunk.src[e]);
+          chunk_buckets[ShardOf(chunk.dst[e])].emplace_back(
+              pos + 1, chunk.dst[e]);
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  std::vector<std::vector<Fresh>> fresh(kNumShards);
+  katana::do_all(
+      katana::iterate(size_t{0}, size_t{kNumShards}),
+      [&](size_t s) {
+        Shard& shard = shards_[s];
+        for (const auto& chunk_buckets : buckets) {
+          for (const auto& [pos, key] : chunk_buckets[s]) {
+            if (shard.ids.find(key) != shard.ids.end()) {
+              continue;
+            }
+            Key owned = Own(&shard, key);
+            auto [it, inserted] = shard.ids.emplace(owned, kUnassigned);
+            KATANA_LOG_DEBUG_ASSERT(inserted);
+            fresh[s].emplace_back(Fresh{pos, &it->second, owned});
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+  buckets.clear();
+
+  std::vector<size_t> offsets(kNumShards + 1, 0);
+  for (uint32_t s = 0; s < kNumShards; ++s) {
+    offsets[s + 1] = offsets[s] + fresh[s].size();
+  }
+  std::vector<Fresh> all(offsets[kNumShards]);
+  katana::do_all(
+      katana::iterate(size_t{0}, size_t{kNumShards}),
+      [&](size_t s) {
+        std::copy(fresh[s].begin(), fresh[s].end(), all.begin() + offsets[s]);
+      },
+      katana::no_stats());
+  fresh.clear();
+
+  katana::ParallelSTL::sort(
+      all.begin(), all.end(),
+      [](const Fresh& a, const Fresh& b) { return a.pos < b.pos; });
+
+  new_keys->resize(all.size());
+  uint64_t base = num_nodes_;
+  katana::do_all(
+      katana::iterate(size_t{0}, all.size()),
+      [&](size_t i) {
+        *all[i].id = base + i;
+        (*new_keys)[i] = all[i].key;
+      },
+      katana::no_stats());
+  num_nodes_ += all.size();
+}
+
+/// EdgeStore holds the edges of every wave with dense ids, either in memory
+/// or in an unlinked temporary file
+class EdgeStore {
+  struct Extent {
+    uint64_t offset;
+    uint64_t num_edges;
+    bool weighted;
+  };
+
+  int fd_{-1};
+  uint64_t file_size_{0};
+  std::vector<Extent> extents_;
+  std::vector<EdgeBlock> blocks_;
+  uint64_t num_edges_{0};
+
+  static katana::Result<void> WriteAll(
+      int fd, const void* data, uint64_t size, uint64_t offset);
+  static katana::Result<void> ReadAll(
+      int fd, void* data, uint64_t size, uint64_t offset);
+  katana::Result<void> ReadBlock(size_t i, EdgeBlock* block) const;
+
+public:
+  EdgeStore() = default;
+  EdgeStore(const EdgeStore& no_copy) = delete;
+  EdgeStore& operator=(const EdgeStore& no_copy) = delete;
+  ~EdgeStore() {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  /// If spill_dir is empty, keep edges in memory
+  katana::Result<void> Init(const std::string& spill_dir);
+
+  katana::Result<void> Append(EdgeBlock&& block);
+
+  uint64_t num_edges() const { return num_edges_; }
+
+  /// Call fn on every block in parallel
+  template <typename F>
+  katana::Result<void> ForEachBlock(F fn) const;
+};
+
+katana::Result<void>
+EdgeStore::Init(const std::string& spill_dir) {
+  if (spill_dir.empty()) {
+    return katana::ResultSuccess();
+  }
+  std::string path = katana::Uri::JoinPath(spill_dir, "edges-XXXXXX");
+  fd_ = mkstemp(path.data());
+  if (fd_ < 0) {
+    auto err = katana::ResultErrno();
+    KATANA_LOG_ERROR("creating spill file in {}: {}", spill_dir, err.message());
+    return err;
+  }
+  // The file is only reachable through fd_ from here on
+  unlink(path.c_str());
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+EdgeStore::WriteAll(int fd, const void* data, uint64_t size, uint64_t offset) {
+  const char* p = static_cast<const char*>(data);
+  while (size > 0) {
+    ssize_t n = pwrite(fd, p, size, offset);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return katana::ResultErrno();
+    }
+    p += n;
+    size -= n;
+    offset += n;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+EdgeStore::ReadAll(int fd, void* data, uint64_t size, uint64_t offset) {
+  char* p = static_cast<char*>(data);
+  while (size > 0) {
+    ssize_t n = pread(fd, p, size, offset);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return katana::ResultErrno();
+    }
+    if (n == 0) {
+      return katana::ErrorCode::InvalidArgument;
+    }
+    p += n;
+    size -= n;
+    offset += n;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+EdgeStore::Append(EdgeBlock&& block) {
+  uint64_t num_edges = block.src.size();
+  num_edges_ += num_edges;
+  if (fd_ < 0) {
+    blocks_.emplace_back(std::move(block));
+    return katana::ResultSuccess();
+  }
+
+  // Layout: sources, destinations, then weights if there are any
+  Extent extent{file_size_, num_edges, !block.weight.empty()};
+  uint64_t ids_size = num_edges * sizeof(uint64_t);
+  if (auto res = WriteAll(fd_, block.src.data(), ids_size, file_size_); !res) {
+    return res.error();
+  }
+  file_size_ += ids_size;
+  if (auto res = WriteAll(fd_, block.dst.data(), ids_size, file_size_); !res) {
+    return res.error();
+  }
+  file_size_ += ids_size;
+  if (extent.weighted) {
+    uint64_t weights_size = num_edges * sizeof(double);
+    if (auto res = WriteAll(fd_, block.weight.data(), weights_size, file_size_);
+        !res) {
+      return res.error();
+    }
+    file_size_ += weights_size;
+  }
+  extents_.emplace_back(extent);
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+EdgeStore::ReadBlock(size_t i, EdgeBlock* block) const {
+  const Extent& extent = extents_[i];
+  uint64_t ids_size = extent.num_edges * sizeof(uint64_t);
+  block->src.resize(extent.num_edges);
+  block->dst.resize(extent.num_edges);
+  block->weight.resize(extent.weighted ? extent.num_edges : 0);
+  if (auto res = ReadAll(fd_, block->src.data(), ids_size, extent.offset);
+      !res) {
+    return res.error();
+  }
+  if (auto res =
+          ReadAll(fd_, block->dst.data(), ids_size, extent.offset + ids_size);
+      !res) {
+    return res.error();
+  }
+  if (extent.weighted) {
+    if (auto res = ReadAll(
+            fd_, block->weight.data(), extent.num_edges * sizeof(double),
+            extent.offset + 2 * ids_size);
+        !res) {
+      return res.error();
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+template <typename F>
+katana::Result<void>
+EdgeStore::ForEachBlock(F fn) const {
+  if (fd_ < 0) {
+    katana::do_all(
+        katana::iterate(size_t{0}, blocks_.size()),
+        [&](size_t i) { fn(blocks_[i]); }, katana::steal(),
+        katana::no_stats());
+    return katana::ResultSuccess();
+  }
+
+  std::vector<katana::Result<void>> results(
+      extents_.size(), katana::ResultSuccess());
+  katana::do_all(
+      katana::iterate(size_t{0}, extents_.size()),
+      [&](size_t i) {
+        EdgeBlock block;
+        results[i] = ReadBlock(i, &block);
+        if (results[i]) {
+          fn(block);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  for (const auto& res : results) {
+    if (!res) {
+      return res.error();
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+/// Build the CSR topology, and the edge weights if there are any, with a
+/// parallel counting sort of the edges by source. The edges of each node are
+/// then sorted by destination (and weight) so the result does not depend on
+/// thread scheduling.
+template <typename NodeIdTy>
+katana::Result<void>
+BuildTopology(
+    const EdgeStore& edges, uint64_t num_nodes, bool weighted,
+    katana::BasicGraphTopology<NodeIdTy>* topo,
+    std::shared_ptr<arrow::Array>* weights) {
+  using DestsBuilder = typename arrow::CTypeTraits<NodeIdTy>::BuilderType;
+  KATANA_LOG_DEBUG_ASSERT(num_nodes <= std::numeric_limits<NodeIdTy>::max());
+  uint64_t num_edges = edges.num_edges();
+
+  std::vector<uint64_t> counts(num_nodes, 0);
+  if (auto res = edges.ForEachBlock([&](const EdgeBlock& block) {
+        for (uint64_t src : block.src) {
+          __atomic_fetch_add(&counts[src], 1, __ATOMIC_RELAXED);
+        }
+      });
+      !res) {
+    return res.error();
+  }
+
+  arrow::UInt64Builder indices_builder;
+  DestsBuilder dests_builder;
+  arrow::DoubleBuilder weights_builder;
+  if (!indices_builder.Resize(num_nodes).ok() ||
+      !dests_builder.Resize(num_edges).ok() ||
+      (weighted && !weights_builder.Resize(num_edges).ok())) {
+    return katana::ErrorCode::ArrowError;
+  }
+  uint64_t* out_indices = num_nodes ? &indices_builder[0] : nullptr;
+  NodeIdTy* out_dests = num_edges ? &dests_builder[0] : nullptr;
+  double* out_weights = weighted && num_edges ? &weights_builder[0] : nullptr;
+
+  katana::ParallelSTL::partial_sum(counts.begin(), counts.end(), out_indices);
+
+  // Turn counts into the next free slot of each node
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { counts[n] = out_indices[n] - counts[n]; },
+      katana::no_stats());
+
+  if (auto res = edges.ForEachBlock([&](const EdgeBlock& block) {
+        for (size_t i = 0; i < block.src.size(); ++i) {
+          uint64_t slot =
+              __atomic_fetch_add(&counts[block.src[i]], 1, __ATOMIC_RELAXED);
+          out_dests[slot] = static_cast<NodeIdTy>(block.dst[i]);
+          if (weighted) {
+            out_weights[slot] = block.weight[i];
+          }
+        }
+      });
+      !res) {
+    return res.error();
+  }
+  counts.clear();
+  counts.shrink_to_fit();
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        uint64_t begin = n > 0 ? out_indices[n - 1] : 0;
+        uint64_t end = out_indices[n];
+        if (!weighted) {
+          std::sort(out_dests + begin, out_dests + end);
+          return;
+        }
+        std::vector<std::pair<NodeIdTy, double>> edges(end - begin);
+        for (uint64_t e = begin; e < end; ++e) {
+          edges[e - begin] = std::make_pair(out_dests[e], out_weights[e]);
+        }
+        std::sort(edges.begin(), edges.end());
+        for (uint64_t e = begin; e < end; ++e) {
+          std::tie(out_dests[e], out_weights[e]) = edges[e - begin];
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  if (!indices_builder.Advance(num_nodes).ok() ||
+      !dests_builder.Advance(num_edges).ok() ||
+      (weighted && !weights_builder.Advance(num_edges).ok())) {
+    return katana::ErrorCode::ArrowError;
+  }
+  if (!indices_builder.Finish(&topo->out_indices).ok() ||
+      !dests_builder.Finish(&topo->out_dests).ok() ||
+      (weighted && !weights_builder.Finish(weights).ok())) {
+    return katana::ErrorCode::ArrowError;
+  }
+  return katana::ResultSuccess();
+}
+
+template <typename Key>
+katana::Result<void>
+AppendIds(const std::vector<Key>& keys, arrow::ArrayBuilder* builder) {
+  arrow::Status status;
+  if constexpr (std::is_same_v<Key, std::string_view>) {
+    auto* b = static_cast<arrow::LargeStringBuilder*>(builder);
+    for (auto it = keys.begin(); it != keys.end() && status.ok(); ++it) {
+      status = b->Append(it->data(), it->size());
+    }
+  } else {
+    auto* b = static_cast<arrow::UInt64Builder*>(builder);
+    status = b->AppendValues(keys);
+  }
+  if (!status.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", status);
+    return katana::ErrorCode::ArrowError;
+  }
+  return katana::ResultSuccess();
+}
+
+std::shared_ptr<arrow::Table>
+EmptyTable(uint64_t num_rows) {
+  return arrow::Table::Make(
+      arrow::schema({}), std::vector<std::shared_ptr<arrow::Array>>{},
+      num_rows);
+}
+
+template <typename Key>
+katana::Result<katana::GraphComponents>
+Import(
+    const std::vector<std::string>& paths,
+    const katana::EdgeListImportOptions& opts) {
+  std::vector<uint64_t> file_sizes(paths.size());
+  uint64_t total_size = 0;
+  for (size_t i = 0; i < paths.size(); ++i) {
+    tsuba::StatBuf buf;
+    if (auto res = tsuba::FileStat(paths[i], &buf); !res) {
+      KATANA_LOG_ERROR("cannot stat {}: {}", paths[i], res.error());
+      return res.error();
+    }
+    file_sizes[i] = buf.size;
+    total_size += buf.size;
+  }
+
+  uint64_t chunk_size = std::max<uint64_t>(opts.chunk_size, 1);
+  std::vector<ChunkSpec> specs;
+  for (size_t i = 0; i < paths.size(); ++i) {
+    for (uint64_t begin = 0; begin < file_sizes[i]; begin += chunk_size) {
+      specs.emplace_back(ChunkSpec{
+          i, begin, std::min(begin + chunk_size, file_sizes[i])});
+    }
+  }
+
+  // Parsing holds the text and keys of a wave in memory, so when spilling,
+  // keep waves to a fraction of the budget
+  bool spill = opts.memory_budget > 0 && total_size > opts.memory_budget;
+  uint64_t wave_size =
+      spill ? std::max(opts.memory_budget / 4, chunk_size) : total_size;
+  size_t chunks_per_wave =
+      std::max<uint64_t>(1, wave_size / std::max<uint64_t>(chunk_size, 1));
+
+  EdgeStore edges;
+  if (auto res = edges.Init(spill ? opts.spill_dir : ""); !res) {
+    return res.error();
+  }
+
+  IdMap<Key> id_map;
+  std::shared_ptr<arrow::ArrayBuilder> id_builder;
+  if constexpr (std::is_same_v<Key, std::string_view>) {
+    id_builder = std::make_shared<arrow::LargeStringBuilder>();
+  } else {
+    id_builder = std::make_shared<arrow::UInt64Builder>();
+  }
+  bool weighted = opts.weight_column.has_value();
+
+  for (size_t wave_begin = 0; wave_begin < specs.size();
+       wave_begin += chunks_per_wave) {
+    size_t wave_end = std::min(wave_begin + chunks_per_wave, specs.size());
+    size_t wave_chunks = wave_end - wave_begin;
+
+    // Sized once so that string keys into ParsedChunk::text stay valid
+    std::vector<ParsedChunk<Key>> wave(wave_chunks);
+    std::vector<katana::Result<void>> results(
+        wave_chunks, katana::ResultSuccess());
+    katana::do_all(
+        katana::iterate(size_t{0}, wave_chunks),
+        [&](size_t c) {
+          const ChunkSpec& spec = specs[wave_begin + c];
+          results[c] = ParseChunk(
+              paths[spec.file], file_sizes[spec.file], spec, opts, &wave[c]);
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("ImportEdgeList-Parse"));
+    for (const auto& res : results) {
+      if (!res) {
+        return res.error();
+      }
+    }
+
+    std::vector<Key> new_keys;
+    id_map.AddWave(wave, &new_keys);
+    if (auto res = AppendIds(new_keys, id_builder.get()); !res) {
+      return res.error();
+    }
+
+    std::vector<EdgeBlock> blocks(wave_chunks);
+    katana::do_all(
+        katana::iterate(size_t{0}, wave_chunks),
+        [&](size_t c) {
+          const ParsedChunk<Key>& chunk = wave[c];
+          EdgeBlock& block = blocks[c];
+          block.src.resize(chunk.src.size());
+          block.dst.resize(chunk.dst.size());
+          for (size_t e = 0; e < chunk.src.size(); ++e) {
+            block.src[e] = id_map.Find(chunk.src[e]);
+            block.dst[e] = id_map.Find(chunk.dst[e]);
+          }
+          block.weight = chunk.weight;
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("ImportEdgeList-MapIds"));
+    wave.clear();
+
+    for (EdgeBlock& block : blocks) {
+      if (auto res = edges.Append(std::move(block)); !res) {
+        return res.error();
+      }
+    }
+  }
+
+  // Graphs whose node ids do not fit in 32 bits get a wide topology
+  std::shared_ptr<katana::GraphTopology> topology;
+  std::shared_ptr<katana::WideGraphTopology> wide_topology;
+  std::shared_ptr<arrow::Array> weights;
+  katana::Result<void> topology_res = katana::ResultSuccess();
+  if (id_map.num_nodes() > std::numeric_limits<uint32_t>::max()) {
+    wide_topology = std::make_shared<katana::WideGraphTopology>();
+    topology_res = BuildTopology(
+        edges, id_map.num_nodes(), weighted, wide_topology.get(), &weights);
+  } else {
+    topology = std::make_shared<katana::GraphTopology>();
+    topology_res = BuildTopology(
+        edges, id_map.num_nodes(), weighted, topology.get(), &weights);
+  }
+  if (!topology_res) {
+    return topology_res.error();
+  }
+
+  std::shared_ptr<arrow::Array> ids;
+  if (!id_builder->Finish(&ids).ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+
+  katana::GraphComponent nodes(
+      arrow::Table::Make(
+          arrow::schema({arrow::field(opts.id_name, ids->type())}), {ids}),
+      EmptyTable(ids->length()));
+  katana::GraphComponent edge_comp(
+      weighted ? arrow::Table::Make(
+                     arrow::schema({arrow::field(
+                         opts.weight_name, arrow::float64())}),
+                     {weights})
+               : EmptyTable(edges.num_edges()),
+      EmptyTable(edges.num_edges()));
+
+  katana::GraphComponents components(
+      std::move(nodes), std::move(edge_comp), std::move(topology));
+  components.wide_topology = std::move(wide_topology);
+  return components;
+}
+
+}  // namespace
+
+katana::Result<katana::GraphComponents>
+katana::ImportEdgeList(
+    const std::vector<std::string>& paths, const EdgeListImportOptions& opts) {
+  if (opts.src_column == opts.dst_column) {
+    return ErrorCode::InvalidArgument;
+  }
+  if (opts.numeric_ids) {
+    return Import<uint64_t>(paths, opts);
+  }
+  return Import<std::string_view>(paths, opts);
+}
@@ -0,0 +1,167 @@
+#include "katana/NumaArrowMemoryPool.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "katana/Env.h"
+#include "katana/Logging.h"
+#include "katana/NumaMem.h"
+#include "katana/PageAlloc.h"
+#include "katana/Statistics.h"
+#include "katana/ThreadPool.h"
+#include "katana/Threads.h"
+
+namespace {
+
+/// The size of the mapping that backs a large allocation of size bytes; this
+/// does not overflow for any nonnegative size
+uint64_t
+MappedSize(int64_t size) {
+  uint64_t page_size = katana::allocSize();
+  return (static_cast<uint64_t>(size) + page_size - 1) / page_size * page_size;
+}
+
+}  // namespace
+
+katana::NumaArrowMemoryPool::Options
+katana::NumaArrowMemoryPool::DefaultOptions() {
+  Options opts;
+  std::string policy;
+  if (katana::GetEnv("KATANA_NUMA_POOL_POLICY", &policy)) {
+    if (policy == "interleaved") {
+      opts.policy = Policy::kInterleaved;
+    } else if (policy == "blocked") {
+      opts.policy = Policy::kBlocked;
+    } else if (policy == "local") {
+      opts.policy = Policy::kLocal;
+    } else {
+      KATANA_LOG_WARN("ignoring unknown KATANA_NUMA_POOL_POLICY {}", policy);
+    }
+  }
+  int min_size = 0;
+  if (katana::GetEnv("KATANA_NUMA_POOL_MIN_SIZE", &min_size) && min_size > 0) {
+    opts.min_numa_size = min_size;
+  }
+  return opts;
+}
+
+katana::NumaArrowMemoryPool::NumaArrowMemoryPool(
+    const Options& opts, arrow::MemoryPool* fallback)
+    : opts_(opts), fallback_(fallback) {
+  // Zero-sized allocations must always go to the fallback pool
+  opts_.min_numa_size = std::max<int64_t>(opts_.min_numa_size, 1);
+}
+
+uint8_t*
+katana::NumaArrowMemoryPool::AllocateNuma(int64_t size) {
+  bool can_page_in = owner_.load() == std::this_thread::get_id() &&
+                     !GetThreadPool().isRunning();
+  unsigned num_threads = katana::getActiveThreads();
+
+  LAptr ptr;
+  if (opts_.policy == Policy::kLocal) {
+    ptr = tryLargeMallocLocal(size);
+  } else if (!can_page_in) {
+    ptr = tryLargeMallocFloating(size);
+  } else if (opts_.policy == Policy::kBlocked) {
+    ptr = tryLargeMallocBlocked(size, num_threads);
+  } else {
+    ptr = tryLargeMallocInterleaved(size, num_threads);
+  }
+  if (!ptr) {
+    return nullptr;
+  }
+
+  num_numa_allocations_.fetch_add(1);
+  numa_bytes_mapped_.fetch_add(static_cast<int64_t>(MappedSize(size)));
+  // Free rebuilds the deleter from the size arrow passes back
+  return static_cast<uint8_t*>(ptr.release());
+}
+
+void
+katana::NumaArrowMemoryPool::Account(int64_t delta) {
+  int64_t now = bytes_allocated_.fetch_add(delta) + delta;
+  int64_t peak = max_memory_.load();
+  while (now > peak && !max_memory_.compare_exchange_weak(peak, now)) {
+  }
+}
+
+arrow::Status
+katana::NumaArrowMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  if (size < 0) {
+    return arrow::Status::Invalid("negative allocation size requested");
+  }
+  if (IsNuma(size)) {
+    if (*out = AllocateNuma(size); *out == nullptr) {
+      return arrow::Status::OutOfMemory("failed to map ", size, " bytes");
+    }
+  } else if (auto status = fallback_->Allocate(size, out); !status.ok()) {
+    return status;
+  }
+  num_allocations_.fetch_add(1);
+  Account(size);
+  return arrow::Status::OK();
+}
+
+arrow::Status
+katana::NumaArrowMemoryPool::Reallocate(
+    int64_t old_size, int64_t new_size, uint8_t** ptr) {
+  if (new_size < 0) {
+    return arrow::Status::Invalid("negative reallocation size requested");
+  }
+  if (!IsNuma(old_size) && !IsNuma(new_size)) {
+    if (auto status = fallback_->Reallocate(old_size, new_size, ptr);
+        !status.ok()) {
+      return status;
+    }
+    Account(new_size - old_size);
+    return arrow::Status::OK();
+  }
+  if (IsNuma(old_size) && IsNuma(new_size) &&
+      MappedSize(old_size) == MappedSize(new_size)) {
+    // Still fits in the existing mapping
+    Account(new_size - old_size);
+    return arrow::Status::OK();
+  }
+
+  uint8_t* out = nullptr;
+  if (auto status = Allocate(new_size, &out); !status.ok()) {
+    return status;
+  }
+  std::memcpy(out, *ptr, std::min(old_size, new_size));
+  Free(*ptr, old_size);
+  *ptr = out;
+  return arrow::Status::OK();
+}
+
+void
+katana::NumaArrowMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  if (IsNuma(size)) {
+    internal::largeFreer{MappedSize(size)}(buffer);
+  } else {
+    fallback_->Free(buffer, size);
+  }
+  Account(-size);
+}
+
+std::string
+katana::NumaArrowMemoryPool::backend_name() const {
+  return "numa+" + fallback_->backend_name();
+}
+
+void
+katana::NumaArrowMemoryPool::ReportStats(const std::string& region) const {
+  katana::ReportStatSingle(region, "NumAllocations", num_allocations_.load());
+  katana::ReportStatSingle(
+      region, "NumNumaAllocations", num_numa_allocations_.load());
+  katana::ReportStatSingle(
+      region, "NumaBytesMapped", numa_bytes_mapped_.load());
+  katana::ReportStatSingle(region, "BytesAllocated", bytes_allocated_.load());
+  katana::ReportStatSingle(region, "PeakBytesAllocated", max_memory_.load());
+}
+
+katana::NumaArrowMemoryPool*
+katana::GetNumaArrowMemoryPool() {
+  static auto* pool = new NumaArrowMemoryPool();
+  return pool;
+}
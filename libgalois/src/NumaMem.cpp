@@ -20,6 +20,7 @@
 #include "katana/NumaMem.h"
 
 #include <cassert>
+#include <limits>
 
 #include "katana/PageAlloc.h"
 #include "katana/ThreadPool.h"
@@ -155,11 +156,31 @@ roundup(size_t data, size_t mult) {
   return data + (mult - rem);
 }
 
-LAptr
-katana::largeMallocInterleaved(size_t bytes, unsigned numThreads) {
+// map whole pages for bytes without faulting them in unless preFault, or
+// return an empty pointer if they cannot be mapped
+static LAptr
+tryMapPages(size_t bytes, bool preFault) {
+  if (bytes > std::numeric_limits<size_t>::max() - allocSize()) {
+    return LAptr{nullptr, internal::largeFreer{0}};
+  }
   // round up to hugePageSize
   bytes = roundup(bytes, allocSize());
+  return LAptr{
+      tryAllocPages(bytes / allocSize(), preFault),
+      internal::largeFreer{bytes}};
+}
 
+// abort if a nonempty allocation failed
+static LAptr
+checkMapped(LAptr ptr, size_t bytes) {
+  if (!ptr && bytes > 0) {
+    KATANA_LOG_FATAL("failed to allocate {} bytes: {}", bytes, errno);
+  }
+  return ptr;
+}
+
+LAptr
+katana::tryLargeMallocInterleaved(size_t bytes, unsigned numThreads) {
 #ifdef KATANA_USE_NUMA
   // We don't use numa_alloc_interleaved_subset because we really want huge
   // pages
@@ -167,44 +188,58 @@ katana::largeMallocInterleaved(size_t bytes, unsigned numThreads) {
   // the alloc would go
 #endif
   // Get a non-prefaulted allocation
-  void* data = allocPages(bytes / allocSize(), false);
+  LAptr ptr = tryMapPages(bytes, false);
 
   // Then page in based on thread number
-  if (data)
+  if (ptr)
     // true = round robin paging
-    pageIn(data, bytes, allocSize(), numThreads, true);
+    pageIn(
+        ptr.get(), ptr.get_deleter().bytes, allocSize(), numThreads, true);
 
-  return LAptr{data, internal::largeFreer{bytes}};
+  return ptr;
 }
 
 LAptr
-katana::largeMallocLocal(size_t bytes) {
-  // round up to hugePageSize
-  bytes = roundup(bytes, allocSize());
+katana::tryLargeMallocLocal(size_t bytes) {
   // Get a prefaulted allocation
-  return LAptr{
-      allocPages(bytes / allocSize(), true), internal::largeFreer{bytes}};
+  return tryMapPages(bytes, true);
 }
 
 LAptr
-katana::largeMallocFloating(size_t bytes) {
-  // round up to hugePageSize
-  bytes = roundup(bytes, allocSize());
+katana::tryLargeMallocFloating(size_t bytes) {
   // Get a non-prefaulted allocation
-  return LAptr{
-      allocPages(bytes / allocSize(), false), internal::largeFreer{bytes}};
+  return tryMapPages(bytes, false);
 }
 
 LAptr
-katana::largeMallocBlocked(size_t bytes, unsigned numThreads) {
-  // round up to hugePageSize
-  bytes = roundup(bytes, allocSize());
+katana::tryLargeMallocBlocked(size_t bytes, unsigned numThreads) {
   // Get a non-prefaulted allocation
-  void* data = allocPages(bytes / allocSize(), false);
-  if (data)
+  LAptr ptr = tryMapPages(bytes, false);
+  if (ptr)
     // false = blocked paging
-    pageIn(data, bytes, allocSize(), numThreads, false);
-  return LAptr{data, internal::largeFreer{bytes}};
+    pageIn(
+        ptr.get(), ptr.get_deleter().bytes, allocSize(), numThreads, false);
+  return ptr;
+}
+
+LAptr
+katana::largeMallocInterleaved(size_t bytes, unsigned numThreads) {
+  return checkMapped(tryLargeMallocInterleaved(bytes, numThreads), bytes);
+}
+
+LAptr
+katana::largeMallocLocal(size_t bytes) {
+  return checkMapped(tryLargeMallocLocal(bytes), bytes);
+}
+
+LAptr
+katana::largeMallocFloating(size_t bytes) {
+  return checkMapped(tryLargeMallocFloating(bytes), bytes);
+}
+
+LAptr
+katana::largeMallocBlocked(size_t bytes, unsigned numThreads) {
+  return checkMapped(tryLargeMallocBlocked(bytes, numThreads), bytes);
 }
 
 /**
@@ -19,6 +19,7 @@
 
 #include "katana/PageAlloc.h"
 
+#include <limits>
 #include <mutex>
 
 #include "katana/Logging.h"
@@ -76,8 +77,8 @@ katana::allocSize() {
 }
 
 void*
-katana::allocPages(unsigned num, bool preFault) {
-  if (num == 0) {
+katana::tryAllocPages(size_t num, bool preFault) {
+  if (num == 0 || num > std::numeric_limits<size_t>::max() / hugePageSize) {
     return nullptr;
   }
 
@@ -88,11 +89,7 @@ katana::allocPages(unsigned num, bool preFault) {
     ptr = trymmap(num * hugePageSize, preFault ? _MAP_POP : _MAP);
   }
 
-  if (!ptr) {
-    KATANA_LOG_FATAL("failed to allocate: {}", errno);
-  }
-
-  if (preFault && doHandMap) {
+  if (ptr && preFault && doHandMap) {
     for (size_t x = 0; x < num * hugePageSize; x += 4096) {
       static_cast<char*>(ptr)[x] = 0;
     }
@@ -101,6 +98,20 @@ katana::allocPages(unsigned num, bool preFault) {
   return ptr;
 }
 
+void*
+katana::allocPages(unsigned num, bool preFault) {
+  if (num == 0) {
+    return nullptr;
+  }
+
+  void* ptr = tryAllocPages(num, preFault);
+  if (!ptr) {
+    KATANA_LOG_FATAL("failed to allocate: {}", errno);
+  }
+
+  return ptr;
+}
+
 void
 katana::freePages(void* ptr, unsigned num) {
   std::lock_guard<SimpleLock> lg(allocLock);
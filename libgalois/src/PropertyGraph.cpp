@@ -2,8 +2,11 @@
 
 #include <sys/mman.h>
 
+#include <limits>
+
 #include "katana/Logging.h"
 #include "katana/Loops.h"
+#include "katana/ParallelSTL.h"
 #include "katana/Platform.h"
 #include "katana/Properties.h"
 #include "katana/Result.h"
@@ -15,45 +18,57 @@
 namespace {
 
 constexpr uint64_t
-GetGraphSize(uint64_t num_nodes, uint64_t num_edges) {
+GetGraphSize(
+    uint64_t num_nodes, uint64_t num_edges,
+    uint64_t sizeof_dest = sizeof(uint32_t)) {
   /// version, sizeof_edge_data, num_nodes, num_edges
   constexpr int mandatory_fields = 4;
 
   return (mandatory_fields + num_nodes) * sizeof(uint64_t) +
-         (num_edges * sizeof(uint32_t));
+         (num_edges * sizeof_dest);
 }
 
+/// The topology file version that stores node ids of type NodeIdTy
+template <typename NodeIdTy>
+constexpr uint64_t kTopologyVersion = sizeof(NodeIdTy) == sizeof(uint32_t) ? 1
+                                                                           : 2;
+
 /// MapTopology takes a file buffer of a topology file and extracts the
 /// topology files.
 ///
 /// Format of a topology file (borrowed from the original FileGraph.cpp:
 ///
-///   uint64_t version: 1
+///   uint64_t version: 1 for 32-bit node ids or 2 for 64-bit node ids
 ///   uint64_t sizeof_edge_data: size of edge data element
 ///   uint64_t num_nodes: number of nodes
 ///   uint64_t num_edges: number of edges
 ///   uint64_t[num_nodes] out_indices: start and end of the edges for a node
-///   uint32_t[num_edges] out_dests: destinations (node indexes) of each edge
-///   uint32_t padding if num_edges is odd
+///   uint32_t[num_edges] (version 1) or uint64_t[num_edges] (version 2)
+///     out_dests: destinations (node indexes) of each edge
+///   uint32_t padding if version 1 and num_edges is odd
 ///   void*[num_edges] edge_data: edge data
 ///
 /// Since property graphs store their edge data separately, we will
 /// ignore the size_of_edge_data (data[1]).
-katana::Result<katana::GraphTopology>
+template <typename NodeIdTy>
+katana::Result<katana::BasicGraphTopology<NodeIdTy>>
 MapTopology(const tsuba::FileView& file_view) {
+  using Topology = katana::BasicGraphTopology<NodeIdTy>;
+
   const auto* data = file_view.ptr<uint64_t>();
-  if (file_view.size() < 4) {
+  if (file_view.size() < 4 * sizeof(uint64_t)) {
     return katana::ErrorCode::InvalidArgument;
   }
 
-  if (data[0] != 1) {
+  if (data[0] != kTopologyVersion<NodeIdTy>) {
     return katana::ErrorCode::InvalidArgument;
   }
 
   uint64_t num_nodes = data[2];
   uint64_t num_edges = data[3];
 
-  uint64_t expected_size = GetGraphSize(num_nodes, num_edges);
+  uint64_t expected_size =
+      GetGraphSize(num_nodes, num_edges, sizeof(NodeIdTy));
 
   if (file_view.size() < expected_size) {
     return katana::ErrorCode::InvalidArgument;
@@ -61,37 +76,222 @@ MapTopology(const tsuba::FileView& file_view) {
 
   uint64_t* out_indices = const_cast<uint64_t*>(&data[4]);
 
-  auto* out_dests = reinterpret_cast<uint32_t*>(out_indices + num_nodes);
+  auto* out_dests = reinterpret_cast<NodeIdTy*>(out_indices + num_nodes);
 
   auto indices_buffer = std::make_shared<arrow::MutableBuffer>(
-      reinterpret_cast<uint8_t*>(out_indices), num_nodes);
+      reinterpret_cast<uint8_t*>(out_indices), num_nodes * sizeof(uint64_t));
 
   auto dests_buffer = std::make_shared<arrow::MutableBuffer>(
-      reinterpret_cast<uint8_t*>(out_dests), num_edges);
+      reinterpret_cast<uint8_t*>(out_dests), num_edges * sizeof(NodeIdTy));
 
-  return katana::GraphTopology{
-      .out_indices = std::make_shared<arrow::UInt64Array>(
-          indices_buffer->size(), indices_buffer),
-      .out_dests = std::make_shared<arrow::UInt32Array>(
-          dests_buffer->size(), dests_buffer),
+  return Topology{
+      .out_indices =
+          std::make_shared<arrow::UInt64Array>(num_nodes, indices_buffer),
+      .out_dests = std::make_shared<typename Topology::DestArray>(
+          num_edges, dests_buffer),
   };
 }
 
+/// NarrowTopology copies a wide topology whose node ids fit in 32 bits into
+/// a compact topology.
+katana::Result<katana::GraphTopology>
+NarrowTopology(const katana::WideGraphTopology& wide) {
+  uint64_t num_nodes = wide.num_nodes();
+  uint64_t num_edges = wide.num_edges();
+  KATANA_LOG_DEBUG_ASSERT(
+      num_nodes <= std::numeric_limits<katana::GraphTopology::Node>::max());
+
+  arrow::UInt64Builder indices_builder;
+  arrow::UInt32Builder dests_builder;
+  if (!indices_builder.Resize(num_nodes).ok() ||
+      !dests_builder.Resize(num_edges).ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  // See SortAllEdgesByDest for why writing through these pointers is fine.
+  uint64_t* out_indices = num_nodes ? &indices_builder[0] : nullptr;
+  uint32_t* out_dests = num_edges ? &dests_builder[0] : nullptr;
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { out_indices[n] = wide.out_indices->Value(n); },
+      katana::no_stats());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_edges),
+      [&](uint64_t e) { out_dests[e] = wide.out_dests->Value(e); },
+      katana::no_stats());
+
+  if (!indices_builder.Advance(num_nodes).ok() ||
+      !dests_builder.Advance(num_edges).ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+
+  katana::GraphTopology topology;
+  if (!indices_builder.Finish(&topology.out_indices).ok() ||
+      !dests_builder.Finish(&topology.out_dests).ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  return topology;
+}
+
+/// LoadTopology loads the topology stored by rdg. The width of node ids is
+/// chosen here: version 1 files and version 2 files with fewer than 2^32
+/// nodes are loaded as a compact topology and the rest as a wide topology.
 katana::Result<void>
 LoadTopology(
-    katana::GraphTopology* topology,
-    const tsuba::FileView& topology_file_storage) {
-  auto map_result = MapTopology(topology_file_storage);
+    katana::GraphTopology* topology, katana::WideGraphTopology* wide_topology,
+    tsuba::RDG* rdg) {
+  const tsuba::FileView& storage = rdg->topology_file_storage();
+  if (storage.size() < sizeof(uint64_t)) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  if (storage.ptr<uint64_t>()[0] != kTopologyVersion<uint64_t>) {
+    auto map_result = MapTopology<uint32_t>(storage);
+    if (!map_result) {
+      return map_result.error();
+    }
+    *topology = std::move(map_result.value());
+    return katana::ResultSuccess();
+  }
+
+  auto map_result = MapTopology<uint64_t>(storage);
   if (!map_result) {
     return map_result.error();
   }
-  *topology = std::move(map_result.value());
 
+  if (map_result.value().num_nodes() >
+      std::numeric_limits<katana::GraphTopology::Node>::max()) {
+    *wide_topology = std::move(map_result.value());
+    return katana::ResultSuccess();
+  }
+
+  auto narrow_result = NarrowTopology(map_result.value());
+  if (!narrow_result) {
+    return narrow_result.error();
+  }
+  *topology = std::move(narrow_result.value());
+
+  // The compact copy no longer aliases storage; the next store writes it out
+  // as a version 1 file.
+  return rdg->UnbindTopologyFileStorage();
+}
+
+/// MapInTopology takes a file buffer of an in-edge topology file and extracts
+/// the in-edge topology.
+///
+/// An in-edge topology file is a topology file (see MapTopology) of the
+/// transposed graph whose edge data is the uint64_t id of the out-edge that
+/// each in-edge mirrors.
+katana::Result<katana::InEdgeTopology>
+MapInTopology(const tsuba::FileView& file_view) {
+  const auto* data = file_view.ptr<uint64_t>();
+  if (file_view.size() < 4 * sizeof(uint64_t)) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  if (data[0] != 1 || data[1] != sizeof(uint64_t)) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  uint64_t num_nodes = data[2];
+  uint64_t num_edges = data[3];
+
+  uint64_t padded_num_edges = num_edges + (num_edges % 2);
+  uint64_t expected_size = GetGraphSize(num_nodes, padded_num_edges) +
+                           num_edges * sizeof(uint64_t);
+
+  if (file_view.size() < expected_size) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  auto* in_indices = const_cast<uint64_t*>(&data[4]);
+  auto* in_sources = reinterpret_cast<uint32_t*>(in_indices + num_nodes);
+  auto* in_edge_ids =
+      reinterpret_cast<uint64_t*>(in_sources + padded_num_edges);
+
+  auto indices_buffer = std::make_shared<arrow::MutableBuffer>(
+      reinterpret_cast<uint8_t*>(in_indices), num_nodes * sizeof(uint64_t));
+  auto sources_buffer = std::make_shared<arrow::MutableBuffer>(
+      reinterpret_cast<uint8_t*>(in_sources), num_edges * sizeof(uint32_t));
+  auto edge_ids_buffer = std::make_shared<arrow::MutableBuffer>(
+      reinterpret_cast<uint8_t*>(in_edge_ids), num_edges * sizeof(uint64_t));
+
+  return katana::InEdgeTopology{
+      .in_indices =
+          std::make_shared<arrow::UInt64Array>(num_nodes, indices_buffer),
+      .in_sources =
+          std::make_shared<arrow::UInt32Array>(num_edges, sources_buffer),
+      .in_edge_ids =
+          std::make_shared<arrow::UInt64Array>(num_edges, edge_ids_buffer),
+  };
+}
+
+katana::Result<void>
+LoadInTopology(
+    katana::InEdgeTopology* in_topology,
+    const tsuba::FileView& in_topology_file_storage) {
+  auto map_result = MapInTopology(in_topology_file_storage);
+  if (!map_result) {
+    return map_result.error();
+  }
+  *in_topology = std::move(map_result.value());
+
+  return katana::ResultSuccess();
+}
+
+template <typename ArrayType>
+katana::Result<void>
+WriteArray(const ArrayType& array, tsuba::FileFrame* ff) {
+  if (array.length() == 0) {
+    return katana::ResultSuccess();
+  }
+  const auto* raw = array.raw_values();
+  auto buf = std::make_shared<arrow::Buffer>(
+      reinterpret_cast<const uint8_t*>(raw), array.length() * sizeof(*raw));
+  arrow::Status aro_sts = ff->Write(buf);
+  if (!aro_sts.ok()) {
+    return tsuba::ArrowToTsuba(aro_sts.code());
+  }
   return katana::ResultSuccess();
 }
 
 katana::Result<std::unique_ptr<tsuba::FileFrame>>
-WriteTopology(const katana::GraphTopology& topology) {
+WriteInTopology(const katana::InEdgeTopology& in_topology) {
+  auto ff = std::make_unique<tsuba::FileFrame>();
+  if (auto res = ff->Init(); !res) {
+    return res.error();
+  }
+  uint64_t num_nodes = in_topology.num_nodes();
+  uint64_t num_edges = in_topology.num_edges();
+
+  uint64_t data[4] = {1, sizeof(uint64_t), num_nodes, num_edges};
+  arrow::Status aro_sts = ff->Write(&data, 4 * sizeof(uint64_t));
+  if (!aro_sts.ok()) {
+    return tsuba::ArrowToTsuba(aro_sts.code());
+  }
+
+  if (auto res = WriteArray(*in_topology.in_indices, ff.get()); !res) {
+    return res.error();
+  }
+  if (auto res = WriteArray(*in_topology.in_sources, ff.get()); !res) {
+    return res.error();
+  }
+  if (num_edges % 2) {
+    uint32_t padding = 0;
+    aro_sts = ff->Write(&padding, sizeof(padding));
+    if (!aro_sts.ok()) {
+      return tsuba::ArrowToTsuba(aro_sts.code());
+    }
+  }
+  if (auto res = WriteArray(*in_topology.in_edge_ids, ff.get()); !res) {
+    return res.error();
+  }
+  return std::unique_ptr<tsuba::FileFrame>(std::move(ff));
+}
+
+template <typename NodeIdTy>
+katana::Result<std::unique_ptr<tsuba::FileFrame>>
+WriteTopology(const katana::BasicGraphTopology<NodeIdTy>& topology) {
   auto ff = std::make_unique<tsuba::FileFrame>();
   if (auto res = ff->Init(); !res) {
     return res.error();
@@ -99,31 +299,21 @@ WriteTopology(const katana::GraphTopology& topology) {
   uint64_t num_nodes = topology.num_nodes();
   uint64_t num_edges = topology.num_edges();
 
-  uint64_t data[4] = {1, 0, num_nodes, num_edges};
+  uint64_t data[4] = {kTopologyVersion<NodeIdTy>, 0, num_nodes, num_edges};
   arrow::Status aro_sts = ff->Write(&data, 4 * sizeof(uint64_t));
   if (!aro_sts.ok()) {
     return tsuba::ArrowToTsuba(aro_sts.code());
   }
 
   if (num_nodes) {
-    const auto* raw = topology.out_indices->raw_values();
-    static_assert(std::is_same_v<std::decay_t<decltype(*raw)>, uint64_t>);
-    auto buf = std::make_shared<arrow::Buffer>(
-        reinterpret_cast<const uint8_t*>(raw), num_nodes * sizeof(uint64_t));
-    aro_sts = ff->Write(buf);
-    if (!aro_sts.ok()) {
-      return tsuba::ArrowToTsuba(aro_sts.code());
+    if (auto res = WriteArray(*topology.out_indices, ff.get()); !res) {
+      return res.error();
     }
   }
 
   if (num_edges) {
-    const auto* raw = topology.out_dests->raw_values();
-    static_assert(std::is_same_v<std::decay_t<decltype(*raw)>, uint32_t>);
-    auto buf = std::make_shared<arrow::Buffer>(
-        reinterpret_cast<const uint8_t*>(raw), num_edges * sizeof(uint32_t));
-    aro_sts = ff->Write(buf);
-    if (!aro_sts.ok()) {
-      return tsuba::ArrowToTsuba(aro_sts.code());
+    if (auto res = WriteArray(*topology.out_dests, ff.get()); !res) {
+      return res.error();
     }
   }
   return std::unique_ptr<tsuba::FileFrame>(std::move(ff));
@@ -170,15 +360,26 @@ katana::PropertyGraph::Validate() {
 katana::Result<void>
 katana::PropertyGraph::DoWrite(
     tsuba::RDGHandle handle, const std::string& command_line) {
+  std::unique_ptr<tsuba::FileFrame> in_ff;
+  if (has_in_edges() && !rdg_.in_topology_file_storage().Valid()) {
+    auto result = WriteInTopology(in_topology_);
+    if (!result) {
+      return result.error();
+    }
+    in_ff = std::move(result.value());
+  }
+
   if (!rdg_.topology_file_storage().Valid()) {
-    auto result = WriteTopology(topology_);
+    auto result = has_wide_node_ids() ? WriteTopology(wide_topology_)
+                                      : WriteTopology(topology_);
     if (!result) {
       return result.error();
     }
-    return rdg_.Store(handle, command_line, std::move(result.value()));
+    return rdg_.Store(
+        handle, command_line, std::move(result.value()), std::move(in_ff));
   }
 
-  return rdg_.Store(handle, command_line);
+  return rdg_.Store(handle, command_line, nullptr, std::move(in_ff));
 }
 
 katana::Result<std::unique_ptr<katana::PropertyGraph>>
@@ -188,11 +389,19 @@ katana::PropertyGraph::Make(
       new PropertyGraph(std::move(rdg_file), std::move(rdg)));
 
   auto load_result =
-      LoadTopology(&g->topology_, g->rdg_.topology_file_storage());
+      LoadTopology(&g->topology_, &g->wide_topology_, &g->rdg_);
   if (!load_result) {
     return load_result.error();
   }
 
+  if (g->rdg_.in_topology_file_storage().Valid()) {
+    auto in_load_result =
+        LoadInTopology(&g->in_topology_, g->rdg_.in_topology_file_storage());
+    if (!in_load_result) {
+      return in_load_result.error();
+    }
+  }
+
   if (auto good = g->Validate(); !good) {
     return good.error();
   }
@@ -279,7 +488,12 @@ katana::PropertyGraph::Commit(const std::string& command_line) {
 
 bool
 katana::PropertyGraph::Equals(const PropertyGraph* other) const {
-  if (!topology().Equals(other->topology())) {
+  if (has_wide_node_ids() != other->has_wide_node_ids()) {
+    return false;
+  }
+  if (has_wide_node_ids()
+          ? !wide_topology().Equals(other->wide_topology())
+          : !topology().Equals(other->topology())) {
     return false;
   }
   const auto& node_props = rdg_.node_properties();
@@ -319,11 +533,10 @@ katana::PropertyGraph::Write(
 katana::Result<void>
 katana::PropertyGraph::AddNodeProperties(
     const std::shared_ptr<arrow::Table>& props) {
-  if (topology_.out_indices &&
-      topology_.out_indices->length() != props->num_rows()) {
+  if ((topology_.out_indices || wide_topology_.out_indices) &&
+      num_nodes() != static_cast<uint64_t>(props->num_rows())) {
     KATANA_LOG_DEBUG(
-        "expected {} rows found {} instead", topology_.out_indices->length(),
-        props->num_rows());
+        "expected {} rows found {} instead", num_nodes(), props->num_rows());
     return ErrorCode::InvalidArgument;
   }
   return rdg_.AddNodeProperties(props);
@@ -347,11 +560,10 @@ katana::PropertyGraph::RemoveNodeProperty(const std::string& prop_name) {
 katana::Result<void>
 katana::PropertyGraph::AddEdgeProperties(
     const std::shared_ptr<arrow::Table>& props) {
-  if (topology_.out_dests &&
-      topology_.out_dests->length() != props->num_rows()) {
+  if ((topology_.out_dests || wide_topology_.out_dests) &&
+      num_edges() != static_cast<uint64_t>(props->num_rows())) {
     KATANA_LOG_DEBUG(
-        "expected {} rows found {} instead", topology_.out_dests->length(),
-        props->num_rows());
+        "expected {} rows found {} instead", num_edges(), props->num_rows());
     return ErrorCode::InvalidArgument;
   }
   return rdg_.AddEdgeProperties(props);
@@ -378,12 +590,134 @@ katana::PropertyGraph::SetTopology(const katana::GraphTopology& topology) {
     return res.error();
   }
   topology_ = topology;
+  wide_topology_ = WideGraphTopology{};
+
+  return DropInEdges();
+}
+
+katana::Result<void>
+katana::PropertyGraph::SetTopology(const katana::WideGraphTopology& topology) {
+  if (auto res = rdg_.UnbindTopologyFileStorage(); !res) {
+    return res.error();
+  }
+  topology_ = GraphTopology{};
+  wide_topology_ = topology;
+
+  return DropInEdges();
+}
+
+katana::Result<void>
+katana::PropertyGraph::DropInEdges() {
+  in_topology_ = InEdgeTopology{};
+  return rdg_.DropInTopologyFile();
+}
+
+katana::Result<void>
+katana::PropertyGraph::BuildInEdges() {
+  if (has_in_edges()) {
+    return katana::ResultSuccess();
+  }
+  if (has_wide_node_ids()) {
+    KATANA_LOG_DEBUG("in-edges of graphs with wide node ids are unsupported");
+    return ErrorCode::NotImplemented;
+  }
+
+  uint64_t num_nodes = topology_.num_nodes();
+  uint64_t num_edges = topology_.num_edges();
+
+  arrow::UInt64Builder indices_builder;
+  arrow::UInt32Builder sources_builder;
+  arrow::UInt64Builder edge_ids_builder;
+  if (!indices_builder.Resize(num_nodes).ok() ||
+      !sources_builder.Resize(num_edges).ok() ||
+      !edge_ids_builder.Resize(num_edges).ok()) {
+    return ErrorCode::ArrowError;
+  }
+  // See SortAllEdgesByDest for why writing through these pointers is fine.
+  uint64_t* in_indices = num_nodes ? &indices_builder[0] : nullptr;
+  uint32_t* in_sources = num_edges ? &sources_builder[0] : nullptr;
+  uint64_t* in_edge_ids = num_edges ? &edge_ids_builder[0] : nullptr;
+
+  const uint64_t* out_indices =
+      num_nodes ? topology_.out_indices->raw_values() : nullptr;
+  const uint32_t* out_dests =
+      num_edges ? topology_.out_dests->raw_values() : nullptr;
+
+  // Count in-degrees, then reuse the counts as the next free slot of each
+  // node's in-edges.
+  katana::LargeArray<uint64_t> slots;
+  slots.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { slots[n] = 0; }, katana::no_stats());
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_edges),
+      [&](uint64_t e) { __sync_fetch_and_add(&slots[out_dests[e]], 1); },
+      katana::no_stats());
+
+  katana::ParallelSTL::partial_sum(slots.begin(), slots.end(), in_indices);
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { slots[n] = n > 0 ? in_indices[n - 1] : 0; },
+      katana::no_stats());
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_edges),
+      [&](uint64_t e) {
+        uint64_t slot = __sync_fetch_and_add(&slots[out_dests[e]], 1);
+        in_edge_ids[slot] = e;
+      },
+      katana::no_stats());
+
+  // Slots were claimed in arbitrary order; sort each node's in-edges by
+  // out-edge id so the result is deterministic and sources are ascending.
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        uint64_t begin = n > 0 ? in_indices[n - 1] : 0;
+        uint64_t end = in_indices[n];
+        std::sort(in_edge_ids + begin, in_edge_ids + end);
+        for (uint64_t i = begin; i < end; ++i) {
+          in_sources[i] =
+              std::upper_bound(
+                  out_indices, out_indices + num_nodes, in_edge_ids[i]) -
+              out_indices;
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  if (!indices_builder.Advance(num_nodes).ok() ||
+      !sources_builder.Advance(num_edges).ok() ||
+      !edge_ids_builder.Advance(num_edges).ok()) {
+    return ErrorCode::ArrowError;
+  }
+
+  InEdgeTopology in_topology;
+  if (!indices_builder.Finish(&in_topology.in_indices).ok() ||
+      !sources_builder.Finish(&in_topology.in_sources).ok() ||
+      !edge_ids_builder.Finish(&in_topology.in_edge_ids).ok()) {
+    return ErrorCode::ArrowError;
+  }
+
+  if (auto res = rdg_.DropInTopologyFile(); !res) {
+    return res.error();
+  }
+  in_topology_ = std::move(in_topology);
 
   return katana::ResultSuccess();
 }
 
 katana::Result<std::shared_ptr<arrow::UInt64Array>>
 katana::SortAllEdgesByDest(katana::PropertyGraph* pg) {
+  if (pg->has_wide_node_ids()) {
+    return ErrorCode::NotImplemented;
+  }
+  if (auto res = pg->DropInEdges(); !res) {
+    return res.error();
+  }
+
   auto view_result_dests =
       katana::ConstructPropertyView<katana::UInt32Property>(
           pg->topology().out_dests.get());
@@ -465,6 +799,13 @@ katana::FindEdgeSortedByDest(
 
 katana::Result<void>
 katana::SortNodesByDegree(katana::PropertyGraph* pg) {
+  if (pg->has_wide_node_ids()) {
+    return ErrorCode::NotImplemented;
+  }
+  if (auto res = pg->DropInEdges(); !res) {
+    return res.error();
+  }
+
   uint64_t num_nodes = pg->topology().num_nodes();
   uint64_t num_edges = pg->topology().num_edges();
 
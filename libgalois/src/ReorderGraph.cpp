@@ -0,0 +1,477 @@
+#include "katana/ReorderGraph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <arrow/compute/api.h>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/LargeArray.h"
+#include "katana/Logging.h"
+#include "katana/Loops.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Timer.h"
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+/// The nodes of a graph in their new order, i.e., the old id of the node at
+/// each new id
+using NodeOrder = std::vector<Node>;
+
+constexpr unsigned kReorderChunkSize = 64;
+
+/// The values of array, or null if it is missing or empty
+template <typename ArrayPtr>
+auto
+RawValues(const ArrayPtr& array) -> decltype(array->raw_values()) {
+  return array && array->length() > 0 ? array->raw_values() : nullptr;
+}
+
+/// Plain views of the edges of a topology, out-edges or in-edges
+struct Edges {
+  const uint64_t* indices;
+  const uint32_t* dests;
+
+  uint64_t Begin(Node n) const { return n > 0 ? indices[n - 1] : 0; }
+  uint64_t End(Node n) const { return indices[n]; }
+  uint64_t Degree(Node n) const { return End(n) - Begin(n); }
+};
+
+/// Order the nodes by increasing rank(n), breaking ties by id
+template <typename RankFn>
+NodeOrder
+OrderByRank(uint64_t num_nodes, RankFn rank) {
+  using RankNodePair = std::pair<uint64_t, Node>;
+  std::vector<RankNodePair> pairs(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { pairs[n] = RankNodePair(rank(n), n); },
+      katana::no_stats());
+
+  katana::ParallelSTL::sort(pairs.begin(), pairs.end());
+
+  NodeOrder order(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t i) { order[i] = pairs[i].second; }, katana::no_stats());
+  return order;
+}
+
+NodeOrder
+DegreeSortOrder(const Edges& edges, uint64_t num_nodes) {
+  return OrderByRank(num_nodes, [&](Node n) {
+    return std::numeric_limits<uint64_t>::max() - edges.Degree(n);
+  });
+}
+
+/// Group 0 holds the degrees of at least 2^(num_groups - 2) times the
+/// average, each following group the degrees of half that, and the last
+/// group the degrees below the average.
+NodeOrder
+HubClusterOrder(const Edges& edges, uint64_t num_nodes, uint32_t num_groups) {
+  uint64_t num_edges = num_nodes > 0 ? edges.End(num_nodes - 1) : 0;
+  double average = num_nodes > 0 ? double(num_edges) / num_nodes : 0;
+  int64_t last_group = num_groups - 1;
+
+  return OrderByRank(num_nodes, [&](Node n) {
+    uint64_t degree = edges.Degree(n);
+    //! [average, 2 * average) is level 0
+    int64_t level = -1;
+    if (degree > 0 && degree >= average) {
+      level = std::floor(std::log2(degree / average));
+    }
+    return std::clamp<int64_t>(last_group - 1 - level, 0, last_group);
+  });
+}
+
+/**
+ * Cuthill-McKee visits the neighbors of each node in order of increasing
+ * degree, so the nodes of a BFS level are ordered by the position of the
+ * first node of the previous level that reaches them and then by degree.
+ * Each level is found and sorted in parallel; a node is claimed by the first
+ * of its parents with an atomic min.
+ */
+NodeOrder
+ReverseCuthillMcKeeOrder(const Edges& edges, uint64_t num_nodes) {
+  constexpr uint64_t kUnvisited = std::numeric_limits<uint64_t>::max();
+
+  //! Starting from a node of low degree keeps the levels narrow
+  NodeOrder by_degree = OrderByRank(
+      num_nodes, [&](Node n) { return edges.Degree(n); });
+
+  //! The position of the node that reached each node first
+  katana::LargeArray<std::atomic<uint64_t>> parent;
+  parent.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        parent[n].store(kUnvisited, std::memory_order_relaxed);
+      },
+      katana::no_stats());
+
+  NodeOrder order;
+  order.reserve(num_nodes);
+  katana::InsertBag<Node> reached;
+  size_t next_start = 0;
+
+  while (order.size() < num_nodes) {
+    while (parent[by_degree[next_start]].load(std::memory_order_relaxed) !=
+           kUnvisited) {
+      ++next_start;
+    }
+    Node start = by_degree[next_start];
+    parent[start].store(order.size(), std::memory_order_relaxed);
+    order.push_back(start);
+
+    size_t level_begin = order.size() - 1;
+    while (level_begin < order.size()) {
+      size_t level_end = order.size();
+
+      //! A node is in an earlier level or claimed by an earlier node of
+      //! this one if its parent precedes i
+      reached.clear();
+      katana::do_all(
+          katana::iterate(level_begin, level_end),
+          [&](size_t i) {
+            Node n = order[i];
+            for (uint64_t e = edges.Begin(n); e < edges.End(n); ++e) {
+              Node dest = edges.dests[e];
+              if (parent[dest].load(std::memory_order_relaxed) > i &&
+                  katana::atomicMin(parent[dest], uint64_t{i}) == kUnvisited) {
+                reached.push(dest);
+              }
+            }
+          },
+          katana::steal(), katana::chunk_size<kReorderChunkSize>(),
+          katana::loopname("ReorderCuthillMcKee"));
+
+      std::vector<Node> level(reached.begin(), reached.end());
+      katana::ParallelSTL::sort(
+          level.begin(), level.end(), [&](Node a, Node b) {
+            uint64_t parent_a = parent[a].load(std::memory_order_relaxed);
+            uint64_t parent_b = parent[b].load(std::memory_order_relaxed);
+            if (parent_a != parent_b) {
+              return parent_a < parent_b;
+            }
+            if (edges.Degree(a) != edges.Degree(b)) {
+              return edges.Degree(a) < edges.Degree(b);
+            }
+            return a < b;
+          });
+      order.insert(order.end(), level.begin(), level.end());
+      level_begin = level_end;
+    }
+  }
+
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+/**
+ * Place the nodes greedily: the score of an unplaced node counts its edges
+ * to and its in-neighbors shared with the last window_size placed nodes,
+ * and the next node has the highest score, or is the unplaced node of
+ * highest in-degree if no node scores.
+ *
+ * The heap holds an entry for every change of a score, and entries that no
+ * longer match the score of their node are skipped when popped.
+ */
+NodeOrder
+GorderOrder(
+    const Edges& out_edges, const Edges& in_edges, uint64_t num_nodes,
+    uint32_t window_size) {
+  uint64_t hub_degree = std::sqrt(double(num_nodes));
+
+  NodeOrder by_in_degree = OrderByRank(num_nodes, [&](Node n) {
+    return std::numeric_limits<uint64_t>::max() - in_edges.Degree(n);
+  });
+
+  katana::LargeArray<uint32_t> score;
+  katana::LargeArray<uint8_t> placed;
+  score.allocateInterleaved(num_nodes);
+  placed.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        score[n] = 0;
+        placed[n] = false;
+      },
+      katana::no_stats());
+
+  //! (score, complement of the node) so that ties pick the smaller node
+  using Entry = std::pair<uint32_t, Node>;
+  std::priority_queue<Entry> heap;
+  auto push = [&](Node n) { heap.emplace(score[n], ~n); };
+
+  auto rescore = [&](Node n, bool entering) {
+    auto bump = [&](Node u) {
+      if (placed[u]) {
+        return;
+      }
+      if (entering) {
+        ++score[u];
+      } else {
+        --score[u];
+      }
+      if (score[u] > 0) {
+        push(u);
+      }
+    };
+    for (uint64_t e = out_edges.Begin(n); e < out_edges.End(n); ++e) {
+      bump(out_edges.dests[e]);
+    }
+    for (uint64_t e = in_edges.Begin(n); e < in_edges.End(n); ++e) {
+      Node src = in_edges.dests[e];
+      bump(src);
+      if (out_edges.Degree(src) > hub_degree) {
+        continue;
+      }
+      for (uint64_t f = out_edges.Begin(src); f < out_edges.End(src); ++f) {
+        if (out_edges.dests[f] != n) {
+          bump(out_edges.dests[f]);
+        }
+      }
+    }
+  };
+
+  NodeOrder order;
+  order.reserve(num_nodes);
+  size_t next_start = 0;
+  for (uint64_t i = 0; i < num_nodes; ++i) {
+    //! Drop the stale entries once they dominate the heap
+    if (heap.size() > 4 * num_nodes) {
+      heap = {};
+      for (Node n = 0; n < num_nodes; ++n) {
+        if (!placed[n] && score[n] > 0) {
+          push(n);
+        }
+      }
+    }
+
+    bool found = false;
+    Node next = 0;
+    while (!heap.empty() && !found) {
+      auto [entry_score, complement] = heap.top();
+      heap.pop();
+      next = ~complement;
+      found = !placed[next] && score[next] == entry_score;
+    }
+    if (!found) {
+      while (placed[by_in_degree[next_start]]) {
+        ++next_start;
+      }
+      next = by_in_degree[next_start];
+    }
+
+    placed[next] = true;
+    order.push_back(next);
+    rescore(next, true);
+    if (i >= window_size) {
+      rescore(order[i - window_size], false);
+    }
+  }
+  return order;
+}
+
+/// Take the rows of each column of table in the order of ids
+katana::Result<std::shared_ptr<arrow::Table>>
+PermuteRows(
+    const std::shared_ptr<arrow::Table>& table,
+    const std::shared_ptr<arrow::UInt64Array>& ids) {
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  for (const auto& column : table->columns()) {
+    auto take_result = arrow::compute::Take(column, ids);
+    if (!take_result.ok()) {
+      KATANA_LOG_DEBUG("arrow error: {}", take_result.status());
+      return katana::ErrorCode::ArrowError;
+    }
+    columns.emplace_back(take_result.ValueOrDie().chunked_array());
+  }
+  return arrow::Table::Make(table->schema(), columns, ids->length());
+}
+
+/// Relabel the nodes of pg so that order[i] becomes node i, and permute the
+/// properties to match
+katana::Result<void>
+ApplyOrder(
+    katana::PropertyGraph* pg, const NodeOrder& order,
+    const std::string& original_id_property_name) {
+  uint64_t num_nodes = pg->num_nodes();
+  uint64_t num_edges = pg->num_edges();
+  Edges edges{
+      RawValues(pg->topology().out_indices),
+      RawValues(pg->topology().out_dests)};
+
+  std::vector<Node> new_id(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t i) { new_id[order[i]] = i; }, katana::no_stats());
+
+  arrow::UInt64Builder indices_builder;
+  arrow::UInt32Builder dests_builder;
+  arrow::UInt64Builder node_ids_builder;
+  arrow::UInt64Builder edge_ids_builder;
+  if (!indices_builder.Resize(num_nodes).ok() ||
+      !dests_builder.Resize(num_edges).ok() ||
+      !node_ids_builder.Resize(num_nodes).ok() ||
+      !edge_ids_builder.Resize(num_edges).ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  // See SortAllEdgesByDest for why writing through these pointers is fine.
+  uint64_t* indices = num_nodes ? &indices_builder[0] : nullptr;
+  uint32_t* dests = num_edges ? &dests_builder[0] : nullptr;
+  uint64_t* node_ids = num_nodes ? &node_ids_builder[0] : nullptr;
+  uint64_t* edge_ids = num_edges ? &edge_ids_builder[0] : nullptr;
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t i) {
+        indices[i] = edges.Degree(order[i]);
+        node_ids[i] = order[i];
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(indices, indices + num_nodes, indices);
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t i) {
+        uint64_t new_edge = i > 0 ? indices[i - 1] : 0;
+        Node old_node = order[i];
+        for (uint64_t e = edges.Begin(old_node); e < edges.End(old_node);
+             ++e, ++new_edge) {
+          dests[new_edge] = new_id[edges.dests[e]];
+          edge_ids[new_edge] = e;
+        }
+      },
+      katana::steal(), katana::no_stats(), katana::loopname("ReorderEdges"));
+
+  if (!indices_builder.Advance(num_nodes).ok() ||
+      !dests_builder.Advance(num_edges).ok() ||
+      !node_ids_builder.Advance(num_nodes).ok() ||
+      !edge_ids_builder.Advance(num_edges).ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+
+  katana::GraphTopology topology;
+  std::shared_ptr<arrow::UInt64Array> node_id_array;
+  std::shared_ptr<arrow::UInt64Array> edge_id_array;
+  if (!indices_builder.Finish(&topology.out_indices).ok() ||
+      !dests_builder.Finish(&topology.out_dests).ok() ||
+      !node_ids_builder.Finish(&node_id_array).ok() ||
+      !edge_ids_builder.Finish(&edge_id_array).ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+
+  auto node_result = PermuteRows(pg->node_properties(), node_id_array);
+  if (!node_result) {
+    return node_result.error();
+  }
+  std::shared_ptr<arrow::Table> node_properties = node_result.value();
+  if (!original_id_property_name.empty() &&
+      !node_properties->GetColumnByName(original_id_property_name)) {
+    auto add_result = node_properties->AddColumn(
+        node_properties->num_columns(),
+        arrow::field(original_id_property_name, arrow::uint64()),
+        std::make_shared<arrow::ChunkedArray>(node_id_array));
+    if (!add_result.ok()) {
+      KATANA_LOG_DEBUG("arrow error: {}", add_result.status());
+      return katana::ErrorCode::ArrowError;
+    }
+    node_properties = add_result.ValueOrDie();
+  }
+
+  auto edge_result = PermuteRows(pg->edge_properties(), edge_id_array);
+  if (!edge_result) {
+    return edge_result.error();
+  }
+  std::shared_ptr<arrow::Table> edge_properties = edge_result.value();
+
+  // Everything is computed; replace the topology and properties
+  if (auto result = pg->SetTopology(topology); !result) {
+    return result.error();
+  }
+  while (pg->GetNodePropertyNum() > 0) {
+    if (auto result = pg->RemoveNodeProperty(0); !result) {
+      return result.error();
+    }
+  }
+  while (pg->GetEdgePropertyNum() > 0) {
+    if (auto result = pg->RemoveEdgeProperty(0); !result) {
+      return result.error();
+    }
+  }
+  if (node_properties->num_columns() > 0) {
+    if (auto result = pg->AddNodeProperties(node_properties); !result) {
+      return result.error();
+    }
+  }
+  if (edge_properties->num_columns() > 0) {
+    if (auto result = pg->AddEdgeProperties(edge_properties); !result) {
+      return result.error();
+    }
+  }
+
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::ReorderGraph(
+    PropertyGraph* pg, const std::string& original_id_property_name,
+    ReorderPlan plan) {
+  if (pg->has_wide_node_ids()) {
+    return ErrorCode::NotImplemented;
+  }
+
+  uint64_t num_nodes = pg->num_nodes();
+  Edges out_edges{
+      RawValues(pg->topology().out_indices),
+      RawValues(pg->topology().out_dests)};
+
+  katana::StatTimer exec_time("ReorderGraph");
+  exec_time.start();
+
+  NodeOrder order;
+  switch (plan.algorithm()) {
+  case ReorderPlan::kDegreeSort:
+    order = DegreeSortOrder(out_edges, num_nodes);
+    break;
+  case ReorderPlan::kHubCluster:
+    if (plan.num_groups() == 0) {
+      return ErrorCode::InvalidArgument;
+    }
+    order = HubClusterOrder(out_edges, num_nodes, plan.num_groups());
+    break;
+  case ReorderPlan::kReverseCuthillMcKee:
+    order = ReverseCuthillMcKeeOrder(out_edges, num_nodes);
+    break;
+  case ReorderPlan::kGorder: {
+    if (plan.window_size() == 0) {
+      return ErrorCode::InvalidArgument;
+    }
+    if (auto result = pg->BuildInEdges(); !result) {
+      return result.error();
+    }
+    Edges in_edges{
+        RawValues(pg->in_topology().in_indices),
+        RawValues(pg->in_topology().in_sources)};
+    order = GorderOrder(out_edges, in_edges, num_nodes, plan.window_size());
+    break;
+  }
+  default:
+    return ErrorCode::InvalidArgument;
+  }
+
+  auto result = ApplyOrder(pg, order, original_id_property_name);
+  exec_time.stop();
+  return result;
+}
@@ -0,0 +1,261 @@
+#include "katana/SetIntersection.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define KATANA_SET_INTERSECTION_X86 1
+#endif
+
+#include "katana/Logging.h"
+
+namespace {
+
+/// Use galloping search when one set is this many times larger than the other
+constexpr uint64_t kGallopRatio = 32;
+
+uint64_t
+MergeScalar(
+    const uint32_t* a, uint64_t a_size, const uint32_t* b, uint64_t b_size) {
+  uint64_t count = 0;
+  uint64_t i = 0;
+  uint64_t j = 0;
+  while (i < a_size && j < b_size) {
+    uint32_t x = a[i];
+    uint32_t y = b[j];
+    count += x == y;
+    i += x <= y;
+    j += y <= x;
+  }
+  return count;
+}
+
+#if KATANA_SET_INTERSECTION_X86
+
+// Each block kernel compares a block of a with every rotation of a block of
+// b, counts the lanes of a that matched and then advances past whichever
+// block ends first (or both). Because the sets have no duplicates, a value
+// that matched can never match again.
+
+uint64_t
+MergeSSE2(
+    const uint32_t* a, uint64_t a_size, const uint32_t* b, uint64_t b_size) {
+  constexpr uint64_t kWidth = 4;
+  uint64_t count = 0;
+  uint64_t i = 0;
+  uint64_t j = 0;
+  while (i + kWidth <= a_size && j + kWidth <= b_size) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+    __m128i m0 = _mm_cmpeq_epi32(va, vb);
+    __m128i m1 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x39));
+    __m128i m2 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x4e));
+    __m128i m3 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x93));
+    __m128i m = _mm_or_si128(_mm_or_si128(m0, m1), _mm_or_si128(m2, m3));
+    count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(m)));
+
+    uint32_t a_last = a[i + kWidth - 1];
+    uint32_t b_last = b[j + kWidth - 1];
+    i += a_last <= b_last ? kWidth : 0;
+    j += b_last <= a_last ? kWidth : 0;
+  }
+  return count + MergeScalar(a + i, a_size - i, b + j, b_size - j);
+}
+
+__attribute__((target("avx2"))) uint64_t
+MergeAVX2(
+    const uint32_t* a, uint64_t a_size, const uint32_t* b, uint64_t b_size) {
+  constexpr uint64_t kWidth = 8;
+  const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+  uint64_t count = 0;
+  uint64_t i = 0;
+  uint64_t j = 0;
+  while (i + kWidth <= a_size && j + kWidth <= b_size) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+    __m256i m = _mm256_cmpeq_epi32(va, vb);
+    for (uint64_t r = 1; r < kWidth; ++r) {
+      vb = _mm256_permutevar8x32_epi32(vb, rotate);
+      m = _mm256_or_si256(m, _mm256_cmpeq_epi32(va, vb));
+    }
+    count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+
+    uint32_t a_last = a[i + kWidth - 1];
+    uint32_t b_last = b[j + kWidth - 1];
+    i += a_last <= b_last ? kWidth : 0;
+    j += b_last <= a_last ? kWidth : 0;
+  }
+  return count + MergeSSE2(a + i, a_size - i, b + j, b_size - j);
+}
+
+__attribute__((target("avx512f"))) uint64_t
+MergeAVX512(
+    const uint32_t* a, uint64_t a_size, const uint32_t* b, uint64_t b_size) {
+  constexpr uint64_t kWidth = 16;
+  const __m512i rotate = _mm512_setr_epi32(
+      1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0);
+  uint64_t count = 0;
+  uint64_t i = 0;
+  uint64_t j = 0;
+  while (i + kWidth <= a_size && j + kWidth <= b_size) {
+    __m512i va = _mm512_loadu_si512(a + i);
+    __m512i vb = _mm512_loadu_si512(b + j);
+    __mmask16 m = _mm512_cmpeq_epi32_mask(va, vb);
+    for (uint64_t r = 1; r < kWidth; ++r) {
+      vb = _mm512_permutexvar_epi32(rotate, vb);
+      m |= _mm512_cmpeq_epi32_mask(va, vb);
+    }
+    count += __builtin_popcount(m);
+
+    uint32_t a_last = a[i + kWidth - 1];
+    uint32_t b_last = b[j + kWidth - 1];
+    i += a_last <= b_last ? kWidth : 0;
+    j += b_last <= a_last ? kWidth : 0;
+  }
+  return count + MergeAVX2(a + i, a_size - i, b + j, b_size - j);
+}
+
+#endif
+
+using MergeFn =
+    uint64_t (*)(const uint32_t*, uint64_t, const uint32_t*, uint64_t);
+
+MergeFn
+GetMergeFn(katana::SimdLevel level) {
+  switch (level) {
+#if KATANA_SET_INTERSECTION_X86
+  case katana::SimdLevel::kAVX512:
+    return MergeAVX512;
+  case katana::SimdLevel::kAVX2:
+    return MergeAVX2;
+  case katana::SimdLevel::kSSE2:
+    return MergeSSE2;
+#endif
+  default:
+    return MergeScalar;
+  }
+}
+
+katana::SimdLevel
+DetectSimdLevel() {
+#if KATANA_SET_INTERSECTION_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return katana::SimdLevel::kAVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return katana::SimdLevel::kAVX2;
+  }
+  return katana::SimdLevel::kSSE2;
+#else
+  return katana::SimdLevel::kScalar;
+#endif
+}
+
+const MergeFn kBestMerge = GetMergeFn(katana::GetSimdLevel());
+
+}  // namespace
+
+katana::SimdLevel
+katana::GetSimdLevel() {
+  static const SimdLevel level = DetectSimdLevel();
+  return level;
+}
+
+const char*
+katana::SimdLevelName(SimdLevel level) {
+  switch (level) {
+  case SimdLevel::kScalar:
+    return "scalar";
+  case SimdLevel::kSSE2:
+    return "sse2";
+  case SimdLevel::kAVX2:
+    return "avx2";
+  case SimdLevel::kAVX512:
+    return "avx512";
+  default:
+    return "unknown";
+  }
+}
+
+uint64_t
+katana::CountIntersectionGallop(
+    const uint32_t* a, uint64_t a_size, const uint32_t* b, uint64_t b_size) {
+  uint64_t count = 0;
+  uint64_t j = 0;
+  for (uint64_t i = 0; i < a_size && j < b_size; ++i) {
+    uint32_t x = a[i];
+    // Find a bound on the first value of b not less than x by doubling the
+    // step from the last position and then binary search within it
+    uint64_t hi = j;
+    uint64_t step = 1;
+    while (hi < b_size && b[hi] < x) {
+      j = hi + 1;
+      hi += step;
+      step <<= 1;
+    }
+    j = std::lower_bound(b + j, b + std::min(hi, b_size), x) - b;
+    if (j < b_size && b[j] == x) {
+      ++count;
+      ++j;
+    }
+  }
+  return count;
+}
+
+uint64_t
+katana::CountIntersectionMerge(
+    const uint32_t* a, uint64_t a_size, const uint32_t* b, uint64_t b_size,
+    SimdLevel level) {
+  KATANA_LOG_DEBUG_ASSERT(level <= GetSimdLevel());
+  return GetMergeFn(level)(a, a_size, b, b_size);
+}
+
+uint64_t
+katana::CountIntersection(
+    const uint32_t* a, uint64_t a_size, const uint32_t* b, uint64_t b_size) {
+  if (a_size > b_size) {
+    std::swap(a, b);
+    std::swap(a_size, b_size);
+  }
+  if (a_size == 0) {
+    return 0;
+  }
+  if (a_size * kGallopRatio < b_size) {
+    return CountIntersectionGallop(a, a_size, b, b_size);
+  }
+  return kBestMerge(a, a_size, b, b_size);
+}
+
+void
+katana::IntersectionBitmap::Assign(const uint32_t* values, uint64_t size) {
+  if (size == 0) {
+    num_bits_ = 0;
+    return;
+  }
+  first_ = values[0];
+  num_bits_ = uint64_t{values[size - 1]} - first_ + 1;
+  words_.assign((num_bits_ + 63) / 64, 0);
+  for (uint64_t i = 0; i < size; ++i) {
+    uint64_t bit = values[i] - first_;
+    words_[bit / 64] |= uint64_t{1} << (bit % 64);
+  }
+}
+
+uint64_t
+katana::IntersectionBitmap::CountIntersection(
+    const uint32_t* b, uint64_t b_size) const {
+  if (num_bits_ == 0) {
+    return 0;
+  }
+  const uint32_t* begin = std::lower_bound(b, b + b_size, first_);
+  uint64_t count = 0;
+  for (const uint32_t* it = begin; it != b + b_size; ++it) {
+    uint64_t bit = uint64_t{*it} - first_;
+    if (bit >= num_bits_) {
+      break;
+    }
+    count += (words_[bit / 64] >> (bit % 64)) & 1;
+  }
+  return count;
+}
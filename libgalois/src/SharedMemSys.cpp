@@ -19,10 +19,14 @@
 
 #include "katana/SharedMemSys.h"
 
+#include "katana/ArrowInterchange.h"
 #include "katana/CommBackend.h"
+#include "katana/Env.h"
 #include "katana/Logging.h"
+#include "katana/NumaArrowMemoryPool.h"
 #include "katana/SharedMem.h"
 #include "katana/Statistics.h"
+#include "katana/Tracing.h"
 #include "tsuba/FileStorage.h"
 #include "tsuba/tsuba.h"
 
@@ -35,6 +39,7 @@ katana::NullCommBackend comm_backend;
 struct katana::SharedMemSys::Impl {
   katana::SharedMem shared_mem;
   katana::StatManager stat_manager;
+  katana::NumaArrowMemoryPool* property_pool{nullptr};
 };
 
 katana::SharedMemSys::SharedMemSys() : impl_(std::make_unique<Impl>()) {
@@ -43,13 +48,39 @@ katana::SharedMemSys::SharedMemSys() : impl_(std::make_unique<Impl>()) {
   }
 
   katana::internal::setSysStatManager(&impl_->stat_manager);
+
+  bool use_numa_pool = true;
+  katana::GetEnv("KATANA_USE_NUMA_POOL", &use_numa_pool);
+  if (use_numa_pool) {
+    impl_->property_pool = katana::GetNumaArrowMemoryPool();
+    impl_->property_pool->Attach();
+    katana::SetPropertyMemoryPool(impl_->property_pool);
+  }
+
+  std::string trace_file;
+  if (katana::GetEnv("KATANA_TRACE_FILE", &trace_file) && !trace_file.empty()) {
+    katana::StartTracing(trace_file);
+  }
 }
 
 katana::SharedMemSys::~SharedMemSys() {
+  if (impl_->property_pool) {
+    katana::SetPropertyMemoryPool(nullptr);
+    impl_->property_pool->Detach();
+    impl_->property_pool->ReportStats("PropertyMemoryPool");
+  }
+
   katana::PrintStats();
   katana::internal::setSysStatManager(nullptr);
 
   if (auto fini_good = tsuba::Fini(); !fini_good) {
     KATANA_LOG_ERROR("tsuba::Fini: {}", fini_good.error());
   }
+
+  // After tsuba::Fini so that outstanding I/O is in the trace
+  if (katana::IsTracing()) {
+    if (auto res = katana::StopTracing(); !res) {
+      KATANA_LOG_ERROR("writing trace: {}", res.error());
+    }
+  }
 }
@@ -25,6 +25,7 @@
 #include "katana/Env.h"
 #include "katana/HWTopo.h"
 #include "katana/Logging.h"
+#include "katana/Tracing.h"
 
 // Forward declare this to avoid including PerThreadStorage.
 // We avoid this to stress that the thread Pool MUST NOT depend on PTS.
@@ -132,6 +133,7 @@ ThreadPool::initThread(unsigned tid) {
   my_box.topo = getHWTopo().threadTopoInfo[tid];
   // Initialize
   initPTS(mi.maxThreads);
+  katana::SetTraceThreadName(fmt::format("katana thread {}", tid));
 
   if (!GetEnv("KATANA_DO_NOT_BIND_THREADS")) {
     bool bind_main = false;
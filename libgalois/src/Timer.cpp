@@ -19,7 +19,10 @@
 
 #include "katana/Timer.h"
 
+#include <fmt/format.h>
+
 #include "katana/Statistics.h"
+#include "katana/Tracing.h"
 
 using namespace katana;
 
@@ -103,6 +106,9 @@ StatTimer::~StatTimer() {
 
 void
 StatTimer::start() {
+  if (katana::IsTracing()) {
+    trace_begin_ns_ = katana::TraceNow();
+  }
   TimeAccumulator::start();
   valid_ = true;
 }
@@ -111,6 +117,15 @@ void
 StatTimer::stop() {
   valid_ = false;
   TimeAccumulator::stop();
+  if (trace_begin_ns_ >= 0) {
+    // Loops time themselves with a "Time" timer named after the loop
+    std::string name = region_.c_str();
+    if (name_ != "Time") {
+      name = fmt::format("{}/{}", name, name_.c_str());
+    }
+    katana::TraceInterval("timer", name, trace_begin_ns_, katana::TraceNow());
+    trace_begin_ns_ = -1;
+  }
 }
 
 uint64_t
@@ -0,0 +1,453 @@
+#include <cmath>
+#include <memory>
+#include <random>
+
+#include <arrow/api.h>
+
+#include "betweenness_centrality_impl.h"
+#include "katana/AtomicHelpers.h"
+#include "katana/LargeArray.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+constexpr static const unsigned kApproximateChunkSize = 16u;
+
+/// Picks one shortest path uniformly at random between two nodes with a
+/// balanced bidirectional BFS: each step expands the side whose frontier has
+/// fewer edges to scan, which in small-world graphs touches far fewer edges
+/// than a BFS from one side.
+class PathSampler {
+  /// The BFS label of a node from one side
+  struct Label {
+    uint32_t dist;
+    double sigma;
+  };
+
+  /// The labels of the nodes one side visited in the current sample, in an
+  /// open addressing hash table. A sample only visits the neighborhoods of its
+  /// two endpoints, so this is much smaller than a label per node. Slots of an
+  /// earlier sample are stale and read as empty, so nothing is cleared
+  /// between samples.
+  class Labels {
+    struct Slot {
+      Node node;
+      uint32_t sample;
+      Label label;
+    };
+
+    static constexpr uint64_t kMinSlots = 64;
+
+    std::vector<Slot> slots_;
+    uint64_t size_{0};
+    uint32_t sample_{0};
+
+    uint64_t Probe(Node n) const {
+      uint64_t mask = slots_.size() - 1;
+      uint64_t i = katana::analytics::HashNodeId(n) & mask;
+      while (slots_[i].sample == sample_ && slots_[i].node != n) {
+        i = (i + 1) & mask;
+      }
+      return i;
+    }
+
+    void Grow() {
+      std::vector<Slot> old(std::max(kMinSlots, 2 * slots_.size()));
+      std::swap(slots_, old);
+      for (const Slot& slot : old) {
+        if (slot.sample == sample_) {
+          slots_[Probe(slot.node)] = slot;
+        }
+      }
+    }
+
+  public:
+    /// Forget every label. Sample 0 marks empty slots.
+    void Reset(uint32_t sample) {
+      if (sample == 1) {
+        std::fill(slots_.begin(), slots_.end(), Slot{0, 0, Label{0, 0}});
+      }
+      sample_ = sample;
+      size_ = 0;
+    }
+
+    const Label* Find(Node n) const {
+      if (slots_.empty()) {
+        return nullptr;
+      }
+      const Slot& slot = slots_[Probe(n)];
+      return slot.sample == sample_ ? &slot.label : nullptr;
+    }
+
+    /// The label of n, inserting label if n has none. Returns whether it was
+    /// inserted. Inserting invalidates the labels returned before.
+    std::pair<Label*, bool> Insert(Node n, Label label) {
+      if (2 * (size_ + 1) > slots_.size()) {
+        Grow();
+      }
+      Slot& slot = slots_[Probe(n)];
+      if (slot.sample == sample_) {
+        return {&slot.label, false};
+      }
+      slot = Slot{n, sample_, label};
+      ++size_;
+      return {&slot.label, true};
+    }
+  };
+
+  /// One side of the bidirectional BFS. The source side follows out-edges,
+  /// the target side in-edges.
+  struct Side {
+    const uint64_t* indices;
+    const uint32_t* neighbors;
+    //! The edges in the opposite direction, to walk back to the source
+    const uint64_t* reverse_indices;
+    const uint32_t* reverse_neighbors;
+    Labels labels;
+    std::vector<Node> frontier;
+    std::vector<Node> next;
+
+    bool Visited(Node n) const { return labels.Find(n) != nullptr; }
+
+    const Label& GetLabel(Node n) const {
+      const Label* label = labels.Find(n);
+      KATANA_LOG_DEBUG_ASSERT(label);
+      return *label;
+    }
+
+    std::pair<uint64_t, uint64_t> Edges(Node n) const {
+      return {n > 0 ? indices[n - 1] : 0, indices[n]};
+    }
+
+    std::pair<uint64_t, uint64_t> ReverseEdges(Node n) const {
+      return {n > 0 ? reverse_indices[n - 1] : 0, reverse_indices[n]};
+    }
+
+    uint64_t FrontierEdges() const {
+      uint64_t edges = 0;
+      for (Node n : frontier) {
+        auto [begin, end] = Edges(n);
+        edges += end - begin;
+      }
+      return edges;
+    }
+
+    void Start(Node source, uint32_t sample) {
+      labels.Reset(sample);
+      labels.Insert(source, Label{0, 1});
+      frontier.assign(1, source);
+    }
+
+    /// Expand the frontier by one level. Return true if it reached a node
+    /// visited by other.
+    bool Expand(const Side& other) {
+      bool met = false;
+      next.clear();
+      for (Node n : frontier) {
+        // Copied because inserting may move the labels
+        Label label = GetLabel(n);
+        auto [begin, end] = Edges(n);
+        for (uint64_t e = begin; e < end; ++e) {
+          Node w = neighbors[e];
+          auto [w_label, inserted] =
+              labels.Insert(w, Label{label.dist + 1, label.sigma});
+          if (inserted) {
+            next.push_back(w);
+            met |= other.Visited(w);
+          } else if (w_label->dist == label.dist + 1) {
+            w_label->sigma += label.sigma;
+          }
+        }
+      }
+      std::swap(frontier, next);
+      return met;
+    }
+
+    /// Walk from n back to the source of this side, choosing each previous
+    /// node with probability proportional to its number of shortest paths,
+    /// and call fn on each node before the source.
+    template <typename Fn>
+    void WalkBack(Node n, std::mt19937_64* gen, Fn fn) const {
+      while (GetLabel(n).dist > 1) {
+        const Label& n_label = GetLabel(n);
+        double pick =
+            std::uniform_real_distribution<double>(0, n_label.sigma)(*gen);
+        auto [begin, end] = ReverseEdges(n);
+        Node previous = n;
+        for (uint64_t e = begin; e < end; ++e) {
+          Node p = reverse_neighbors[e];
+          const Label* p_label = labels.Find(p);
+          if (!p_label || p_label->dist + 1 != n_label.dist) {
+            continue;
+          }
+          previous = p;
+          pick -= p_label->sigma;
+          if (pick < 0) {
+            break;
+          }
+        }
+        KATANA_LOG_DEBUG_ASSERT(previous != n);
+        n = previous;
+        fn(n);
+      }
+    }
+  };
+
+  Side source_side_;
+  Side target_side_;
+  uint32_t sample_{0};
+  std::mt19937_64 gen_;
+
+public:
+  PathSampler(
+      const katana::GraphTopology& topology,
+      const katana::GraphTopology& in_topology, uint64_t seed)
+      : gen_(seed) {
+    const uint64_t* out_indices = topology.out_indices->raw_values();
+    const uint32_t* out_dests = topology.out_dests->raw_values();
+    const uint64_t* in_indices = in_topology.out_indices->raw_values();
+    const uint32_t* in_sources = in_topology.out_dests->raw_values();
+    source_side_ = Side{out_indices, out_dests, in_indices, in_sources};
+    target_side_ = Side{in_indices, in_sources, out_indices, out_dests};
+  }
+
+  std::mt19937_64& gen() { return gen_; }
+
+  /// Sample a shortest path from source to target, if there is one, and
+  /// call fn on each node strictly inside it.
+  template <typename Fn>
+  void Sample(Node source, Node target, Fn fn) {
+    // Sample 0 marks empty slots
+    if (++sample_ == 0) {
+      sample_ = 1;
+    }
+
+    source_side_.Start(source, sample_);
+    target_side_.Start(target, sample_);
+
+    Side* met_side = nullptr;
+    while (!source_side_.frontier.empty() && !target_side_.frontier.empty()) {
+      Side* side = &source_side_;
+      Side* other = &target_side_;
+      if (target_side_.FrontierEdges() < source_side_.FrontierEdges()) {
+        std::swap(side, other);
+      }
+      if (side->Expand(*other)) {
+        met_side = side;
+        break;
+      }
+    }
+    if (!met_side) {
+      return;
+    }
+
+    // Every shortest path crosses the new frontier of met_side at exactly
+    // one node, which the other side reached on its last level
+    const Side& other = met_side == &source_side_ ? target_side_ : source_side_;
+    double num_paths = 0;
+    for (Node n : met_side->frontier) {
+      if (other.Visited(n)) {
+        num_paths += met_side->GetLabel(n).sigma * other.GetLabel(n).sigma;
+      }
+    }
+
+    double pick = std::uniform_real_distribution<double>(0, num_paths)(gen_);
+    Node middle = met_side->frontier.back();
+    for (Node n : met_side->frontier) {
+      if (!other.Visited(n)) {
+        continue;
+      }
+      middle = n;
+      pick -= met_side->GetLabel(n).sigma * other.GetLabel(n).sigma;
+      if (pick < 0) {
+        break;
+      }
+    }
+
+    if (middle != source && middle != target) {
+      fn(middle);
+    }
+    source_side_.WalkBack(middle, &gen_, fn);
+    target_side_.WalkBack(middle, &gen_, fn);
+  }
+};
+
+/// An upper bound on the number of nodes in a shortest path (the vertex
+/// diameter), from a BFS that ignores edge directions. Within the component
+/// of the start node it is twice its eccentricity plus one, and every other
+/// component has at most as many nodes as were not reached. This is a true
+/// bound for symmetric graphs but only an estimate for directed ones, where a
+/// shortest path can be longer than the undirected distance.
+uint64_t
+EstimateVertexDiameter(
+    const katana::GraphTopology& topology,
+    const katana::GraphTopology& in_topology) {
+  uint64_t num_nodes = topology.num_nodes();
+  if (num_nodes == 0) {
+    return 0;
+  }
+
+  // Start from the node of largest degree, which is likely central
+  auto degree = [&](Node n) {
+    auto [begin, end] = topology.edge_range(n);
+    return end - begin;
+  };
+  Node start = 0;
+  for (Node n = 1; n < num_nodes; ++n) {
+    if (degree(n) > degree(start)) {
+      start = n;
+    }
+  }
+
+  std::vector<bool> visited(num_nodes);
+  std::vector<Node> frontier{start};
+  std::vector<Node> next;
+  auto visit_edges = [&](const katana::GraphTopology& edges, Node n) {
+    const uint32_t* dests = edges.out_dests->raw_values();
+    auto [begin, end] = edges.edge_range(n);
+    for (uint64_t e = begin; e < end; ++e) {
+      if (!visited[dests[e]]) {
+        visited[dests[e]] = true;
+        next.push_back(dests[e]);
+      }
+    }
+  };
+
+  visited[start] = true;
+  uint64_t eccentricity = 0;
+  uint64_t reached = 1;
+  while (true) {
+    next.clear();
+    for (Node n : frontier) {
+      visit_edges(topology, n);
+      visit_edges(in_topology, n);
+    }
+    if (next.empty()) {
+      break;
+    }
+    reached += next.size();
+    ++eccentricity;
+    std::swap(frontier, next);
+  }
+
+  return std::min(
+      num_nodes, std::max(2 * eccentricity + 1, num_nodes - reached));
+}
+
+/// The number of samples for an error of at most epsilon with probability
+/// at least 1 - delta
+uint64_t
+NumSamples(uint64_t vertex_diameter, double epsilon, double delta) {
+  // The sample size of Riondato and Kornaropoulos with their constant c = 0.5.
+  // The VC dimension of shortest paths is at most floor(log2(VD - 2)) + 1.
+  double vc_dimension = 1;
+  if (vertex_diameter > 3) {
+    vc_dimension += std::floor(std::log2(vertex_diameter - 2));
+  }
+  constexpr double kC = 0.5;
+  return std::ceil(
+      kC / (epsilon * epsilon) * (vc_dimension + std::log(1 / delta)));
+}
+
+}  // namespace
+
+katana::Result<void>
+BetweennessCentralityApproximate(
+    katana::PropertyGraph* pg,
+    katana::analytics::BetweennessCentralitySources sources [[maybe_unused]],
+    const std::string& output_property_name,
+    katana::analytics::BetweennessCentralityPlan plan) {
+  if (!(plan.epsilon() > 0 && plan.epsilon() < 1) ||
+      !(plan.delta() > 0 && plan.delta() < 1)) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  katana::ReportStatSingle(
+      "BetweennessCentrality", "ChunkSize", kApproximateChunkSize);
+
+  if (auto r = pg->BuildInEdges(); !r) {
+    return r.error();
+  }
+  // The in-edges in the same layout as the out-edges
+  katana::GraphTopology in_topology{
+      .out_indices = pg->in_topology().in_indices,
+      .out_dests = pg->in_topology().in_sources};
+
+  const katana::GraphTopology& topology = pg->topology();
+  uint64_t num_nodes = topology.num_nodes();
+
+  uint64_t vertex_diameter = EstimateVertexDiameter(topology, in_topology);
+  uint64_t num_samples =
+      num_nodes < 2
+          ? 0
+          : NumSamples(vertex_diameter, plan.epsilon(), plan.delta());
+  katana::ReportStatSingle(
+      "BetweennessCentrality", "VertexDiameter", vertex_diameter);
+  katana::ReportStatSingle("BetweennessCentrality", "Samples", num_samples);
+
+  katana::LargeArray<std::atomic<uint64_t>> counts;
+  counts.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(topology),
+      [&](Node n) { counts[n].store(0, std::memory_order_relaxed); },
+      katana::no_stats());
+
+  katana::PerThreadStorage<std::unique_ptr<PathSampler>> samplers;
+
+  katana::StatTimer exec_time("Approximate", "BetweennessCentrality");
+  exec_time.start();
+  katana::on_each([&](unsigned tid, unsigned) {
+    *samplers.getLocal() =
+        std::make_unique<PathSampler>(topology, in_topology, tid);
+  });
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_samples),
+      [&](uint64_t) {
+        PathSampler& sampler = **samplers.getLocal();
+        std::uniform_int_distribution<Node> pick_node(0, num_nodes - 1);
+        Node source = pick_node(sampler.gen());
+        Node target = pick_node(sampler.gen());
+        while (target == source) {
+          target = pick_node(sampler.gen());
+        }
+        sampler.Sample(source, target, [&](Node n) {
+          katana::atomicAdd(counts[n], uint64_t{1});
+        });
+      },
+      katana::steal(), katana::chunk_size<kApproximateChunkSize>(),
+      katana::loopname("BetweennessCentralityApproximate"));
+  katana::on_each([&](unsigned, unsigned) { samplers.getLocal()->reset(); });
+  exec_time.stop();
+
+  // Scale the fraction of sampled paths through a node to the number of
+  // ordered pairs, which is what the exact algorithms compute
+  double scale = num_samples == 0
+                     ? 0
+                     : double(num_nodes) * (num_nodes - 1) / num_samples;
+  arrow::FloatBuilder builder;
+  if (auto r = builder.Resize(num_nodes); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  for (Node n = 0; n < num_nodes; ++n) {
+    builder.UnsafeAppend(counts[n].load(std::memory_order_relaxed) * scale);
+  }
+  std::shared_ptr<arrow::FloatArray> values;
+  if (auto r = builder.Finish(&values); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+
+  auto metadata = arrow::key_value_metadata(
+      {kBetweennessCentralityNumSamplesKey}, {std::to_string(num_samples)});
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field(
+          output_property_name, arrow::float32(), true, metadata)}),
+      {values});
+  if (auto r = pg->AddNodeProperties(table); !r) {
+    return r.error();
+  }
+
+  return katana::ResultSuccess();
+}
@@ -41,6 +41,12 @@ katana::analytics::BetweennessCentrality(
     return BetweennessCentralityLevel(pg, sources, output_property_name, plan);
   case BetweennessCentralityPlan::kOuter:
     return BetweennessCentralityOuter(pg, sources, output_property_name, plan);
+  case BetweennessCentralityPlan::kMultiSource:
+    return BetweennessCentralityMultiSource(
+        pg, sources, output_property_name, plan);
+  case BetweennessCentralityPlan::kApproximate:
+    return BetweennessCentralityApproximate(
+        pg, sources, output_property_name, plan);
   default:
     return katana::ErrorCode::InvalidArgument;
   }
@@ -51,6 +57,9 @@ BetweennessCentralityStatistics::Print(std::ostream& os) {
   os << "Maximum centrality = " << max_centrality << std::endl;
   os << "Minimum centrality = " << min_centrality << std::endl;
   os << "Average centrality = " << average_centrality << std::endl;
+  if (num_samples > 0) {
+    os << "Number of samples = " << num_samples << std::endl;
+  }
 }
 
 katana::Result<BetweennessCentralityStatistics>
@@ -77,7 +86,17 @@ BetweennessCentralityStatistics::Compute(
       katana::no_stats(),
       katana::loopname("Betweenness Centrality Statistics"));
 
+  uint64_t num_samples = 0;
+  auto field = pg->node_schema()->GetFieldByName(output_property_name);
+  if (field && field->HasMetadata()) {
+    auto samples_result =
+        field->metadata()->Get(kBetweennessCentralityNumSamplesKey);
+    if (samples_result.ok()) {
+      num_samples = std::stoull(samples_result.ValueOrDie());
+    }
+  }
+
   return BetweennessCentralityStatistics{
       accum_max.reduce(), accum_min.reduce(),
-      accum_sum.reduce() / pg->num_nodes()};
+      accum_sum.reduce() / pg->num_nodes(), num_samples};
 }
@@ -4,6 +4,11 @@
 #include "katana/analytics/Utils.h"
 #include "katana/analytics/betweenness_centrality/betweenness_centrality.h"
 
+/// The key of the metadata of the output property that holds the number of
+/// sampled paths, which BetweennessCentralityStatistics reports
+constexpr const char* kBetweennessCentralityNumSamplesKey =
+    "katana.betweenness_centrality.num_samples";
+
 katana::Result<void> BetweennessCentralityOuter(
     katana::PropertyGraph* pg,
     katana::analytics::BetweennessCentralitySources sources,
@@ -16,4 +21,16 @@ katana::Result<void> BetweennessCentralityLevel(
     const std::string& output_property_name,
     katana::analytics::BetweennessCentralityPlan plan);
 
+katana::Result<void> BetweennessCentralityApproximate(
+    katana::PropertyGraph* pg,
+    katana::analytics::BetweennessCentralitySources sources,
+    const std::string& output_property_name,
+    katana::analytics::BetweennessCentralityPlan plan);
+
+katana::Result<void> BetweennessCentralityMultiSource(
+    katana::PropertyGraph* pg,
+    katana::analytics::BetweennessCentralitySources sources,
+    const std::string& output_property_name,
+    katana::analytics::BetweennessCentralityPlan plan);
+
 #endif
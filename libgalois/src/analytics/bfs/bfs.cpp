@@ -20,10 +20,13 @@
 #include "katana/analytics/bfs/bfs.h"
 
 #include <deque>
+#include <memory>
 #include <type_traits>
 
+#include "katana/DynamicBitset.h"
 #include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/BfsSsspImplementationBase.h"
+#include "katana/analytics/BitParallelBfs.h"
 
 using namespace katana::analytics;
 
@@ -246,6 +249,141 @@ SynchronousAlgo(
   }
 }
 
+template <typename WL>
+void
+WlToBitset(const WL& wl, katana::DynamicBitset* bitset) {
+  katana::do_all(
+      katana::iterate(wl), [&](const Graph::Node& src) { bitset->set(src); },
+      katana::steal(), katana::chunk_size<kChunkSize>(),
+      katana::loopname("WlToBitset"));
+}
+
+template <typename WL>
+void
+BitsetToWl(
+    const Graph& graph, const katana::DynamicBitset& bitset, WL* wl) {
+  wl->clear();
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Graph::Node& src) {
+        if (bitset.test(src)) {
+          wl->push(src);
+        }
+      },
+      katana::steal(), katana::chunk_size<kChunkSize>(),
+      katana::loopname("BitsetToWl"));
+}
+
+/// Direction-optimizing BFS (Beamer et al., SC 2012). Sparse frontiers are
+/// expanded top-down into a worklist; once the frontier's out-edges exceed
+/// 1/alpha of the unexplored edges, levels are computed bottom-up from a dense
+/// frontier bitset until the frontier shrinks below 1/beta of the nodes.
+/// Requires the in-edges of the graph.
+void
+DirectionOptimizingAlgo(
+    Graph* graph, Graph::Node source, uint32_t alpha, uint32_t beta) {
+  using Cont = katana::InsertBag<Graph::Node>;
+
+  const katana::PropertyGraph& pg = graph->GetPropertyGraph();
+
+  katana::DynamicBitset bitsets[2];
+  bitsets[0].resize(graph->num_nodes());
+  bitsets[1].resize(graph->num_nodes());
+  katana::DynamicBitset* front_bitset = &bitsets[0];
+  katana::DynamicBitset* next_bitset = &bitsets[1];
+
+  auto curr = std::make_unique<Cont>();
+  auto next = std::make_unique<Cont>();
+
+  Dist next_level = 0U;
+  graph->GetData<BfsNodeDistance>(source) = 0U;
+  next->push(source);
+
+  int64_t edges_to_check = graph->num_edges();
+  int64_t scout_count = std::distance(
+      graph->edge_begin(source), graph->edge_end(source));
+  uint64_t num_nodes = graph->num_nodes();
+
+  katana::GAccumulator<uint64_t> work_items;
+  uint64_t bottom_up_steps = 0;
+  uint64_t top_down_steps = 0;
+
+  while (!next->empty()) {
+    std::swap(curr, next);
+    next->clear();
+
+    if (scout_count > edges_to_check / alpha) {
+      WlToBitset(*curr, front_bitset);
+      uint64_t awake_count = std::distance(curr->begin(), curr->end());
+      uint64_t old_awake_count = 0;
+
+      do {
+        ++next_level;
+        ++bottom_up_steps;
+        old_awake_count = awake_count;
+        work_items.reset();
+
+        katana::do_all(
+            katana::iterate(*graph),
+            [&](const Graph::Node& dst) {
+              auto& ddata = graph->GetData<BfsNodeDistance>(dst);
+              if (ddata != BfsImplementation::kDistanceInfinity) {
+                return;
+              }
+              for (auto ie : pg.in_edges(dst)) {
+                if (front_bitset->test(*pg.GetInEdgeSource(ie))) {
+                  ddata = next_level;
+                  next_bitset->set(dst);
+                  work_items += 1;
+                  break;
+                }
+              }
+            },
+            katana::steal(), katana::chunk_size<kChunkSize>(),
+            katana::loopname("BottomUp"));
+
+        std::swap(front_bitset, next_bitset);
+        next_bitset->reset();
+        awake_count = work_items.reduce();
+      } while (awake_count >= old_awake_count ||
+               awake_count > num_nodes / beta);
+
+      BitsetToWl(*graph, *front_bitset, next.get());
+      front_bitset->reset();
+      scout_count = 1;
+    } else {
+      ++next_level;
+      ++top_down_steps;
+      edges_to_check -= scout_count;
+      work_items.reset();
+
+      katana::do_all(
+          katana::iterate(*curr),
+          [&](const Graph::Node& src) {
+            for (auto e : graph->edges(src)) {
+              auto dest = graph->GetEdgeDest(e);
+              auto& ddata = graph->GetData<BfsNodeDistance>(dest);
+              if (ddata == BfsImplementation::kDistanceInfinity &&
+                  __sync_bool_compare_and_swap(
+                      &ddata, BfsImplementation::kDistanceInfinity,
+                      next_level)) {
+                next->push(*dest);
+                work_items += std::distance(
+                    graph->edge_begin(*dest), graph->edge_end(*dest));
+              }
+            }
+          },
+          katana::steal(), katana::chunk_size<kChunkSize>(),
+          katana::loopname("TopDown"));
+
+      scout_count = work_items.reduce();
+    }
+  }
+
+  katana::ReportStatSingle("BFS", "TopDownSteps", top_down_steps);
+  katana::ReportStatSingle("BFS", "BottomUpSteps", bottom_up_steps);
+}
+
 template <bool CONCURRENT>
 void
 RunAlgo(BfsPlan algo, Graph* graph, const Graph::Node& source) {
@@ -267,6 +405,9 @@ RunAlgo(BfsPlan algo, Graph* graph, const Graph::Node& source) {
     SynchronousAlgo<CONCURRENT, Graph::Node>(
         graph, source, NodePushWrap(), OutEdgeRangeFn{graph});
     break;
+  case BfsPlan::kDirectionOptimizing:
+    DirectionOptimizingAlgo(graph, source, algo.alpha(), algo.beta());
+    break;
   default:
     std::cerr << "ERROR: unkown algo type\n";
   }
@@ -302,12 +443,87 @@ BfsImpl(
   return katana::ResultSuccess();
 }
 
+/// Call fn with the number of 64-bit words in the narrowest batch that holds
+/// num_sources searches, as a std::integral_constant.
+template <typename Fn>
+void
+WithBatchWords(size_t num_sources, Fn fn) {
+  static_assert(kBfsBatchMaxSources == 512);
+  if (num_sources <= 64) {
+    fn(std::integral_constant<size_t, 1>{});
+  } else if (num_sources <= 128) {
+    fn(std::integral_constant<size_t, 2>{});
+  } else if (num_sources <= 256) {
+    fn(std::integral_constant<size_t, 4>{});
+  } else {
+    fn(std::integral_constant<size_t, 8>{});
+  }
+}
+
+/// Search from sources in batches and call visit_fn(i, level, node) for each
+/// search i and each node it reaches, where level is the BFS level of node in
+/// search i. begin_batch_fn(first, count) is called before the searches from
+/// sources[first] to sources[first + count - 1] start.
+template <typename BeginBatchFn, typename VisitFn>
+void
+RunBfsBatches(
+    const katana::GraphTopology& topology, const std::vector<uint32_t>& sources,
+    BeginBatchFn begin_batch_fn, VisitFn visit_fn) {
+  WithBatchWords(sources.size(), [&](auto words) {
+    using BatchBfs = BitParallelBfs<decltype(words)::value>;
+    BatchBfs bfs(topology);
+
+    for (size_t first = 0; first < sources.size();
+         first += BatchBfs::kMaxSources) {
+      size_t count = std::min(BatchBfs::kMaxSources, sources.size() - first);
+      begin_batch_fn(first, count);
+
+      bfs.Start(&sources[first], count);
+      while (!bfs.Done()) {
+        uint32_t level = bfs.level();
+        katana::do_all(
+            katana::iterate(bfs.frontier()),
+            [&](const typename BatchBfs::Visit& visit) {
+              visit.bits.ForEach(
+                  [&](size_t i) { visit_fn(first + i, level, visit.node); });
+            },
+            katana::steal(), katana::no_stats());
+        bfs.Step();
+      }
+    }
+  });
+}
+
+katana::Result<void>
+CheckBatchSources(
+    const katana::PropertyGraph& pg, const std::vector<uint32_t>& sources) {
+  for (uint32_t source : sources) {
+    if (source >= pg.num_nodes()) {
+      return katana::ErrorCode::InvalidArgument;
+    }
+  }
+  return katana::ResultSuccess();
+}
 }  // namespace
 
 katana::Result<void>
 katana::analytics::Bfs(
     katana::PropertyGraph* pg, size_t start_node,
     const std::string& output_property_name, BfsPlan algo) {
+  if (algo.algorithm() == BfsPlan::kAutomatic) {
+    algo = BfsPlan(pg);
+  }
+
+  // The bottom-up steps scan in-edges
+  if (algo.algorithm() == BfsPlan::kDirectionOptimizing) {
+    if (algo.alpha() == 0 || algo.beta() == 0) {
+      return katana::ErrorCode::InvalidArgument;
+    }
+    if (auto result = pg->BuildInEdges(); !result) {
+      return result.error();
+    }
+  }
+
   if (auto result = ConstructNodeProperties<std::tuple<BfsNodeDistance>>(
           pg, {output_property_name});
       !result) {
@@ -356,6 +572,118 @@ katana::analytics::BfsAssertValid(
   return katana::ResultSuccess();
 }
 
+katana::Result<void>
+katana::analytics::BfsBatch(
+    katana::PropertyGraph* pg, const std::vector<uint32_t>& sources,
+    const std::vector<std::string>& output_property_names) {
+  if (pg->has_wide_node_ids()) {
+    return katana::ErrorCode::NotImplemented;
+  }
+  if (sources.size() != output_property_names.size()) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+  if (auto result = CheckBatchSources(*pg, sources); !result) {
+    return result.error();
+  }
+
+  std::vector<Graph> graphs;
+  for (const std::string& name : output_property_names) {
+    if (auto result =
+            ConstructNodeProperties<std::tuple<BfsNodeDistance>>(pg, {name});
+        !result) {
+      return result.error();
+    }
+    auto pg_result = Graph::Make(pg, {name}, {});
+    if (!pg_result) {
+      return pg_result.error();
+    }
+    graphs.emplace_back(pg_result.value());
+  }
+
+  katana::StatTimer exec_time("BfsBatch");
+  exec_time.start();
+
+  RunBfsBatches(
+      pg->topology(), sources,
+      [&](size_t first, size_t count) {
+        for (size_t i = first; i < first + count; ++i) {
+          Graph& graph = graphs[i];
+          katana::do_all(
+              katana::iterate(graph),
+              [&](auto n) {
+                graph.GetData<BfsNodeDistance>(n) =
+                    BfsImplementation::kDistanceInfinity;
+              },
+              katana::no_stats());
+        }
+      },
+      [&](size_t i, uint32_t level, uint32_t node) {
+        graphs[i].GetData<BfsNodeDistance>(node) = level;
+      });
+
+  exec_time.stop();
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<std::vector<BfsStatistics>>
+katana::analytics::BfsBatchReduce(
+    katana::PropertyGraph* pg, const std::vector<uint32_t>& sources) {
+  if (pg->has_wide_node_ids()) {
+    return katana::ErrorCode::NotImplemented;
+  }
+  if (auto result = CheckBatchSources(*pg, sources); !result) {
+    return result.error();
+  }
+
+  std::vector<BfsStatistics> statistics(sources.size());
+  katana::PerThreadStorage<std::vector<BfsStatistics>> per_thread_statistics;
+  size_t batch_first = 0;
+  size_t batch_count = 0;
+
+  // Reduce the per-thread statistics of the previous batch into statistics
+  auto reduce_batch = [&]() {
+    for (unsigned t = 0; t < per_thread_statistics.size(); ++t) {
+      std::vector<BfsStatistics>& local = *per_thread_statistics.getRemote(t);
+      for (size_t i = 0; i < local.size(); ++i) {
+        BfsStatistics& s = statistics[batch_first + i];
+        s.max_distance = std::max(s.max_distance, local[i].max_distance);
+        s.total_distance += local[i].total_distance;
+        s.n_reached_nodes += local[i].n_reached_nodes;
+      }
+      local.assign(batch_count, BfsStatistics{});
+    }
+  };
+
+  katana::StatTimer exec_time("BfsBatchReduce");
+  exec_time.start();
+
+  RunBfsBatches(
+      pg->topology(), sources,
+      [&](size_t first, size_t count) {
+        reduce_batch();
+        batch_first = first;
+        batch_count = count;
+        for (unsigned t = 0; t < per_thread_statistics.size(); ++t) {
+          per_thread_statistics.getRemote(t)->assign(count, BfsStatistics{});
+        }
+      },
+      [&](size_t i, uint32_t level, uint32_t) {
+        BfsStatistics& s = (*per_thread_statistics.getLocal())[i - batch_first];
+        s.max_distance = std::max(s.max_distance, level);
+        s.total_distance += level;
+        s.n_reached_nodes += 1;
+      });
+  reduce_batch();
+
+  exec_time.stop();
+
+  for (size_t i = 0; i < sources.size(); ++i) {
+    statistics[i].source_node = sources[i];
+  }
+  return statistics;
+}
+
 katana::Result<BfsStatistics>
 katana::analytics::BfsStatistics::Compute(
     katana::PropertyGraph* pg, const std::string& property_name) {
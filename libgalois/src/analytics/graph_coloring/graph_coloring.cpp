@@ -0,0 +1,360 @@
+#include "katana/analytics/graph_coloring/graph_coloring.h"
+
+#include <atomic>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Reduction.h"
+#include "katana/TypedPropertyGraph.h"
+
+using namespace katana::analytics;
+
+const int GraphColoringPlan::kChunkSize = 64;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+constexpr uint32_t kNoColor = std::numeric_limits<uint32_t>::max();
+
+struct NodeColor : public katana::PODProperty<uint32_t> {};
+
+using ColorGraph =
+    katana::TypedPropertyGraph<std::tuple<NodeColor>, std::tuple<>>;
+
+/// The topology of the input graph and the color of each node
+struct ColoredGraph {
+  uint64_t num_nodes{0};
+  const uint64_t* indices{nullptr};
+  const Node* dests{nullptr};
+  katana::LargeArray<std::atomic<uint32_t>> colors;
+
+  Edge Begin(Node n) const { return n > 0 ? indices[n - 1] : 0; }
+  Edge End(Node n) const { return indices[n]; }
+
+  uint32_t Color(Node n) const {
+    return colors[n].load(std::memory_order_relaxed);
+  }
+  void SetColor(Node n, uint32_t c) {
+    colors[n].store(c, std::memory_order_relaxed);
+  }
+};
+
+/// The colors taken by the neighbors of a node, marked with a stamp that
+/// changes for every node so that the marks never need to be cleared
+struct ColorMarks {
+  std::vector<uint64_t> marks;
+  uint64_t stamp{0};
+
+  /// The smallest color that no neighbor of n has. A node with d neighbors
+  /// always finds one of the first d + 1 colors free.
+  uint32_t FirstFit(const ColoredGraph& graph, Node n) {
+    uint64_t degree = graph.End(n) - graph.Begin(n);
+    if (marks.size() < degree + 1) {
+      marks.resize(degree + 1, 0);
+    }
+    ++stamp;
+    for (Edge e = graph.Begin(n); e < graph.End(n); ++e) {
+      Node dst = graph.dests[e];
+      uint32_t c = graph.Color(dst);
+      if (dst != n && c <= degree) {
+        marks[c] = stamp;
+      }
+    }
+    uint32_t c = 0;
+    while (marks[c] == stamp) {
+      ++c;
+    }
+    return c;
+  }
+};
+
+void
+Speculative(ColoredGraph* graph) {
+  katana::PerThreadStorage<ColorMarks> marks;
+  katana::InsertBag<Node> bags[2];
+  katana::InsertBag<Node>* cur = &bags[0];
+  katana::InsertBag<Node>* next = &bags[1];
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph->num_nodes),
+      [&](Node n) { cur->push(n); }, katana::no_stats());
+
+  uint32_t rounds = 0;
+  while (!cur->empty()) {
+    ++rounds;
+    katana::do_all(
+        katana::iterate(*cur),
+        [&](Node n) {
+          graph->SetColor(n, marks.getLocal()->FirstFit(*graph, n));
+        },
+        katana::steal(), katana::chunk_size<GraphColoringPlan::kChunkSize>(),
+        katana::loopname("GraphColoring-Speculative"));
+
+    // Only nodes colored in the same round can conflict, and the smallest node
+    // of those with the same color keeps it, so every round colors at least
+    // one node for good
+    katana::do_all(
+        katana::iterate(*cur),
+        [&](Node n) {
+          uint32_t c = graph->Color(n);
+          for (Edge e = graph->Begin(n); e < graph->End(n); ++e) {
+            Node dst = graph->dests[e];
+            if (dst < n && graph->Color(dst) == c) {
+              next->push(n);
+              return;
+            }
+          }
+        },
+        katana::steal(), katana::chunk_size<GraphColoringPlan::kChunkSize>(),
+        katana::loopname("GraphColoring-Conflicts"));
+
+    cur->clear();
+    std::swap(cur, next);
+  }
+
+  katana::ReportStatSingle("GraphColoring", "Rounds", rounds);
+}
+
+void
+JonesPlassmann(ColoredGraph* graph, bool largest_degree_first) {
+  // Node ids fit in 32 bits and hash is a bijection on them, so priorities
+  // are distinct
+  katana::LargeArray<uint64_t> priorities;
+  priorities.allocateInterleaved(graph->num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph->num_nodes),
+      [&](Node n) {
+        uint64_t priority = HashNodeId(n);
+        if (largest_degree_first) {
+          priority |= (graph->End(n) - graph->Begin(n)) << 32;
+        }
+        priorities[n] = priority;
+      },
+      katana::no_stats());
+
+  katana::PerThreadStorage<ColorMarks> marks;
+  katana::InsertBag<Node> selected;
+  katana::InsertBag<Node> bags[2];
+  katana::InsertBag<Node>* cur = &bags[0];
+  katana::InsertBag<Node>* next = &bags[1];
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph->num_nodes),
+      [&](Node n) { cur->push(n); }, katana::no_stats());
+
+  uint32_t rounds = 0;
+  while (!cur->empty()) {
+    ++rounds;
+    // The uncolored nodes whose priority is larger than that of any uncolored
+    // neighbor form an independent set, so they can all be colored at once
+    katana::do_all(
+        katana::iterate(*cur),
+        [&](Node n) {
+          for (Edge e = graph->Begin(n); e < graph->End(n); ++e) {
+            Node dst = graph->dests[e];
+            if (graph->Color(dst) == kNoColor &&
+                priorities[dst] > priorities[n]) {
+              next->push(n);
+              return;
+            }
+          }
+          selected.push(n);
+        },
+        katana::steal(), katana::chunk_size<GraphColoringPlan::kChunkSize>(),
+        katana::loopname("GraphColoring-Select"));
+
+    katana::do_all(
+        katana::iterate(selected),
+        [&](Node n) {
+          graph->SetColor(n, marks.getLocal()->FirstFit(*graph, n));
+        },
+        katana::steal(), katana::chunk_size<GraphColoringPlan::kChunkSize>(),
+        katana::loopname("GraphColoring-JonesPlassmann"));
+
+    selected.clear();
+    cur->clear();
+    std::swap(cur, next);
+  }
+
+  katana::ReportStatSingle("GraphColoring", "Rounds", rounds);
+}
+
+katana::Result<void>
+MakeColoredGraph(katana::PropertyGraph* pg, ColoredGraph* graph) {
+  if (pg->has_wide_node_ids()) {
+    return katana::ErrorCode::NotImplemented;
+  }
+  graph->num_nodes = pg->num_nodes();
+  graph->indices = pg->topology().out_indices->raw_values();
+  graph->dests = pg->topology().out_dests->raw_values();
+  graph->colors.allocateInterleaved(graph->num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph->num_nodes),
+      [&](Node n) { graph->colors.constructAt(n, kNoColor); },
+      katana::no_stats());
+  return katana::ResultSuccess();
+}
+
+/// The topology of pg and the colors in property_name
+katana::Result<void>
+LoadColors(
+    katana::PropertyGraph* pg, const std::string& property_name,
+    ColoredGraph* graph) {
+  if (auto result = MakeColoredGraph(pg, graph); !result) {
+    return result.error();
+  }
+
+  auto pg_result = ColorGraph::Make(pg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto colored = pg_result.value();
+  katana::do_all(
+      katana::iterate(colored),
+      [&](const Node& n) {
+        graph->SetColor(n, colored.GetData<NodeColor>(n));
+      },
+      katana::no_stats());
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::GraphColoring(
+    PropertyGraph* pg, const std::string& output_property_name,
+    GraphColoringPlan plan) {
+  ColoredGraph graph;
+  if (auto result = MakeColoredGraph(pg, &graph); !result) {
+    return result.error();
+  }
+
+  katana::StatTimer exec_time("GraphColoring");
+  exec_time.start();
+
+  switch (plan.algorithm()) {
+  case GraphColoringPlan::kSpeculative:
+    Speculative(&graph);
+    break;
+  case GraphColoringPlan::kJonesPlassmann:
+    JonesPlassmann(&graph, false);
+    break;
+  case GraphColoringPlan::kLargestDegreeFirst:
+    JonesPlassmann(&graph, true);
+    break;
+  default:
+    return ErrorCode::InvalidArgument;
+  }
+
+  GReduceMax<uint32_t> max_color;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](Node n) { max_color.update(graph.Color(n)); }, katana::no_stats());
+  katana::ReportStatSingle(
+      "GraphColoring", "NumColors",
+      graph.num_nodes > 0 ? max_color.reduce() + 1 : 0);
+
+  exec_time.stop();
+
+  if (auto result = ConstructNodeProperties<std::tuple<NodeColor>>(
+          pg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+  auto pg_result = ColorGraph::Make(pg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto colored = pg_result.value();
+  katana::do_all(
+      katana::iterate(colored),
+      [&](const Node& n) { colored.GetData<NodeColor>(n) = graph.Color(n); },
+      katana::no_stats());
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::GraphColoringAssertValid(
+    PropertyGraph* pg, const std::string& property_name) {
+  ColoredGraph graph;
+  if (auto result = LoadColors(pg, property_name, &graph); !result) {
+    return result.error();
+  }
+
+  GReduceLogicalOr conflict;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](Node n) {
+        uint32_t c = graph.Color(n);
+        if (c == kNoColor) {
+          conflict.update(true);
+          return;
+        }
+        for (Edge e = graph.Begin(n); e < graph.End(n); ++e) {
+          Node dst = graph.dests[e];
+          if (dst != n && graph.Color(dst) == c) {
+            conflict.update(true);
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+  if (conflict.reduce()) {
+    return ErrorCode::AssertionFailed;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<GraphColoringStatistics>
+katana::analytics::GraphColoringStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  ColoredGraph graph;
+  if (auto result = LoadColors(pg, property_name, &graph); !result) {
+    return result.error();
+  }
+
+  GReduceMax<uint32_t> max_color;
+  GReduceLogicalOr uncolored;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](Node n) {
+        uint32_t c = graph.Color(n);
+        if (c == kNoColor) {
+          uncolored.update(true);
+        } else {
+          max_color.update(c);
+        }
+      },
+      katana::no_stats());
+  if (uncolored.reduce()) {
+    return ErrorCode::AssertionFailed;
+  }
+  uint32_t num_colors = graph.num_nodes > 0 ? max_color.reduce() + 1 : 0;
+
+  std::vector<std::atomic<uint64_t>> sizes(num_colors);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](Node n) { katana::atomicAdd(sizes[graph.Color(n)], uint64_t{1}); },
+      katana::no_stats());
+
+  std::vector<uint64_t> color_class_sizes;
+  for (const auto& size : sizes) {
+    color_class_sizes.emplace_back(size.load());
+  }
+  return GraphColoringStatistics{
+      .num_colors = num_colors,
+      .color_class_sizes = std::move(color_class_sizes),
+  };
+}
+
+void
+katana::analytics::GraphColoringStatistics::Print(std::ostream& os) const {
+  os << "Number of colors = " << num_colors << std::endl;
+  for (uint32_t c = 0; c < color_class_sizes.size(); ++c) {
+    os << "Nodes of color " << c << " = " << color_class_sizes[c] << std::endl;
+  }
+}
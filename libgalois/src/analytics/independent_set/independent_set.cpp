@@ -40,13 +40,6 @@ using namespace katana::analytics;
 constexpr int kChunkSize = 64;
 constexpr float kHashScale = 1.0 / std::numeric_limits<unsigned int>::max();
 
-unsigned int
-hash(unsigned int val) {
-  val = ((val >> 16) ^ val) * 0x45d9f3b;
-  val = ((val >> 16) ^ val) * 0x45d9f3b;
-  return (val >> 16) ^ val;
-}
-
 enum MatchFlag : char {
   KOtherMatched = false,
   kMatched = true,
@@ -363,7 +356,7 @@ struct PrioAlgo {
         [&](const GNode& src) {
           auto& src_flag = graph->GetData<NodeFlag>(src);
           float degree = graph->edges(src).size();
-          float x = degree - hash(src) * kHashScale;
+          float x = degree - HashNodeId(src) * kHashScale;
           int res = round(scale_avg / (avg_degree + x));
           uint8_t val = (res + res) | 1;
           src_flag = val;
@@ -466,7 +459,7 @@ struct EdgeTiledPrioAlgo {
           const auto end = graph->edge_end(src);
 
           float degree = float(graph->edges(src).size());
-          float x = degree - hash(src) * kHashScale;
+          float x = degree - HashNodeId(src) * kHashScale;
           int res = round(scale_avg / (avg_degree + x));
           uint8_t val = (res + res) | 0x03;
 
@@ -19,6 +19,9 @@
 
 #include "katana/analytics/jaccard/jaccard.h"
 
+#include <optional>
+
+#include "katana/SetIntersection.h"
 #include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/Utils.h"
 
@@ -34,35 +37,32 @@ namespace {
 
 struct IntersectWithSortedEdgeList {
 private:
-  const GNode base_;
-  const Graph& graph_;
+  const katana::GraphTopology& topology_;
+  const uint32_t* base_begin_;
+  const uint32_t* base_end_;
+  // Set when base has enough neighbors that a bitmap of them is cheaper
+  // than merging with them for every node
+  std::optional<katana::IntersectionBitmap> base_bitmap_;
 
 public:
   IntersectWithSortedEdgeList(const Graph& graph, GNode base)
-      : base_(base), graph_(graph) {}
+      : topology_(graph.GetPropertyGraph().topology()) {
+    std::tie(base_begin_, base_end_) =
+        katana::OutDestinations(topology_, base);
+    uint64_t base_size = base_end_ - base_begin_;
+    if (katana::IntersectionBitmap::IsWorthwhile(base_begin_, base_size)) {
+      base_bitmap_.emplace();
+      base_bitmap_->Assign(base_begin_, base_size);
+    }
+  }
 
   uint32_t operator()(GNode n2) {
-    uint32_t intersection_size = 0;
-    // Iterate over the edges of both n2 and base in sync, based on the
-    // assumption that edges lists are sorted.
-    auto edges_n2_iter = graph_.edge_begin(n2);
-    auto edges_n2_end = graph_.edge_end(n2);
-    auto edges_base_iter = graph_.edge_begin(base_);
-    auto edges_base_end = graph_.edge_end(base_);
-    while (edges_n2_iter != edges_n2_end && edges_base_iter != edges_base_end) {
-      auto edge_n2_dst = graph_.GetEdgeDest(*edges_n2_iter);
-      auto edge_base_dst = graph_.GetEdgeDest(*edges_base_iter);
-      if (edge_n2_dst == edge_base_dst) {
-        intersection_size++;
-        edges_n2_iter++;
-        edges_base_iter++;
-      } else if (edge_n2_dst > edge_base_dst) {
-        edges_base_iter++;
-      } else if (edge_n2_dst < edge_base_dst) {
-        edges_n2_iter++;
-      }
+    auto [begin, end] = katana::OutDestinations(topology_, n2);
+    if (base_bitmap_) {
+      return base_bitmap_->CountIntersection(begin, end - begin);
     }
-    return intersection_size;
+    return katana::CountIntersection(
+        base_begin_, base_end_ - base_begin_, begin, end - begin);
   }
 };
 
@@ -19,6 +19,8 @@
 
 #include "katana/analytics/k_core/k_core.h"
 
+#include <limits>
+
 #include "katana/ArrowRandomAccessBuilder.h"
 #include "katana/TypedPropertyGraph.h"
 
@@ -262,6 +264,233 @@ katana::analytics::KCore(
   return KCoreMarkAliveNodes(&graph_final, k_core_number);
 }
 
+/*******************************************************************************
+ * Functions for computing the core number of every node
+ ******************************************************************************/
+struct KCoreNodeCoreNumber {
+  using ArrowType = arrow::CTypeTraits<uint32_t>::ArrowType;
+  using ViewType = katana::PODPropertyView<std::atomic<uint32_t>>;
+};
+
+using DecompositionGraph = katana::TypedPropertyGraph<
+    std::tuple<KCoreNodeCoreNumber, KCoreNodeCurrentDegree>, std::tuple<>>;
+using CoreNumberGraph =
+    katana::TypedPropertyGraph<std::tuple<KCoreNodeCoreNumber>, std::tuple<>>;
+
+//! Core number of a node that has not been peeled yet.
+constexpr uint32_t kUnassignedCoreNumber = std::numeric_limits<uint32_t>::max();
+
+/**
+ * Peel nodes in order of increasing k. At level k, every remaining node with
+ * current degree at most k has core number k; removing it decrements the
+ * degree of its neighbors, which may bring them down to k in turn.
+ *
+ * Only nodes that have not been peeled are scanned for each level, and levels
+ * at which no node would be peeled are skipped.
+ *
+ * @param graph Graph to operate on, with degrees initialized
+ */
+void
+SyncPeelKCoreDecomposition(DecompositionGraph* graph) {
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](const GNode& node) {
+        graph->GetData<KCoreNodeCoreNumber>(node) = kUnassignedCoreNumber;
+      },
+      katana::loopname("KCoreDecomposition Init"), katana::no_stats());
+
+  auto remaining = std::make_unique<katana::InsertBag<GNode>>();
+  auto next_remaining = std::make_unique<katana::InsertBag<GNode>>();
+  auto current = std::make_unique<katana::InsertBag<GNode>>();
+  auto next = std::make_unique<katana::InsertBag<GNode>>();
+  katana::GReduceMin<uint32_t> min_degree;
+
+  uint32_t k = 0;
+  bool scan_graph = true;
+  while (scan_graph || !remaining->empty()) {
+    next_remaining->clear();
+    next->clear();
+    min_degree.reset();
+
+    //! Collect the nodes at this level and keep the rest for later levels.
+    auto scan = [&](const GNode& node) {
+      auto& core_number = graph->GetData<KCoreNodeCoreNumber>(node);
+      if (core_number.load(std::memory_order_relaxed) !=
+          kUnassignedCoreNumber) {
+        return;
+      }
+      uint32_t degree = graph->GetData<KCoreNodeCurrentDegree>(node);
+      if (degree <= k) {
+        core_number.store(k, std::memory_order_relaxed);
+        next->emplace(node);
+      } else {
+        next_remaining->emplace(node);
+        min_degree.update(degree);
+      }
+    };
+    if (scan_graph) {
+      katana::do_all(
+          katana::iterate(*graph), scan, katana::steal(),
+          katana::loopname("KCoreDecomposition Scan"));
+      scan_graph = false;
+    } else {
+      katana::do_all(
+          katana::iterate(*remaining), scan, katana::steal(),
+          katana::loopname("KCoreDecomposition Scan"));
+    }
+    std::swap(remaining, next_remaining);
+
+    if (next->empty()) {
+      //! Nothing was peeled, so no degree changed since the scan.
+      k = min_degree.reduce();
+      continue;
+    }
+
+    while (!next->empty()) {
+      std::swap(current, next);
+      next->clear();
+
+      katana::do_all(
+          katana::iterate(*current),
+          [&](const GNode& dead_node) {
+            for (auto e : graph->edges(dead_node)) {
+              auto dest = graph->GetEdgeDest(e);
+              auto& dest_current_degree =
+                  graph->GetData<KCoreNodeCurrentDegree>(dest);
+              uint32_t old_degree = katana::atomicSub(dest_current_degree, 1u);
+
+              if (old_degree == k + 1) {
+                //! This thread brought the degree of the destination down to
+                //! this level: it is peeled at this level too.
+                graph->GetData<KCoreNodeCoreNumber>(dest).store(
+                    k, std::memory_order_relaxed);
+                next->emplace(*dest);
+              }
+            }
+          },
+          katana::steal(), katana::chunk_size<KCorePlan::kChunkSize>(),
+          katana::loopname("KCoreDecomposition Synchronous"));
+    }
+    ++k;
+  }
+}
+
+/**
+ * Start with the degree of each node as an upper bound on its core number
+ * and repeatedly lower the bound of a node to the h-index of the bounds of
+ * its neighbors, i.e., the largest h such that at least h neighbors have a
+ * bound of at least h. When no bound changes, every bound is the core number.
+ *
+ * @param graph Graph to operate on, with degrees initialized
+ */
+void
+AsyncHIndexKCoreDecomposition(DecompositionGraph* graph) {
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](const GNode& node) {
+        graph->GetData<KCoreNodeCoreNumber>(node) =
+            graph->GetData<KCoreNodeCurrentDegree>(node).load();
+      },
+      katana::loopname("KCoreDecomposition Init"), katana::no_stats());
+
+  katana::PerThreadStorage<std::vector<uint32_t>> per_thread_counts;
+
+  katana::for_each(
+      katana::iterate(*graph),
+      [&](const GNode& node, auto& ctx) {
+        auto& core_number = graph->GetData<KCoreNodeCoreNumber>(node);
+        uint32_t bound = core_number.load(std::memory_order_relaxed);
+        if (bound == 0) {
+          return;
+        }
+
+        //! counts[i] is the number of neighbors with bound i, where bounds
+        //! above this node's bound count as this node's bound.
+        std::vector<uint32_t>& counts = *per_thread_counts.getLocal();
+        counts.assign(bound + 1, 0);
+        for (auto e : graph->edges(node)) {
+          auto dest = graph->GetEdgeDest(e);
+          uint32_t dest_bound = graph->GetData<KCoreNodeCoreNumber>(dest).load(
+              std::memory_order_relaxed);
+          counts[std::min(dest_bound, bound)] += 1;
+        }
+
+        uint32_t h = bound;
+        uint32_t at_least_h = counts[h];
+        while (at_least_h < h) {
+          --h;
+          at_least_h += counts[h];
+        }
+        if (h == bound || katana::atomicMin(core_number, h) <= h) {
+          return;
+        }
+
+        //! Only neighbors with a larger bound can depend on this one.
+        for (auto e : graph->edges(node)) {
+          auto dest = graph->GetEdgeDest(e);
+          if (graph->GetData<KCoreNodeCoreNumber>(dest).load(
+                  std::memory_order_relaxed) > h) {
+            ctx.push(*dest);
+          }
+        }
+      },
+      katana::disable_conflict_detection(),
+      katana::chunk_size<KCorePlan::kChunkSize>(),
+      katana::loopname("KCoreDecomposition Asynchronous"));
+}
+
+katana::Result<void>
+katana::analytics::KCoreDecomposition(
+    katana::PropertyGraph* pg, const std::string& output_property_name,
+    KCorePlan plan) {
+  katana::analytics::TemporaryPropertyGuard temporary_property{pg};
+  if (auto result = ConstructNodeProperties<std::tuple<KCoreNodeCurrentDegree>>(
+          pg, {temporary_property.name()});
+      !result) {
+    return result.error();
+  }
+  if (auto result = ConstructNodeProperties<std::tuple<KCoreNodeCoreNumber>>(
+          pg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = DecompositionGraph::Make(
+      pg, {output_property_name, temporary_property.name()}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  size_t approxNodeData = 4 * (graph.num_nodes() + graph.num_edges());
+  katana::Prealloc(8, approxNodeData);
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        graph.GetData<KCoreNodeCurrentDegree>(node).store(
+            std::distance(graph.edge_begin(node), graph.edge_end(node)));
+      },
+      katana::loopname("DegreeCounting"), katana::no_stats());
+
+  katana::StatTimer exec_time("KCoreDecomposition");
+  exec_time.start();
+
+  switch (plan.algorithm()) {
+  case KCorePlan::kSynchronous:
+    SyncPeelKCoreDecomposition(&graph);
+    break;
+  case KCorePlan::kAsynchronous:
+    AsyncHIndexKCoreDecomposition(&graph);
+    break;
+  default:
+    return katana::ErrorCode::AssertionFailed;
+  }
+  exec_time.stop();
+
+  return katana::ResultSuccess();
+}
+
 // Doxygen doesn't correctly handle implementation annotations that do not
 // appear in the declaration.
 /// \cond DO_NOT_DOCUMENT
@@ -301,6 +530,83 @@ katana::analytics::KCoreStatistics::Compute(
 
   return KCoreStatistics{alive_nodes.reduce()};
 }
+
+katana::Result<void>
+katana::analytics::KCoreDecompositionAssertValid(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto pg_result = CoreNumberGraph::Make(pg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  //! A node has core number c exactly when at least c of its neighbors have
+  //! core number at least c (so it is in the c-core) and at most c neighbors
+  //! have a larger core number (otherwise it would be in the (c+1)-core). A
+  //! self loop always counts.
+  katana::GReduceLogicalOr invalid;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        uint32_t core_number = graph.GetData<KCoreNodeCoreNumber>(node);
+        uint64_t at_least = 0;
+        uint64_t above = 0;
+        for (auto e : graph.edges(node)) {
+          auto dest = graph.GetEdgeDest(e);
+          uint32_t dest_core_number =
+              *dest == node ? kUnassignedCoreNumber
+                            : graph.GetData<KCoreNodeCoreNumber>(dest).load();
+          at_least += dest_core_number >= core_number;
+          above += dest_core_number > core_number;
+        }
+        if (at_least < core_number || above > core_number) {
+          invalid.update(true);
+        }
+      },
+      katana::loopname("KCoreDecomposition sanity check"), katana::no_stats());
+
+  if (invalid.reduce()) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<KCoreDecompositionStatistics>
+katana::analytics::KCoreDecompositionStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto pg_result = CoreNumberGraph::Make(pg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::PerThreadStorage<std::vector<uint64_t>> per_thread_histogram;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        uint32_t core_number = graph.GetData<KCoreNodeCoreNumber>(node);
+        std::vector<uint64_t>& histogram = *per_thread_histogram.getLocal();
+        if (histogram.size() <= core_number) {
+          histogram.resize(core_number + 1);
+        }
+        histogram[core_number] += 1;
+      },
+      katana::loopname("KCoreDecomposition histogram"), katana::no_stats());
+
+  std::vector<uint64_t> histogram;
+  for (unsigned i = 0; i < per_thread_histogram.size(); ++i) {
+    const std::vector<uint64_t>& local = *per_thread_histogram.getRemote(i);
+    if (histogram.size() < local.size()) {
+      histogram.resize(local.size());
+    }
+    for (size_t k = 0; k < local.size(); ++k) {
+      histogram[k] += local[k];
+    }
+  }
+
+  uint32_t max_core_number = histogram.empty() ? 0 : histogram.size() - 1;
+  return KCoreDecompositionStatistics{max_core_number, std::move(histogram)};
+}
 /// \endcond DO_NOT_DOCUMENT
 
 void
@@ -308,3 +614,23 @@ katana::analytics::KCoreStatistics::Print(std::ostream& os) const {
   os << "Number of nodes in the core = " << number_of_nodes_in_kcore
      << std::endl;
 }
+
+uint64_t
+katana::analytics::KCoreDecompositionStatistics::CoreSize(uint32_t k) const {
+  uint64_t size = 0;
+  for (size_t i = k; i < core_number_histogram.size(); ++i) {
+    size += core_number_histogram[i];
+  }
+  return size;
+}
+
+void
+katana::analytics::KCoreDecompositionStatistics::Print(std::ostream& os) const {
+  os << "Maximum core number = " << max_core_number << std::endl;
+  for (size_t k = 0; k < core_number_histogram.size(); ++k) {
+    if (core_number_histogram[k] > 0) {
+      os << "Number of nodes with core number " << k << " = "
+         << core_number_histogram[k] << std::endl;
+    }
+  }
+}
@@ -19,7 +19,13 @@
 
 #include "katana/analytics/k_truss/k_truss.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "katana/ArrowRandomAccessBuilder.h"
+#include "katana/AtomicHelpers.h"
+#include "katana/EdgeBalancedRange.h"
+#include "katana/SetIntersection.h"
 #include "katana/TypedPropertyGraph.h"
 
 using namespace katana::analytics;
@@ -374,6 +380,342 @@ katana::analytics::KTruss(
   }
 }
 
+/*******************************************************************************
+ * Functions for computing the trussness of every edge
+ ******************************************************************************/
+struct EdgeTrussness : public katana::PODProperty<uint32_t> {};
+
+using TrussnessGraph =
+    katana::TypedPropertyGraph<std::tuple<>, std::tuple<EdgeTrussness>>;
+
+namespace {
+
+/// An edge from src to a larger node id. It stands for both directions of
+/// the edge, and its index is used to index per edge state.
+struct TrussEdge {
+  GNode src;
+  uint64_t edge;
+};
+
+using TrussEdgeVec = katana::InsertBag<TrussEdge>;
+
+struct TrussDecompositionState {
+  const katana::GraphTopology& topology;
+  const uint32_t* dests;
+  //! The index of the edge in the opposite direction of each edge
+  katana::LargeArray<uint64_t> reverse;
+  //! The number of triangles with unpeeled edges each edge is in
+  katana::LargeArray<std::atomic<uint32_t>> support;
+  //! Whether an edge was peeled in an earlier round
+  katana::LargeArray<uint8_t> peeled;
+  //! Whether an edge is being peeled in the current round
+  katana::LargeArray<uint8_t> in_current;
+
+  explicit TrussDecompositionState(const katana::GraphTopology& t)
+      : topology(t), dests(t.out_dests->raw_values()) {
+    reverse.allocateInterleaved(t.num_edges());
+    support.allocateInterleaved(t.num_edges());
+    peeled.allocateInterleaved(t.num_edges());
+    in_current.allocateInterleaved(t.num_edges());
+  }
+
+  /// The TrussEdge for the edge with index edge from src
+  TrussEdge Canonical(GNode src, uint64_t edge) const {
+    GNode dest = dests[edge];
+    return src < dest ? TrussEdge{src, edge} : TrussEdge{dest, reverse[edge]};
+  }
+};
+
+/**
+ * Find the reverse of every edge.
+ *
+ * @returns InvalidArgument if the graph is not symmetric
+ */
+katana::Result<void>
+FindReverseEdges(TrussDecompositionState* state) {
+  const katana::GraphTopology& topology = state->topology;
+  const uint32_t* dests = state->dests;
+  katana::GReduceLogicalOr missing;
+
+  katana::do_all(
+      katana::iterate_edge_balanced(topology),
+      [&](GNode src) {
+        auto [begin, end] = topology.edge_range(src);
+        for (uint64_t e = begin; e < end; ++e) {
+          GNode dest = dests[e];
+          if (dest == src) {
+            state->reverse[e] = e;
+          }
+          if (dest <= src) {
+            continue;
+          }
+          auto [dest_begin, dest_end] = katana::OutDestinations(topology, dest);
+          const uint32_t* it = std::lower_bound(dest_begin, dest_end, src);
+          if (it == dest_end || *it != src) {
+            missing.update(true);
+            continue;
+          }
+          uint64_t r = it - dests;
+          state->reverse[e] = r;
+          state->reverse[r] = e;
+        }
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("KTrussDecomposition Reverse"));
+
+  if (missing.reduce()) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+  return katana::ResultSuccess();
+}
+
+/**
+ * Count the triangles each edge is in by intersecting the neighbors of its
+ * endpoints, and collect all edges.
+ */
+void
+ComputeSupport(TrussDecompositionState* state, TrussEdgeVec* edges) {
+  const katana::GraphTopology& topology = state->topology;
+  const uint32_t* dests = state->dests;
+
+  katana::do_all(
+      katana::iterate_edge_balanced(topology),
+      [&](GNode src) {
+        auto [src_begin, src_end] = katana::OutDestinations(topology, src);
+        bool src_loop = std::binary_search(src_begin, src_end, src);
+        auto [begin, end] = topology.edge_range(src);
+        for (uint64_t e = begin; e < end; ++e) {
+          GNode dest = dests[e];
+          if (dest <= src) {
+            continue;
+          }
+          auto [dest_begin, dest_end] = katana::OutDestinations(topology, dest);
+          uint64_t count = katana::CountIntersection(
+              src_begin, src_end - src_begin, dest_begin,
+              dest_end - dest_begin);
+          //! A self loop puts an endpoint in the neighbors of both endpoints
+          //! without making a triangle.
+          count -= src_loop;
+          count -= std::binary_search(dest_begin, dest_end, dest);
+
+          state->support[e].store(count, std::memory_order_relaxed);
+          state->peeled[e] = 0;
+          state->in_current[e] = 0;
+          edges->push(TrussEdge{src, e});
+        }
+      },
+      katana::steal(), katana::loopname("KTrussDecomposition Support"));
+}
+
+/// Remove one triangle from the support of edge, and add edge to next if
+/// its support drops to level.
+void
+DecrementSupport(
+    TrussDecompositionState* state, const TrussEdge& edge, uint32_t level,
+    TrussEdgeVec* next) {
+  uint32_t old_support = katana::atomicSub(state->support[edge.edge], 1u);
+  if (old_support == level + 1) {
+    next->push(edge);
+  } else if (old_support <= level) {
+    //! The edge is already being peeled at this level; its support no
+    //! longer matters and must not underflow.
+    katana::atomicAdd(state->support[edge.edge], 1u);
+  }
+}
+
+/**
+ * Remove the triangles of a peeled edge from the support of its other two
+ * edges.
+ *
+ * When several edges of a triangle are peeled in the same round, only one of
+ * them may remove the triangle from the support of the remaining edge: the
+ * one with the smallest index.
+ */
+void
+PeelEdge(
+    TrussDecompositionState* state, const TrussEdge& edge, uint32_t level,
+    TrussEdgeVec* next) {
+  const uint32_t* dests = state->dests;
+  GNode u = edge.src;
+  GNode v = dests[edge.edge];
+  auto [i, u_end] = state->topology.edge_range(u);
+  auto [j, v_end] = state->topology.edge_range(v);
+
+  while (i < u_end && j < v_end) {
+    GNode a = dests[i];
+    GNode b = dests[j];
+    if (a < b) {
+      ++i;
+      continue;
+    }
+    if (b < a) {
+      ++j;
+      continue;
+    }
+    if (a != u && a != v) {
+      TrussEdge e1 = state->Canonical(u, i);
+      TrussEdge e2 = state->Canonical(v, j);
+      if (!state->peeled[e1.edge] && !state->peeled[e2.edge]) {
+        bool e1_above = state->support[e1.edge].load() > level;
+        bool e2_above = state->support[e2.edge].load() > level;
+        if (e1_above && e2_above) {
+          DecrementSupport(state, e1, level, next);
+          DecrementSupport(state, e2, level, next);
+        } else if (e1_above) {
+          if (!state->in_current[e2.edge] || edge.edge < e2.edge) {
+            DecrementSupport(state, e1, level, next);
+          }
+        } else if (e2_above) {
+          if (!state->in_current[e1.edge] || edge.edge < e1.edge) {
+            DecrementSupport(state, e2, level, next);
+          }
+        }
+      }
+    }
+    ++i;
+    ++j;
+  }
+}
+
+/**
+ * Peel edges in order of increasing support. At level l, every unpeeled
+ * edge with support at most l has trussness l + 2; peeling it lowers the
+ * support of the other edges of its triangles, which may bring them down to
+ * l in turn.
+ *
+ * Only unpeeled edges are scanned for each level, and levels at which no
+ * edge would be peeled are skipped.
+ */
+void
+PeelTrusses(
+    TrussDecompositionState* state, TrussnessGraph* graph,
+    std::unique_ptr<TrussEdgeVec> remaining) {
+  auto next_remaining = std::make_unique<TrussEdgeVec>();
+  auto current = std::make_unique<TrussEdgeVec>();
+  auto next = std::make_unique<TrussEdgeVec>();
+  katana::GReduceMin<uint32_t> min_support;
+
+  uint32_t level = 0;
+  while (!remaining->empty()) {
+    next_remaining->clear();
+    next->clear();
+    min_support.reset();
+
+    katana::do_all(
+        katana::iterate(*remaining),
+        [&](const TrussEdge& edge) {
+          if (state->peeled[edge.edge]) {
+            return;
+          }
+          uint32_t support =
+              state->support[edge.edge].load(std::memory_order_relaxed);
+          if (support <= level) {
+            next->push(edge);
+          } else {
+            next_remaining->push(edge);
+            min_support.update(support);
+          }
+        },
+        katana::steal(), katana::loopname("KTrussDecomposition Scan"));
+    std::swap(remaining, next_remaining);
+
+    if (next->empty()) {
+      //! Nothing was peeled, so no support changed since the scan.
+      level = min_support.reduce();
+      continue;
+    }
+
+    while (!next->empty()) {
+      std::swap(current, next);
+      next->clear();
+
+      katana::do_all(
+          katana::iterate(*current),
+          [&](const TrussEdge& edge) {
+            state->in_current[edge.edge] = 1;
+            graph->GetEdgeData<EdgeTrussness>(edge.edge) = level + 2;
+          },
+          katana::no_stats());
+
+      katana::do_all(
+          katana::iterate(*current),
+          [&](const TrussEdge& edge) { PeelEdge(state, edge, level, &*next); },
+          katana::steal(), katana::chunk_size<64>(),
+          katana::loopname("KTrussDecomposition Peel"));
+
+      katana::do_all(
+          katana::iterate(*current),
+          [&](const TrussEdge& edge) {
+            state->in_current[edge.edge] = 0;
+            state->peeled[edge.edge] = 1;
+          },
+          katana::no_stats());
+    }
+    ++level;
+  }
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::KTrussDecomposition(
+    katana::PropertyGraph* pg, const std::string& output_property_name) {
+  if (auto result = ConstructEdgeProperties<std::tuple<EdgeTrussness>>(
+          pg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  if (auto result = katana::SortAllEdgesByDest(pg); !result) {
+    return result.error();
+  }
+
+  auto pg_result = TrussnessGraph::Make(pg, {}, {output_property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  const katana::GraphTopology& topology = pg->topology();
+  if (topology.num_edges() == 0) {
+    return katana::ResultSuccess();
+  }
+
+  katana::StatTimer exec_time("KTrussDecomposition");
+  exec_time.start();
+
+  TrussDecompositionState state(topology);
+  if (auto result = FindReverseEdges(&state); !result) {
+    return result.error();
+  }
+
+  auto edges = std::make_unique<TrussEdgeVec>();
+  ComputeSupport(&state, edges.get());
+  PeelTrusses(&state, &graph, std::move(edges));
+
+  //! Copy the trussness of each edge to its reverse. Self loops are in no
+  //! triangle.
+  katana::do_all(
+      katana::iterate_edge_balanced(topology),
+      [&](GNode src) {
+        auto [begin, end] = topology.edge_range(src);
+        for (uint64_t e = begin; e < end; ++e) {
+          GNode dest = state.dests[e];
+          if (dest == src) {
+            graph.GetEdgeData<EdgeTrussness>(e) = 2;
+          } else if (dest < src) {
+            graph.GetEdgeData<EdgeTrussness>(e) =
+                graph.GetEdgeData<EdgeTrussness>(state.reverse[e]);
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  exec_time.stop();
+
+  return katana::ResultSuccess();
+}
+
 // Doxygen doesn't correctly handle implementation annotations that do not
 // appear in the declaration.
 /// \cond DO_NOT_DOCUMENT
@@ -415,9 +757,149 @@ katana::analytics::KTrussStatistics::Compute(
 
   return KTrussStatistics{alive_edges.reduce()};
 }
+
+katana::Result<void>
+katana::analytics::KTrussDecompositionAssertValid(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto pg_result = TrussnessGraph::Make(pg, {}, {property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+  const katana::GraphTopology& topology = pg->topology();
+
+  //! An edge has trussness t exactly when at least t - 2 of its triangles
+  //! have other edges with trussness at least t (so it is in the t-truss)
+  //! and at most t - 2 of its triangles have other edges with larger
+  //! trussness (otherwise it would be in the (t+1)-truss).
+  katana::GReduceLogicalOr invalid;
+  katana::do_all(
+      katana::iterate_edge_balanced(topology),
+      [&](GNode u) {
+        auto [u_begin, u_end] = topology.edge_range(u);
+        for (uint64_t e = u_begin; e < u_end; ++e) {
+          GNode v = *graph.GetEdgeDest(e);
+          uint32_t trussness = graph.GetEdgeData<EdgeTrussness>(e);
+          if (v == u) {
+            if (trussness != 2) {
+              invalid.update(true);
+            }
+            continue;
+          }
+          auto [v_begin, v_end] = katana::OutDestinations(topology, v);
+          const uint32_t* it = std::lower_bound(v_begin, v_end, u);
+          if (it == v_end || *it != u ||
+              graph.GetEdgeData<EdgeTrussness>(
+                  it - topology.out_dests->raw_values()) != trussness) {
+            invalid.update(true);
+            continue;
+          }
+          if (v < u) {
+            continue;
+          }
+
+          uint64_t at_least = 0;
+          uint64_t above = 0;
+          auto [i, i_end] = topology.edge_range(u);
+          auto [j, j_end] = topology.edge_range(v);
+          while (i < i_end && j < j_end) {
+            GNode a = *graph.GetEdgeDest(i);
+            GNode b = *graph.GetEdgeDest(j);
+            if (a < b) {
+              ++i;
+            } else if (b < a) {
+              ++j;
+            } else {
+              if (a != u && a != v) {
+                uint32_t other = std::min(
+                    graph.GetEdgeData<EdgeTrussness>(i),
+                    graph.GetEdgeData<EdgeTrussness>(j));
+                at_least += other >= trussness;
+                above += other > trussness;
+              }
+              ++i;
+              ++j;
+            }
+          }
+          if (trussness < 2 || at_least + 2 < trussness ||
+              above + 2 > trussness) {
+            invalid.update(true);
+          }
+        }
+      },
+      katana::loopname("KTrussDecomposition sanity check"), katana::no_stats());
+
+  if (invalid.reduce()) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<KTrussDecompositionStatistics>
+katana::analytics::KTrussDecompositionStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto pg_result = TrussnessGraph::Make(pg, {}, {property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::PerThreadStorage<std::vector<uint64_t>> per_thread_histogram;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        std::vector<uint64_t>& histogram = *per_thread_histogram.getLocal();
+        for (auto e : graph.edges(node)) {
+          if (*graph.GetEdgeDest(e) < node) {
+            continue;
+          }
+          uint32_t trussness = graph.GetEdgeData<EdgeTrussness>(e);
+          if (histogram.size() <= trussness) {
+            histogram.resize(trussness + 1);
+          }
+          histogram[trussness] += 1;
+        }
+      },
+      katana::loopname("KTrussDecomposition histogram"), katana::no_stats());
+
+  std::vector<uint64_t> histogram;
+  for (unsigned i = 0; i < per_thread_histogram.size(); ++i) {
+    const std::vector<uint64_t>& local = *per_thread_histogram.getRemote(i);
+    if (histogram.size() < local.size()) {
+      histogram.resize(local.size());
+    }
+    for (size_t k = 0; k < local.size(); ++k) {
+      histogram[k] += local[k];
+    }
+  }
+
+  uint32_t max_trussness = histogram.empty() ? 0 : histogram.size() - 1;
+  return KTrussDecompositionStatistics{max_trussness, std::move(histogram)};
+}
 /// \endcond DO_NOT_DOCUMENT
 
 void
 katana::analytics::KTrussStatistics::Print(std::ostream& os) const {
   os << "Number of nodes in the core = " << number_of_edges_left << std::endl;
 }
+
+uint64_t
+katana::analytics::KTrussDecompositionStatistics::TrussSize(uint32_t k) const {
+  uint64_t size = 0;
+  for (size_t i = k; i < trussness_histogram.size(); ++i) {
+    size += trussness_histogram[i];
+  }
+  return size;
+}
+
+void
+katana::analytics::KTrussDecompositionStatistics::Print(
+    std::ostream& os) const {
+  os << "Maximum trussness = " << max_trussness << std::endl;
+  for (size_t k = 0; k < trussness_histogram.size(); ++k) {
+    if (trussness_histogram[k] > 0) {
+      os << "Number of edges with trussness " << k << " = "
+         << trussness_histogram[k] << std::endl;
+    }
+  }
+}
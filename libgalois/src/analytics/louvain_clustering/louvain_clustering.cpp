@@ -0,0 +1,889 @@
+#include "katana/analytics/louvain_clustering/louvain_clustering.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/ParallelSTL.h"
+#include "katana/TypedPropertyGraph.h"
+
+using namespace katana::analytics;
+
+const int LouvainClusteringPlan::kChunkSize = 16;
+
+namespace {
+
+using ClusterType = uint64_t;
+struct NodeCluster : public katana::PODProperty<ClusterType> {};
+
+using NodeData = std::tuple<NodeCluster>;
+using EdgeData = std::tuple<>;
+typedef katana::TypedPropertyGraph<NodeData, EdgeData> Graph;
+typedef typename Graph::Node GNode;
+
+template <typename Weight>
+struct EdgeWeight : public katana::PODProperty<Weight> {};
+
+constexpr uint32_t kNoCluster = std::numeric_limits<uint32_t>::max();
+
+/// A symmetric graph in compressed sparse row form. Level 0 is the input
+/// graph; each node of a coarser level is a cluster of nodes of the level
+/// before it. The edges of a coarse node sum the weights of the edges between
+/// the clusters, and the edges within its cluster become a self loop, so the
+/// weighted degree of a cluster is the same in both levels.
+struct LevelGraph {
+  uint64_t num_nodes{0};
+  const uint64_t* indices{nullptr};
+  const uint32_t* dests{nullptr};
+  const double* weights{nullptr};
+
+  //! The buffers of a coarse level; level 0 shares the topology of the input
+  //! and only owns its weights
+  katana::LargeArray<uint64_t> owned_indices;
+  katana::LargeArray<uint32_t> owned_dests;
+  katana::LargeArray<double> owned_weights;
+
+  uint64_t EdgeBegin(uint32_t n) const { return n > 0 ? indices[n - 1] : 0; }
+  uint64_t EdgeEnd(uint32_t n) const { return indices[n]; }
+};
+
+/// (cluster, weight) pairs gathered from the edges of some nodes
+using ClusterWeights = std::vector<std::pair<uint32_t, double>>;
+
+/// Sort weights by cluster and sum the weights of each cluster
+void
+SortAndMerge(ClusterWeights* weights) {
+  std::sort(weights->begin(), weights->end(), [](const auto& a, const auto& b) {
+    return a.first < b.first;
+  });
+  size_t merged = 0;
+  for (size_t i = 0; i < weights->size(); ++i) {
+    if (merged > 0 && (*weights)[merged - 1].first == (*weights)[i].first) {
+      (*weights)[merged - 1].second += (*weights)[i].second;
+    } else {
+      (*weights)[merged++] = (*weights)[i];
+    }
+  }
+  weights->resize(merged);
+}
+
+/// Sum the weights of the edges from n to each cluster into weights, sorted
+/// by cluster. Self loops and neighbors whose cluster_of is kNoCluster are
+/// skipped.
+template <typename ClusterFn>
+void
+GatherNeighborClusters(
+    const LevelGraph& graph, uint32_t n, ClusterFn cluster_of,
+    ClusterWeights* weights) {
+  weights->clear();
+  for (uint64_t e = graph.EdgeBegin(n); e < graph.EdgeEnd(n); ++e) {
+    uint32_t dest = graph.dests[e];
+    if (dest == n) {
+      continue;
+    }
+    uint32_t cluster = cluster_of(dest);
+    if (cluster != kNoCluster) {
+      weights->emplace_back(cluster, graph.weights[e]);
+    }
+  }
+  SortAndMerge(weights);
+}
+
+/// The weight of the edges of n that go to cluster, or 0 if there are none
+double
+WeightTo(const ClusterWeights& weights, uint32_t cluster) {
+  auto it = std::lower_bound(
+      weights.begin(), weights.end(), cluster,
+      [](const auto& pair, uint32_t c) { return pair.first < c; });
+  return it != weights.end() && it->first == cluster ? it->second : 0;
+}
+
+/// The clusters of the nodes of a level graph, with the sum of the weighted
+/// degrees and the number of nodes of each cluster
+struct Clustering {
+  katana::LargeArray<std::atomic<uint32_t>> cluster;
+  katana::LargeArray<std::atomic<double>> total;
+  katana::LargeArray<std::atomic<uint32_t>> size;
+
+  uint32_t ClusterOf(uint32_t n) const {
+    return cluster[n].load(std::memory_order_relaxed);
+  }
+  double Total(uint32_t c) const {
+    return total[c].load(std::memory_order_relaxed);
+  }
+  uint32_t Size(uint32_t c) const {
+    return size[c].load(std::memory_order_relaxed);
+  }
+
+  /// Start from initial[n], which must be less than the number of nodes
+  Clustering(
+      const LevelGraph& graph, const katana::LargeArray<double>& degree,
+      const katana::LargeArray<uint32_t>& initial) {
+    uint64_t num_nodes = graph.num_nodes;
+    cluster.allocateInterleaved(num_nodes);
+    total.allocateInterleaved(num_nodes);
+    size.allocateInterleaved(num_nodes);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) {
+          total[n].store(0, std::memory_order_relaxed);
+          size[n].store(0, std::memory_order_relaxed);
+        },
+        katana::no_stats());
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) {
+          uint32_t c = initial[n];
+          cluster[n].store(c, std::memory_order_relaxed);
+          katana::atomicAdd(total[c], degree[n]);
+          size[c].fetch_add(1, std::memory_order_relaxed);
+        },
+        katana::no_stats());
+  }
+};
+
+/// The nodes of a graph grouped by their cluster
+struct Members {
+  //! The end of the nodes of each cluster in nodes
+  katana::LargeArray<uint64_t> offsets;
+  katana::LargeArray<uint32_t> nodes;
+
+  uint64_t Begin(uint32_t c) const { return c > 0 ? offsets[c - 1] : 0; }
+  uint64_t End(uint32_t c) const { return offsets[c]; }
+
+  /// Group the nodes by cluster_of(n), which must be less than num_clusters.
+  /// The nodes of each cluster are in increasing order.
+  template <typename ClusterFn>
+  Members(uint64_t num_nodes, uint64_t num_clusters, ClusterFn cluster_of) {
+    katana::LargeArray<std::atomic<uint64_t>> cursor;
+    cursor.allocateInterleaved(num_clusters);
+    offsets.allocateInterleaved(num_clusters);
+    nodes.allocateInterleaved(num_nodes);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_clusters),
+        [&](uint64_t c) { cursor[c].store(0, std::memory_order_relaxed); },
+        katana::no_stats());
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) {
+          cursor[cluster_of(n)].fetch_add(1, std::memory_order_relaxed);
+        },
+        katana::no_stats());
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_clusters),
+        [&](uint64_t c) {
+          offsets[c] = cursor[c].load(std::memory_order_relaxed);
+        },
+        katana::no_stats());
+    katana::ParallelSTL::partial_sum(
+        offsets.begin(), offsets.end(), offsets.begin());
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_clusters),
+        [&](uint64_t c) {
+          cursor[c].store(Begin(c), std::memory_order_relaxed);
+        },
+        katana::no_stats());
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) {
+          nodes[cursor[cluster_of(n)].fetch_add(
+              1, std::memory_order_relaxed)] = n;
+        },
+        katana::no_stats());
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_clusters),
+        [&](uint64_t c) {
+          std::sort(nodes.begin() + Begin(c), nodes.begin() + End(c));
+        },
+        katana::steal(), katana::no_stats());
+  }
+};
+
+/// The sum of the weights of the edges of each node. Their sum, which is
+/// twice the weight of the edges, is stored in total_weight.
+katana::LargeArray<double>
+WeightedDegrees(const LevelGraph& graph, double* total_weight) {
+  katana::LargeArray<double> degree;
+  degree.allocateInterleaved(graph.num_nodes);
+  katana::GAccumulator<double> total;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](uint64_t n) {
+        double sum = 0;
+        for (uint64_t e = graph.EdgeBegin(n); e < graph.EdgeEnd(n); ++e) {
+          sum += graph.weights[e];
+        }
+        degree[n] = sum;
+        total += sum;
+      },
+      katana::no_stats());
+  *total_weight = total.reduce();
+  return degree;
+}
+
+/// The modularity of a clustering of a graph whose degrees sum to
+/// total_weight, which is twice the weight of its edges:
+///   sum over clusters c of in(c) / total_weight
+///       - resolution * (total(c) / total_weight)^2
+/// where in(c) sums the weights of the edges within c in both directions.
+double
+Modularity(
+    const LevelGraph& graph, const Clustering& clustering, double total_weight,
+    double resolution) {
+  katana::GAccumulator<double> internal;
+  katana::GAccumulator<double> expected;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](uint64_t n) {
+        uint32_t c = clustering.ClusterOf(n);
+        double sum = 0;
+        for (uint64_t e = graph.EdgeBegin(n); e < graph.EdgeEnd(n); ++e) {
+          if (clustering.ClusterOf(graph.dests[e]) == c) {
+            sum += graph.weights[e];
+          }
+        }
+        internal += sum;
+        double total = clustering.Total(n);
+        expected += total * total;
+      },
+      katana::no_stats());
+  return internal.reduce() / total_weight -
+         resolution * expected.reduce() / (total_weight * total_weight);
+}
+
+/// One round of moving every node to the neighboring cluster that gains the
+/// most modularity. The nodes move in parallel, each seeing the moves made
+/// so far, as in the doall variant of the Lonestar application.
+void
+MoveNodes(
+    const LevelGraph& graph, const katana::LargeArray<double>& degree,
+    double total_weight, double resolution, Clustering* clustering,
+    katana::PerThreadStorage<ClusterWeights>* scratch) {
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](uint64_t n) {
+        ClusterWeights& neighbors = *scratch->getLocal();
+        GatherNeighborClusters(
+            graph, n, [&](uint32_t m) { return clustering->ClusterOf(m); },
+            &neighbors);
+
+        //! The gain of joining cluster c from a cluster of its own is
+        //!   weight(n, c) - resolution * degree(n) * total(c) / total_weight
+        //! up to a constant factor; n does not count towards its own cluster.
+        uint32_t current = clustering->ClusterOf(n);
+        double scale = resolution * degree[n] / total_weight;
+        uint32_t best = current;
+        double best_gain = WeightTo(neighbors, current) -
+                           scale * (clustering->Total(current) - degree[n]);
+        for (const auto& [c, weight] : neighbors) {
+          if (c == current) {
+            continue;
+          }
+          double gain = weight - scale * clustering->Total(c);
+          if (gain < best_gain ||
+              (gain == best_gain && (best == current || c > best))) {
+            continue;
+          }
+          //! Two nodes alone in their clusters could swap clusters forever,
+          //! so only the larger one moves into the cluster of the smaller one.
+          if (clustering->Size(current) == 1 && clustering->Size(c) == 1 &&
+              c > current) {
+            continue;
+          }
+          best = c;
+          best_gain = gain;
+        }
+
+        if (best != current) {
+          katana::atomicAdd(clustering->total[best], degree[n]);
+          katana::atomicAdd(clustering->total[current], -degree[n]);
+          clustering->size[best].fetch_add(1, std::memory_order_relaxed);
+          clustering->size[current].fetch_sub(1, std::memory_order_relaxed);
+          clustering->cluster[n].store(best, std::memory_order_relaxed);
+        }
+      },
+      katana::steal(), katana::chunk_size<LouvainClusteringPlan::kChunkSize>(),
+      katana::loopname("LouvainMoveNodes"));
+}
+
+/// Number the clusters with nodes from 0 and store the number of the cluster
+/// of each node in numbered. Returns the number of clusters.
+template <typename ClusterFn>
+uint64_t
+Renumber(
+    uint64_t num_nodes, const katana::LargeArray<std::atomic<uint32_t>>& size,
+    ClusterFn cluster_of, katana::LargeArray<uint32_t>* numbered) {
+  if (num_nodes == 0) {
+    return 0;
+  }
+  katana::LargeArray<uint32_t> prefix;
+  prefix.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t c) {
+        prefix[c] = size[c].load(std::memory_order_relaxed) > 0 ? 1 : 0;
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      prefix.begin(), prefix.end(), prefix.begin());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { (*numbered)[n] = prefix[cluster_of(n)] - 1; },
+      katana::no_stats());
+  return prefix[num_nodes - 1];
+}
+
+/**
+ * The refinement phase of Leiden. Split each cluster into subclusters that
+ * are well connected to the rest of their cluster, starting from a subcluster
+ * per node. Each node of a cluster that is still alone and well connected
+ * joins a well-connected subcluster of a neighbor in the same cluster, chosen
+ * at random among those that do not lose modularity with a probability that
+ * grows exponentially with the gain, at a rate of 1 / randomness.
+ *
+ * Each cluster is refined serially by one thread, so the subclusters are
+ * numbered by their first node and the result only depends on the clustering.
+ */
+void
+Refine(
+    const LevelGraph& graph, const katana::LargeArray<double>& degree,
+    double total_weight, double resolution, double randomness,
+    const katana::LargeArray<uint32_t>& cluster, const Members& members,
+    uint64_t num_clusters, katana::LargeArray<uint32_t>* subcluster,
+    katana::LargeArray<std::atomic<uint32_t>>* subcluster_size,
+    katana::PerThreadStorage<ClusterWeights>* scratch) {
+  //! The sum of the weighted degrees of each subcluster and the weight of
+  //! its edges to the rest of its cluster
+  katana::LargeArray<double> sub_total;
+  katana::LargeArray<double> sub_cut;
+  sub_total.allocateInterleaved(graph.num_nodes);
+  sub_cut.allocateInterleaved(graph.num_nodes);
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_clusters),
+      [&](uint64_t c) {
+        ClusterWeights& neighbors = *scratch->getLocal();
+        std::vector<double> candidates;
+        std::mt19937_64 generator(c);
+        auto same_cluster = [&](uint32_t m) {
+          return cluster[m] == c ? (*subcluster)[m] : kNoCluster;
+        };
+
+        double cluster_total = 0;
+        for (uint64_t i = members.Begin(c); i < members.End(c); ++i) {
+          uint32_t n = members.nodes[i];
+          double cut = 0;
+          for (uint64_t e = graph.EdgeBegin(n); e < graph.EdgeEnd(n); ++e) {
+            uint32_t dest = graph.dests[e];
+            if (dest != n && cluster[dest] == c) {
+              cut += graph.weights[e];
+            }
+          }
+          (*subcluster)[n] = n;
+          (*subcluster_size)[n].store(1, std::memory_order_relaxed);
+          sub_total[n] = degree[n];
+          sub_cut[n] = cut;
+          cluster_total += degree[n];
+        }
+
+        //! A subcluster is well connected if the weight of its edges to the
+        //! rest of the cluster is at least what the resolution expects
+        auto well_connected = [&](uint32_t s) {
+          return sub_cut[s] >= resolution * sub_total[s] *
+                                   (cluster_total - sub_total[s]) /
+                                   total_weight;
+        };
+
+        for (uint64_t i = members.Begin(c); i < members.End(c); ++i) {
+          uint32_t n = members.nodes[i];
+          if ((*subcluster)[n] != n ||
+              (*subcluster_size)[n].load(std::memory_order_relaxed) != 1 ||
+              !well_connected(n)) {
+            continue;
+          }
+
+          GatherNeighborClusters(graph, n, same_cluster, &neighbors);
+          double scale = resolution * degree[n] / total_weight;
+          double max_gain = 0;
+          candidates.clear();
+          for (const auto& [s, weight] : neighbors) {
+            double gain = -1;
+            if (s != n && well_connected(s)) {
+              gain = weight - scale * sub_total[s];
+            }
+            candidates.push_back(gain);
+            max_gain = std::max(max_gain, gain);
+          }
+
+          //! Weights relative to the best gain do not overflow
+          double sum = 0;
+          for (double& gain : candidates) {
+            sum += gain >= 0 ? std::exp((gain - max_gain) / randomness) : 0;
+            gain = sum;
+          }
+          if (sum == 0) {
+            continue;
+          }
+          double r = std::uniform_real_distribution<double>(0, sum)(generator);
+          size_t chosen = std::upper_bound(
+                              candidates.begin(), candidates.end(), r) -
+                          candidates.begin();
+          chosen = std::min(chosen, candidates.size() - 1);
+          while (chosen > 0 && candidates[chosen] == candidates[chosen - 1]) {
+            --chosen;
+          }
+          auto [s, weight] = neighbors[chosen];
+
+          sub_cut[s] += sub_cut[n] - 2 * weight;
+          sub_total[s] += degree[n];
+          (*subcluster)[n] = s;
+          (*subcluster_size)[s].fetch_add(1, std::memory_order_relaxed);
+          (*subcluster_size)[n].store(0, std::memory_order_relaxed);
+        }
+      },
+      katana::steal(), katana::loopname("LeidenRefine"));
+}
+
+/// Merge the nodes of graph in each cluster of members into a node of a
+/// coarser graph. The edges of each cluster are gathered twice, first to size
+/// the compact CSR arrays of the coarser graph and then to fill them in.
+std::unique_ptr<LevelGraph>
+Coarsen(
+    const LevelGraph& graph, const katana::LargeArray<uint32_t>& cluster,
+    const Members& members, uint64_t num_clusters,
+    katana::PerThreadStorage<ClusterWeights>* scratch) {
+  auto gather = [&](uint32_t c, ClusterWeights* edges) {
+    edges->clear();
+    for (uint64_t i = members.Begin(c); i < members.End(c); ++i) {
+      uint32_t n = members.nodes[i];
+      for (uint64_t e = graph.EdgeBegin(n); e < graph.EdgeEnd(n); ++e) {
+        edges->emplace_back(cluster[graph.dests[e]], graph.weights[e]);
+      }
+    }
+    SortAndMerge(edges);
+  };
+
+  auto coarse = std::make_unique<LevelGraph>();
+  coarse->num_nodes = num_clusters;
+  coarse->owned_indices.allocateInterleaved(num_clusters);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_clusters),
+      [&](uint64_t c) {
+        ClusterWeights& edges = *scratch->getLocal();
+        gather(c, &edges);
+        coarse->owned_indices[c] = edges.size();
+      },
+      katana::steal(), katana::loopname("LouvainCoarsenCount"));
+  katana::ParallelSTL::partial_sum(
+      coarse->owned_indices.begin(), coarse->owned_indices.end(),
+      coarse->owned_indices.begin());
+  coarse->indices = coarse->owned_indices.data();
+
+  uint64_t num_edges = num_clusters > 0 ? coarse->indices[num_clusters - 1] : 0;
+  coarse->owned_dests.allocateInterleaved(num_edges);
+  coarse->owned_weights.allocateInterleaved(num_edges);
+  coarse->dests = coarse->owned_dests.data();
+  coarse->weights = coarse->owned_weights.data();
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_clusters),
+      [&](uint64_t c) {
+        ClusterWeights& edges = *scratch->getLocal();
+        gather(c, &edges);
+        uint64_t begin = coarse->EdgeBegin(c);
+        for (size_t i = 0; i < edges.size(); ++i) {
+          coarse->owned_dests[begin + i] = edges[i].first;
+          coarse->owned_weights[begin + i] = edges[i].second;
+        }
+      },
+      katana::steal(), katana::loopname("LouvainCoarsenFill"));
+
+  return coarse;
+}
+
+/// Cluster the nodes of the level 0 graph input and return the cluster of
+/// each node, numbered from 0.
+katana::LargeArray<uint32_t>
+ClusterLevels(std::unique_ptr<LevelGraph> input, LouvainClusteringPlan plan) {
+  uint64_t num_input_nodes = input->num_nodes;
+  bool leiden = plan.algorithm() == LouvainClusteringPlan::kLeiden;
+
+  //! The node of the current level that each input node is in
+  katana::LargeArray<uint32_t> node_of;
+  node_of.allocateInterleaved(num_input_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_input_nodes),
+      [&](uint64_t n) { node_of[n] = n; }, katana::no_stats());
+
+  std::unique_ptr<LevelGraph> graph = std::move(input);
+  katana::LargeArray<uint32_t> initial;
+  initial.allocateInterleaved(graph->num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph->num_nodes),
+      [&](uint64_t n) { initial[n] = n; }, katana::no_stats());
+  katana::PerThreadStorage<ClusterWeights> scratch;
+
+  for (uint32_t level = 0;; ++level) {
+    double total_weight = 0;
+    katana::LargeArray<double> degree = WeightedDegrees(*graph, &total_weight);
+    Clustering clustering(*graph, degree, initial);
+
+    double start_modularity = 0;
+    double modularity = 0;
+    if (total_weight > 0) {
+      start_modularity = Modularity(
+          *graph, clustering, total_weight, plan.resolution());
+      modularity = start_modularity;
+      for (uint32_t i = 0; i < plan.max_iterations(); ++i) {
+        MoveNodes(
+            *graph, degree, total_weight, plan.resolution(), &clustering,
+            &scratch);
+        double next = Modularity(
+            *graph, clustering, total_weight, plan.resolution());
+        double gain = next - modularity;
+        modularity = next;
+        if (gain < plan.min_modularity_gain()) {
+          break;
+        }
+      }
+    }
+
+    katana::LargeArray<uint32_t> cluster;
+    cluster.allocateInterleaved(graph->num_nodes);
+    uint64_t num_clusters = Renumber(
+        graph->num_nodes, clustering.size,
+        [&](uint32_t n) { return clustering.ClusterOf(n); }, &cluster);
+
+    bool last = level + 1 >= plan.max_levels() ||
+                num_clusters == graph->num_nodes ||
+                (level > 0 &&
+                 modularity - start_modularity < plan.min_modularity_gain());
+
+    //! The clusters of the current level become the nodes of the next
+    //! level, or for Leiden their refined subclusters
+    katana::LargeArray<uint32_t> next_node;
+    uint64_t num_next_nodes = num_clusters;
+    if (leiden && !last) {
+      Members members(graph->num_nodes, num_clusters, [&](uint32_t n) {
+        return cluster[n];
+      });
+      katana::LargeArray<uint32_t> subcluster;
+      katana::LargeArray<std::atomic<uint32_t>> subcluster_size;
+      subcluster.allocateInterleaved(graph->num_nodes);
+      subcluster_size.allocateInterleaved(graph->num_nodes);
+      Refine(
+          *graph, degree, total_weight, plan.resolution(), plan.randomness(),
+          cluster, members, num_clusters, &subcluster, &subcluster_size,
+          &scratch);
+      next_node.allocateInterleaved(graph->num_nodes);
+      num_next_nodes = Renumber(
+          graph->num_nodes, subcluster_size,
+          [&](uint32_t n) { return subcluster[n]; }, &next_node);
+      last = num_next_nodes == graph->num_nodes;
+    }
+
+    if (last) {
+      katana::do_all(
+          katana::iterate(uint64_t{0}, num_input_nodes),
+          [&](uint64_t n) { node_of[n] = cluster[node_of[n]]; },
+          katana::no_stats());
+      return node_of;
+    }
+    if (!leiden) {
+      next_node = std::move(cluster);
+    }
+
+    Members members(graph->num_nodes, num_next_nodes, [&](uint32_t n) {
+      return next_node[n];
+    });
+    std::unique_ptr<LevelGraph> coarse =
+        Coarsen(*graph, next_node, members, num_next_nodes, &scratch);
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_input_nodes),
+        [&](uint64_t n) { node_of[n] = next_node[node_of[n]]; },
+        katana::no_stats());
+
+    //! Louvain starts the next level from a cluster per node; Leiden starts
+    //! from the clusters before refinement
+    katana::LargeArray<uint32_t> next_initial;
+    next_initial.allocateInterleaved(num_next_nodes);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_next_nodes),
+        [&](uint64_t s) {
+          next_initial[s] =
+              leiden ? cluster[members.nodes[members.Begin(s)]] : s;
+        },
+        katana::no_stats());
+
+    initial = std::move(next_initial);
+    graph = std::move(coarse);
+  }
+}
+
+/// Copy the weights of the edges of pg in edge_weight_property_name to
+/// weights
+template <typename Weight>
+katana::Result<void>
+CopyEdgeWeights(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    katana::LargeArray<double>* weights) {
+  using WeightGraph = katana::TypedPropertyGraph<
+      std::tuple<>, std::tuple<EdgeWeight<Weight>>>;
+  auto pg_result = WeightGraph::Make(pg, {}, {edge_weight_property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        for (auto e : graph.edges(n)) {
+          (*weights)[e] = graph.template GetEdgeData<EdgeWeight<Weight>>(e);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  return katana::ResultSuccess();
+}
+
+/// The level 0 graph of pg with the weights in edge_weight_property_name, or
+/// unit weights if it is empty
+katana::Result<std::unique_ptr<LevelGraph>>
+MakeInputGraph(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name) {
+  if (pg->has_wide_node_ids()) {
+    return katana::ErrorCode::NotImplemented;
+  }
+  auto graph = std::make_unique<LevelGraph>();
+  graph->num_nodes = pg->num_nodes();
+  graph->indices = pg->topology().out_indices->raw_values();
+  graph->dests = pg->topology().out_dests->raw_values();
+  graph->owned_weights.allocateInterleaved(pg->num_edges());
+  graph->weights = graph->owned_weights.data();
+
+  if (edge_weight_property_name.empty()) {
+    katana::do_all(
+        katana::iterate(uint64_t{0}, pg->num_edges()),
+        [&](uint64_t e) { graph->owned_weights[e] = 1; }, katana::no_stats());
+    return graph;
+  }
+
+  katana::Result<void> result = katana::ResultSuccess();
+  switch (pg->GetEdgeProperty(edge_weight_property_name)->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    result = CopyEdgeWeights<uint32_t>(
+        pg, edge_weight_property_name, &graph->owned_weights);
+    break;
+  case arrow::Int32Type::type_id:
+    result = CopyEdgeWeights<int32_t>(
+        pg, edge_weight_property_name, &graph->owned_weights);
+    break;
+  case arrow::UInt64Type::type_id:
+    result = CopyEdgeWeights<uint64_t>(
+        pg, edge_weight_property_name, &graph->owned_weights);
+    break;
+  case arrow::Int64Type::type_id:
+    result = CopyEdgeWeights<int64_t>(
+        pg, edge_weight_property_name, &graph->owned_weights);
+    break;
+  case arrow::FloatType::type_id:
+    result = CopyEdgeWeights<float>(
+        pg, edge_weight_property_name, &graph->owned_weights);
+    break;
+  case arrow::DoubleType::type_id:
+    result = CopyEdgeWeights<double>(
+        pg, edge_weight_property_name, &graph->owned_weights);
+    break;
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+  if (!result) {
+    return result.error();
+  }
+  return graph;
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::LouvainClustering(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, LouvainClusteringPlan plan) {
+  if ((plan.algorithm() != LouvainClusteringPlan::kDoAll &&
+       plan.algorithm() != LouvainClusteringPlan::kLeiden) ||
+      !(plan.resolution() >= 0) || plan.max_levels() == 0 ||
+      !(plan.randomness() > 0)) {
+    return ErrorCode::InvalidArgument;
+  }
+
+  auto input_result = MakeInputGraph(pg, edge_weight_property_name);
+  if (!input_result) {
+    return input_result.error();
+  }
+
+  if (auto result =
+          ConstructNodeProperties<NodeData>(pg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = Graph::Make(pg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::StatTimer exec_time("LouvainClustering");
+  exec_time.start();
+  katana::LargeArray<uint32_t> cluster =
+      ClusterLevels(std::move(input_result.value()), plan);
+  exec_time.stop();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) { graph.GetData<NodeCluster>(n) = cluster[n]; },
+      katana::no_stats());
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::LouvainClusteringAssertValid(
+    PropertyGraph* pg, const std::string& property_name) {
+  auto pg_result = Graph::Make(pg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::LargeArray<std::atomic<bool>> used;
+  used.allocateInterleaved(graph.size());
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) { used[n].store(false, std::memory_order_relaxed); },
+      katana::no_stats());
+
+  katana::GReduceMax<ClusterType> max_cluster;
+  katana::GReduceLogicalOr out_of_range;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        ClusterType c = graph.GetData<NodeCluster>(n);
+        if (c >= graph.size()) {
+          out_of_range.update(true);
+          return;
+        }
+        used[c].store(true, std::memory_order_relaxed);
+        max_cluster.update(c);
+      },
+      katana::no_stats());
+  if (out_of_range.reduce()) {
+    KATANA_LOG_DEBUG("cluster ids must be less than the number of nodes");
+    return katana::ErrorCode::AssertionFailed;
+  }
+
+  katana::GReduceLogicalOr gap;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& c) {
+        if (c <= max_cluster.reduce() &&
+            !used[c].load(std::memory_order_relaxed)) {
+          gap.update(true);
+        }
+      },
+      katana::no_stats());
+  if (gap.reduce()) {
+    KATANA_LOG_DEBUG("cluster ids must be numbered without gaps");
+    return katana::ErrorCode::AssertionFailed;
+  }
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<LouvainClusteringStatistics>
+katana::analytics::LouvainClusteringStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  auto pg_result = Graph::Make(pg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  auto input_result = MakeInputGraph(pg, edge_weight_property_name);
+  if (!input_result) {
+    return input_result.error();
+  }
+  const LevelGraph& input = *input_result.value();
+
+  katana::LargeArray<uint32_t> cluster;
+  cluster.allocateInterleaved(graph.size());
+  katana::GReduceLogicalOr out_of_range;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        ClusterType c = graph.GetData<NodeCluster>(n);
+        if (c >= graph.size()) {
+          out_of_range.update(true);
+          return;
+        }
+        cluster[n] = c;
+      },
+      katana::no_stats());
+  if (out_of_range.reduce()) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  double total_weight = 0;
+  katana::LargeArray<double> degree = WeightedDegrees(input, &total_weight);
+  Clustering clustering(input, degree, cluster);
+  double modularity = 0;
+  if (total_weight > 0) {
+    modularity = Modularity(input, clustering, total_weight, 1.0);
+  }
+
+  katana::GAccumulator<uint64_t> n_clusters;
+  katana::GAccumulator<uint64_t> n_non_trivial_clusters;
+  katana::GReduceMax<uint64_t> largest_cluster;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& c) {
+        uint64_t size = clustering.Size(c);
+        if (size > 0) {
+          n_clusters += 1;
+        }
+        if (size > 1) {
+          n_non_trivial_clusters += 1;
+        }
+        largest_cluster.update(size);
+      },
+      katana::loopname("CountLargest"));
+
+  uint64_t largest_cluster_size = largest_cluster.reduce();
+  double largest_cluster_proportion = 0;
+  if (!graph.empty()) {
+    largest_cluster_proportion = double(largest_cluster_size) / graph.size();
+  }
+
+  return LouvainClusteringStatistics{
+      n_clusters.reduce(), n_non_trivial_clusters.reduce(),
+      largest_cluster_size, largest_cluster_proportion, modularity};
+}
+
+void
+katana::analytics::LouvainClusteringStatistics::Print(std::ostream& os) const {
+  os << "Total number of clusters = " << n_clusters << std::endl;
+  os << "Total number of non trivial clusters = " << n_non_trivial_clusters
+     << std::endl;
+  os << "Number of nodes in the largest cluster = " << largest_cluster_size
+     << std::endl;
+  os << "Ratio of nodes in the largest cluster = " << largest_cluster_proportion
+     << std::endl;
+  os << "Modularity = " << modularity << std::endl;
+}
@@ -0,0 +1,694 @@
+#include "katana/analytics/matrix_completion/matrix_completion.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Reduction.h"
+#include "katana/SetIntersection.h"
+#include "katana/SimpleLock.h"
+#include "katana/TiledExecutor.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/LatentVectorKernels.h"
+
+using namespace katana::analytics;
+
+const int MatrixCompletionPlan::kChunkSize = 4;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+template <typename T>
+struct EdgeRating : public katana::PODProperty<T> {};
+
+/// Solve gram x = rhs for x, where gram is symmetric positive definite and
+/// only its upper triangle is set, by Cholesky factorization in place. Returns
+/// false if gram is not positive definite.
+bool
+CholeskySolve(float* gram, float* rhs, uint32_t n) {
+  // gram = U^T U with U in the upper triangle
+  for (uint32_t r = 0; r < n; ++r) {
+    float* row = gram + r * n;
+    for (uint32_t k = 0; k < r; ++k) {
+      float u = gram[k * n + r];
+      for (uint32_t c = r; c < n; ++c) {
+        row[c] -= u * gram[k * n + c];
+      }
+    }
+    if (!(row[r] > 0)) {
+      return false;
+    }
+    float pivot = std::sqrt(row[r]);
+    for (uint32_t c = r; c < n; ++c) {
+      row[c] /= pivot;
+    }
+  }
+  // U^T y = rhs
+  for (uint32_t r = 0; r < n; ++r) {
+    for (uint32_t k = 0; k < r; ++k) {
+      rhs[r] -= gram[k * n + r] * rhs[k];
+    }
+    rhs[r] /= gram[r * n + r];
+  }
+  // U x = y
+  for (uint32_t r = n; r-- > 0;) {
+    for (uint32_t c = r + 1; c < n; ++c) {
+      rhs[r] -= gram[r * n + c] * rhs[c];
+    }
+    rhs[r] /= gram[r * n + r];
+  }
+  return true;
+}
+
+/// The interface of the legacy graphs that Fixed2DGraphTiledExecutor expects,
+/// over a GraphTopology
+struct TiledTopology {
+  using GraphNode = Node;
+  using iterator = katana::GraphTopology::iterator;
+  using edge_iterator = katana::GraphTopology::edge_iterator;
+
+  const katana::GraphTopology& topology;
+
+  iterator begin() const { return topology.begin(); }
+  iterator end() const { return topology.end(); }
+  edge_iterator edge_begin(GraphNode n, katana::MethodFlag) const {
+    return topology.edges(n).begin();
+  }
+  edge_iterator edge_end(GraphNode n, katana::MethodFlag) const {
+    return topology.edges(n).end();
+  }
+  GraphNode getEdgeDst(edge_iterator e) const {
+    return topology.out_dests->Value(*e);
+  }
+};
+
+/// The ratings of a bipartite graph
+struct Ratings {
+  const katana::GraphTopology& topology;
+  uint64_t num_items{0};
+  katana::LargeArray<float> values;
+
+  //! For ALS, the ratings of each user: user_indices[u] is the end of the
+  //! ratings of user num_items + u in user_items and user_values
+  katana::LargeArray<uint64_t> user_indices;
+  katana::LargeArray<Node> user_items;
+  katana::LargeArray<float> user_values;
+
+  uint64_t num_nodes() const { return topology.num_nodes(); }
+  uint64_t num_users() const { return num_nodes() - num_items; }
+  Edge Begin(Node n) const { return n > 0 ? End(n - 1) : 0; }
+  Edge End(Node n) const { return topology.out_indices->Value(n); }
+  Node Dest(Edge e) const { return topology.out_dests->Value(e); }
+};
+
+template <typename Rating>
+katana::Result<void>
+CopyRatings(
+    katana::PropertyGraph* pg, const std::string& property_name,
+    katana::LargeArray<float>* values) {
+  using RatingGraph =
+      katana::TypedPropertyGraph<std::tuple<>, std::tuple<EdgeRating<Rating>>>;
+  auto pg_result = RatingGraph::Make(pg, {}, {property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) {
+        for (auto e : graph.edges(n)) {
+          (*values)[e] = graph.template GetEdgeData<EdgeRating<Rating>>(e);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+LoadRatings(
+    katana::PropertyGraph* pg, const std::string& property_name,
+    Ratings* ratings) {
+  if (pg->has_wide_node_ids()) {
+    return katana::ErrorCode::NotImplemented;
+  }
+  const katana::GraphTopology& topology = pg->topology();
+
+  // Items are the nodes up to the last one with edges
+  katana::GReduceMax<uint64_t> num_items;
+  katana::do_all(
+      katana::iterate(topology),
+      [&](Node n) {
+        auto [begin, end] = topology.edge_range(n);
+        if (end > begin) {
+          num_items.update(n + 1);
+        }
+      },
+      katana::no_stats());
+  ratings->num_items = topology.num_edges() > 0 ? num_items.reduce() : 0;
+
+  katana::GReduceLogicalOr not_bipartite;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, topology.num_edges()),
+      [&](Edge e) {
+        if (ratings->Dest(e) < ratings->num_items) {
+          not_bipartite.update(true);
+        }
+      },
+      katana::no_stats());
+  if (not_bipartite.reduce()) {
+    KATANA_LOG_DEBUG("every edge must go from an item to a user");
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  auto property = pg->GetEdgeProperty(property_name);
+  if (!property) {
+    return katana::ErrorCode::PropertyNotFound;
+  }
+  ratings->values.allocateInterleaved(topology.num_edges());
+  switch (property->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return CopyRatings<uint32_t>(pg, property_name, &ratings->values);
+  case arrow::Int32Type::type_id:
+    return CopyRatings<int32_t>(pg, property_name, &ratings->values);
+  case arrow::UInt64Type::type_id:
+    return CopyRatings<uint64_t>(pg, property_name, &ratings->values);
+  case arrow::Int64Type::type_id:
+    return CopyRatings<int64_t>(pg, property_name, &ratings->values);
+  case arrow::FloatType::type_id:
+    return CopyRatings<float>(pg, property_name, &ratings->values);
+  case arrow::DoubleType::type_id:
+    return CopyRatings<double>(pg, property_name, &ratings->values);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
+
+/// Group the ratings by user for the user half of ALS. The ratings of each
+/// user are in order of item so that the solution does not depend on the
+/// schedule.
+void
+TransposeRatings(Ratings* ratings) {
+  uint64_t num_items = ratings->num_items;
+  uint64_t num_users = ratings->num_users();
+  uint64_t num_edges = ratings->topology.num_edges();
+
+  katana::LargeArray<std::atomic<uint64_t>> next;
+  next.allocateInterleaved(num_users);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_users),
+      [&](uint64_t u) { next[u].store(0, std::memory_order_relaxed); },
+      katana::no_stats());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_edges),
+      [&](Edge e) {
+        next[ratings->Dest(e) - num_items].fetch_add(
+            1, std::memory_order_relaxed);
+      },
+      katana::no_stats());
+
+  ratings->user_indices.allocateInterleaved(num_users);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_users),
+      [&](uint64_t u) { ratings->user_indices[u] = next[u].load(); },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      ratings->user_indices.begin(), ratings->user_indices.end(),
+      ratings->user_indices.begin());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_users),
+      [&](uint64_t u) {
+        next[u].store(u > 0 ? ratings->user_indices[u - 1] : 0);
+      },
+      katana::no_stats());
+
+  ratings->user_items.allocateInterleaved(num_edges);
+  ratings->user_values.allocateInterleaved(num_edges);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_items),
+      [&](Node item) {
+        for (Edge e = ratings->Begin(item); e < ratings->End(item); ++e) {
+          uint64_t slot = next[ratings->Dest(e) - num_items].fetch_add(
+              1, std::memory_order_relaxed);
+          ratings->user_items[slot] = item;
+          ratings->user_values[slot] = ratings->values[e];
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_users),
+      [&](uint64_t u) {
+        uint64_t begin = u > 0 ? ratings->user_indices[u - 1] : 0;
+        uint64_t end = ratings->user_indices[u];
+        std::vector<std::pair<Node, float>> sorted;
+        for (uint64_t i = begin; i < end; ++i) {
+          sorted.emplace_back(ratings->user_items[i], ratings->user_values[i]);
+        }
+        std::sort(sorted.begin(), sorted.end());
+        for (uint64_t i = begin; i < end; ++i) {
+          ratings->user_items[i] = sorted[i - begin].first;
+          ratings->user_values[i] = sorted[i - begin].second;
+        }
+      },
+      katana::steal(), katana::no_stats());
+}
+
+float
+StepSize(const MatrixCompletionPlan& plan, uint32_t round) {
+  double learning_rate = plan.learning_rate();
+  switch (plan.step_function()) {
+  case MatrixCompletionPlan::kBottou:
+    return learning_rate / (1.0 + learning_rate * plan.lambda() * round);
+  case MatrixCompletionPlan::kIntel:
+    return learning_rate * std::pow(plan.decay_rate(), round);
+  case MatrixCompletionPlan::kInverse:
+    return 1.0 / (round + 1);
+  case MatrixCompletionPlan::kPurdue:
+  default:
+    return learning_rate * 1.5 /
+           (1.0 + plan.decay_rate() * std::pow(round + 1, 1.5));
+  }
+}
+
+/// A uniform float in [0, 1) that depends only on seed and i
+float
+RandomFloat(uint64_t seed, uint64_t i) {
+  uint64_t z = seed + (i + 1) * 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  z ^= z >> 31;
+  return static_cast<float>(z >> 40) * 0x1.0p-24F;
+}
+
+template <typename Kernel>
+class Solver {
+public:
+  Solver(
+      const Ratings& ratings, const MatrixCompletionPlan& plan, float* latent)
+      : ratings_(ratings),
+        plan_(plan),
+        latent_(latent),
+        size_(plan.latent_vector_size()) {}
+
+  /// Run rounds until the error converges; returns the number of rounds.
+  katana::Result<uint32_t> Run() {
+    Initialize();
+
+    double last = -1;
+    uint32_t round = 0;
+    while (round < plan_.max_rounds()) {
+      switch (plan_.algorithm()) {
+      case MatrixCompletionPlan::kSGDByEdges:
+        SGDByEdgesRound(StepSize(plan_, round));
+        break;
+      case MatrixCompletionPlan::kSGDByItems:
+        SGDByItemsRound(StepSize(plan_, round));
+        break;
+      case MatrixCompletionPlan::kALS:
+        ALSRound();
+        break;
+      }
+      ++round;
+
+      double error = SumSquaredError();
+      if (!std::isfinite(error)) {
+        KATANA_LOG_DEBUG(
+            "matrix completion diverged in round {}; try a smaller learning "
+            "rate or a larger lambda",
+            round);
+        return katana::ErrorCode::InvalidArgument;
+      }
+      if (last >= 0 && std::abs(last - error) <= plan_.tolerance() * last) {
+        break;
+      }
+      last = error;
+    }
+    return round;
+  }
+
+  double SumSquaredError() {
+    katana::GAccumulator<double> error;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, ratings_.num_items),
+        [&](Node item) {
+          double item_error = 0;
+          for (Edge e = ratings_.Begin(item); e < ratings_.End(item); ++e) {
+            double diff =
+                Kernel::Dot(Vector(item), Vector(ratings_.Dest(e)), size_) -
+                ratings_.values[e];
+            item_error += diff * diff;
+          }
+          error += item_error;
+        },
+        katana::steal(), katana::no_stats());
+    return error.reduce();
+  }
+
+private:
+  float* Vector(Node n) const { return latent_ + uint64_t{n} * size_; }
+
+  void Initialize() {
+    float scale = 1 / std::sqrt(static_cast<float>(size_));
+    katana::do_all(
+        katana::iterate(uint64_t{0}, ratings_.num_nodes()),
+        [&](Node n) {
+          float* v = Vector(n);
+          for (uint32_t i = 0; i < size_; ++i) {
+            v[i] = scale * RandomFloat(plan_.seed(), uint64_t{n} * size_ + i);
+          }
+        },
+        katana::no_stats());
+  }
+
+  void SGDByEdgesRound(float step) {
+    if (ratings_.num_items == 0) {
+      return;
+    }
+    float lambda = plan_.lambda();
+    TiledTopology graph{ratings_.topology};
+    katana::Fixed2DGraphTiledExecutor<TiledTopology> executor(graph);
+    executor.execute(
+        graph.begin(), graph.begin() + ratings_.num_items,
+        graph.begin() + ratings_.num_items, graph.end(),
+        plan_.items_per_block(), plan_.users_per_block(),
+        [&](Node item, Node user, TiledTopology::edge_iterator edge) {
+          Kernel::Sgd(
+              Vector(item), Vector(user), ratings_.values[*edge], step, lambda,
+              size_);
+        },
+        /*_useLocks=*/true);
+  }
+
+  void SGDByItemsRound(float step) {
+    float lambda = plan_.lambda();
+    if (user_locks_.size() != ratings_.num_users()) {
+      user_locks_ = std::vector<katana::SimpleLock>(ratings_.num_users());
+    }
+    katana::do_all(
+        katana::iterate(uint64_t{0}, ratings_.num_items),
+        [&](Node item) {
+          for (Edge e = ratings_.Begin(item); e < ratings_.End(item); ++e) {
+            Node user = ratings_.Dest(e);
+            katana::SimpleLock& lock = user_locks_[user - ratings_.num_items];
+            lock.lock();
+            Kernel::Sgd(
+                Vector(item), Vector(user), ratings_.values[e], step, lambda,
+                size_);
+            lock.unlock();
+          }
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("MatrixCompletion-SGDByItems"));
+  }
+
+  /// Set the vector of n to the solution of the regularized least squares
+  /// problem over its ratings, with the other vectors fixed
+  template <typename ForEachRating>
+  void Solve(Node n, ForEachRating for_each_rating) {
+    std::vector<float>& gram = *grams_.getLocal();
+    std::vector<float>& rhs = *rhss_.getLocal();
+    gram.assign(size_ * size_, 0);
+    rhs.assign(size_, 0);
+    for_each_rating([&](Node other, float rating) {
+      Kernel::AddOuter(gram.data(), rhs.data(), Vector(other), rating, size_);
+    });
+    for (uint32_t i = 0; i < size_; ++i) {
+      gram[i * size_ + i] += plan_.lambda();
+    }
+    //! With lambda 0, a node with fewer ratings than the size of its vector
+    //! has no unique solution; keep its vector
+    if (CholeskySolve(gram.data(), rhs.data(), size_)) {
+      std::copy(rhs.begin(), rhs.end(), Vector(n));
+    }
+  }
+
+  void ALSRound() {
+    katana::do_all(
+        katana::iterate(uint64_t{0}, ratings_.num_items),
+        [&](Node item) {
+          Solve(item, [&](auto fn) {
+            for (Edge e = ratings_.Begin(item); e < ratings_.End(item); ++e) {
+              fn(ratings_.Dest(e), ratings_.values[e]);
+            }
+          });
+        },
+        katana::steal(),
+        katana::chunk_size<MatrixCompletionPlan::kChunkSize>(),
+        katana::loopname("MatrixCompletion-ALSItems"));
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, ratings_.num_users()),
+        [&](uint64_t u) {
+          Solve(ratings_.num_items + u, [&](auto fn) {
+            uint64_t begin = u > 0 ? ratings_.user_indices[u - 1] : 0;
+            for (uint64_t i = begin; i < ratings_.user_indices[u]; ++i) {
+              fn(ratings_.user_items[i], ratings_.user_values[i]);
+            }
+          });
+        },
+        katana::steal(),
+        katana::chunk_size<MatrixCompletionPlan::kChunkSize>(),
+        katana::loopname("MatrixCompletion-ALSUsers"));
+  }
+
+  const Ratings& ratings_;
+  const MatrixCompletionPlan& plan_;
+  float* latent_;
+  uint32_t size_;
+  std::vector<katana::SimpleLock> user_locks_;
+  katana::PerThreadStorage<std::vector<float>> grams_;
+  katana::PerThreadStorage<std::vector<float>> rhss_;
+};
+
+template <template <uint32_t> class Kernel>
+katana::Result<uint32_t>
+RunWithKernel(
+    const Ratings& ratings, const MatrixCompletionPlan& plan, float* latent) {
+  switch (plan.latent_vector_size()) {
+  case 16:
+    return Solver<Kernel<16>>(ratings, plan, latent).Run();
+  case 32:
+    return Solver<Kernel<32>>(ratings, plan, latent).Run();
+  case 64:
+    return Solver<Kernel<64>>(ratings, plan, latent).Run();
+  case 128:
+    return Solver<Kernel<128>>(ratings, plan, latent).Run();
+  default:
+    return Solver<Kernel<0>>(ratings, plan, latent).Run();
+  }
+}
+
+/// Run with the widest kernels the CPU supports
+katana::Result<uint32_t>
+Run(const Ratings& ratings, const MatrixCompletionPlan& plan, float* latent) {
+#if KATANA_LATENT_VECTOR_KERNELS_X86
+  katana::SimdLevel level = katana::GetSimdLevel();
+  if (level == katana::SimdLevel::kAVX512) {
+    return RunWithKernel<AVX512Kernel>(ratings, plan, latent);
+  }
+  if (level == katana::SimdLevel::kAVX2 && __builtin_cpu_supports("fma")) {
+    return RunWithKernel<AVX2Kernel>(ratings, plan, latent);
+  }
+#endif
+  return RunWithKernel<ScalarKernel>(ratings, plan, latent);
+}
+
+katana::Result<void>
+CheckPlan(const MatrixCompletionPlan& plan) {
+  if (plan.latent_vector_size() == 0 || !(plan.lambda() >= 0) ||
+      !(plan.tolerance() >= 0)) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+  switch (plan.algorithm()) {
+  case MatrixCompletionPlan::kSGDByEdges:
+    if (plan.items_per_block() == 0 || plan.users_per_block() == 0) {
+      return katana::ErrorCode::InvalidArgument;
+    }
+    [[fallthrough]];
+  case MatrixCompletionPlan::kSGDByItems:
+    if (!(plan.learning_rate() > 0)) {
+      return katana::ErrorCode::InvalidArgument;
+    }
+    return katana::ResultSuccess();
+  case MatrixCompletionPlan::kALS:
+    return katana::ResultSuccess();
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+}
+
+/// The latent vectors of property_name as floats
+katana::Result<std::shared_ptr<arrow::FloatArray>>
+GetLatentVectors(katana::PropertyGraph* pg, const std::string& property_name) {
+  auto property = pg->GetNodeProperty(property_name);
+  if (!property) {
+    return katana::ErrorCode::PropertyNotFound;
+  }
+  if (property->type()->id() != arrow::Type::FIXED_SIZE_LIST ||
+      property->num_chunks() != 1) {
+    return katana::ErrorCode::TypeError;
+  }
+  auto vectors =
+      std::static_pointer_cast<arrow::FixedSizeListArray>(property->chunk(0));
+  if (vectors->value_type()->id() != arrow::Type::FLOAT ||
+      vectors->offset() != 0) {
+    return katana::ErrorCode::TypeError;
+  }
+  return std::static_pointer_cast<arrow::FloatArray>(vectors->values());
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::MatrixCompletion(
+    PropertyGraph* pg, const std::string& edge_rating_property_name,
+    const std::string& output_property_name, MatrixCompletionPlan plan) {
+  if (auto result = CheckPlan(plan); !result) {
+    return result.error();
+  }
+
+  katana::StatTimer exec_time("MatrixCompletion");
+  exec_time.start();
+
+  Ratings ratings{pg->topology()};
+  if (auto result = LoadRatings(pg, edge_rating_property_name, &ratings);
+      !result) {
+    return result.error();
+  }
+
+  if (plan.algorithm() == MatrixCompletionPlan::kSGDByEdges) {
+    // The tiled executor finds the ratings of each block by binary search
+    GReduceLogicalOr unsorted;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, ratings.num_items),
+        [&](Node item) {
+          for (Edge e = ratings.Begin(item) + 1; e < ratings.End(item); ++e) {
+            if (ratings.Dest(e) < ratings.Dest(e - 1)) {
+              unsorted.update(true);
+              return;
+            }
+          }
+        },
+        katana::steal(), katana::no_stats());
+    if (unsorted.reduce()) {
+      KATANA_LOG_DEBUG("SGDByEdges needs edges sorted by destination");
+      return ErrorCode::InvalidArgument;
+    }
+  }
+  if (plan.algorithm() == MatrixCompletionPlan::kALS) {
+    TransposeRatings(&ratings);
+  }
+
+  uint64_t num_values = pg->num_nodes() * plan.latent_vector_size();
+  auto buffer_result = arrow::AllocateBuffer(num_values * sizeof(float));
+  if (!buffer_result.ok()) {
+    return ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::Buffer> buffer = std::move(buffer_result.ValueOrDie());
+  auto* latent = reinterpret_cast<float*>(buffer->mutable_data());
+
+  auto rounds_result = Run(ratings, plan, latent);
+  if (!rounds_result) {
+    return rounds_result.error();
+  }
+  katana::ReportStatSingle("MatrixCompletion", "Rounds", rounds_result.value());
+
+  exec_time.stop();
+
+  auto type =
+      arrow::fixed_size_list(arrow::float32(), plan.latent_vector_size());
+  auto vectors = std::make_shared<arrow::FixedSizeListArray>(
+      type, pg->num_nodes(),
+      std::make_shared<arrow::FloatArray>(num_values, buffer));
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field(output_property_name, type)}), {vectors});
+  if (auto r = pg->AddNodeProperties(table); !r) {
+    return r.error();
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::MatrixCompletionAssertValid(
+    PropertyGraph* pg, const std::string& property_name) {
+  auto values_result = GetLatentVectors(pg, property_name);
+  if (!values_result) {
+    return values_result.error();
+  }
+  std::shared_ptr<arrow::FloatArray> values = values_result.value();
+  if (values->null_count() > 0) {
+    return ErrorCode::AssertionFailed;
+  }
+
+  GReduceLogicalOr invalid;
+  katana::do_all(
+      katana::iterate(int64_t{0}, values->length()),
+      [&](int64_t i) {
+        if (!std::isfinite(values->Value(i))) {
+          invalid.update(true);
+        }
+      },
+      katana::no_stats());
+  if (invalid.reduce()) {
+    return ErrorCode::AssertionFailed;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<MatrixCompletionStatistics>
+katana::analytics::MatrixCompletionStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& edge_rating_property_name,
+    const std::string& property_name) {
+  auto values_result = GetLatentVectors(pg, property_name);
+  if (!values_result) {
+    return values_result.error();
+  }
+  std::shared_ptr<arrow::FloatArray> values = values_result.value();
+  if (pg->num_nodes() == 0 ||
+      values->length() % static_cast<int64_t>(pg->num_nodes()) != 0) {
+    return ErrorCode::InvalidArgument;
+  }
+
+  Ratings ratings{pg->topology()};
+  if (auto result = LoadRatings(pg, edge_rating_property_name, &ratings);
+      !result) {
+    return result.error();
+  }
+
+  uint32_t size = values->length() / pg->num_nodes();
+  const float* latent = values->raw_values();
+  katana::GAccumulator<double> error;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, ratings.num_items),
+      [&](Node item) {
+        for (Edge e = ratings.Begin(item); e < ratings.End(item); ++e) {
+          double diff = ScalarKernel<0>::Dot(
+                            latent + uint64_t{item} * size,
+                            latent + uint64_t{ratings.Dest(e)} * size, size) -
+                        ratings.values[e];
+          error += diff * diff;
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  uint64_t num_ratings = pg->num_edges();
+  return MatrixCompletionStatistics{
+      .num_items = ratings.num_items,
+      .num_users = ratings.num_users(),
+      .rmse = num_ratings ? std::sqrt(error.reduce() / num_ratings) : 0,
+  };
+}
+
+void
+katana::analytics::MatrixCompletionStatistics::Print(std::ostream& os) const {
+  os << "Number of items = " << num_items << std::endl;
+  os << "Number of users = " << num_users << std::endl;
+  os << "RMSE = " << rmse << std::endl;
+}
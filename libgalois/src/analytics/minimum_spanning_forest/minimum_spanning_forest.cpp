@@ -0,0 +1,553 @@
+#include "katana/analytics/minimum_spanning_forest/minimum_spanning_forest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include "katana/ParallelSTL.h"
+#include "katana/Reduction.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/UnionFind.h"
+
+using namespace katana::analytics;
+
+const int MinimumSpanningForestPlan::kChunkSize = 64;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+constexpr Edge kNoEdge = std::numeric_limits<Edge>::max();
+
+template <typename T>
+struct EdgeWeight : public katana::PODProperty<T> {};
+
+struct EdgeInForest : public katana::PODProperty<uint8_t> {};
+
+using ForestGraph =
+    katana::TypedPropertyGraph<std::tuple<>, std::tuple<EdgeInForest>>;
+
+struct TreeNode : public katana::UnionFindNode<TreeNode> {
+  TreeNode() : katana::UnionFindNode<TreeNode>(this) {}
+};
+
+/// The weighted topology of the input graph and a union-find over its nodes
+struct WeightedGraph {
+  uint64_t num_nodes{0};
+  const uint64_t* indices{nullptr};
+  const Node* dests{nullptr};
+  katana::LargeArray<double> weights;
+  katana::LargeArray<TreeNode> trees;
+
+  Edge Begin(Node n) const { return n > 0 ? indices[n - 1] : 0; }
+  Edge End(Node n) const { return indices[n]; }
+
+  /// The representative of the tree of n
+  Node Find(Node n) { return trees[n].findAndCompress() - trees.data(); }
+
+  /// Merge the trees of n and m; returns false if they were the same tree.
+  bool Union(Node n, Node m) {
+    return trees[n].merge(&trees[m]) != nullptr;
+  }
+
+  /// Edges are ordered by weight, then by their endpoints, so that the two
+  /// edges between a pair of nodes are equally light, then by id.
+  auto Key(Node src, Edge e) const {
+    Node dst = dests[e];
+    return std::make_tuple(
+        weights[e], std::min(src, dst), std::max(src, dst), e);
+  }
+};
+
+template <typename Weight>
+katana::Result<void>
+CopyEdgeWeights(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    katana::LargeArray<double>* weights) {
+  using WeightGraph = katana::TypedPropertyGraph<
+      std::tuple<>, std::tuple<EdgeWeight<Weight>>>;
+  auto pg_result = WeightGraph::Make(pg, {}, {edge_weight_property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) {
+        for (auto e : graph.edges(n)) {
+          (*weights)[e] = graph.template GetEdgeData<EdgeWeight<Weight>>(e);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+LoadWeights(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    katana::LargeArray<double>* weights) {
+  weights->allocateInterleaved(pg->num_edges());
+  if (edge_weight_property_name.empty()) {
+    katana::do_all(
+        katana::iterate(uint64_t{0}, pg->num_edges()),
+        [&](uint64_t e) { (*weights)[e] = 1; }, katana::no_stats());
+    return katana::ResultSuccess();
+  }
+
+  auto property = pg->GetEdgeProperty(edge_weight_property_name);
+  if (!property) {
+    return katana::ErrorCode::PropertyNotFound;
+  }
+  katana::Result<void> result = katana::ResultSuccess();
+  switch (property->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    result = CopyEdgeWeights<uint32_t>(pg, edge_weight_property_name, weights);
+    break;
+  case arrow::Int32Type::type_id:
+    result = CopyEdgeWeights<int32_t>(pg, edge_weight_property_name, weights);
+    break;
+  case arrow::UInt64Type::type_id:
+    result = CopyEdgeWeights<uint64_t>(pg, edge_weight_property_name, weights);
+    break;
+  case arrow::Int64Type::type_id:
+    result = CopyEdgeWeights<int64_t>(pg, edge_weight_property_name, weights);
+    break;
+  case arrow::FloatType::type_id:
+    result = CopyEdgeWeights<float>(pg, edge_weight_property_name, weights);
+    break;
+  case arrow::DoubleType::type_id:
+    result = CopyEdgeWeights<double>(pg, edge_weight_property_name, weights);
+    break;
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+  if (!result) {
+    return result.error();
+  }
+
+  // NaN weights have no order
+  katana::GReduceLogicalOr nan;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, pg->num_edges()),
+      [&](uint64_t e) {
+        if (std::isnan((*weights)[e])) {
+          nan.update(true);
+        }
+      },
+      katana::no_stats());
+  if (nan.reduce()) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+MakeWeightedGraph(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    WeightedGraph* graph) {
+  if (pg->has_wide_node_ids()) {
+    return katana::ErrorCode::NotImplemented;
+  }
+  graph->num_nodes = pg->num_nodes();
+  graph->indices = pg->topology().out_indices->raw_values();
+  graph->dests = pg->topology().out_dests->raw_values();
+  if (auto result = LoadWeights(pg, edge_weight_property_name, &graph->weights);
+      !result) {
+    return result.error();
+  }
+
+  graph->trees.allocateInterleaved(graph->num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph->num_nodes),
+      [&](Node n) { graph->trees.constructAt(n); }, katana::no_stats());
+  return katana::ResultSuccess();
+}
+
+void
+Boruvka(WeightedGraph* graph, katana::LargeArray<uint8_t>* in_forest) {
+  constexpr Node kNoNode = std::numeric_limits<Node>::max();
+  uint64_t num_nodes = graph->num_nodes;
+
+  //! The tree of each node at the start of the round
+  katana::LargeArray<Node> tree;
+  //! The lightest edge from each node to another tree
+  katana::LargeArray<Edge> node_lightest;
+  //! The node with the lightest edge to another tree, by the node that
+  //! represents the tree
+  katana::LargeArray<std::atomic<Node>> tree_lightest;
+  //! Whether every edge of a node is inside its tree. Trees only grow, so
+  //! such nodes never need to be visited again.
+  katana::LargeArray<uint8_t> settled;
+  tree.allocateInterleaved(num_nodes);
+  node_lightest.allocateInterleaved(num_nodes);
+  tree_lightest.allocateInterleaved(num_nodes);
+  settled.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes), [&](Node n) { settled[n] = 0; },
+      katana::no_stats());
+
+  auto key = [&](Node n) { return graph->Key(n, node_lightest[n]); };
+
+  uint32_t rounds = 0;
+  while (true) {
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](Node n) {
+          tree[n] = graph->Find(n);
+          tree_lightest[n].store(kNoNode, std::memory_order_relaxed);
+        },
+        katana::no_stats());
+
+    katana::GReduceLogicalOr found;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](Node n) {
+          if (settled[n]) {
+            return;
+          }
+          Node t = tree[n];
+          Edge best = kNoEdge;
+          for (Edge e = graph->Begin(n); e < graph->End(n); ++e) {
+            if (tree[graph->dests[e]] != t &&
+                (best == kNoEdge || graph->Key(n, e) < graph->Key(n, best))) {
+              best = e;
+            }
+          }
+          if (best == kNoEdge) {
+            settled[n] = 1;
+            return;
+          }
+          node_lightest[n] = best;
+          found.update(true);
+
+          Node current = tree_lightest[t].load(std::memory_order_acquire);
+          while (current == kNoNode || key(n) < key(current)) {
+            if (tree_lightest[t].compare_exchange_weak(current, n)) {
+              break;
+            }
+          }
+        },
+        katana::steal(),
+        katana::chunk_size<MinimumSpanningForestPlan::kChunkSize>(),
+        katana::loopname("MinimumSpanningForest-Boruvka"));
+    if (!found.reduce()) {
+      break;
+    }
+    ++rounds;
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](Node t) {
+          Node n = tree_lightest[t].load(std::memory_order_relaxed);
+          if (n == kNoNode) {
+            return;
+          }
+          Edge e = node_lightest[n];
+          Node dst = graph->dests[e];
+
+          // Two trees may choose the two edges between the same pair of
+          // nodes; only the one from the smaller node is taken
+          Node other = tree_lightest[tree[dst]].load(std::memory_order_relaxed);
+          if (other == dst && graph->dests[node_lightest[other]] == n &&
+              graph->weights[node_lightest[other]] == graph->weights[e] &&
+              dst < n) {
+            return;
+          }
+          if (graph->Union(t, dst)) {
+            (*in_forest)[e] = 1;
+          }
+        },
+        katana::no_stats());
+  }
+
+  katana::ReportStatSingle("MinimumSpanningForest", "Rounds", rounds);
+}
+
+/// An edge for Kruskal, from its smaller node to its larger node
+struct KruskalEdge {
+  double weight;
+  Node src;
+  Node dst;
+  Edge id;
+
+  bool operator<(const KruskalEdge& o) const {
+    return std::tie(weight, src, dst, id) <
+           std::tie(o.weight, o.src, o.dst, o.id);
+  }
+};
+
+/// The median of evenly spaced samples of [begin, end)
+KruskalEdge
+ChoosePivot(const KruskalEdge* begin, const KruskalEdge* end) {
+  constexpr uint64_t kNumSamples = 31;
+  uint64_t size = end - begin;
+  std::vector<KruskalEdge> samples;
+  for (uint64_t i = 0; i < kNumSamples; ++i) {
+    samples.emplace_back(begin[i * size / kNumSamples]);
+  }
+  std::nth_element(
+      samples.begin(), samples.begin() + kNumSamples / 2, samples.end());
+  return samples[kNumSamples / 2];
+}
+
+void
+FilterKruskal(
+    WeightedGraph* graph, KruskalEdge* begin, KruskalEdge* end,
+    uint64_t base_case_size, katana::LargeArray<uint8_t>* in_forest) {
+  // Below a few hundred edges a pivot is not worth sampling
+  if (static_cast<uint64_t>(end - begin) <=
+      std::max<uint64_t>(base_case_size, 256)) {
+    katana::ParallelSTL::sort(begin, end);
+    for (KruskalEdge* edge = begin; edge != end; ++edge) {
+      if (graph->Union(edge->src, edge->dst)) {
+        (*in_forest)[edge->id] = 1;
+      }
+    }
+    return;
+  }
+
+  // Edges are distinct, so both sides are smaller than the whole
+  KruskalEdge pivot = ChoosePivot(begin, end);
+  KruskalEdge* middle = katana::ParallelSTL::partition(
+      begin, end, [&](const KruskalEdge& edge) { return edge < pivot; });
+  FilterKruskal(graph, begin, middle, base_case_size, in_forest);
+
+  KruskalEdge* rest = katana::ParallelSTL::partition(
+      middle, end, [&](const KruskalEdge& edge) {
+        return graph->Find(edge.src) != graph->Find(edge.dst);
+      });
+  FilterKruskal(graph, middle, rest, base_case_size, in_forest);
+}
+
+void
+FilterKruskal(
+    WeightedGraph* graph, uint64_t base_case_size,
+    katana::LargeArray<uint8_t>* in_forest) {
+  uint64_t num_nodes = graph->num_nodes;
+
+  // Take each pair of nodes once
+  katana::LargeArray<uint64_t> offsets;
+  offsets.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) {
+        uint64_t count = 0;
+        for (Edge e = graph->Begin(n); e < graph->End(n); ++e) {
+          count += n < graph->dests[e];
+        }
+        offsets[n] = count;
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      offsets.begin(), offsets.end(), offsets.begin());
+  uint64_t num_edges = num_nodes > 0 ? offsets[num_nodes - 1] : 0;
+
+  katana::LargeArray<KruskalEdge> edges;
+  edges.allocateInterleaved(num_edges);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) {
+        uint64_t next = n > 0 ? offsets[n - 1] : 0;
+        for (Edge e = graph->Begin(n); e < graph->End(n); ++e) {
+          Node dst = graph->dests[e];
+          if (n < dst) {
+            edges[next++] = KruskalEdge{graph->weights[e], n, dst, e};
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  FilterKruskal(
+      graph, edges.data(), edges.data() + num_edges, base_case_size,
+      in_forest);
+}
+
+/// The weighted topology of pg and the flags of the edges in the forest in
+/// property_name
+katana::Result<void>
+LoadForest(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name, WeightedGraph* graph,
+    katana::LargeArray<uint8_t>* in_forest) {
+  if (auto result =
+          MakeWeightedGraph(pg, edge_weight_property_name, graph);
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = ForestGraph::Make(pg, {}, {property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto forest = pg_result.value();
+
+  in_forest->allocateInterleaved(pg->num_edges());
+  katana::do_all(
+      katana::iterate(forest),
+      [&](const Node& n) {
+        for (auto e : forest.edges(n)) {
+          (*in_forest)[e] = forest.GetEdgeData<EdgeInForest>(e);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::MinimumSpanningForest(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, MinimumSpanningForestPlan plan) {
+  if ((plan.algorithm() != MinimumSpanningForestPlan::kBoruvka &&
+       plan.algorithm() != MinimumSpanningForestPlan::kFilterKruskal) ||
+      plan.base_case_size() == 0) {
+    return ErrorCode::InvalidArgument;
+  }
+
+  WeightedGraph graph;
+  if (auto result = MakeWeightedGraph(pg, edge_weight_property_name, &graph);
+      !result) {
+    return result.error();
+  }
+
+  katana::StatTimer exec_time("MinimumSpanningForest");
+  exec_time.start();
+
+  katana::LargeArray<uint8_t> in_forest;
+  in_forest.allocateInterleaved(pg->num_edges());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, pg->num_edges()),
+      [&](uint64_t e) { in_forest[e] = 0; }, katana::no_stats());
+
+  switch (plan.algorithm()) {
+  case MinimumSpanningForestPlan::kBoruvka:
+    Boruvka(&graph, &in_forest);
+    break;
+  case MinimumSpanningForestPlan::kFilterKruskal:
+    FilterKruskal(&graph, plan.base_case_size(), &in_forest);
+    break;
+  }
+
+  katana::GAccumulator<double> total_weight;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, pg->num_edges()),
+      [&](uint64_t e) {
+        if (in_forest[e]) {
+          total_weight += graph.weights[e];
+        }
+      },
+      katana::no_stats());
+  katana::ReportStatSingle(
+      "MinimumSpanningForest", "TotalWeight", total_weight.reduce());
+
+  exec_time.stop();
+
+  if (auto result = ConstructEdgeProperties<std::tuple<EdgeInForest>>(
+          pg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+  auto pg_result = ForestGraph::Make(pg, {}, {output_property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto forest = pg_result.value();
+  katana::do_all(
+      katana::iterate(forest),
+      [&](const Node& n) {
+        for (auto e : forest.edges(n)) {
+          forest.GetEdgeData<EdgeInForest>(e) = in_forest[e];
+        }
+      },
+      katana::steal(), katana::no_stats());
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::MinimumSpanningForestAssertValid(
+    PropertyGraph* pg, const std::string& property_name) {
+  WeightedGraph graph;
+  katana::LargeArray<uint8_t> in_forest;
+  if (auto result = LoadForest(pg, "", property_name, &graph, &in_forest);
+      !result) {
+    return result.error();
+  }
+
+  // Joining the ends of every edge of the forest must merge two trees, and
+  // afterwards the ends of every edge of pg must be in the same tree
+  GReduceLogicalOr cycle;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](Node n) {
+        for (Edge e = graph.Begin(n); e < graph.End(n); ++e) {
+          if (in_forest[e] && !graph.Union(n, graph.dests[e])) {
+            cycle.update(true);
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+  if (cycle.reduce()) {
+    return ErrorCode::AssertionFailed;
+  }
+
+  GReduceLogicalOr not_spanning;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph.num_nodes),
+      [&](Node n) {
+        for (Edge e = graph.Begin(n); e < graph.End(n); ++e) {
+          if (graph.Find(n) != graph.Find(graph.dests[e])) {
+            not_spanning.update(true);
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+  if (not_spanning.reduce()) {
+    return ErrorCode::AssertionFailed;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<MinimumSpanningForestStatistics>
+katana::analytics::MinimumSpanningForestStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  WeightedGraph graph;
+  katana::LargeArray<uint8_t> in_forest;
+  if (auto result = LoadForest(
+          pg, edge_weight_property_name, property_name, &graph, &in_forest);
+      !result) {
+    return result.error();
+  }
+
+  GAccumulator<uint64_t> num_edges;
+  GAccumulator<double> total_weight;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, pg->num_edges()),
+      [&](uint64_t e) {
+        if (in_forest[e]) {
+          num_edges += 1;
+          total_weight += graph.weights[e];
+        }
+      },
+      katana::no_stats());
+
+  return MinimumSpanningForestStatistics{
+      .num_edges = num_edges.reduce(),
+      .num_trees = pg->num_nodes() - num_edges.reduce(),
+      .total_weight = total_weight.reduce(),
+  };
+}
+
+void
+katana::analytics::MinimumSpanningForestStatistics::Print(
+    std::ostream& os) const {
+  os << "Number of edges = " << num_edges << std::endl;
+  os << "Number of trees = " << num_trees << std::endl;
+  os << "Total weight = " << total_weight << std::endl;
+}
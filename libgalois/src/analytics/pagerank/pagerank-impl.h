@@ -49,4 +49,10 @@ katana::Result<void> PagerankPushSynchronous(
     katana::PropertyGraph* pg, const std::string& output_property_name,
     katana::analytics::PagerankPlan plan);
 
+/// Correct the ranks in property_name in place for update
+katana::Result<void> PagerankPushIncremental(
+    katana::PropertyGraph* pg, const std::string& property_name,
+    const katana::analytics::PagerankUpdate& update,
+    katana::analytics::PagerankPlan plan);
+
 #endif
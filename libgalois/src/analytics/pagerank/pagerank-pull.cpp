@@ -17,6 +17,7 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include "katana/EdgeBalancedRange.h"
 #include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/Utils.h"
 #include "pagerank-impl.h"
@@ -142,7 +143,7 @@ ComputePRResidual(
         katana::no_stats(), katana::loopname("PageRank_delta"));
 
     katana::do_all(
-        katana::iterate(*graph),
+        katana::iterate_edge_balanced(graph->GetPropertyGraph()),
         [&](const GNode& src) {
           float sum = 0;
           for (auto nbr : graph->edges(src)) {
@@ -183,7 +184,7 @@ ComputePRTopological(Graph* graph, katana::analytics::PagerankPlan plan) {
   float base_score = (1.0f - plan.alpha()) / graph->size();
   while (true) {
     katana::do_all(
-        katana::iterate(*graph),
+        katana::iterate_edge_balanced(graph->GetPropertyGraph()),
         [&](const GNode& src) {
           auto& sdata_value = graph->GetData<NodeValue>(src);
           float sum = 0.0;
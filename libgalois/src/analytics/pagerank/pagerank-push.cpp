@@ -17,7 +17,13 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include <algorithm>
+#include <cmath>
+
 #include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/LargeArray.h"
+#include "katana/Reduction.h"
 #include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/Utils.h"
 #include "pagerank-impl.h"
@@ -36,6 +42,49 @@ using EdgeData = std::tuple<>;
 typedef katana::TypedPropertyGraph<NodeData, EdgeData> Graph;
 typedef typename Graph::Node GNode;
 
+/// Push residuals larger than the tolerance to out-neighbors, starting from
+/// the nodes in initial, until no residual is larger than the tolerance.
+/// Residuals may be negative when ranks are being corrected after a graph
+/// update; they are compared by magnitude.
+template <typename GraphTy, typename ResidualFn, typename Range>
+void
+PushResidualAsynchronous(
+    GraphTy& graph, ResidualFn residual_of, const Range& initial,
+    katana::analytics::PagerankPlan plan) {
+  using Node = typename GraphTy::Node;
+  typedef katana::PerSocketChunkFIFO<
+      katana::analytics::PagerankPlan::kChunkSize>
+      WL;
+  katana::for_each(
+      initial,
+      [&](const Node& src, auto& ctx) {
+        std::atomic<PRTy>& src_residual = residual_of(src);
+        if (std::fabs(src_residual.load()) > plan.tolerance()) {
+          PRTy old_residual = src_residual.exchange(0.0);
+          auto& src_value = graph.template GetData<NodeValue>(src);
+          src_value += old_residual;
+          int src_nout = graph.edges(src).size();
+          if (src_nout > 0) {
+            PRTy delta = old_residual * plan.alpha() / src_nout;
+            //! For each out-going neighbors.
+            for (const auto& jj : graph.edges(src)) {
+              auto dest = graph.GetEdgeDest(jj);
+              std::atomic<PRTy>& dest_residual = residual_of(*dest);
+              if (delta != 0) {
+                auto old = atomicAdd(dest_residual, delta);
+                if ((std::fabs(old) < plan.tolerance()) &&
+                    (std::fabs(old + delta) >= plan.tolerance())) {
+                  ctx.push(*dest);
+                }
+              }
+            }
+          }
+        }
+      },
+      katana::loopname("PushResidualAsynchronous"),
+      katana::disable_conflict_detection(), katana::wl<WL>());
+}
+
 void
 InitializeNodeResidual(Graph& graph, katana::analytics::PagerankPlan plan) {
   katana::do_all(
@@ -72,37 +121,12 @@ PagerankPushAsynchronous(
 
   InitializeNodeResidual(graph, plan);
 
-  typedef katana::PerSocketChunkFIFO<
-      katana::analytics::PagerankPlan::kChunkSize>
-      WL;
-  katana::for_each(
-      katana::iterate(graph),
-      [&](const GNode& src, auto& ctx) {
-        auto& src_residual = graph.GetData<NodeResidual>(src);
-        if (src_residual > plan.tolerance()) {
-          PRTy old_residual = src_residual.exchange(0.0);
-          auto& src_value = graph.GetData<NodeValue>(src);
-          src_value += old_residual;
-          int src_nout = graph.edges(src).size();
-          if (src_nout > 0) {
-            PRTy delta = old_residual * plan.alpha() / src_nout;
-            //! For each out-going neighbors.
-            for (const auto& jj : graph.edges(src)) {
-              auto dest = graph.GetEdgeDest(jj);
-              auto& dest_residual = graph.GetData<NodeResidual>(dest);
-              if (delta > 0) {
-                auto old = atomicAdd(dest_residual, delta);
-                if ((old < plan.tolerance()) &&
-                    (old + delta >= plan.tolerance())) {
-                  ctx.push(*dest);
-                }
-              }
-            }
-          }
-        }
+  PushResidualAsynchronous(
+      graph,
+      [&](GNode n) -> std::atomic<PRTy>& {
+        return graph.GetData<NodeResidual>(n);
       },
-      katana::loopname("PushResidualAsynchronous"),
-      katana::disable_conflict_detection(), katana::wl<WL>());
+      katana::iterate(graph), plan);
 
   return katana::ResultSuccess();
 }
@@ -210,3 +234,125 @@ PagerankPushSynchronous(
   }
   return katana::ResultSuccess();
 }
+
+katana::Result<void>
+PagerankPushIncremental(
+    katana::PropertyGraph* pg, const std::string& property_name,
+    const katana::analytics::PagerankUpdate& update,
+    katana::analytics::PagerankPlan plan) {
+  using ValueGraph =
+      katana::TypedPropertyGraph<std::tuple<NodeValue>, std::tuple<>>;
+  using Node = ValueGraph::Node;
+  using Edge = std::pair<Node, Node>;
+
+  auto graph_result = ValueGraph::Make(pg, {property_name}, {});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  ValueGraph graph = graph_result.value();
+
+  // Residuals start at zero. Pages of a floating allocation are zero-filled
+  // when first touched, so only the pages holding residuals of nodes near the
+  // update are ever faulted in.
+  katana::LargeArray<std::atomic<PRTy>> residual;
+  residual.allocateFloating(pg->num_nodes());
+  auto residual_of = [&](Node n) -> std::atomic<PRTy>& { return residual[n]; };
+
+  std::vector<Edge> inserted(update.inserted_edges);
+  std::vector<Edge> deleted(update.deleted_edges);
+  std::sort(inserted.begin(), inserted.end());
+  std::sort(deleted.begin(), deleted.end());
+
+  std::vector<Node> sources;
+  for (const auto* edges : {&inserted, &deleted}) {
+    for (const Edge& e : *edges) {
+      sources.emplace_back(e.first);
+    }
+  }
+  std::sort(sources.begin(), sources.end());
+  sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+
+  auto edges_of = [](const std::vector<Edge>& edges, Node src) {
+    auto less = [](const Edge& e, Node n) { return e.first < n; };
+    auto begin = std::lower_bound(edges.begin(), edges.end(), src, less);
+    auto end = begin;
+    while (end != edges.end() && end->first == src) {
+      ++end;
+    }
+    return std::make_pair(begin, end);
+  };
+
+  katana::InsertBag<Node> seeds;
+  auto add_residual = [&](Node n, PRTy delta) {
+    if (delta != 0) {
+      atomicAdd(residual[n], delta);
+      seeds.push(n);
+    }
+  };
+
+  // A node that has pushed rank value x along d out-edges has given each
+  // neighbor alpha * x / d. Correct the residual of each neighbor, old and
+  // new, by the difference between what it has and what it should have
+  // received given the current out-edges. Nodes whose out-edges did not
+  // change are assumed to have no residual left.
+  katana::GReduceLogicalOr inconsistent;
+  katana::do_all(
+      katana::iterate(sources),
+      [&](Node src) {
+        auto [ins_begin, ins_end] = edges_of(inserted, src);
+        auto [del_begin, del_end] = edges_of(deleted, src);
+        int64_t new_nout = graph.edges(src).size();
+        int64_t old_nout =
+            new_nout - (ins_end - ins_begin) + (del_end - del_begin);
+        if (old_nout < 0) {
+          inconsistent.update(true);
+          return;
+        }
+
+        PRTy value = graph.GetData<NodeValue>(src);
+        PRTy old_share = old_nout > 0 ? plan.alpha() * value / old_nout : 0;
+        PRTy new_share = new_nout > 0 ? plan.alpha() * value / new_nout : 0;
+        if (new_share != old_share) {
+          for (auto e : graph.edges(src)) {
+            add_residual(*graph.GetEdgeDest(e), new_share - old_share);
+          }
+        }
+        // Inserted edges were just credited with new_share - old_share but
+        // had nothing before; deleted edges are no longer in the graph
+        for (auto it = ins_begin; it != ins_end; ++it) {
+          add_residual(it->second, old_share);
+        }
+        for (auto it = del_begin; it != del_end; ++it) {
+          add_residual(it->second, -old_share);
+        }
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("PagerankIncremental-Seed"));
+  if (inconsistent.reduce()) {
+    KATANA_LOG_DEBUG("update deletes more edges than a node has");
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  // Nodes without a rank are new and start with the initial residual like
+  // every node does in a full computation
+  std::vector<Node> endpoints;
+  for (const Edge& e : inserted) {
+    endpoints.emplace_back(e.first);
+    endpoints.emplace_back(e.second);
+  }
+  std::sort(endpoints.begin(), endpoints.end());
+  endpoints.erase(
+      std::unique(endpoints.begin(), endpoints.end()), endpoints.end());
+  katana::do_all(
+      katana::iterate(endpoints),
+      [&](Node n) {
+        if (graph.GetData<NodeValue>(n) == 0) {
+          add_residual(n, plan.initial_residual());
+        }
+      },
+      katana::no_stats());
+
+  PushResidualAsynchronous(graph, residual_of, katana::iterate(seeds), plan);
+
+  return katana::ResultSuccess();
+}
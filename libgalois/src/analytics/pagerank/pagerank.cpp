@@ -38,6 +38,45 @@ katana::analytics::Pagerank(
   }
 }
 
+katana::Result<void>
+katana::analytics::PagerankIncremental(
+    katana::PropertyGraph* pg, const std::string& previous_property_name,
+    const PagerankUpdate& update, const std::string& output_property_name,
+    PagerankPlan plan) {
+  for (const auto* edges : {&update.inserted_edges, &update.deleted_edges}) {
+    for (const auto& [src, dst] : *edges) {
+      if (src >= pg->num_nodes() || dst >= pg->num_nodes()) {
+        return katana::ErrorCode::InvalidArgument;
+      }
+    }
+  }
+
+  if (output_property_name != previous_property_name) {
+    struct PreviousValue : public PODProperty<PRTy> {};
+    using NodeData = std::tuple<NodeValue, PreviousValue>;
+
+    if (auto result = ConstructNodeProperties<std::tuple<NodeValue>>(
+            pg, {output_property_name});
+        !result) {
+      return result.error();
+    }
+    auto graph_result = TypedPropertyGraph<NodeData, std::tuple<>>::Make(
+        pg, {output_property_name, previous_property_name}, {});
+    if (!graph_result) {
+      return graph_result.error();
+    }
+    auto graph = graph_result.value();
+    katana::do_all(
+        katana::iterate(graph),
+        [&](uint32_t n) {
+          graph.GetData<NodeValue>(n) = graph.GetData<PreviousValue>(n);
+        },
+        katana::no_stats(), katana::loopname("CopyPreviousRanks"));
+  }
+
+  return PagerankPushIncremental(pg, output_property_name, update, plan);
+}
+
 /// \cond DO_NOT_DOCUMENT
 katana::Result<void>
 katana::analytics::PagerankAssertValid(
@@ -0,0 +1,894 @@
+#include "katana/analytics/partition/partition.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Reduction.h"
+#include "katana/TypedPropertyGraph.h"
+
+using namespace katana::analytics;
+
+const int PartitionPlan::kChunkSize = 64;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+constexpr Node kNoNode = std::numeric_limits<Node>::max();
+constexpr uint32_t kNoPart = std::numeric_limits<uint32_t>::max();
+
+/// Coarsening stops when a level would keep more than this fraction of the
+/// nodes of the level before it
+constexpr double kMinCoarsening = 0.95;
+/// The maximum number of rounds of proposals when matching the nodes of a
+/// level. Coarse levels are dense and need more than a few rounds.
+constexpr uint32_t kMaxMatchingPasses = 16;
+/// The number of seeds greedy graph growing tries for each bisection
+constexpr uint32_t kNumSeeds = 4;
+
+struct NodePart : public katana::PODProperty<uint32_t> {};
+
+using PartGraph =
+    katana::TypedPropertyGraph<std::tuple<NodePart>, std::tuple<>>;
+
+/// An undirected edge of a level, with the total weight of the edges of the
+/// finest level that it stands for
+struct Neighbor {
+  Node dst;
+  uint64_t weight;
+};
+
+/// One graph of the multilevel hierarchy in flat CSR arrays. Every edge is
+/// stored at both of its nodes and there are no self loops.
+struct Level {
+  uint64_t num_nodes{0};
+  katana::LargeArray<uint64_t> indices;
+  katana::LargeArray<Neighbor> edges;
+  katana::LargeArray<uint64_t> node_weights;
+  //! The node of the next coarser level that contains each node
+  katana::LargeArray<Node> coarse;
+
+  Edge Begin(Node n) const { return n > 0 ? indices[n - 1] : 0; }
+  Edge End(Node n) const { return indices[n]; }
+};
+
+/// Sort the edges of each node of level, which are in scratch after the
+/// edges of the nodes before it in bounds, merge the ones to the same node
+/// and pack them into the edges of level.
+void
+PackEdges(
+    katana::LargeArray<Neighbor>* scratch,
+    const katana::LargeArray<uint64_t>& bounds,
+    katana::LargeArray<uint64_t>* counts, Level* level) {
+  uint64_t num_nodes = level->num_nodes;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) {
+        Neighbor* begin = scratch->data() + (n > 0 ? bounds[n - 1] : 0);
+        Neighbor* end = begin + (*counts)[n];
+        std::sort(begin, end, [](const Neighbor& a, const Neighbor& b) {
+          return a.dst < b.dst;
+        });
+        Neighbor* out = begin;
+        for (Neighbor* it = begin; it != end; ++it) {
+          if (out != begin && (out - 1)->dst == it->dst) {
+            (out - 1)->weight += it->weight;
+          } else {
+            *out++ = *it;
+          }
+        }
+        (*counts)[n] = out - begin;
+      },
+      katana::steal(), katana::chunk_size<PartitionPlan::kChunkSize>(),
+      katana::no_stats());
+
+  level->indices.allocateInterleaved(num_nodes);
+  katana::ParallelSTL::partial_sum(
+      counts->begin(), counts->end(), level->indices.begin());
+  uint64_t num_edges = num_nodes > 0 ? level->indices[num_nodes - 1] : 0;
+  level->edges.allocateInterleaved(num_edges);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) {
+        const Neighbor* begin = scratch->data() + (n > 0 ? bounds[n - 1] : 0);
+        std::copy(
+            begin, begin + (*counts)[n], level->edges.data() + level->Begin(n));
+      },
+      katana::steal(), katana::no_stats());
+}
+
+/// The topology of pg with every edge in both directions, self loops
+/// dropped and the edges between a pair of nodes merged
+void
+MakeFinestLevel(katana::PropertyGraph* pg, Level* level) {
+  uint64_t num_nodes = pg->num_nodes();
+  const uint64_t* indices = pg->topology().out_indices->raw_values();
+  const Node* dests = pg->topology().out_dests->raw_values();
+  level->num_nodes = num_nodes;
+
+  katana::LargeArray<std::atomic<uint64_t>> degrees;
+  degrees.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) { degrees.constructAt(n, 0); }, katana::no_stats());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) {
+        uint64_t out_degree = 0;
+        for (Edge e = n > 0 ? indices[n - 1] : 0; e < indices[n]; ++e) {
+          if (dests[e] != n) {
+            ++out_degree;
+            katana::atomicAdd(degrees[dests[e]], uint64_t{1});
+          }
+        }
+        katana::atomicAdd(degrees[n], out_degree);
+      },
+      katana::steal(), katana::no_stats());
+
+  katana::LargeArray<uint64_t> bounds;
+  bounds.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) {
+        bounds[n] = degrees[n].load(std::memory_order_relaxed);
+        degrees[n].store(0, std::memory_order_relaxed);
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      bounds.begin(), bounds.end(), bounds.begin());
+
+  katana::LargeArray<Neighbor> scratch;
+  scratch.allocateInterleaved(num_nodes > 0 ? bounds[num_nodes - 1] : 0);
+  auto add = [&](Node n, Node dst) {
+    uint64_t slot = degrees[n].fetch_add(1, std::memory_order_relaxed);
+    scratch[(n > 0 ? bounds[n - 1] : 0) + slot] = Neighbor{dst, 1};
+  };
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) {
+        for (Edge e = n > 0 ? indices[n - 1] : 0; e < indices[n]; ++e) {
+          if (dests[e] != n) {
+            add(n, dests[e]);
+            add(dests[e], n);
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  katana::LargeArray<uint64_t> counts;
+  counts.allocateInterleaved(num_nodes);
+  level->node_weights.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) {
+        counts[n] = degrees[n].load(std::memory_order_relaxed);
+        level->node_weights[n] = 1;
+      },
+      katana::no_stats());
+  PackEdges(&scratch, bounds, &counts, level);
+}
+
+/// Match the nodes of fine along heavy edges, without letting a pair weigh
+/// more than max_node_weight. Each pass, every unmatched node proposes to its
+/// heaviest unmatched neighbor, and pairs that propose to each other are
+/// matched. Ties are broken by a hash of the pair, so that both nodes agree
+/// and the matching does not depend on the schedule. Nodes without edges are
+/// matched with each other in order of id. The match of a node without one is
+/// the node itself.
+void
+Match(
+    const Level& fine, uint64_t max_node_weight,
+    katana::LargeArray<Node>* match) {
+  uint64_t num_nodes = fine.num_nodes;
+  katana::LargeArray<Node> proposals;
+  proposals.allocateInterleaved(num_nodes);
+  match->allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) { (*match)[n] = kNoNode; }, katana::no_stats());
+
+  auto key = [](Node n, const Neighbor& neighbor) {
+    Node lo = std::min(n, neighbor.dst);
+    Node hi = std::max(n, neighbor.dst);
+    return std::make_pair(neighbor.weight, HashNodeId(HashNodeId(lo) ^ hi));
+  };
+
+  for (uint32_t pass = 0; pass < kMaxMatchingPasses; ++pass) {
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](Node n) {
+          proposals[n] = kNoNode;
+          if ((*match)[n] != kNoNode) {
+            return;
+          }
+          const Neighbor* best = nullptr;
+          for (Edge e = fine.Begin(n); e < fine.End(n); ++e) {
+            const Neighbor& neighbor = fine.edges[e];
+            if ((*match)[neighbor.dst] != kNoNode ||
+                fine.node_weights[n] + fine.node_weights[neighbor.dst] >
+                    max_node_weight) {
+              continue;
+            }
+            if (!best || key(n, *best) < key(n, neighbor)) {
+              best = &neighbor;
+            }
+          }
+          if (best) {
+            proposals[n] = best->dst;
+          }
+        },
+        katana::steal(), katana::chunk_size<PartitionPlan::kChunkSize>(),
+        katana::loopname("Partition-Match"));
+
+    katana::GReduceLogicalOr matched;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](Node n) {
+          Node proposal = proposals[n];
+          if (proposal != kNoNode && proposals[proposal] == n) {
+            (*match)[n] = proposal;
+            matched.update(true);
+          }
+        },
+        katana::no_stats());
+    if (!matched.reduce()) {
+      break;
+    }
+  }
+
+  katana::InsertBag<Node> isolated_bag;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) {
+        if (fine.Begin(n) == fine.End(n)) {
+          isolated_bag.push(n);
+        }
+      },
+      katana::no_stats());
+  std::vector<Node> isolated(isolated_bag.begin(), isolated_bag.end());
+  katana::ParallelSTL::sort(isolated.begin(), isolated.end());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, isolated.size() / 2),
+      [&](uint64_t i) {
+        Node a = isolated[2 * i];
+        Node b = isolated[2 * i + 1];
+        if (fine.node_weights[a] + fine.node_weights[b] <= max_node_weight) {
+          (*match)[a] = b;
+          (*match)[b] = a;
+        }
+      },
+      katana::no_stats());
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) {
+        if ((*match)[n] == kNoNode) {
+          (*match)[n] = n;
+        }
+      },
+      katana::no_stats());
+}
+
+/// Merge the matched nodes of fine into the nodes of coarse and set the
+/// coarse nodes of fine. Returns false, leaving coarse empty, if that would
+/// not make the graph enough smaller to be worth another level.
+bool
+Coarsen(Level* fine, uint64_t max_node_weight, Level* coarse) {
+  uint64_t num_nodes = fine->num_nodes;
+  katana::LargeArray<Node> match;
+  Match(*fine, max_node_weight, &match);
+
+  // The smaller node of each pair leads it
+  katana::LargeArray<uint64_t> ids;
+  ids.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) { ids[n] = match[n] >= n; }, katana::no_stats());
+  katana::ParallelSTL::partial_sum(ids.begin(), ids.end(), ids.begin());
+  uint64_t num_coarse = num_nodes > 0 ? ids[num_nodes - 1] : 0;
+  if (num_coarse > kMinCoarsening * num_nodes) {
+    return false;
+  }
+
+  fine->coarse.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) { fine->coarse[n] = ids[std::min(n, match[n])] - 1; },
+      katana::no_stats());
+
+  coarse->num_nodes = num_coarse;
+  katana::LargeArray<Node> leaders;
+  leaders.allocateInterleaved(num_coarse);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) {
+        if (match[n] >= n) {
+          leaders[fine->coarse[n]] = n;
+        }
+      },
+      katana::no_stats());
+
+  katana::LargeArray<uint64_t> bounds;
+  bounds.allocateInterleaved(num_coarse);
+  coarse->node_weights.allocateInterleaved(num_coarse);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_coarse),
+      [&](Node c) {
+        Node a = leaders[c];
+        Node b = match[a];
+        bounds[c] = fine->End(a) - fine->Begin(a);
+        coarse->node_weights[c] = fine->node_weights[a];
+        if (b != a) {
+          bounds[c] += fine->End(b) - fine->Begin(b);
+          coarse->node_weights[c] += fine->node_weights[b];
+        }
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      bounds.begin(), bounds.end(), bounds.begin());
+
+  katana::LargeArray<Neighbor> scratch;
+  scratch.allocateInterleaved(num_coarse > 0 ? bounds[num_coarse - 1] : 0);
+  katana::LargeArray<uint64_t> counts;
+  counts.allocateInterleaved(num_coarse);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_coarse),
+      [&](Node c) {
+        Neighbor* out = scratch.data() + (c > 0 ? bounds[c - 1] : 0);
+        uint64_t count = 0;
+        Node a = leaders[c];
+        for (Node member : {a, match[a]}) {
+          for (Edge e = fine->Begin(member); e < fine->End(member); ++e) {
+            Node dst = fine->coarse[fine->edges[e].dst];
+            if (dst != c) {
+              out[count++] = Neighbor{dst, fine->edges[e].weight};
+            }
+          }
+          if (match[a] == a) {
+            break;
+          }
+        }
+        counts[c] = count;
+      },
+      katana::steal(), katana::chunk_size<PartitionPlan::kChunkSize>(),
+      katana::loopname("Partition-Coarsen"));
+  PackEdges(&scratch, bounds, &counts, coarse);
+  return true;
+}
+
+/// The state of greedy graph growing, by node of the level
+struct GrowScratch {
+  //! The weight of the edges of a node to the region less the weight of its
+  //! other edges to nodes being bisected
+  std::vector<int64_t> gains;
+  std::vector<uint8_t> in_region;
+};
+
+/// Split nodes, whose part is first_part, into num_parts parts numbered from
+/// first_part by recursive bisection. Each bisection grows a region from a
+/// seed, adding the node that most reduces the edges leaving the region until
+/// it has its share of the weight, and keeps the best of kNumSeeds seeds.
+void
+Bisect(
+    const Level& level, const std::vector<Node>& nodes, uint32_t first_part,
+    uint32_t num_parts, katana::LargeArray<uint32_t>* parts,
+    GrowScratch* scratch) {
+  if (num_parts < 2 || nodes.empty()) {
+    return;
+  }
+  uint32_t left_parts = num_parts / 2;
+  uint64_t total_weight = 0;
+  for (Node n : nodes) {
+    total_weight += level.node_weights[n];
+  }
+  uint64_t target = total_weight * left_parts / num_parts;
+
+  std::vector<int64_t>& gains = scratch->gains;
+  std::vector<uint8_t>& in_region = scratch->in_region;
+  auto in_nodes = [&](Node n) { return (*parts)[n] == first_part; };
+
+  std::vector<Node> best_region;
+  uint64_t best_cut = std::numeric_limits<uint64_t>::max();
+  for (uint32_t seed = 0; seed < std::min<uint64_t>(kNumSeeds, nodes.size());
+       ++seed) {
+    for (Node n : nodes) {
+      in_region[n] = 0;
+      gains[n] = 0;
+      for (Edge e = level.Begin(n); e < level.End(n); ++e) {
+        if (in_nodes(level.edges[e].dst)) {
+          gains[n] -= level.edges[e].weight;
+        }
+      }
+    }
+
+    std::vector<Node> region;
+    uint64_t weight = 0;
+    std::priority_queue<std::pair<int64_t, Node>> frontier;
+    Node start =
+        nodes[HashNodeId(first_part * kNumSeeds + seed) % nodes.size()];
+    frontier.emplace(gains[start], start);
+    uint64_t next_unvisited = 0;
+    while (weight < target) {
+      if (frontier.empty()) {
+        // The region covers its connected component; start another one
+        while (next_unvisited < nodes.size() &&
+               in_region[nodes[next_unvisited]]) {
+          ++next_unvisited;
+        }
+        if (next_unvisited == nodes.size()) {
+          break;
+        }
+        Node n = nodes[next_unvisited++];
+        frontier.emplace(gains[n], n);
+      }
+      auto [gain, n] = frontier.top();
+      frontier.pop();
+      uint64_t w = level.node_weights[n];
+      if (in_region[n] || gain != gains[n] ||
+          (weight + w > target && weight + w - target > target - weight)) {
+        continue;
+      }
+      in_region[n] = 1;
+      region.emplace_back(n);
+      weight += w;
+      for (Edge e = level.Begin(n); e < level.End(n); ++e) {
+        Node dst = level.edges[e].dst;
+        if (in_nodes(dst) && !in_region[dst]) {
+          gains[dst] += 2 * level.edges[e].weight;
+          frontier.emplace(gains[dst], dst);
+        }
+      }
+    }
+
+    uint64_t cut = 0;
+    for (Node n : region) {
+      for (Edge e = level.Begin(n); e < level.End(n); ++e) {
+        Node dst = level.edges[e].dst;
+        if (in_nodes(dst) && !in_region[dst]) {
+          cut += level.edges[e].weight;
+        }
+      }
+    }
+    if (cut < best_cut) {
+      best_cut = cut;
+      best_region = std::move(region);
+    }
+  }
+
+  for (Node n : nodes) {
+    in_region[n] = 0;
+  }
+  for (Node n : best_region) {
+    in_region[n] = 1;
+  }
+  std::vector<Node> rest;
+  for (Node n : nodes) {
+    if (!in_region[n]) {
+      (*parts)[n] = first_part + left_parts;
+      rest.emplace_back(n);
+    }
+  }
+  Bisect(level, best_region, first_part, left_parts, parts, scratch);
+  Bisect(
+      level, rest, first_part + left_parts, num_parts - left_parts, parts,
+      scratch);
+}
+
+/// The weight of the edges from a node to each part
+struct Connectivity {
+  std::vector<uint64_t> weights;
+  std::vector<uint32_t> parts;
+
+  void Compute(
+      const Level& level, const katana::LargeArray<uint32_t>& node_parts,
+      uint32_t num_parts, Node n) {
+    if (weights.size() < num_parts) {
+      weights.resize(num_parts, 0);
+    }
+    for (uint32_t p : parts) {
+      weights[p] = 0;
+    }
+    parts.clear();
+    for (Edge e = level.Begin(n); e < level.End(n); ++e) {
+      uint32_t p = node_parts[level.edges[e].dst];
+      if (weights[p] == 0) {
+        parts.emplace_back(p);
+      }
+      weights[p] += level.edges[e].weight;
+    }
+  }
+
+  /// How much moving a node from part from to part to reduces the cut
+  int64_t Gain(uint32_t from, uint32_t to) const {
+    return static_cast<int64_t>(weights[to]) -
+           static_cast<int64_t>(weights[from]);
+  }
+};
+
+struct Move {
+  int64_t gain;
+  Node node;
+  uint32_t to;
+
+  /// Larger gains first, then smaller nodes
+  bool operator<(const Move& o) const {
+    return std::tie(o.gain, node) < std::tie(gain, o.node);
+  }
+};
+
+/// The state of the refinement of one level
+struct Refiner {
+  const Level& level;
+  uint32_t num_parts;
+  uint64_t max_part_weight;
+  katana::LargeArray<uint32_t>* parts;
+  std::vector<uint64_t> part_weights;
+  katana::PerThreadStorage<Connectivity> connectivity;
+  //! The nodes that refinement considers moving
+  std::vector<Node> active;
+  //! The nodes moved since the last call of Activate
+  std::vector<Node> moved;
+  katana::LargeArray<std::atomic<uint8_t>> in_active;
+
+  Refiner(
+      const Level& level_, uint32_t num_parts_, uint64_t max_part_weight_,
+      katana::LargeArray<uint32_t>* parts_)
+      : level(level_),
+        num_parts(num_parts_),
+        max_part_weight(max_part_weight_),
+        parts(parts_) {
+    in_active.allocateInterleaved(level.num_nodes);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, level.num_nodes),
+        [&](Node n) { in_active.constructAt(n, 0); }, katana::no_stats());
+
+    katana::PerThreadStorage<std::vector<uint64_t>> local(num_parts, 0);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, level.num_nodes),
+        [&](Node n) {
+          (*local.getLocal())[(*parts)[n]] += level.node_weights[n];
+        },
+        katana::no_stats());
+    part_weights.assign(num_parts, 0);
+    for (unsigned i = 0; i < katana::getActiveThreads(); ++i) {
+      const std::vector<uint64_t>& weights = *local.getRemote(i);
+      for (uint32_t p = 0; p < num_parts; ++p) {
+        part_weights[p] += weights[p];
+      }
+    }
+  }
+
+  /// Make the moves in order of gain. The gains were found in parallel from
+  /// the parts before any of the moves, and a move is skipped if it would
+  /// make its new part too heavy or, when balancing, if its old part is no
+  /// longer too heavy. Returns the number of moves made.
+  uint64_t Apply(katana::InsertBag<Move>* bag, bool balancing) {
+    std::vector<Move> moves(bag->begin(), bag->end());
+    katana::ParallelSTL::sort(moves.begin(), moves.end());
+    uint64_t num_moves = 0;
+    for (const Move& move : moves) {
+      uint64_t w = level.node_weights[move.node];
+      uint32_t from = (*parts)[move.node];
+      if ((balancing && part_weights[from] <= max_part_weight) ||
+          part_weights[move.to] + w > max_part_weight) {
+        continue;
+      }
+      part_weights[from] -= w;
+      part_weights[move.to] += w;
+      (*parts)[move.node] = move.to;
+      moved.emplace_back(move.node);
+      ++num_moves;
+    }
+    return num_moves;
+  }
+
+  /// Move nodes out of the parts that are too heavy, to the neighboring part
+  /// that adds the fewest edges to the cut or else to the lightest part
+  uint64_t Balance() {
+    uint32_t lightest =
+        std::min_element(part_weights.begin(), part_weights.end()) -
+        part_weights.begin();
+    if (part_weights[lightest] + 1 > max_part_weight ||
+        *std::max_element(part_weights.begin(), part_weights.end()) <=
+            max_part_weight) {
+      return 0;
+    }
+
+    katana::InsertBag<Move> bag;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, level.num_nodes),
+        [&](Node n) {
+          uint32_t from = (*parts)[n];
+          if (part_weights[from] <= max_part_weight) {
+            return;
+          }
+          Connectivity& c = *connectivity.getLocal();
+          c.Compute(level, *parts, num_parts, n);
+          uint64_t w = level.node_weights[n];
+          uint32_t to = kNoPart;
+          for (uint32_t p : c.parts) {
+            if (p != from && part_weights[p] + w <= max_part_weight &&
+                (to == kNoPart || c.Gain(from, p) > c.Gain(from, to))) {
+              to = p;
+            }
+          }
+          if (to == kNoPart) {
+            to = lightest;
+          }
+          if (to != from) {
+            bag.push(Move{c.Gain(from, to), n, to});
+          }
+        },
+        katana::steal(), katana::chunk_size<PartitionPlan::kChunkSize>(),
+        katana::loopname("Partition-Balance"));
+    return Apply(&bag, true);
+  }
+
+  /// Move the nodes on the boundary of their part to the neighboring part
+  /// that most reduces the cut. Only moves to larger parts are considered if
+  /// up is true and only moves to smaller parts otherwise, so that two
+  /// neighbors never swap parts at the same time.
+  uint64_t Refine(bool up) {
+    katana::InsertBag<Move> bag;
+    katana::do_all(
+        katana::iterate(active),
+        [&](Node n) {
+          Connectivity& c = *connectivity.getLocal();
+          c.Compute(level, *parts, num_parts, n);
+          uint32_t from = (*parts)[n];
+          uint32_t to = from;
+          int64_t gain = 0;
+          for (uint32_t p : c.parts) {
+            if ((up ? p > from : p < from) && c.Gain(from, p) > gain) {
+              to = p;
+              gain = c.Gain(from, p);
+            }
+          }
+          if (to != from) {
+            bag.push(Move{gain, n, to});
+          }
+        },
+        katana::steal(), katana::chunk_size<PartitionPlan::kChunkSize>(),
+        katana::loopname("Partition-Refine"));
+    return Apply(&bag, false);
+  }
+
+  /// Make the moved nodes and their neighbors the active nodes, since the
+  /// best moves of the other nodes have not changed
+  void Activate() {
+    katana::InsertBag<Node> bag;
+    auto add = [&](Node n) {
+      if (!in_active[n].exchange(1, std::memory_order_relaxed)) {
+        bag.push(n);
+      }
+    };
+    katana::do_all(
+        katana::iterate(moved),
+        [&](Node n) {
+          add(n);
+          for (Edge e = level.Begin(n); e < level.End(n); ++e) {
+            add(level.edges[e].dst);
+          }
+        },
+        katana::steal(), katana::no_stats());
+    active.assign(bag.begin(), bag.end());
+    katana::do_all(
+        katana::iterate(active),
+        [&](Node n) { in_active[n].store(0, std::memory_order_relaxed); },
+        katana::no_stats());
+    moved.clear();
+  }
+
+  void Run(uint32_t max_rounds) {
+    while (Balance() > 0) {
+    }
+    active.resize(level.num_nodes);
+    std::iota(active.begin(), active.end(), 0);
+    moved.clear();
+    for (uint32_t round = 0; round < max_rounds; ++round) {
+      if (Refine(true) + Refine(false) == 0) {
+        break;
+      }
+      Activate();
+    }
+  }
+};
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::Partition(
+    PropertyGraph* pg, uint32_t num_parts,
+    const std::string& output_property_name, PartitionPlan plan) {
+  if (plan.algorithm() != PartitionPlan::kMultilevelKWay || num_parts == 0 ||
+      !(plan.imbalance() >= 0) || plan.coarsen_to() == 0) {
+    return ErrorCode::InvalidArgument;
+  }
+  if (pg->has_wide_node_ids()) {
+    return ErrorCode::NotImplemented;
+  }
+
+  katana::StatTimer exec_time("Partition");
+  exec_time.start();
+
+  std::vector<Level> levels(1);
+  MakeFinestLevel(pg, &levels[0]);
+
+  uint64_t total_weight = pg->num_nodes();
+  uint64_t coarsen_to = uint64_t{plan.coarsen_to()} * num_parts;
+  // Heavier nodes would leave too few choices for the initial partition
+  uint64_t max_node_weight =
+      std::max<uint64_t>(1, 3 * total_weight / (2 * coarsen_to));
+  while (num_parts > 1 && levels.back().num_nodes > coarsen_to) {
+    Level coarse;
+    if (!Coarsen(&levels.back(), max_node_weight, &coarse)) {
+      break;
+    }
+    levels.emplace_back(std::move(coarse));
+  }
+  katana::ReportStatSingle("Partition", "Levels", levels.size());
+
+  uint64_t max_part_weight = std::max<uint64_t>(
+      1, std::ceil(total_weight * (1 + plan.imbalance()) / num_parts));
+
+  const Level& coarsest = levels.back();
+  katana::LargeArray<uint32_t> parts;
+  parts.allocateInterleaved(coarsest.num_nodes);
+  std::vector<Node> nodes(coarsest.num_nodes);
+  for (uint64_t n = 0; n < coarsest.num_nodes; ++n) {
+    parts[n] = 0;
+    nodes[n] = n;
+  }
+  GrowScratch scratch{
+      .gains = std::vector<int64_t>(coarsest.num_nodes),
+      .in_region = std::vector<uint8_t>(coarsest.num_nodes),
+  };
+  Bisect(coarsest, nodes, 0, num_parts, &parts, &scratch);
+  Refiner(coarsest, num_parts, max_part_weight, &parts)
+      .Run(plan.max_refinement_rounds());
+
+  for (uint64_t i = levels.size() - 1; i > 0; --i) {
+    const Level& fine = levels[i - 1];
+    katana::LargeArray<uint32_t> fine_parts;
+    fine_parts.allocateInterleaved(fine.num_nodes);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, fine.num_nodes),
+        [&](Node n) { fine_parts[n] = parts[fine.coarse[n]]; },
+        katana::no_stats());
+    parts = std::move(fine_parts);
+    Refiner(fine, num_parts, max_part_weight, &parts)
+        .Run(plan.max_refinement_rounds());
+  }
+
+  // Each edge of pg between two parts is counted at both of its nodes
+  const Level& finest = levels[0];
+  katana::GAccumulator<uint64_t> cut;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, finest.num_nodes),
+      [&](Node n) {
+        for (Edge e = finest.Begin(n); e < finest.End(n); ++e) {
+          if (parts[finest.edges[e].dst] != parts[n]) {
+            cut += finest.edges[e].weight;
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+  katana::ReportStatSingle("Partition", "EdgeCut", cut.reduce() / 2);
+
+  exec_time.stop();
+
+  if (auto result = ConstructNodeProperties<std::tuple<NodePart>>(
+          pg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+  auto pg_result = PartGraph::Make(pg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) { graph.GetData<NodePart>(n) = parts[n]; },
+      katana::no_stats());
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::PartitionAssertValid(
+    PropertyGraph* pg, uint32_t num_parts, const std::string& property_name) {
+  auto pg_result = PartGraph::Make(pg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  GReduceLogicalOr invalid;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) {
+        if (graph.GetData<NodePart>(n) >= num_parts) {
+          invalid.update(true);
+        }
+      },
+      katana::no_stats());
+  if (invalid.reduce()) {
+    return ErrorCode::AssertionFailed;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<PartitionStatistics>
+katana::analytics::PartitionStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto pg_result = PartGraph::Make(pg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  GReduceMax<uint32_t> max_part;
+  GAccumulator<uint64_t> edge_cut;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) {
+        uint32_t part = graph.GetData<NodePart>(n);
+        max_part.update(part);
+        for (auto e : graph.edges(n)) {
+          if (graph.GetData<NodePart>(graph.GetEdgeDest(e)) != part) {
+            edge_cut += 1;
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+  uint32_t num_parts = graph.num_nodes() > 0 ? max_part.reduce() + 1 : 0;
+
+  std::vector<std::atomic<uint64_t>> sizes(num_parts);
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) {
+        katana::atomicAdd(sizes[graph.GetData<NodePart>(n)], uint64_t{1});
+      },
+      katana::no_stats());
+
+  std::vector<uint64_t> part_sizes;
+  uint64_t largest = 0;
+  for (const auto& size : sizes) {
+    part_sizes.emplace_back(size.load());
+    largest = std::max(largest, part_sizes.back());
+  }
+  double imbalance = 0;
+  if (graph.num_nodes() > 0) {
+    imbalance =
+        static_cast<double>(largest) * num_parts / graph.num_nodes() - 1;
+  }
+
+  return PartitionStatistics{
+      .num_parts = num_parts,
+      .part_sizes = std::move(part_sizes),
+      .edge_cut = edge_cut.reduce(),
+      .imbalance = imbalance,
+  };
+}
+
+void
+katana::analytics::PartitionStatistics::Print(std::ostream& os) const {
+  os << "Number of parts = " << num_parts << std::endl;
+  os << "Edge cut = " << edge_cut << std::endl;
+  os << "Imbalance = " << imbalance << std::endl;
+  for (uint32_t p = 0; p < part_sizes.size(); ++p) {
+    os << "Nodes in part " << p << " = " << part_sizes[p] << std::endl;
+  }
+}
@@ -0,0 +1,836 @@
+#include "katana/analytics/random_walks/random_walks.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <arrow/io/file.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/properties.h>
+
+#include "katana/PerThreadStorage.h"
+#include "katana/Reduction.h"
+#include "katana/TypedPropertyGraph.h"
+
+using namespace katana::analytics;
+
+const int RandomWalksPlan::kChunkSize = 64;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+template <typename T>
+struct EdgeValue : public katana::PODProperty<T> {};
+
+/// Edge types are dense indexes into a num_types x num_types matrix
+constexpr uint64_t kMaxEdgeTypes = 1024;
+
+/// Nodes with at most this many edges are searched linearly
+constexpr uint64_t kLinearSearchDegree = 16;
+
+/// A SplitMix64 generator. It is small and cheap to seed, so every walk gets
+/// its own generator seeded by its id, which makes the walks independent of
+/// how they are scheduled.
+class WalkRandom {
+public:
+  WalkRandom(uint64_t seed, uint64_t walk, uint64_t round)
+      : state_(seed ^ Mix(walk ^ Mix(round))) {}
+
+  uint64_t Next() {
+    state_ += kGamma;
+    return Mix(state_);
+  }
+
+  /// A uniform double in [0, 1)
+  double NextDouble() { return static_cast<double>(Next() >> 11) * 0x1.0p-53; }
+
+  /// A uniform integer in [0, n)
+  uint64_t NextIndex(uint64_t n) {
+    return std::min<uint64_t>(NextDouble() * n, n - 1);
+  }
+
+private:
+  static constexpr uint64_t kGamma = 0x9e3779b97f4a7c15ULL;
+
+  static uint64_t Mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  uint64_t state_;
+};
+
+/// The topology of the input graph and everything derived from its
+/// properties that the walks read
+struct WalkGraph {
+  uint64_t num_nodes{0};
+  const uint64_t* indices{nullptr};
+  const Node* dests{nullptr};
+
+  //! Alias tables over the edges of each node, if edges are weighted: edge
+  //! begin + i is taken with probability alias_probability[begin + i] when
+  //! slot i is drawn, and edge begin + alias[begin + i] otherwise
+  bool weighted{false};
+  katana::LargeArray<double> alias_probability;
+  katana::LargeArray<uint32_t> alias;
+  //! Whether each node has an edge of positive weight
+  katana::LargeArray<uint8_t> can_leave;
+
+  //! The destinations of each node in sorted order, for neighbor tests;
+  //! points to dests if they are already sorted
+  const Node* sorted_dests{nullptr};
+  katana::LargeArray<Node> owned_sorted_dests;
+
+  katana::LargeArray<uint32_t> types;
+  uint32_t num_types{0};
+
+  Edge Begin(Node n) const { return n > 0 ? indices[n - 1] : 0; }
+  Edge End(Node n) const { return indices[n]; }
+
+  bool CanLeave(Node n) const {
+    return weighted ? can_leave[n] != 0 : End(n) > Begin(n);
+  }
+
+  /// An edge of n, picked with probability proportional to its weight
+  Edge SampleEdge(Node n, WalkRandom* random) const {
+    Edge begin = Begin(n);
+    Edge e = begin + random->NextIndex(End(n) - begin);
+    if (!weighted || random->NextDouble() < alias_probability[e]) {
+      return e;
+    }
+    return begin + alias[e];
+  }
+
+  /// Whether b is a destination of a
+  bool IsNeighbor(Node a, Node b) const {
+    const Node* begin = sorted_dests + Begin(a);
+    const Node* end = sorted_dests + End(a);
+    if (end - begin <= static_cast<int64_t>(kLinearSearchDegree)) {
+      return std::find(begin, end, b) != end;
+    }
+    return std::binary_search(begin, end, b);
+  }
+};
+
+template <typename Weight>
+katana::Result<void>
+CopyEdgeValues(
+    katana::PropertyGraph* pg, const std::string& property_name,
+    katana::LargeArray<double>* values) {
+  using ValueGraph =
+      katana::TypedPropertyGraph<std::tuple<>, std::tuple<EdgeValue<Weight>>>;
+  auto pg_result = ValueGraph::Make(pg, {}, {property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const Node& n) {
+        for (auto e : graph.edges(n)) {
+          (*values)[e] = graph.template GetEdgeData<EdgeValue<Weight>>(e);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  return katana::ResultSuccess();
+}
+
+/// Copy the numeric edge property property_name of pg to values
+katana::Result<void>
+CopyEdgeValues(
+    katana::PropertyGraph* pg, const std::string& property_name,
+    katana::LargeArray<double>* values, bool integers_only) {
+  auto property = pg->GetEdgeProperty(property_name);
+  if (!property) {
+    return katana::ErrorCode::PropertyNotFound;
+  }
+  switch (property->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return CopyEdgeValues<uint32_t>(pg, property_name, values);
+  case arrow::Int32Type::type_id:
+    return CopyEdgeValues<int32_t>(pg, property_name, values);
+  case arrow::UInt64Type::type_id:
+    return CopyEdgeValues<uint64_t>(pg, property_name, values);
+  case arrow::Int64Type::type_id:
+    return CopyEdgeValues<int64_t>(pg, property_name, values);
+  case arrow::FloatType::type_id:
+    if (integers_only) {
+      return katana::ErrorCode::TypeError;
+    }
+    return CopyEdgeValues<float>(pg, property_name, values);
+  case arrow::DoubleType::type_id:
+    if (integers_only) {
+      return katana::ErrorCode::TypeError;
+    }
+    return CopyEdgeValues<double>(pg, property_name, values);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
+
+/// Build the alias table of every node with Vose's method.
+/// [1] M. D. Vose, "A Linear Algorithm for Generating Random Numbers with a
+/// Given Distribution," IEEE Trans. Softw. Eng. 17(9), 1991.
+void
+BuildAliasTables(const katana::LargeArray<double>& weights, WalkGraph* graph) {
+  graph->alias_probability.allocateInterleaved(weights.size());
+  graph->alias.allocateInterleaved(weights.size());
+  graph->can_leave.allocateInterleaved(graph->num_nodes);
+
+  katana::PerThreadStorage<std::vector<uint32_t>> small_stacks;
+  katana::PerThreadStorage<std::vector<uint32_t>> large_stacks;
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph->num_nodes),
+      [&](uint64_t n) {
+        Edge begin = graph->Begin(n);
+        uint64_t degree = graph->End(n) - begin;
+        double total = 0;
+        uint32_t heaviest = 0;
+        for (uint64_t i = 0; i < degree; ++i) {
+          total += weights[begin + i];
+          if (weights[begin + i] > weights[begin + heaviest]) {
+            heaviest = i;
+          }
+        }
+        graph->can_leave[n] = total > 0;
+        if (!(total > 0)) {
+          return;
+        }
+
+        //! Scale the weights so they average 1; a slot whose scaled weight
+        //! is below 1 is topped up by a slot above 1
+        double* probability = &graph->alias_probability[begin];
+        uint32_t* alias = &graph->alias[begin];
+        std::vector<uint32_t>& small = *small_stacks.getLocal();
+        std::vector<uint32_t>& large = *large_stacks.getLocal();
+        small.clear();
+        large.clear();
+        for (uint64_t i = 0; i < degree; ++i) {
+          probability[i] = weights[begin + i] * degree / total;
+          alias[i] = i;
+          (probability[i] < 1 ? small : large).emplace_back(i);
+        }
+        while (!small.empty() && !large.empty()) {
+          uint32_t s = small.back();
+          small.pop_back();
+          uint32_t l = large.back();
+          alias[s] = l;
+          probability[l] -= 1 - probability[s];
+          if (probability[l] < 1) {
+            large.pop_back();
+            small.emplace_back(l);
+          }
+        }
+        for (uint32_t l : large) {
+          probability[l] = 1;
+        }
+        //! Only rounding leaves slots here; never let them pick an edge of
+        //! weight 0
+        for (uint32_t s : small) {
+          if (weights[begin + s] > 0) {
+            probability[s] = 1;
+          } else {
+            probability[s] = 0;
+            alias[s] = heaviest;
+          }
+        }
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("RandomWalks-AliasTables"));
+}
+
+katana::Result<void>
+LoadWeights(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    WalkGraph* graph) {
+  if (edge_weight_property_name.empty()) {
+    return katana::ResultSuccess();
+  }
+  katana::LargeArray<double> weights;
+  weights.allocateInterleaved(pg->num_edges());
+  if (auto result = CopyEdgeValues(
+          pg, edge_weight_property_name, &weights, /*integers_only=*/false);
+      !result) {
+    return result.error();
+  }
+
+  katana::GReduceLogicalOr invalid;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, pg->num_edges()),
+      [&](uint64_t e) {
+        if (!(weights[e] >= 0) || !std::isfinite(weights[e])) {
+          invalid.update(true);
+        }
+      },
+      katana::no_stats());
+  if (invalid.reduce()) {
+    KATANA_LOG_DEBUG("edge weights must be finite and non-negative");
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  graph->weighted = true;
+  BuildAliasTables(weights, graph);
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+LoadTypes(
+    katana::PropertyGraph* pg, const std::string& edge_type_property_name,
+    WalkGraph* graph) {
+  katana::LargeArray<double> values;
+  values.allocateInterleaved(pg->num_edges());
+  if (auto result = CopyEdgeValues(
+          pg, edge_type_property_name, &values, /*integers_only=*/true);
+      !result) {
+    return result.error();
+  }
+
+  graph->types.allocateInterleaved(pg->num_edges());
+  katana::GReduceMax<uint32_t> max_type;
+  katana::GReduceLogicalOr invalid;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, pg->num_edges()),
+      [&](uint64_t e) {
+        if (!(values[e] >= 0 && values[e] < kMaxEdgeTypes)) {
+          invalid.update(true);
+          return;
+        }
+        graph->types[e] = values[e];
+        max_type.update(graph->types[e]);
+      },
+      katana::no_stats());
+  if (invalid.reduce()) {
+    KATANA_LOG_DEBUG("edge types must be in [0, {})", kMaxEdgeTypes);
+    return katana::ErrorCode::InvalidArgument;
+  }
+  graph->num_types = pg->num_edges() > 0 ? max_type.reduce() + 1 : 1;
+  return katana::ResultSuccess();
+}
+
+/// Point sorted_dests at the destinations of each node in sorted order
+void
+SortDests(WalkGraph* graph) {
+  katana::GReduceLogicalOr unsorted;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph->num_nodes),
+      [&](uint64_t n) {
+        if (!std::is_sorted(
+                graph->dests + graph->Begin(n), graph->dests + graph->End(n))) {
+          unsorted.update(true);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  if (!unsorted.reduce()) {
+    graph->sorted_dests = graph->dests;
+    return;
+  }
+
+  uint64_t num_edges = graph->num_nodes ? graph->End(graph->num_nodes - 1) : 0;
+  graph->owned_sorted_dests.allocateInterleaved(num_edges);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, graph->num_nodes),
+      [&](uint64_t n) {
+        Node* sorted = graph->owned_sorted_dests.data();
+        std::copy(
+            graph->dests + graph->Begin(n), graph->dests + graph->End(n),
+            sorted + graph->Begin(n));
+        std::sort(sorted + graph->Begin(n), sorted + graph->End(n));
+      },
+      katana::steal(), katana::no_stats());
+  graph->sorted_dests = graph->owned_sorted_dests.data();
+}
+
+/// The sums over walks of the edge type counts of each walk, and of the
+/// products of each pair of them, from which Edge2vec correlates edge types
+struct TypeCounts {
+  uint64_t num_walks{0};
+  std::vector<double> sums;
+  std::vector<double> products;
+
+  void Reset(uint32_t num_types) {
+    num_walks = 0;
+    sums.assign(num_types, 0);
+    products.assign(num_types * num_types, 0);
+  }
+
+  /// Add the counts of a walk whose edges have the given types
+  void Add(uint32_t* types, uint32_t num_steps, uint32_t num_types) {
+    ++num_walks;
+    std::sort(types, types + num_steps);
+    for (uint32_t i = 0; i < num_steps;) {
+      uint32_t j = i;
+      while (j < num_steps && types[j] == types[i]) {
+        ++j;
+      }
+      double count_i = j - i;
+      sums[types[i]] += count_i;
+      for (uint32_t k = 0; k < num_steps;) {
+        uint32_t l = k;
+        while (l < num_steps && types[l] == types[k]) {
+          ++l;
+        }
+        products[types[i] * num_types + types[k]] += count_i * (l - k);
+        k = l;
+      }
+      i = j;
+    }
+  }
+};
+
+/// The Edge2vec transition weight between each pair of edge types: the
+/// sigmoid of the Pearson correlation of their counts over walks
+std::vector<double>
+TransitionMatrix(const TypeCounts& counts, uint32_t num_types) {
+  std::vector<double> matrix(num_types * num_types, 1.0);
+  if (counts.num_walks == 0) {
+    return matrix;
+  }
+  double n = counts.num_walks;
+  auto variance = [&](uint32_t i) {
+    double mean = counts.sums[i] / n;
+    return counts.products[i * num_types + i] / n - mean * mean;
+  };
+  for (uint32_t i = 0; i < num_types; ++i) {
+    for (uint32_t j = 0; j < num_types; ++j) {
+      double covariance = counts.products[i * num_types + j] / n -
+                          (counts.sums[i] / n) * (counts.sums[j] / n);
+      double deviations = std::sqrt(variance(i) * variance(j));
+      double correlation = deviations > 0 ? covariance / deviations : 0;
+      matrix[i * num_types + j] = 1 / (1 + std::exp(-correlation));
+    }
+  }
+  return matrix;
+}
+
+class Walker {
+public:
+  Walker(
+      const WalkGraph& graph, const RandomWalksPlan& plan,
+      const std::vector<double>* transition)
+      : graph_(graph),
+        plan_(plan),
+        transition_(transition),
+        backward_weight_(1 / plan.backward_probability()),
+        forward_weight_(1 / plan.forward_probability()),
+        upper_bound_(std::max({1.0, backward_weight_, forward_weight_})),
+        lower_bound_(std::min({1.0, backward_weight_, forward_weight_})) {}
+
+  /// Write the nodes of walk to nodes and the types of its edges to types,
+  /// if there is a transition matrix, and return the number of nodes.
+  uint32_t Walk(
+      uint64_t walk, uint32_t round, Node* nodes, uint32_t* types) const {
+    WalkRandom random(plan_.seed(), walk, round);
+    uint32_t length = 1;
+    nodes[0] = walk % graph_.num_nodes;
+    for (; length < plan_.walk_length(); ++length) {
+      Node curr = nodes[length - 1];
+      if (!graph_.CanLeave(curr)) {
+        break;
+      }
+      Edge e = graph_.SampleEdge(curr, &random);
+      if (length > 1) {
+        Node prev = nodes[length - 2];
+        uint32_t prev_type = transition_ ? types[length - 2] : 0;
+        while (!Accept(e, prev, prev_type, &random)) {
+          e = graph_.SampleEdge(curr, &random);
+        }
+      }
+      nodes[length] = graph_.dests[e];
+      if (transition_) {
+        types[length - 1] = graph_.types[e];
+      }
+    }
+    return length;
+  }
+
+private:
+  /// Accept the edge e from the node after prev with probability proportional
+  /// to its second-order weight
+  bool Accept(
+      Edge e, Node prev, uint32_t prev_type, WalkRandom* random) const {
+    double y = random->NextDouble() * upper_bound_;
+    if (!transition_ && y <= lower_bound_) {
+      return true;
+    }
+    Node dest = graph_.dests[e];
+    double alpha = 1.0;
+    if (dest == prev) {
+      alpha = backward_weight_;
+    } else if (forward_weight_ != 1.0 && !graph_.IsNeighbor(prev, dest)) {
+      alpha = forward_weight_;
+    }
+    if (transition_) {
+      alpha *= (*transition_)[prev_type * graph_.num_types + graph_.types[e]];
+    }
+    return alpha >= y;
+  }
+
+  const WalkGraph& graph_;
+  const RandomWalksPlan& plan_;
+  const std::vector<double>* transition_;
+  double backward_weight_;
+  double forward_weight_;
+  double upper_bound_;
+  double lower_bound_;
+};
+
+/// Generate the walks [first_walk, first_walk + num_walks) into a fixed size
+/// list array
+katana::Result<std::shared_ptr<arrow::FixedSizeListArray>>
+MakeBatch(
+    const Walker& walker, uint64_t first_walk, uint64_t num_walks,
+    uint32_t round, uint32_t walk_length) {
+  uint64_t num_values = num_walks * walk_length;
+  auto data_result = arrow::AllocateBuffer(num_values * sizeof(Node));
+  if (!data_result.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::Buffer> data = std::move(data_result.ValueOrDie());
+  Node* values = reinterpret_cast<Node*>(data->mutable_data());
+
+  katana::LargeArray<uint32_t> lengths;
+  lengths.allocateInterleaved(num_walks);
+  katana::PerThreadStorage<std::vector<uint32_t>> types;
+  katana::GAccumulator<uint64_t> num_nulls;
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_walks),
+      [&](uint64_t i) {
+        std::vector<uint32_t>& walk_types = *types.getLocal();
+        walk_types.resize(walk_length);
+        Node* nodes = values + i * walk_length;
+        uint32_t length =
+            walker.Walk(first_walk + i, round, nodes, walk_types.data());
+        std::fill(nodes + length, nodes + walk_length, 0);
+        lengths[i] = length;
+        num_nulls += walk_length - length;
+      },
+      katana::steal(),
+      katana::chunk_size<RandomWalksPlan::kChunkSize>(),
+      katana::loopname("RandomWalks"));
+
+  std::shared_ptr<arrow::Buffer> null_bitmap;
+  uint64_t null_count = num_nulls.reduce();
+  if (null_count > 0) {
+    uint64_t num_bytes = (num_values + 7) / 8;
+    auto bitmap_result = arrow::AllocateBuffer(num_bytes);
+    if (!bitmap_result.ok()) {
+      return katana::ErrorCode::ArrowError;
+    }
+    null_bitmap = std::move(bitmap_result.ValueOrDie());
+    uint8_t* bits = null_bitmap->mutable_data();
+    //! Each byte is written by one iteration, so walks that share a byte do
+    //! not race
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_bytes),
+        [&](uint64_t b) {
+          uint8_t byte = 0;
+          for (uint64_t bit = 0; bit < 8; ++bit) {
+            uint64_t v = b * 8 + bit;
+            if (v < num_values && v % walk_length < lengths[v / walk_length]) {
+              byte |= 1 << bit;
+            }
+          }
+          bits[b] = byte;
+        },
+        katana::no_stats());
+  }
+
+  auto nodes = std::make_shared<arrow::UInt32Array>(
+      num_values, data, null_bitmap, null_count);
+  return std::make_shared<arrow::FixedSizeListArray>(
+      arrow::fixed_size_list(arrow::uint32(), walk_length), num_walks, nodes);
+}
+
+/// Run the rounds of Edge2vec walks that only update the transition matrix
+void
+LearnTransitions(
+    const WalkGraph& graph, const RandomWalksPlan& plan, uint64_t total_walks,
+    std::vector<double>* transition) {
+  katana::PerThreadStorage<TypeCounts> counts;
+  katana::PerThreadStorage<std::vector<Node>> nodes;
+  katana::PerThreadStorage<std::vector<uint32_t>> types;
+
+  for (uint32_t round = 0; round + 1 < plan.max_iterations(); ++round) {
+    Walker walker(graph, plan, transition);
+    katana::on_each([&](unsigned, unsigned) {
+      counts.getLocal()->Reset(graph.num_types);
+      nodes.getLocal()->resize(plan.walk_length());
+      types.getLocal()->resize(plan.walk_length());
+    });
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, total_walks),
+        [&](uint64_t walk) {
+          uint32_t* walk_types = types.getLocal()->data();
+          uint32_t length = walker.Walk(
+              walk, round, nodes.getLocal()->data(), walk_types);
+          counts.getLocal()->Add(walk_types, length - 1, graph.num_types);
+        },
+        katana::steal(),
+        katana::chunk_size<RandomWalksPlan::kChunkSize>(),
+        katana::loopname("Edge2vec-Learn"));
+
+    TypeCounts total;
+    total.Reset(graph.num_types);
+    for (unsigned t = 0; t < counts.size(); ++t) {
+      const TypeCounts& local = *counts.getRemote(t);
+      if (local.sums.empty()) {
+        continue;
+      }
+      total.num_walks += local.num_walks;
+      for (uint32_t i = 0; i < graph.num_types; ++i) {
+        total.sums[i] += local.sums[i];
+      }
+      for (uint64_t i = 0; i < total.products.size(); ++i) {
+        total.products[i] += local.products[i];
+      }
+    }
+    *transition = TransitionMatrix(total, graph.num_types);
+  }
+}
+
+katana::Result<void>
+CheckPlan(const RandomWalksPlan& plan) {
+  if (plan.algorithm() != RandomWalksPlan::kNode2vec &&
+      plan.algorithm() != RandomWalksPlan::kEdge2vec) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+  if (plan.walk_length() == 0 ||
+      !(plan.backward_probability() > 0 &&
+        std::isfinite(plan.backward_probability())) ||
+      !(plan.forward_probability() > 0 &&
+        std::isfinite(plan.forward_probability()))) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+  if (plan.algorithm() == RandomWalksPlan::kEdge2vec &&
+      plan.max_iterations() == 0) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::RandomWalksInBatches(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& edge_type_property_name, uint64_t batch_size,
+    const RandomWalksConsumer& consume, RandomWalksPlan plan) {
+  if (auto result = CheckPlan(plan); !result) {
+    return result.error();
+  }
+  if (batch_size == 0) {
+    return ErrorCode::InvalidArgument;
+  }
+  if (pg->has_wide_node_ids()) {
+    return ErrorCode::NotImplemented;
+  }
+
+  WalkGraph graph;
+  graph.num_nodes = pg->num_nodes();
+  if (graph.num_nodes > 0) {
+    graph.indices = pg->topology().out_indices->raw_values();
+  }
+  if (pg->num_edges() > 0) {
+    graph.dests = pg->topology().out_dests->raw_values();
+  }
+
+  katana::StatTimer exec_time("RandomWalks");
+  exec_time.start();
+
+  if (auto result = LoadWeights(pg, edge_weight_property_name, &graph);
+      !result) {
+    return result.error();
+  }
+  bool edge2vec = plan.algorithm() == RandomWalksPlan::kEdge2vec;
+  if (edge2vec) {
+    if (auto result = LoadTypes(pg, edge_type_property_name, &graph);
+        !result) {
+      return result.error();
+    }
+  }
+  if (plan.forward_probability() != 1.0) {
+    SortDests(&graph);
+  }
+
+  uint64_t total_walks = graph.num_nodes * plan.number_of_walks();
+  std::vector<double> transition;
+  uint32_t round = 0;
+  if (edge2vec) {
+    transition.assign(graph.num_types * graph.num_types, 1.0);
+    LearnTransitions(graph, plan, total_walks, &transition);
+    round = plan.max_iterations() - 1;
+  }
+
+  Walker walker(graph, plan, edge2vec ? &transition : nullptr);
+  for (uint64_t first = 0; first < total_walks; first += batch_size) {
+    uint64_t num_walks = std::min(batch_size, total_walks - first);
+    auto batch_result =
+        MakeBatch(walker, first, num_walks, round, plan.walk_length());
+    if (!batch_result) {
+      return batch_result.error();
+    }
+    if (auto result = consume(batch_result.value()); !result) {
+      return result.error();
+    }
+  }
+
+  exec_time.stop();
+  return katana::ResultSuccess();
+}
+
+katana::Result<std::shared_ptr<arrow::FixedSizeListArray>>
+katana::analytics::RandomWalks(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& edge_type_property_name, RandomWalksPlan plan) {
+  std::vector<std::shared_ptr<arrow::FixedSizeListArray>> batches;
+  uint64_t total_walks = pg->num_nodes() * plan.number_of_walks();
+  auto result = RandomWalksInBatches(
+      pg, edge_weight_property_name, edge_type_property_name,
+      std::max<uint64_t>(total_walks, 1),
+      [&](const std::shared_ptr<arrow::FixedSizeListArray>& batch)
+          -> katana::Result<void> {
+        batches.emplace_back(batch);
+        return katana::ResultSuccess();
+      },
+      plan);
+  if (!result) {
+    return result.error();
+  }
+  if (!batches.empty()) {
+    return batches.front();
+  }
+
+  // No walks
+  arrow::UInt32Builder builder;
+  std::shared_ptr<arrow::UInt32Array> nodes;
+  if (!builder.Finish(&nodes).ok()) {
+    return ErrorCode::ArrowError;
+  }
+  return std::make_shared<arrow::FixedSizeListArray>(
+      arrow::fixed_size_list(arrow::uint32(), plan.walk_length()), 0, nodes);
+}
+
+katana::Result<void>
+katana::analytics::RandomWalksToParquet(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& edge_type_property_name, const std::string& path,
+    uint64_t batch_size, RandomWalksPlan plan) {
+  auto schema = arrow::schema({arrow::field(
+      "walk", arrow::fixed_size_list(arrow::uint32(), plan.walk_length()))});
+
+  auto sink_result = arrow::io::FileOutputStream::Open(path);
+  if (!sink_result.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", sink_result.status());
+    return ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::io::FileOutputStream> sink = sink_result.ValueOrDie();
+
+  std::unique_ptr<parquet::arrow::FileWriter> writer;
+  auto open_status = parquet::arrow::FileWriter::Open(
+      *schema, arrow::default_memory_pool(), sink,
+      parquet::default_writer_properties(),
+      parquet::default_arrow_writer_properties(), &writer);
+  if (!open_status.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", open_status);
+    return ErrorCode::ArrowError;
+  }
+
+  auto result = RandomWalksInBatches(
+      pg, edge_weight_property_name, edge_type_property_name, batch_size,
+      [&](const std::shared_ptr<arrow::FixedSizeListArray>& batch)
+          -> katana::Result<void> {
+        auto table = arrow::Table::Make(schema, {batch});
+        auto write_status = writer->WriteTable(*table, batch->length());
+        if (!write_status.ok()) {
+          KATANA_LOG_DEBUG("arrow error: {}", write_status);
+          return ErrorCode::ArrowError;
+        }
+        return katana::ResultSuccess();
+      },
+      plan);
+
+  auto close_status = writer->Close();
+  if (close_status.ok()) {
+    close_status = sink->Close();
+  }
+  if (!result) {
+    return result.error();
+  }
+  if (!close_status.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", close_status);
+    return ErrorCode::ArrowError;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::RandomWalksAssertValid(
+    PropertyGraph* pg,
+    const std::shared_ptr<arrow::FixedSizeListArray>& walks) {
+  if (pg->has_wide_node_ids()) {
+    return ErrorCode::NotImplemented;
+  }
+  if (walks->value_type()->id() != arrow::UInt32Type::type_id ||
+      walks->null_count() > 0) {
+    return ErrorCode::AssertionFailed;
+  }
+  auto nodes = std::static_pointer_cast<arrow::UInt32Array>(walks->values());
+  uint64_t walk_length = walks->list_type()->list_size();
+  const katana::GraphTopology& topology = pg->topology();
+
+  katana::GReduceLogicalOr invalid;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, static_cast<uint64_t>(walks->length())),
+      [&](uint64_t w) {
+        uint64_t offset = walks->value_offset(w);
+        for (uint64_t i = 0; i < walk_length; ++i) {
+          if (nodes->IsNull(offset + i)) {
+            //! Nulls end a walk, which has at least its start node
+            if (i == 0) {
+              invalid.update(true);
+            }
+            for (uint64_t j = i; j < walk_length; ++j) {
+              if (nodes->IsValid(offset + j)) {
+                invalid.update(true);
+              }
+            }
+            return;
+          }
+          Node n = nodes->Value(offset + i);
+          if (n >= topology.num_nodes()) {
+            invalid.update(true);
+            return;
+          }
+          if (i > 0) {
+            Node prev = nodes->Value(offset + i - 1);
+            bool found = false;
+            for (auto e : topology.edges(prev)) {
+              if (topology.out_dests->Value(e) == n) {
+                found = true;
+                break;
+              }
+            }
+            if (!found) {
+              invalid.update(true);
+              return;
+            }
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  if (invalid.reduce()) {
+    return ErrorCode::AssertionFailed;
+  }
+  return katana::ResultSuccess();
+}
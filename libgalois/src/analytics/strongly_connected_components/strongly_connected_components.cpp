@@ -0,0 +1,661 @@
+#include "katana/analytics/strongly_connected_components/strongly_connected_components.h"
+
+#include <atomic>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "katana/ArrowRandomAccessBuilder.h"
+#include "katana/AtomicHelpers.h"
+#include "katana/TypedPropertyGraph.h"
+
+using namespace katana::analytics;
+
+const int StronglyConnectedComponentsPlan::kChunkSize = 64;
+
+namespace {
+
+using ComponentType = uint64_t;
+struct NodeComponent : public katana::PODProperty<ComponentType> {};
+
+using NodeData = std::tuple<NodeComponent>;
+using EdgeData = std::tuple<>;
+typedef katana::TypedPropertyGraph<NodeData, EdgeData> Graph;
+typedef typename Graph::Node GNode;
+
+using NodeVec = katana::InsertBag<GNode>;
+
+constexpr uint32_t kUnassigned = std::numeric_limits<uint32_t>::max();
+
+/// The out-edges and in-edges of a graph as plain arrays, and the component
+/// of each node found so far
+struct SccState {
+  uint64_t num_nodes;
+  const uint64_t* out_indices;
+  const uint32_t* out_dests;
+  const uint64_t* in_indices;
+  const uint32_t* in_sources;
+
+  //! The component of each node, or kUnassigned if it is still active
+  katana::LargeArray<std::atomic<uint32_t>> component;
+  //! The number of edges from other active nodes to each active node
+  katana::LargeArray<std::atomic<uint32_t>> in_degree;
+  //! The number of edges from each active node to other active nodes
+  katana::LargeArray<std::atomic<uint32_t>> out_degree;
+  //! Per node scratch: colors during coloring and reachability marks during
+  //! forward-backward search
+  katana::LargeArray<std::atomic<uint32_t>> color;
+
+  SccState(const katana::PropertyGraph& pg)
+      : num_nodes(pg.num_nodes()),
+        out_indices(pg.topology().out_indices->raw_values()),
+        out_dests(pg.topology().out_dests->raw_values()),
+        in_indices(pg.in_topology().in_indices->raw_values()),
+        in_sources(pg.in_topology().in_sources->raw_values()) {
+    component.allocateInterleaved(num_nodes);
+    in_degree.allocateInterleaved(num_nodes);
+    out_degree.allocateInterleaved(num_nodes);
+    color.allocateInterleaved(num_nodes);
+  }
+
+  uint64_t OutBegin(GNode n) const { return n > 0 ? out_indices[n - 1] : 0; }
+  uint64_t OutEnd(GNode n) const { return out_indices[n]; }
+  uint64_t InBegin(GNode n) const { return n > 0 ? in_indices[n - 1] : 0; }
+  uint64_t InEnd(GNode n) const { return in_indices[n]; }
+
+  bool IsActive(GNode n) const {
+    return component[n].load(std::memory_order_relaxed) == kUnassigned;
+  }
+
+  /// Put an active node in component c. Returns false if the node already
+  /// had a component.
+  bool Assign(GNode n, uint32_t c) {
+    uint32_t expected = kUnassigned;
+    return component[n].compare_exchange_strong(
+        expected, c, std::memory_order_relaxed);
+  }
+};
+
+/// Replace active with the nodes in it that are still active
+void
+Compact(SccState* state, std::unique_ptr<NodeVec>* active) {
+  auto remaining = std::make_unique<NodeVec>();
+  katana::do_all(
+      katana::iterate(**active),
+      [&](const GNode& n) {
+        if (state->IsActive(n)) {
+          remaining->push(n);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  *active = std::move(remaining);
+}
+
+/**
+ * Put every active node without edges from or to other active nodes in a
+ * component of its own. Removing such a node can leave its neighbors without
+ * edges in turn, so this repeats until no such node is left. Afterwards, the
+ * degrees of the remaining active nodes are exact.
+ */
+void
+TrimSingletons(SccState* state, const NodeVec& active) {
+  NodeVec trimmed;
+
+  katana::do_all(
+      katana::iterate(active),
+      [&](const GNode& n) {
+        uint32_t in_degree = 0;
+        for (uint64_t e = state->InBegin(n); e < state->InEnd(n); ++e) {
+          GNode src = state->in_sources[e];
+          in_degree += src != n && state->IsActive(src);
+        }
+        uint32_t out_degree = 0;
+        for (uint64_t e = state->OutBegin(n); e < state->OutEnd(n); ++e) {
+          GNode dest = state->out_dests[e];
+          out_degree += dest != n && state->IsActive(dest);
+        }
+        state->in_degree[n].store(in_degree, std::memory_order_relaxed);
+        state->out_degree[n].store(out_degree, std::memory_order_relaxed);
+        if (in_degree == 0 || out_degree == 0) {
+          trimmed.push(n);
+        }
+      },
+      katana::steal(), katana::loopname("SCC Degrees"));
+
+  katana::for_each(
+      katana::iterate(trimmed),
+      [&](const GNode& n, auto& ctx) {
+        //! A node is pushed once for each degree that drops to zero.
+        if (!state->Assign(n, n)) {
+          return;
+        }
+        for (uint64_t e = state->OutBegin(n); e < state->OutEnd(n); ++e) {
+          GNode dest = state->out_dests[e];
+          if (dest != n && state->IsActive(dest) &&
+              katana::atomicSub(state->in_degree[dest], 1u) == 1) {
+            ctx.push(dest);
+          }
+        }
+        for (uint64_t e = state->InBegin(n); e < state->InEnd(n); ++e) {
+          GNode src = state->in_sources[e];
+          if (src != n && state->IsActive(src) &&
+              katana::atomicSub(state->out_degree[src], 1u) == 1) {
+            ctx.push(src);
+          }
+        }
+      },
+      katana::disable_conflict_detection(),
+      katana::chunk_size<StronglyConnectedComponentsPlan::kChunkSize>(),
+      katana::loopname("SCC Trim1"));
+}
+
+/// The only active neighbor of n among [begin, end) of neighbors, or
+/// kUnassigned if there is none
+GNode
+OnlyActiveNeighbor(
+    const SccState& state, GNode n, const uint32_t* neighbors, uint64_t begin,
+    uint64_t end) {
+  for (uint64_t e = begin; e < end; ++e) {
+    GNode other = neighbors[e];
+    if (other != n && state.IsActive(other)) {
+      return other;
+    }
+  }
+  return kUnassigned;
+}
+
+/**
+ * Find the components of size two that only one edge enters (or leaves),
+ * i.e., pairs of active nodes u and v where v is the only active node with
+ * an edge to u and u is the only active node with an edge to v (or likewise
+ * for outgoing edges).
+ *
+ * Requires the exact degrees left by TrimSingletons; degrees only become
+ * overestimates as pairs are assigned, which can only miss pairs.
+ */
+void
+TrimPairs(SccState* state, const NodeVec& active) {
+  katana::do_all(
+      katana::iterate(active),
+      [&](const GNode& u) {
+        if (!state->IsActive(u)) {
+          return;
+        }
+        GNode v = kUnassigned;
+        if (state->in_degree[u].load(std::memory_order_relaxed) == 1) {
+          GNode w = OnlyActiveNeighbor(
+              *state, u, state->in_sources, state->InBegin(u),
+              state->InEnd(u));
+          if (w != kUnassigned && u < w &&
+              state->in_degree[w].load(std::memory_order_relaxed) == 1 &&
+              OnlyActiveNeighbor(
+                  *state, w, state->in_sources, state->InBegin(w),
+                  state->InEnd(w)) == u) {
+            v = w;
+          }
+        }
+        if (v == kUnassigned &&
+            state->out_degree[u].load(std::memory_order_relaxed) == 1) {
+          GNode w = OnlyActiveNeighbor(
+              *state, u, state->out_dests, state->OutBegin(u),
+              state->OutEnd(u));
+          if (w != kUnassigned && u < w &&
+              state->out_degree[w].load(std::memory_order_relaxed) == 1 &&
+              OnlyActiveNeighbor(
+                  *state, w, state->out_dests, state->OutBegin(w),
+                  state->OutEnd(w)) == u) {
+            v = w;
+          }
+        }
+        //! Each node is in at most one such pair, and only the thread for
+        //! its smaller node assigns it.
+        if (v != kUnassigned) {
+          state->Assign(u, u);
+          state->Assign(v, u);
+        }
+      },
+      katana::steal(), katana::loopname("SCC Trim2"));
+}
+
+/// Mark the active nodes reachable from pivot by following out-edges (or
+/// in-edges) with bit in color.
+void
+MarkReachable(
+    SccState* state, GNode pivot, uint32_t bit, const uint64_t* indices,
+    const uint32_t* neighbors) {
+  auto current = std::make_unique<NodeVec>();
+  auto next = std::make_unique<NodeVec>();
+  state->color[pivot].fetch_or(bit, std::memory_order_relaxed);
+  next->push(pivot);
+
+  while (!next->empty()) {
+    std::swap(current, next);
+    next->clear();
+    katana::do_all(
+        katana::iterate(*current),
+        [&](const GNode& n) {
+          uint64_t begin = n > 0 ? indices[n - 1] : 0;
+          for (uint64_t e = begin; e < indices[n]; ++e) {
+            GNode other = neighbors[e];
+            if (state->IsActive(other) &&
+                !(state->color[other].fetch_or(
+                      bit, std::memory_order_relaxed) &
+                  bit)) {
+              next->push(other);
+            }
+          }
+        },
+        katana::steal(),
+        katana::chunk_size<StronglyConnectedComponentsPlan::kChunkSize>(),
+        katana::loopname("SCC Reach"));
+  }
+}
+
+/**
+ * Find the component of the active node with the most paths through it, as
+ * estimated by the product of its degrees: the nodes that are both reachable
+ * from it and can reach it.
+ */
+void
+ForwardBackward(SccState* state, const NodeVec& active) {
+  katana::GReduceMax<uint64_t> max_product;
+  katana::do_all(
+      katana::iterate(active),
+      [&](const GNode& n) {
+        state->color[n].store(0, std::memory_order_relaxed);
+        max_product.update(
+            uint64_t{state->in_degree[n].load(std::memory_order_relaxed)} *
+            state->out_degree[n].load(std::memory_order_relaxed));
+      },
+      katana::no_stats());
+  uint64_t product = max_product.reduce();
+
+  katana::GReduceMin<GNode> pivot_reduce;
+  katana::do_all(
+      katana::iterate(active),
+      [&](const GNode& n) {
+        if (uint64_t{state->in_degree[n].load(std::memory_order_relaxed)} *
+                state->out_degree[n].load(std::memory_order_relaxed) ==
+            product) {
+          pivot_reduce.update(n);
+        }
+      },
+      katana::no_stats());
+  GNode pivot = pivot_reduce.reduce();
+
+  constexpr uint32_t kForward = 1;
+  constexpr uint32_t kBackward = 2;
+  MarkReachable(state, pivot, kForward, state->out_indices, state->out_dests);
+  MarkReachable(state, pivot, kBackward, state->in_indices, state->in_sources);
+
+  katana::do_all(
+      katana::iterate(active),
+      [&](const GNode& n) {
+        if (state->color[n].load(std::memory_order_relaxed) ==
+            (kForward | kBackward)) {
+          state->Assign(n, pivot);
+        }
+      },
+      katana::no_stats());
+}
+
+/**
+ * Color every active node with the largest id of the active nodes that can
+ * reach it. A node whose color is its own id is the root of a component,
+ * namely of the nodes with its color that can reach it; all of them are
+ * assigned to the component. At least the largest active node is a root, so
+ * every call makes progress.
+ */
+void
+ColorAndClaim(SccState* state, const NodeVec& active) {
+  katana::do_all(
+      katana::iterate(active),
+      [&](const GNode& n) {
+        state->color[n].store(n, std::memory_order_relaxed);
+      },
+      katana::no_stats());
+
+  katana::for_each(
+      katana::iterate(active),
+      [&](const GNode& n, auto& ctx) {
+        uint32_t c = state->color[n].load(std::memory_order_relaxed);
+        for (uint64_t e = state->OutBegin(n); e < state->OutEnd(n); ++e) {
+          GNode dest = state->out_dests[e];
+          if (state->IsActive(dest) &&
+              katana::atomicMax(state->color[dest], c) < c) {
+            ctx.push(dest);
+          }
+        }
+      },
+      katana::disable_conflict_detection(),
+      katana::chunk_size<StronglyConnectedComponentsPlan::kChunkSize>(),
+      katana::loopname("SCC Color"));
+
+  NodeVec roots;
+  katana::do_all(
+      katana::iterate(active),
+      [&](const GNode& n) {
+        if (state->color[n].load(std::memory_order_relaxed) == n) {
+          state->Assign(n, n);
+          roots.push(n);
+        }
+      },
+      katana::no_stats());
+
+  katana::for_each(
+      katana::iterate(roots),
+      [&](const GNode& n, auto& ctx) {
+        uint32_t c = state->color[n].load(std::memory_order_relaxed);
+        for (uint64_t e = state->InBegin(n); e < state->InEnd(n); ++e) {
+          GNode src = state->in_sources[e];
+          if (state->color[src].load(std::memory_order_relaxed) == c &&
+              state->Assign(src, c)) {
+            ctx.push(src);
+          }
+        }
+      },
+      katana::disable_conflict_detection(),
+      katana::chunk_size<StronglyConnectedComponentsPlan::kChunkSize>(),
+      katana::loopname("SCC Claim"));
+}
+
+/// Label each node of graph with the smallest node id in its component.
+void
+WriteSmallestIds(SccState* state, Graph* graph) {
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](const GNode& n) {
+        state->color[n].store(kUnassigned, std::memory_order_relaxed);
+      },
+      katana::no_stats());
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](const GNode& n) {
+        uint32_t c = state->component[n].load(std::memory_order_relaxed);
+        katana::atomicMin(state->color[c], n);
+      },
+      katana::no_stats());
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](const GNode& n) {
+        uint32_t c = state->component[n].load(std::memory_order_relaxed);
+        graph->GetData<NodeComponent>(n) =
+            state->color[c].load(std::memory_order_relaxed);
+      },
+      katana::no_stats());
+}
+
+void
+ParallelStronglyConnectedComponents(
+    const katana::PropertyGraph& pg, Graph* graph, bool forward_backward) {
+  SccState state(pg);
+
+  auto active = std::make_unique<NodeVec>();
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](const GNode& n) {
+        state.component[n].store(kUnassigned, std::memory_order_relaxed);
+        active->push(n);
+      },
+      katana::no_stats());
+
+  uint64_t rounds = 0;
+  if (forward_backward) {
+    TrimSingletons(&state, *active);
+    Compact(&state, &active);
+    if (!active->empty()) {
+      ForwardBackward(&state, *active);
+      Compact(&state, &active);
+      TrimSingletons(&state, *active);
+      TrimPairs(&state, *active);
+      Compact(&state, &active);
+    }
+  }
+
+  while (!active->empty()) {
+    TrimSingletons(&state, *active);
+    Compact(&state, &active);
+    if (active->empty()) {
+      break;
+    }
+    ColorAndClaim(&state, *active);
+    Compact(&state, &active);
+    ++rounds;
+  }
+  katana::ReportStatSingle("SCC", "ColoringRounds", rounds);
+
+  WriteSmallestIds(&state, graph);
+}
+
+/**
+ * Find the components of the graph with Tarjan's algorithm, labeling each
+ * node with the smallest node id in its component.
+ */
+std::vector<uint32_t>
+SerialStronglyConnectedComponents(const katana::GraphTopology& topology) {
+  constexpr uint32_t kUnvisited = std::numeric_limits<uint32_t>::max();
+  uint64_t num_nodes = topology.num_nodes();
+  const uint32_t* dests = topology.out_dests->raw_values();
+
+  std::vector<uint32_t> component(num_nodes, kUnassigned);
+  std::vector<uint32_t> index(num_nodes, kUnvisited);
+  std::vector<uint32_t> low_link(num_nodes);
+  std::vector<GNode> stack;
+  //! The node and next out-edge of each active call of the recursive
+  //! formulation
+  std::vector<std::pair<GNode, uint64_t>> calls;
+  uint32_t next_index = 0;
+
+  for (GNode root = 0; root < num_nodes; ++root) {
+    if (index[root] != kUnvisited) {
+      continue;
+    }
+    auto visit = [&](GNode n) {
+      index[n] = low_link[n] = next_index++;
+      stack.emplace_back(n);
+      calls.emplace_back(n, topology.edge_range(n).first);
+    };
+    visit(root);
+
+    while (!calls.empty()) {
+      GNode n = calls.back().first;
+      uint64_t e = calls.back().second;
+      if (e < topology.edge_range(n).second) {
+        calls.back().second += 1;
+        GNode dest = dests[e];
+        if (index[dest] == kUnvisited) {
+          visit(dest);
+        } else if (component[dest] == kUnassigned) {
+          //! dest is on the stack
+          low_link[n] = std::min(low_link[n], index[dest]);
+        }
+        continue;
+      }
+
+      calls.pop_back();
+      if (!calls.empty()) {
+        GNode parent = calls.back().first;
+        low_link[parent] = std::min(low_link[parent], low_link[n]);
+      }
+      if (low_link[n] != index[n]) {
+        continue;
+      }
+      auto first = std::find(stack.rbegin(), stack.rend(), n).base() - 1;
+      uint32_t smallest = *std::min_element(first, stack.end());
+      for (auto it = first; it != stack.end(); ++it) {
+        component[*it] = smallest;
+      }
+      stack.erase(first, stack.end());
+    }
+  }
+
+  return component;
+}
+
+}  //namespace
+
+katana::Result<void>
+katana::analytics::StronglyConnectedComponents(
+    PropertyGraph* pg, const std::string& output_property_name,
+    StronglyConnectedComponentsPlan plan) {
+  if (plan.algorithm() != StronglyConnectedComponentsPlan::kSerial &&
+      plan.algorithm() != StronglyConnectedComponentsPlan::kColoring &&
+      plan.algorithm() != StronglyConnectedComponentsPlan::kForwardBackward) {
+    return ErrorCode::InvalidArgument;
+  }
+
+  if (plan.algorithm() != StronglyConnectedComponentsPlan::kSerial) {
+    if (auto result = pg->BuildInEdges(); !result) {
+      return result.error();
+    }
+  }
+
+  if (auto result =
+          ConstructNodeProperties<NodeData>(pg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = Graph::Make(pg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::StatTimer exec_time("StronglyConnectedComponents");
+  exec_time.start();
+
+  switch (plan.algorithm()) {
+  case StronglyConnectedComponentsPlan::kSerial: {
+    std::vector<uint32_t> component =
+        SerialStronglyConnectedComponents(pg->topology());
+    for (GNode n = 0; n < component.size(); ++n) {
+      graph.GetData<NodeComponent>(n) = component[n];
+    }
+    break;
+  }
+  case StronglyConnectedComponentsPlan::kColoring:
+    ParallelStronglyConnectedComponents(*pg, &graph, false);
+    break;
+  case StronglyConnectedComponentsPlan::kForwardBackward:
+    ParallelStronglyConnectedComponents(*pg, &graph, true);
+    break;
+  default:
+    return ErrorCode::InvalidArgument;
+  }
+
+  exec_time.stop();
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::StronglyConnectedComponentsAssertValid(
+    PropertyGraph* pg, const std::string& property_name) {
+  auto pg_result = Graph::Make(pg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  std::vector<uint32_t> expected =
+      SerialStronglyConnectedComponents(pg->topology());
+
+  //! The labels partition the nodes like the expected components if the
+  //! nodes with the same label have the same expected component and there
+  //! are as many labels as expected components.
+  std::unordered_map<ComponentType, uint32_t> expected_of_label;
+  uint64_t num_expected = 0;
+  for (GNode n = 0; n < expected.size(); ++n) {
+    num_expected += expected[n] == n;
+    ComponentType label = graph.GetData<NodeComponent>(n);
+    auto [it, inserted] = expected_of_label.emplace(label, expected[n]);
+    if (!inserted && it->second != expected[n]) {
+      KATANA_LOG_DEBUG(
+          "{} (component: {}) must not be in the same component as {}", n,
+          label, it->second);
+      return katana::ErrorCode::AssertionFailed;
+    }
+  }
+
+  if (expected_of_label.size() != num_expected) {
+    KATANA_LOG_DEBUG(
+        "found {} components but expected {}", expected_of_label.size(),
+        num_expected);
+    return katana::ErrorCode::AssertionFailed;
+  }
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<StronglyConnectedComponentsStatistics>
+katana::analytics::StronglyConnectedComponentsStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto pg_result = Graph::Make(pg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::LargeArray<std::atomic<uint64_t>> sizes;
+  sizes.allocateInterleaved(graph.size());
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) { sizes[n].store(0, std::memory_order_relaxed); },
+      katana::no_stats());
+
+  katana::GReduceLogicalOr out_of_range;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        ComponentType c = graph.GetData<NodeComponent>(n);
+        if (c >= graph.size()) {
+          out_of_range.update(true);
+          return;
+        }
+        sizes[c].fetch_add(1, std::memory_order_relaxed);
+      },
+      katana::no_stats());
+  if (out_of_range.reduce()) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  katana::GAccumulator<uint64_t> total_components;
+  katana::GAccumulator<uint64_t> non_trivial_components;
+  katana::GReduceMax<uint64_t> largest_component;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        uint64_t size = sizes[n].load(std::memory_order_relaxed);
+        if (size > 0) {
+          total_components += 1;
+        }
+        if (size > 1) {
+          non_trivial_components += 1;
+        }
+        largest_component.update(size);
+      },
+      katana::loopname("CountLargest"));
+
+  uint64_t largest_component_size = largest_component.reduce();
+  double largest_component_ratio = 0;
+  if (!graph.empty()) {
+    largest_component_ratio = double(largest_component_size) / graph.size();
+  }
+
+  return StronglyConnectedComponentsStatistics{
+      total_components.reduce(), non_trivial_components.reduce(),
+      largest_component_size, largest_component_ratio};
+}
+
+void
+katana::analytics::StronglyConnectedComponentsStatistics::Print(
+    std::ostream& os) const {
+  os << "Total number of components = " << total_components << std::endl;
+  os << "Total number of non trivial components = "
+     << total_non_trivial_components << std::endl;
+  os << "Number of nodes in the largest component = " << largest_component_size
+     << std::endl;
+  os << "Ratio of nodes in the largest component = " << largest_component_ratio
+     << std::endl;
+}
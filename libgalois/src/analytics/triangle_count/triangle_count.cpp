@@ -19,6 +19,10 @@
 
 #include "katana/analytics/triangle_count/triangle_count.h"
 
+#include <algorithm>
+
+#include "katana/EdgeBalancedRange.h"
+#include "katana/SetIntersection.h"
 #include "katana/analytics/Utils.h"
 
 using namespace katana::analytics;
@@ -28,80 +32,14 @@ using Node = katana::PropertyGraph::Node;
 
 constexpr static const unsigned kChunkSize = 64U;
 
-/**
- * Like std::lower_bound but doesn't dereference iterators. Returns the first
- * element for which comp is not true.
- */
-template <typename Iterator, typename Compare>
-Iterator
-LowerBound(Iterator first, Iterator last, Compare comp) {
-  using difference_type =
-      typename std::iterator_traits<Iterator>::difference_type;
-
-  Iterator it;
-  difference_type count;
-  difference_type half;
-
-  count = std::distance(first, last);
-  while (count > 0) {
-    it = first;
-    half = count / 2;
-    std::advance(it, half);
-    if (comp(it)) {
-      first = ++it;
-      count -= half + 1;
-    } else {
-      count = half;
-    }
-  }
-  return first;
-}
+using Span = std::pair<const uint32_t*, const uint32_t*>;
 
-/**
- * std::set_intersection over edge_iterators.
- */
-template <typename G>
-size_t
-CountEqual(
-    const G& g, typename G::edge_iterator aa, typename G::edge_iterator ea,
-    typename G::edge_iterator bb, typename G::edge_iterator eb) {
-  size_t retval = 0;
-  while (aa != ea && bb != eb) {
-    typename G::Node a = *g.GetEdgeDest(aa);
-    typename G::Node b = *g.GetEdgeDest(bb);
-    if (a < b) {
-      ++aa;
-    } else if (b < a) {
-      ++bb;
-    } else {
-      retval += 1;
-      ++aa;
-      ++bb;
-    }
-  }
-  return retval;
+uint64_t
+CountIntersection(Span a, Span b) {
+  return katana::CountIntersection(
+      a.first, a.second - a.first, b.first, b.second - b.first);
 }
 
-template <typename G>
-struct LessThan {
-  const G& g;
-  typename G::Node n;
-  LessThan(const G& g, typename G::Node n) : g(g), n(n) {}
-  bool operator()(typename G::edge_iterator it) {
-    return *g.GetEdgeDest(it) < n;
-  }
-};
-
-template <typename G>
-struct GreaterThanOrEqual {
-  const G& g;
-  typename G::Node n;
-  GreaterThanOrEqual(const G& g, typename G::Node n) : g(g), n(n) {}
-  bool operator()(typename G::edge_iterator it) {
-    return n >= *g.GetEdgeDest(it);
-  }
-};
-
 template <typename G>
 struct GetDegree {
   typedef typename G::Node N;
@@ -134,33 +72,35 @@ struct IdLess {
  */
 size_t
 NodeIteratingAlgo(katana::PropertyGraph* graph) {
+  const katana::GraphTopology& topology = graph->topology();
   katana::GAccumulator<size_t> numTriangles;
+  katana::PerThreadStorage<katana::IntersectionBitmap> bitmaps;
 
   katana::do_all(
-      katana::iterate(*graph),
+      katana::iterate_edge_balanced(topology),
       [&](const PropertyGraph::Node& n) {
         // Partition neighbors
         // [first, ea) [n] [bb, last)
-        PropertyGraph::edge_iterator first = graph->edges(n).begin();
-        PropertyGraph::edge_iterator last = graph->edges(n).end();
-        PropertyGraph::edge_iterator ea =
-            LowerBound(first, last, LessThan<PropertyGraph>(*graph, n));
-        PropertyGraph::edge_iterator bb = LowerBound(
-            first, last, GreaterThanOrEqual<PropertyGraph>(*graph, n));
-
-        for (; bb != last; ++bb) {
-          Node B = *graph->GetEdgeDest(bb);
-          for (auto aa = first; aa != ea; ++aa) {
-            Node A = *graph->GetEdgeDest(aa);
-            PropertyGraph::edge_iterator vv = graph->edges(A).begin();
-            PropertyGraph::edge_iterator ev = graph->edges(A).end();
-            PropertyGraph::edge_iterator it =
-                LowerBound(vv, ev, LessThan<PropertyGraph>(*graph, B));
-            if (it != ev && *graph->GetEdgeDest(it) == B) {
-              numTriangles += 1;
-            }
-          }
+        auto [first, last] = katana::OutDestinations(topology, n);
+        const uint32_t* ea = std::lower_bound(first, last, n);
+        const uint32_t* bb = std::upper_bound(ea, last, n);
+
+        // Every pair (a, b) is a triangle if b is a neighbor of a, so count
+        // the neighbors of each a that are in [bb, last)
+        katana::IntersectionBitmap* upper = nullptr;
+        if (ea != first &&
+            katana::IntersectionBitmap::IsWorthwhile(bb, last - bb)) {
+          upper = bitmaps.getLocal();
+          upper->Assign(bb, last - bb);
+        }
+
+        size_t local = 0;
+        for (const uint32_t* aa = first; aa != ea; ++aa) {
+          auto [va, ev] = katana::OutDestinations(topology, *aa);
+          local += upper ? upper->CountIntersection(va, ev - va)
+                         : CountIntersection({va, ev}, {bb, last});
         }
+        numTriangles += local;
       },
       katana::chunk_size<kChunkSize>(), katana::steal(),
       katana::loopname("TriangleCount_NodeIteratingAlgo"));
@@ -173,27 +113,31 @@ NodeIteratingAlgo(katana::PropertyGraph* graph) {
  */
 void
 OrderedCountFunc(
-    PropertyGraph* graph, Node n, katana::GAccumulator<size_t>& numTriangles) {
+    const katana::GraphTopology& topology, Node n,
+    katana::IntersectionBitmap* bitmap,
+    katana::GAccumulator<size_t>& numTriangles) {
+  // The neighbors of n that are not greater than n
+  auto [first, last] = katana::OutDestinations(topology, n);
+  last = std::upper_bound(first, last, n);
+
+  // For a hub, intersect with a bitmap of its neighbors rather than merging
+  // its neighbor list once per neighbor
+  bool use_bitmap =
+      katana::IntersectionBitmap::IsWorthwhile(first, last - first);
+  if (use_bitmap) {
+    bitmap->Assign(first, last - first);
+  }
+
   size_t numTriangles_local = 0;
-  for (auto it_v : graph->edges(n)) {
-    auto v = *graph->GetEdgeDest(it_v);
-    if (v > n) {
-      break;
-    }
-    PropertyGraph::edge_iterator it_n = graph->edges(n).begin();
-
-    for (auto it_vv : graph->edges(v)) {
-      auto vv = *graph->GetEdgeDest(it_vv);
-      if (vv > v) {
-        break;
-      }
-      while (*graph->GetEdgeDest(it_n) < vv) {
-        it_n++;
-      }
-      if (vv == *graph->GetEdgeDest(it_n)) {
-        numTriangles_local += 1;
-      }
-    }
+  for (const uint32_t* it_v = first; it_v != last; ++it_v) {
+    Node v = *it_v;
+    auto [vv_first, vv_last] = katana::OutDestinations(topology, v);
+    vv_last = std::upper_bound(vv_first, vv_last, v);
+    // Neighbors of v not greater than v are also not greater than n, so
+    // they are common neighbors exactly when they are in [first, it_v]
+    numTriangles_local +=
+        use_bitmap ? bitmap->CountIntersection(vv_first, vv_last - vv_first)
+                   : CountIntersection({first, it_v + 1}, {vv_first, vv_last});
   }
   numTriangles += numTriangles_local;
 }
@@ -203,10 +147,14 @@ OrderedCountFunc(
  */
 size_t
 OrderedCountAlgo(PropertyGraph* graph) {
+  const katana::GraphTopology& topology = graph->topology();
   katana::GAccumulator<size_t> numTriangles;
+  katana::PerThreadStorage<katana::IntersectionBitmap> bitmaps;
   katana::do_all(
-      katana::iterate(*graph),
-      [&](const Node& n) { OrderedCountFunc(graph, n, numTriangles); },
+      katana::iterate_edge_balanced(topology),
+      [&](const Node& n) {
+        OrderedCountFunc(topology, n, bitmaps.getLocal(), numTriangles);
+      },
       katana::chunk_size<kChunkSize>(), katana::steal(),
       katana::loopname("TriangleCount_OrderedCountAlgo"));
 
@@ -234,41 +182,37 @@ EdgeIteratingAlgo(PropertyGraph* graph) {
     WorkItem(const Node& a1, const Node& a2) : src(a1), dst(a2) {}
   };
 
+  const katana::GraphTopology& topology = graph->topology();
   katana::InsertBag<WorkItem> items;
   katana::GAccumulator<size_t> numTriangles;
 
+  // Split hubs so that no thread pushes all the edges of a hub by itself
   katana::do_all(
-      katana::iterate(*graph),
-      [&](Node n) {
-        for (auto edge : graph->edges(n)) {
+      katana::iterate_edge_balanced_split_hubs(topology),
+      [&](const katana::NodeEdgeRange& r) {
+        for (auto edge = r.begin; edge != r.end; ++edge) {
           auto dest = graph->GetEdgeDest(edge);
-          if (n < *dest) {
-            items.push(WorkItem(n, *dest));
+          if (r.node < *dest) {
+            items.push(WorkItem(r.node, *dest));
           }
         }
       },
-      katana::loopname("TriangleCount_Initialize"));
+      katana::steal(), katana::loopname("TriangleCount_Initialize"));
 
   katana::do_all(
       katana::iterate(items),
       [&](const WorkItem& w) {
         // Compute intersection of range (w.src, w.dst) in neighbors of
         // w.src and w.dst
-        PropertyGraph::edge_iterator abegin = graph->edges(w.src).begin();
-        PropertyGraph::edge_iterator aend = graph->edges(w.src).end();
-        PropertyGraph::edge_iterator bbegin = graph->edges(w.dst).begin();
-        PropertyGraph::edge_iterator bend = graph->edges(w.dst).end();
-
-        PropertyGraph::edge_iterator aa = LowerBound(
-            abegin, aend, GreaterThanOrEqual<PropertyGraph>(*graph, w.src));
-        PropertyGraph::edge_iterator ea =
-            LowerBound(abegin, aend, LessThan<PropertyGraph>(*graph, w.dst));
-        PropertyGraph::edge_iterator bb = LowerBound(
-            bbegin, bend, GreaterThanOrEqual<PropertyGraph>(*graph, w.src));
-        PropertyGraph::edge_iterator eb =
-            LowerBound(bbegin, bend, LessThan<PropertyGraph>(*graph, w.dst));
-
-        numTriangles += CountEqual(*graph, aa, ea, bb, eb);
+        auto [abegin, aend] = katana::OutDestinations(topology, w.src);
+        auto [bbegin, bend] = katana::OutDestinations(topology, w.dst);
+
+        const uint32_t* aa = std::upper_bound(abegin, aend, w.src);
+        const uint32_t* ea = std::lower_bound(aa, aend, w.dst);
+        const uint32_t* bb = std::upper_bound(bbegin, bend, w.src);
+        const uint32_t* eb = std::lower_bound(bb, bend, w.dst);
+
+        numTriangles += CountIntersection({aa, ea}, {bb, eb});
       },
       katana::loopname("TriangleCount_EdgeIteratingAlgo"),
       katana::chunk_size<kChunkSize>(), katana::steal());
@@ -279,6 +223,10 @@ EdgeIteratingAlgo(PropertyGraph* graph) {
 katana::Result<uint64_t>
 katana::analytics::TriangleCount(
     katana::PropertyGraph* pg, TriangleCountPlan plan) {
+  if (pg->has_wide_node_ids()) {
+    return katana::ErrorCode::NotImplemented;
+  }
+
   katana::StatTimer timer_graph_read("GraphReadingTime", "TriangleCount");
   katana::StatTimer timer_auto_algo("AutoRelabel", "TriangleCount");
 
@@ -333,6 +281,9 @@ katana::analytics::TriangleCount(
   katana::reportPageAlloc("TriangleCount_MeminfoPre");
 
   size_t total_count;
+  katana::ReportParam(
+      "TriangleCount", "IntersectionKernel",
+      katana::SimdLevelName(katana::GetSimdLevel()));
   katana::StatTimer execTime("TriangleCount", "TriangleCount");
   execTime.start();
   switch (plan.algorithm()) {
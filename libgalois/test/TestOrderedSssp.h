@@ -0,0 +1,157 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef KATANA_LIBGALOIS_TESTORDEREDSSSP_H_
+#define KATANA_LIBGALOIS_TESTORDEREDSSSP_H_
+
+#include <atomic>
+#include <limits>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "katana/Galois.h"
+
+/// Single-source shortest paths written as an ordered algorithm, used to test
+/// and benchmark katana::for_each_ordered against a serial priority queue.
+///
+/// \file TestOrderedSssp.h
+
+struct SsspNode : public katana::Lockable {
+  std::atomic<uint64_t> dist{std::numeric_limits<uint64_t>::max()};
+};
+
+struct SsspEdge {
+  uint32_t dest;
+  uint32_t weight;
+};
+
+struct SsspGraph {
+  std::vector<uint64_t> indices;
+  std::vector<SsspEdge> edges;
+  std::vector<SsspNode> nodes;
+
+  explicit SsspGraph(size_t num_nodes) : nodes(num_nodes) {}
+
+  size_t num_nodes() const { return nodes.size(); }
+
+  void Reset() {
+    for (auto& n : nodes) {
+      n.dist = std::numeric_limits<uint64_t>::max();
+    }
+  }
+};
+
+struct SsspTask {
+  uint64_t dist;
+  uint32_t node;
+};
+
+struct SsspTaskLess {
+  bool operator()(const SsspTask& a, const SsspTask& b) const {
+    return a.dist < b.dist;
+  }
+};
+
+/// Generate a random graph where each node has degree edges to random nodes
+/// with weights in [1, max_weight].
+inline SsspGraph
+MakeRandomSsspGraph(
+    size_t num_nodes, size_t degree, uint32_t max_weight, unsigned seed = 0) {
+  SsspGraph g(num_nodes);
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<uint32_t> node_dist(0, num_nodes - 1);
+  std::uniform_int_distribution<uint32_t> weight_dist(1, max_weight);
+
+  g.indices.reserve(num_nodes + 1);
+  g.indices.push_back(0);
+  for (size_t n = 0; n < num_nodes; ++n) {
+    for (size_t i = 0; i < degree; ++i) {
+      g.edges.emplace_back(SsspEdge{node_dist(gen), weight_dist(gen)});
+    }
+    g.indices.push_back(g.edges.size());
+  }
+  return g;
+}
+
+/// Dijkstra's algorithm with a std::priority_queue. Returns the distances.
+inline std::vector<uint64_t>
+SerialSssp(const SsspGraph& g, uint32_t source) {
+  std::vector<uint64_t> dist(
+      g.num_nodes(), std::numeric_limits<uint64_t>::max());
+  auto greater = [](const SsspTask& a, const SsspTask& b) {
+    return a.dist > b.dist;
+  };
+  std::priority_queue<SsspTask, std::vector<SsspTask>, decltype(greater)> pq(
+      greater);
+
+  pq.push(SsspTask{0, source});
+  while (!pq.empty()) {
+    SsspTask t = pq.top();
+    pq.pop();
+    if (dist[t.node] != std::numeric_limits<uint64_t>::max()) {
+      continue;
+    }
+    dist[t.node] = t.dist;
+    for (uint64_t e = g.indices[t.node]; e < g.indices[t.node + 1]; ++e) {
+      const SsspEdge& edge = g.edges[e];
+      if (dist[edge.dest] == std::numeric_limits<uint64_t>::max()) {
+        pq.push(SsspTask{t.dist + edge.weight, edge.dest});
+      }
+    }
+  }
+  return dist;
+}
+
+/// Dijkstra's algorithm with katana::for_each_ordered. A task settles its
+/// node, so its neighborhood is the node and its neighbors, which it may
+/// push new tasks for.
+inline void
+OrderedSssp(SsspGraph* g, uint32_t source) {
+  std::vector<SsspTask> initial{SsspTask{0, source}};
+
+  katana::for_each_ordered(
+      initial.begin(), initial.end(), SsspTaskLess(),
+      [&](const SsspTask& t) {
+        katana::acquire(&g->nodes[t.node], katana::MethodFlag::WRITE);
+        for (uint64_t e = g->indices[t.node]; e < g->indices[t.node + 1];
+             ++e) {
+          katana::acquire(
+              &g->nodes[g->edges[e].dest], katana::MethodFlag::WRITE);
+        }
+      },
+      [&](const SsspTask& t, katana::UserContext<SsspTask>& ctx) {
+        SsspNode& node = g->nodes[t.node];
+        if (node.dist != std::numeric_limits<uint64_t>::max()) {
+          return;
+        }
+        node.dist = t.dist;
+        for (uint64_t e = g->indices[t.node]; e < g->indices[t.node + 1];
+             ++e) {
+          const SsspEdge& edge = g->edges[e];
+          if (g->nodes[edge.dest].dist ==
+              std::numeric_limits<uint64_t>::max()) {
+            ctx.push(SsspTask{t.dist + edge.weight, edge.dest});
+          }
+        }
+      },
+      "OrderedSssp");
+}
+
+#endif
@@ -0,0 +1,268 @@
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <arrow/api.h>
+#include <benchmark/benchmark.h>
+
+#include "katana/ArrowInterchange.h"
+#include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/CompressedTopology.h"
+#include "katana/Galois.h"
+#include "katana/HWTopo.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Reduction.h"
+#include "katana/SharedMemSys.h"
+
+// Traversal-only kernels on a raw GraphTopology and on a
+// CompressedGraphTopology of the same graph. Each benchmark reports the bytes
+// of topology read per second (bytes_per_second) and the edges traversed per
+// second (edges). The compressed topology reads fewer bytes per edge at the
+// cost of decoding them, so it wins when the raw kernel is bound by memory
+// bandwidth.
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+constexpr uint64_t kAverageDegree = 16;
+constexpr uint32_t kLocalWindow = 256;
+constexpr unsigned kPageRankRounds = 10;
+constexpr double kAlpha = 0.85;
+
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  for (long num_nodes : {1L << 16, 1L << 20}) {
+    b->Arg(num_nodes);
+  }
+}
+
+/// A symmetric graph where most edges connect nodes with nearby ids, like a
+/// graph after locality-improving reordering, and the rest are uniform
+katana::GraphTopology
+MakeTopology(uint64_t num_nodes) {
+  std::mt19937 gen(num_nodes);
+  std::uniform_int_distribution<uint32_t> near(1, kLocalWindow);
+  std::uniform_int_distribution<uint32_t> far(0, num_nodes - 1);
+
+  std::vector<std::vector<uint32_t>> adj(num_nodes);
+  for (uint64_t i = 0; i < num_nodes * kAverageDegree / 2; ++i) {
+    auto src = static_cast<Node>(i % num_nodes);
+    Node dst = i % 4 == 3 ? far(gen) : (src + near(gen)) % num_nodes;
+    adj[src].emplace_back(dst);
+    adj[dst].emplace_back(src);
+  }
+
+  std::vector<uint64_t> indices;
+  std::vector<uint32_t> dests;
+  for (auto& node_dests : adj) {
+    std::sort(node_dests.begin(), node_dests.end());
+    dests.insert(dests.end(), node_dests.begin(), node_dests.end());
+    indices.emplace_back(dests.size());
+  }
+  return katana::GraphTopology{
+      .out_indices = std::static_pointer_cast<arrow::UInt64Array>(
+          katana::BuildArray(indices)),
+      .out_dests = std::static_pointer_cast<arrow::UInt32Array>(
+          katana::BuildArray(dests)),
+  };
+}
+
+uint64_t
+SizeInBytes(const katana::GraphTopology& topology) {
+  return topology.num_nodes() * sizeof(uint64_t) +
+         topology.num_edges() * sizeof(uint32_t);
+}
+
+uint64_t
+SizeInBytes(const katana::CompressedGraphTopology& topology) {
+  return topology.size_in_bytes();
+}
+
+template <typename F>
+void
+ForEachDest(const katana::GraphTopology& topology, Node n, const F& fn) {
+  const uint32_t* dests = topology.out_dests->raw_values();
+  auto [begin, end] = topology.edge_range(n);
+  for (uint64_t e = begin; e < end; ++e) {
+    fn(dests[e]);
+  }
+}
+
+template <typename F>
+void
+ForEachDest(
+    const katana::CompressedGraphTopology& topology, Node n, const F& fn) {
+  topology.ForEachEdge(n, [&](uint64_t, Node dest) { fn(dest); });
+}
+
+/// Sum every destination; returns the number of passes over the topology.
+template <typename Topology>
+uint64_t
+Scan(const Topology& topology) {
+  katana::GAccumulator<uint64_t> sum;
+  katana::do_all(
+      katana::iterate(topology),
+      [&](Node n) {
+        ForEachDest(topology, n, [&](Node dest) { sum += dest; });
+      },
+      katana::steal(), katana::no_stats());
+  benchmark::DoNotOptimize(sum.reduce());
+  return 1;
+}
+
+/// Level-synchronous top-down BFS from node 0
+template <typename Topology>
+uint64_t
+Bfs(const Topology& topology) {
+  std::vector<std::atomic<uint32_t>> level(topology.num_nodes());
+  katana::do_all(
+      katana::iterate(topology),
+      [&](Node n) { level[n].store(std::numeric_limits<uint32_t>::max()); },
+      katana::no_stats());
+  level[0] = 0;
+
+  katana::InsertBag<Node> frontier;
+  katana::InsertBag<Node> next;
+  frontier.push(0);
+  for (uint32_t depth = 1; !frontier.empty(); ++depth) {
+    katana::do_all(
+        katana::iterate(frontier),
+        [&](Node n) {
+          ForEachDest(topology, n, [&](Node dest) {
+            uint32_t old = katana::atomicMin(level[dest], depth);
+            if (old > depth) {
+              next.push(dest);
+            }
+          });
+        },
+        katana::steal(), katana::no_stats());
+    frontier.clear();
+    std::swap(frontier, next);
+  }
+  return 1;
+}
+
+/// Label propagation connected components; returns the number of rounds.
+template <typename Topology>
+uint64_t
+ConnectedComponents(const Topology& topology) {
+  std::vector<std::atomic<Node>> label(topology.num_nodes());
+  katana::do_all(
+      katana::iterate(topology), [&](Node n) { label[n].store(n); },
+      katana::no_stats());
+
+  uint64_t rounds = 0;
+  katana::GReduceLogicalOr changed;
+  do {
+    changed.reset();
+    katana::do_all(
+        katana::iterate(topology),
+        [&](Node n) {
+          Node min_label = label[n].load(std::memory_order_relaxed);
+          ForEachDest(topology, n, [&](Node dest) {
+            min_label = std::min(
+                min_label, label[dest].load(std::memory_order_relaxed));
+          });
+          if (katana::atomicMin(label[n], min_label) > min_label) {
+            changed.update(true);
+          }
+        },
+        katana::steal(), katana::no_stats());
+    ++rounds;
+  } while (changed.reduce());
+  return rounds;
+}
+
+/// Pull-style PageRank on the symmetric graph; returns the number of rounds.
+template <typename Topology>
+uint64_t
+PageRank(const Topology& topology) {
+  uint64_t num_nodes = topology.num_nodes();
+  std::vector<double> contrib(num_nodes, 1.0 / num_nodes);
+  std::vector<double> rank(num_nodes);
+  for (unsigned round = 0; round < kPageRankRounds; ++round) {
+    katana::do_all(
+        katana::iterate(topology),
+        [&](Node n) {
+          double sum = 0;
+          ForEachDest(topology, n, [&](Node dest) { sum += contrib[dest]; });
+          rank[n] = (1 - kAlpha) / num_nodes + kAlpha * sum;
+        },
+        katana::steal(), katana::no_stats());
+    katana::do_all(
+        katana::iterate(topology),
+        [&](Node n) {
+          auto [begin, end] = topology.edge_range(n);
+          contrib[n] = end > begin ? rank[n] / (end - begin) : 0;
+        },
+        katana::no_stats());
+  }
+  benchmark::DoNotOptimize(rank.data());
+  return kPageRankRounds;
+}
+
+template <typename Topology, uint64_t (*Kernel)(const Topology&)>
+void
+Run(benchmark::State& state, const Topology& topology) {
+  uint64_t passes = 0;
+  for (auto _ : state) {
+    passes += Kernel(topology);
+  }
+  state.SetBytesProcessed(passes * SizeInBytes(topology));
+  state.counters["edges"] = benchmark::Counter(
+      passes * topology.num_edges(), benchmark::Counter::kIsRate);
+  state.counters["bytes_per_edge"] =
+      static_cast<double>(SizeInBytes(topology)) / topology.num_edges();
+}
+
+template <uint64_t (*RawKernel)(const katana::GraphTopology&)>
+void
+Raw(benchmark::State& state) {
+  katana::GraphTopology topology = MakeTopology(state.range(0));
+  Run<katana::GraphTopology, RawKernel>(state, topology);
+}
+
+template <uint64_t (*CompressedKernel)(const katana::CompressedGraphTopology&)>
+void
+Compressed(benchmark::State& state) {
+  katana::GraphTopology raw = MakeTopology(state.range(0));
+  auto res = katana::CompressedGraphTopology::Make(raw);
+  if (!res) {
+    KATANA_LOG_FATAL("could not compress topology: {}", res.error());
+  }
+  Run<katana::CompressedGraphTopology, CompressedKernel>(state, res.value());
+}
+
+#define TOPOLOGY_BENCHMARK(Kernel)                                             \
+  BENCHMARK_TEMPLATE(Raw, Kernel<katana::GraphTopology>)                       \
+      ->Apply(MakeArguments)                                                   \
+      ->Unit(benchmark::kMillisecond)                                          \
+      ->UseRealTime();                                                         \
+  BENCHMARK_TEMPLATE(Compressed, Kernel<katana::CompressedGraphTopology>)      \
+      ->Apply(MakeArguments)                                                   \
+      ->Unit(benchmark::kMillisecond)                                          \
+      ->UseRealTime()
+
+TOPOLOGY_BENCHMARK(Scan);
+TOPOLOGY_BENCHMARK(Bfs);
+TOPOLOGY_BENCHMARK(ConnectedComponents);
+TOPOLOGY_BENCHMARK(PageRank);
+
+#undef TOPOLOGY_BENCHMARK
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(katana::getHWTopo().machineTopoInfo.maxThreads);
+
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+#include <boost/filesystem.hpp>
+
+#include "katana/ArrowInterchange.h"
+#include "katana/CompressedTopology.h"
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Uri.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+constexpr unsigned kNumThreads = 4;
+constexpr uint64_t kNumNodes = 5000;
+constexpr uint64_t kHubDegree = 20000;
+
+/// A graph whose edges are sorted by destination. Most nodes have a few edges
+/// to nearby nodes, node 0 is a hub and a few edges span the whole id range
+/// so that some codes take several bytes.
+katana::GraphTopology
+MakeSortedTopology() {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<uint32_t> near(0, 64);
+  std::uniform_int_distribution<uint32_t> far(0, kNumNodes - 1);
+
+  std::vector<uint64_t> indices;
+  std::vector<uint32_t> dests;
+  for (uint32_t n = 0; n < kNumNodes; ++n) {
+    std::vector<uint32_t> node_dests;
+    uint64_t degree = n == 0 ? kHubDegree : n % 7;
+    for (uint64_t i = 0; i < degree; ++i) {
+      if (i % 5 == 4) {
+        node_dests.emplace_back(far(gen));
+      } else {
+        node_dests.emplace_back(
+            std::min<uint64_t>(n + near(gen), kNumNodes - 1));
+      }
+    }
+    std::sort(node_dests.begin(), node_dests.end());
+    dests.insert(dests.end(), node_dests.begin(), node_dests.end());
+    indices.emplace_back(dests.size());
+  }
+
+  return katana::GraphTopology{
+      .out_indices = std::static_pointer_cast<arrow::UInt64Array>(
+          katana::BuildArray(indices)),
+      .out_dests = std::static_pointer_cast<arrow::UInt32Array>(
+          katana::BuildArray(dests)),
+  };
+}
+
+void
+CheckEqual(
+    const katana::GraphTopology& expected,
+    const katana::CompressedGraphTopology& compressed) {
+  KATANA_LOG_ASSERT(expected.num_nodes() == compressed.num_nodes());
+  KATANA_LOG_ASSERT(expected.num_edges() == compressed.num_edges());
+
+  std::vector<std::atomic<uint32_t>> visits(expected.num_edges());
+  katana::do_all(
+      katana::iterate(compressed),
+      [&](uint32_t n) {
+        KATANA_LOG_ASSERT(expected.edge_range(n) == compressed.edge_range(n));
+
+        auto [begin, end] = expected.edge_range(n);
+        uint64_t next = begin;
+        compressed.ForEachEdge(n, [&](uint64_t e, uint32_t dest) {
+          KATANA_LOG_ASSERT(e == next);
+          KATANA_LOG_ASSERT(dest == expected.out_dests->Value(e));
+          ++next;
+        });
+        KATANA_LOG_ASSERT(next == end);
+
+        next = begin;
+        for (const katana::CompressedEdge& edge : compressed.DecodedEdges(n)) {
+          KATANA_LOG_ASSERT(edge.id == next);
+          KATANA_LOG_ASSERT(edge.dest == expected.out_dests->Value(edge.id));
+          ++next;
+        }
+        KATANA_LOG_ASSERT(next == end);
+
+        for (uint64_t b = 0; b < compressed.num_blocks(n); ++b) {
+          compressed.ForEachEdgeInBlock(n, b, [&](uint64_t e, uint32_t dest) {
+            KATANA_LOG_ASSERT(dest == expected.out_dests->Value(e));
+            visits[e] += 1;
+          });
+        }
+      },
+      katana::steal());
+  for (const auto& v : visits) {
+    KATANA_LOG_ASSERT(v == 1);
+  }
+
+  auto decompressed = compressed.Decompress();
+  KATANA_LOG_ASSERT(decompressed);
+  KATANA_LOG_ASSERT(decompressed.value().Equals(expected));
+}
+
+void
+TestRoundTrip(const katana::GraphTopology& topology) {
+  for (uint32_t block_size : {1U, 3U, 64U, 1U << 20}) {
+    auto res = katana::CompressedGraphTopology::Make(topology, block_size);
+    KATANA_LOG_ASSERT(res);
+    KATANA_LOG_ASSERT(res.value().block_size() == block_size);
+    CheckEqual(topology, res.value());
+  }
+
+  // Most destinations are close to their source or the previous destination
+  auto res = katana::CompressedGraphTopology::Make(topology);
+  KATANA_LOG_ASSERT(res);
+  uint64_t raw_size = topology.num_nodes() * sizeof(uint64_t) +
+                      topology.num_edges() * sizeof(uint32_t);
+  KATANA_LOG_VASSERT(
+      res.value().size_in_bytes() < raw_size, "compressed {} raw {}",
+      res.value().size_in_bytes(), raw_size);
+}
+
+void
+TestExtremes() {
+  // Deltas that need the most bytes, in both directions from the source
+  constexpr uint32_t kMax = std::numeric_limits<uint32_t>::max();
+  std::vector<uint64_t> indices{3, 3, 5};
+  std::vector<uint32_t> dests{0, 1, kMax, 0, kMax};
+  katana::GraphTopology topology{
+      .out_indices = std::static_pointer_cast<arrow::UInt64Array>(
+          katana::BuildArray(indices)),
+      .out_dests = std::static_pointer_cast<arrow::UInt32Array>(
+          katana::BuildArray(dests)),
+  };
+  for (uint32_t block_size : {1U, 2U, 64U}) {
+    auto res = katana::CompressedGraphTopology::Make(topology, block_size);
+    KATANA_LOG_ASSERT(res);
+    CheckEqual(topology, res.value());
+  }
+
+  auto empty = katana::CompressedGraphTopology::Make(katana::GraphTopology{});
+  KATANA_LOG_ASSERT(empty);
+  KATANA_LOG_ASSERT(empty.value().num_nodes() == 0);
+  KATANA_LOG_ASSERT(empty.value().num_edges() == 0);
+}
+
+void
+TestInvalid(const katana::GraphTopology& topology) {
+  auto res = katana::CompressedGraphTopology::Make(topology, 0);
+  KATANA_LOG_ASSERT(!res);
+  KATANA_LOG_ASSERT(res.error() == katana::ErrorCode::InvalidArgument);
+
+  std::vector<uint64_t> indices{2};
+  std::vector<uint32_t> dests{1, 0};
+  katana::GraphTopology unsorted{
+      .out_indices = std::static_pointer_cast<arrow::UInt64Array>(
+          katana::BuildArray(indices)),
+      .out_dests = std::static_pointer_cast<arrow::UInt32Array>(
+          katana::BuildArray(dests)),
+  };
+  res = katana::CompressedGraphTopology::Make(unsorted);
+  KATANA_LOG_ASSERT(!res);
+  KATANA_LOG_ASSERT(res.error() == katana::ErrorCode::InvalidArgument);
+}
+
+void
+TestWriteLoad(const katana::GraphTopology& topology, const std::string& dir) {
+  auto res = katana::CompressedGraphTopology::Make(topology, 16);
+  KATANA_LOG_ASSERT(res);
+
+  std::string path = dir + "/topology";
+  auto write_res = res.value().Write(path);
+  KATANA_LOG_VASSERT(write_res, "{}", write_res.error());
+
+  auto load_res = katana::CompressedGraphTopology::Load(path);
+  KATANA_LOG_VASSERT(load_res, "{}", load_res.error());
+  KATANA_LOG_ASSERT(load_res.value().block_size() == 16);
+  KATANA_LOG_ASSERT(
+      load_res.value().num_code_bytes() == res.value().num_code_bytes());
+  CheckEqual(topology, load_res.value());
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(kNumThreads);
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/compressedtopology");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string temp_dir(uri_res.value().path());  // path because local
+  fs::create_directories(temp_dir);
+
+  katana::GraphTopology topology = MakeSortedTopology();
+  TestRoundTrip(topology);
+  TestExtremes();
+  TestInvalid(topology);
+  TestWriteLoad(topology, temp_dir);
+
+  fs::remove_all(temp_dir);
+  return 0;
+}
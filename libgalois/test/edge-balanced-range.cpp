@@ -0,0 +1,136 @@
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/ArrowInterchange.h"
+#include "katana/EdgeBalancedRange.h"
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+constexpr unsigned kNumThreads = 4;
+constexpr uint64_t kNumNodes = 10000;
+constexpr uint64_t kHubDegree = 50000;
+
+/// A graph where node 1 and the last node are hubs and every other node has
+/// a few edges
+std::unique_ptr<katana::PropertyGraph>
+MakeSkewedGraph() {
+  std::vector<uint64_t> indices;
+  std::vector<uint32_t> dests;
+  for (uint64_t n = 0; n < kNumNodes; ++n) {
+    uint64_t degree = n % 4;
+    if (n == 1 || n == kNumNodes - 1) {
+      degree = kHubDegree;
+    }
+    for (uint64_t i = 0; i < degree; ++i) {
+      dests.emplace_back((n + i + 1) % kNumNodes);
+    }
+    indices.emplace_back(dests.size());
+  }
+
+  auto pg = std::make_unique<katana::PropertyGraph>();
+  auto res = pg->SetTopology(katana::GraphTopology{
+      .out_indices = std::static_pointer_cast<arrow::UInt64Array>(
+          katana::BuildArray(indices)),
+      .out_dests = std::static_pointer_cast<arrow::UInt32Array>(
+          katana::BuildArray(dests)),
+  });
+  KATANA_LOG_ASSERT(res);
+  return pg;
+}
+
+void
+TestNodes(const katana::PropertyGraph& pg) {
+  const katana::GraphTopology& topology = pg.topology();
+  auto range = katana::iterate_edge_balanced(pg);
+
+  std::vector<std::atomic<uint32_t>> visits(pg.num_nodes());
+  katana::do_all(range, [&](uint32_t n) { visits[n] += 1; });
+  for (const auto& v : visits) {
+    KATANA_LOG_ASSERT(v == 1);
+  }
+
+  // No block is heavier than an even share plus its heaviest node
+  auto partition = katana::EdgeBalancedPartition::Get(topology);
+  KATANA_LOG_ASSERT(partition->num_items() == pg.num_nodes());
+  unsigned num_threads = katana::getActiveThreads();
+  uint64_t total = pg.num_nodes() + pg.num_edges();
+  for (unsigned t = 0; t < num_threads; ++t) {
+    uint64_t begin = partition->thread_begin(t);
+    uint64_t end = partition->thread_begin(t + 1);
+    KATANA_LOG_ASSERT(begin <= end);
+    uint64_t weight = end - begin;
+    for (uint64_t n = begin; n < end; ++n) {
+      weight += partition->item(n).end - partition->item(n).begin;
+    }
+    KATANA_LOG_VASSERT(
+        weight <= total / num_threads + kHubDegree + 2,
+        "thread {} has weight {} of {}", t, weight, total);
+  }
+
+  // The partition is cached
+  KATANA_LOG_ASSERT(katana::EdgeBalancedPartition::Get(topology) == partition);
+}
+
+void
+TestSplitHubs(const katana::PropertyGraph& pg) {
+  constexpr uint64_t kMaxHubEdges = 4096;
+  auto range = katana::iterate_edge_balanced_split_hubs(pg, kMaxHubEdges);
+
+  std::vector<std::atomic<uint32_t>> visits(pg.num_edges());
+  std::atomic<uint64_t> num_items = 0;
+  katana::do_all(
+      range,
+      [&](const katana::NodeEdgeRange& r) {
+        auto [begin, end] = pg.topology().edge_range(r.node);
+        KATANA_LOG_ASSERT(begin <= r.begin && r.end <= end);
+        KATANA_LOG_ASSERT(r.end - r.begin <= kMaxHubEdges || r.begin == begin);
+        for (uint64_t e = r.begin; e < r.end; ++e) {
+          visits[e] += 1;
+        }
+        num_items += 1;
+      },
+      katana::steal());
+  for (const auto& v : visits) {
+    KATANA_LOG_ASSERT(v == 1);
+  }
+
+  uint64_t pieces = (kHubDegree + kMaxHubEdges - 1) / kMaxHubEdges;
+  KATANA_LOG_ASSERT(num_items == pg.num_nodes() + 2 * (pieces - 1));
+
+  // Items are in node order, and a hub's items cover its edges in order
+  auto partition =
+      katana::EdgeBalancedPartition::Get(pg.topology(), kMaxHubEdges);
+  uint64_t next_edge = 0;
+  for (uint64_t i = 0; i < partition->num_items(); ++i) {
+    katana::NodeEdgeRange r = partition->item(i);
+    KATANA_LOG_ASSERT(r.begin == next_edge);
+    next_edge = r.end;
+  }
+  KATANA_LOG_ASSERT(next_edge == pg.num_edges());
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(kNumThreads);
+
+  auto pg = MakeSkewedGraph();
+  TestNodes(*pg);
+  TestSplitHubs(*pg);
+
+  katana::PropertyGraph empty;
+  katana::do_all(katana::iterate_edge_balanced(empty), [](uint32_t) {
+    KATANA_LOG_FATAL("empty graph has no nodes");
+  });
+
+  return 0;
+}
@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <clocale>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <arrow/api.h>
+#include <boost/filesystem.hpp>
+
+#include "katana/EdgeListImport.h"
+#include "katana/ErrorCode.h"
+#include "katana/Logging.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Uri.h"
+
+namespace {
+
+namespace fs = boost::filesystem;
+
+using Edge = std::tuple<uint64_t, uint64_t, double>;
+
+/// Input is a set of edge list files along with what a serial import of them
+/// should produce
+struct Input {
+  std::vector<std::string> paths;
+  std::vector<std::string> ids;
+  std::vector<Edge> edges;
+};
+
+Input
+MakeInput(
+    const std::string& dir, size_t num_files, bool numeric, bool header,
+    uint32_t seed) {
+  std::mt19937 gen(seed);
+  Input input;
+  std::map<std::string, uint64_t> dense;
+  auto lookup = [&](const std::string& id) {
+    auto [it, inserted] = dense.emplace(id, input.ids.size());
+    if (inserted) {
+      input.ids.emplace_back(id);
+    }
+    return it->second;
+  };
+
+  for (size_t f = 0; f < num_files; ++f) {
+    std::string path = dir + "/edges" + std::to_string(f);
+    input.paths.emplace_back(path);
+    std::ofstream out(path);
+    if (header) {
+      out << "src,dst,weight\n";
+    }
+    size_t num_lines = 200 + gen() % 200;
+    for (size_t i = 0; i < num_lines; ++i) {
+      if (gen() % 16 == 0) {
+        out << "# comment\n\n";
+      }
+      std::string src = (numeric ? "" : "v") + std::to_string(gen() % 100);
+      std::string dst = (numeric ? "" : "v") + std::to_string(gen() % 100);
+      double weight = (gen() % 1024) / 4.0;
+      out << src << ", " << dst << "," << weight;
+      // Exercise files that do not end with a newline
+      if (i + 1 < num_lines || f % 2 == 0) {
+        out << "\n";
+      }
+      uint64_t s = lookup(src);
+      uint64_t d = lookup(dst);
+      input.edges.emplace_back(s, d, weight);
+    }
+  }
+
+  std::sort(input.edges.begin(), input.edges.end());
+  return input;
+}
+
+void
+Check(
+    const Input& input, const katana::EdgeListImportOptions& opts,
+    const katana::GraphComponents& comps) {
+  // Only graphs with more than 2^32 - 1 nodes get a wide topology
+  KATANA_LOG_ASSERT(comps.topology && !comps.wide_topology);
+  const auto& indices = comps.topology->out_indices;
+  const auto& dests = comps.topology->out_dests;
+  KATANA_LOG_ASSERT(static_cast<size_t>(indices->length()) == input.ids.size());
+  KATANA_LOG_ASSERT(static_cast<size_t>(dests->length()) == input.edges.size());
+
+  auto ids = comps.nodes.properties->GetColumnByName(opts.id_name);
+  KATANA_LOG_ASSERT(ids);
+  for (size_t n = 0; n < input.ids.size(); ++n) {
+    std::string id;
+    if (opts.numeric_ids) {
+      id = std::to_string(
+          std::static_pointer_cast<arrow::UInt64Array>(ids->chunk(0))->Value(
+              n));
+    } else {
+      id = std::static_pointer_cast<arrow::LargeStringArray>(ids->chunk(0))
+               ->GetString(n);
+    }
+    KATANA_LOG_VASSERT(
+        id == input.ids[n], "node {}: expected {} found {}", n, input.ids[n],
+        id);
+  }
+
+  std::shared_ptr<arrow::DoubleArray> weights;
+  if (opts.weight_column) {
+    auto col = comps.edges.properties->GetColumnByName(opts.weight_name);
+    KATANA_LOG_ASSERT(col);
+    weights = std::static_pointer_cast<arrow::DoubleArray>(col->chunk(0));
+  } else {
+    KATANA_LOG_ASSERT(comps.edges.properties->num_columns() == 0);
+  }
+
+  uint64_t e = 0;
+  for (uint64_t n = 0; n < input.ids.size(); ++n) {
+    for (; e < indices->Value(n); ++e) {
+      const auto& [src, dst, weight] = input.edges[e];
+      KATANA_LOG_VASSERT(src == n, "edge {}: expected source {}", e, src);
+      KATANA_LOG_VASSERT(dests->Value(e) == dst, "edge {}: bad destination", e);
+      if (weights) {
+        KATANA_LOG_VASSERT(
+            weights->Value(e) == weight, "edge {}: bad weight", e);
+      }
+    }
+  }
+}
+
+void
+TestImport(const std::string& dir) {
+  uint32_t seed = 0;
+  for (bool numeric : {false, true}) {
+    for (bool weighted : {false, true}) {
+      for (uint64_t budget : {UINT64_C(0), UINT64_C(1024)}) {
+        std::string case_dir = dir + "/" + std::to_string(seed);
+        fs::create_directories(case_dir);
+        Input input = MakeInput(case_dir, 3, numeric, weighted, ++seed);
+
+        katana::EdgeListImportOptions opts;
+        opts.has_header = weighted;
+        opts.numeric_ids = numeric;
+        if (weighted) {
+          opts.weight_column = 2;
+        }
+        // Small chunks so that lines regularly straddle chunk boundaries
+        opts.chunk_size = 97;
+        opts.memory_budget = budget;
+        opts.spill_dir = case_dir;
+
+        auto res = katana::ImportEdgeList(input.paths, opts);
+        KATANA_LOG_VASSERT(res, "import failed: {}", res.error());
+        Check(input, opts, res.value());
+      }
+    }
+  }
+}
+
+void
+TestMalformed(const std::string& dir) {
+  std::string path = dir + "/malformed";
+  std::ofstream(path) << "a,b\nc\n";
+
+  auto res = katana::ImportEdgeList({path}, katana::EdgeListImportOptions{});
+  KATANA_LOG_ASSERT(!res);
+  KATANA_LOG_ASSERT(res.error() == katana::ErrorCode::InvalidArgument);
+}
+
+/// Weights are parsed in the C locale even if the process uses one whose
+/// decimal separator is not '.'
+void
+TestLocale(const std::string& dir) {
+  std::string path = dir + "/locale";
+  std::ofstream(path) << "a,b,1.5\n";
+
+  for (const char* name : {"de_DE.UTF-8", "de_DE", "fr_FR.UTF-8"}) {
+    if (std::setlocale(LC_NUMERIC, name)) {
+      break;
+    }
+  }
+  katana::EdgeListImportOptions opts;
+  opts.weight_column = 2;
+  auto res = katana::ImportEdgeList({path}, opts);
+  std::setlocale(LC_NUMERIC, "C");
+
+  KATANA_LOG_VASSERT(res, "import failed: {}", res.error());
+  auto col = res.value().edges.properties->GetColumnByName(opts.weight_name);
+  KATANA_LOG_ASSERT(col);
+  double weight =
+      std::static_pointer_cast<arrow::DoubleArray>(col->chunk(0))->Value(0);
+  KATANA_LOG_VASSERT(weight == 1.5, "expected 1.5 found {}", weight);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/edgelistimport");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string temp_dir(uri_res.value().path());  // path because local
+  fs::create_directories(temp_dir);
+
+  TestImport(temp_dir);
+  TestMalformed(temp_dir);
+  TestLocale(temp_dir);
+
+  fs::remove_all(temp_dir);
+  return 0;
+}
@@ -0,0 +1,122 @@
+#include <fstream>
+#include <future>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <boost/filesystem.hpp>
+
+#include "katana/Logging.h"
+#include "katana/Result.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Uri.h"
+#include "tsuba/file.h"
+
+namespace {
+
+namespace fs = boost::filesystem;
+
+// The file is read back right after it is written, so these numbers mostly
+// reflect the page cache: they measure per-request overhead (threads, copies,
+// syscalls) rather than device bandwidth.
+constexpr uint64_t kFileSize = UINT64_C(256) << 20;
+
+std::string file_path;
+
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  for (long page_size : {1L << 16, 1L << 20, 1L << 22}) {
+    b->Arg(page_size);
+  }
+}
+
+/// Read the file the way the previous LocalStorage backend did: one
+/// std::ifstream per request wrapped in a std::async task.
+katana::Result<void>
+IfstreamRead(
+    const std::string& path, uint64_t start, uint64_t size, uint8_t* data) {
+  std::ifstream ifile(path);
+  ifile.seekg(start);
+  ifile.read(reinterpret_cast<char*>(data), size); /* NOLINT */
+  if (!ifile) {
+    return std::make_error_code(std::errc::io_error);
+  }
+  return katana::ResultSuccess();
+}
+
+void
+IfstreamLoad(benchmark::State& state) {
+  uint64_t page_size = state.range(0);
+  std::vector<uint8_t> buf(kFileSize);
+
+  for (auto _ : state) {
+    std::vector<std::future<katana::Result<void>>> futures;
+    for (uint64_t off = 0; off < kFileSize; off += page_size) {
+      uint64_t size = std::min(page_size, kFileSize - off);
+      futures.emplace_back(std::async(
+          std::launch::async, IfstreamRead, file_path, off, size, &buf[off]));
+    }
+    for (auto& f : futures) {
+      KATANA_LOG_ASSERT(f.get());
+    }
+    benchmark::DoNotOptimize(buf.data());
+  }
+
+  state.SetBytesProcessed(state.iterations() * kFileSize);
+}
+
+void
+LocalStorageLoad(benchmark::State& state) {
+  uint64_t page_size = state.range(0);
+  std::vector<uint8_t> buf(kFileSize);
+
+  for (auto _ : state) {
+    std::vector<std::future<katana::Result<void>>> futures;
+    for (uint64_t off = 0; off < kFileSize; off += page_size) {
+      uint64_t size = std::min(page_size, kFileSize - off);
+      futures.emplace_back(
+          tsuba::FileGetAsync(file_path, &buf[off], off, size));
+    }
+    for (auto& f : futures) {
+      KATANA_LOG_ASSERT(f.get());
+    }
+    benchmark::DoNotOptimize(buf.data());
+  }
+
+  state.SetBytesProcessed(state.iterations() * kFileSize);
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  katana::SharedMemSys sys;
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/localstoragebench");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string temp_dir(uri_res.value().path());  // path because local
+  file_path = temp_dir + "/data";
+
+  std::vector<uint8_t> data(kFileSize);
+  for (uint64_t i = 0; i < kFileSize; ++i) {
+    data[i] = i * 2654435761U >> 24;
+  }
+  if (auto res = tsuba::FileStore(file_path, data.data(), data.size()); !res) {
+    KATANA_LOG_FATAL("could not write {}: {}", file_path, res.error());
+  }
+
+  benchmark::RegisterBenchmark("IfstreamLoad", IfstreamLoad)
+      ->Apply(MakeArguments)
+      ->Unit(benchmark::kMillisecond)
+      ->UseRealTime();
+  benchmark::RegisterBenchmark("LocalStorageLoad", LocalStorageLoad)
+      ->Apply(MakeArguments)
+      ->Unit(benchmark::kMillisecond)
+      ->UseRealTime();
+
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+
+  fs::remove_all(temp_dir);
+  return 0;
+}
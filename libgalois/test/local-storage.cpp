@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cstdlib>
+#include <future>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "katana/Logging.h"
+#include "katana/Result.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Uri.h"
+#include "tsuba/file.h"
+
+namespace {
+
+namespace fs = boost::filesystem;
+
+// Small requests so that modest reads and writes are split into many chunks
+constexpr uint64_t kRequestSize = 4 * tsuba::kBlockSize;
+// Not a multiple of the block or request size
+constexpr uint64_t kFileSize = 37 * kRequestSize + 1234;
+
+std::string file_path;
+std::vector<uint8_t> expected;
+
+void
+AssertMatches(const uint8_t* buf, uint64_t start, uint64_t size) {
+  for (uint64_t i = 0; i < size; ++i) {
+    KATANA_LOG_VASSERT(
+        buf[i] == expected[start + i], "byte {} differs: {} != {}", start + i,
+        buf[i], expected[start + i]);
+  }
+}
+
+/// A single read much larger than the request size is split into chunks
+void
+TestSplit() {
+  for (uint64_t start : {UINT64_C(0), UINT64_C(1), kRequestSize - 3}) {
+    uint64_t size = kFileSize - start;
+    std::vector<uint8_t> buf(size);
+    auto res = tsuba::FileGet(file_path, buf.data(), start, size);
+    KATANA_LOG_VASSERT(res, "reading from {}: {}", start, res.error());
+    AssertMatches(buf.data(), start, size);
+  }
+}
+
+/// Many small contiguous reads, which the pool folds into vectored reads
+/// while they wait in the queue
+void
+TestCoalesce() {
+  for (uint64_t piece : {UINT64_C(1000), kRequestSize, kRequestSize + 17}) {
+    std::vector<uint8_t> buf(kFileSize);
+    std::vector<std::future<katana::Result<void>>> futures;
+    for (uint64_t off = 0; off < kFileSize; off += piece) {
+      uint64_t size = std::min(piece, kFileSize - off);
+      futures.emplace_back(
+          tsuba::FileGetAsync(file_path, &buf[off], off, size));
+    }
+    for (auto& f : futures) {
+      auto res = f.get();
+      KATANA_LOG_VASSERT(res, "reading pieces of {}: {}", piece, res.error());
+    }
+    AssertMatches(buf.data(), 0, kFileSize);
+  }
+}
+
+/// Reads past the end of the file succeed if they are short by less than a
+/// block and fail otherwise
+void
+TestShortRead() {
+  uint64_t start = kFileSize - 100;
+
+  std::vector<uint8_t> buf(tsuba::kBlockSize, 0xab);
+  auto res = tsuba::FileGet(file_path, buf.data(), start, buf.size());
+  KATANA_LOG_VASSERT(res, "short read: {}", res.error());
+  AssertMatches(buf.data(), start, 100);
+
+  std::vector<uint8_t> big_buf(3 * kRequestSize);
+  res = tsuba::FileGet(file_path, big_buf.data(), start, big_buf.size());
+  KATANA_LOG_ASSERT(!res);
+  AssertMatches(big_buf.data(), start, 100);
+}
+
+/// A write split into chunks produces the same file
+void
+TestWrite() {
+  std::string copy_path = file_path + ".copy";
+  auto res = tsuba::FileStore(copy_path, expected.data(), expected.size());
+  KATANA_LOG_VASSERT(res, "writing {}: {}", copy_path, res.error());
+
+  tsuba::StatBuf stat_buf;
+  KATANA_LOG_ASSERT(tsuba::FileStat(copy_path, &stat_buf));
+  KATANA_LOG_ASSERT(stat_buf.size == kFileSize);
+
+  std::vector<uint8_t> buf(kFileSize);
+  res = tsuba::FileGet(copy_path, buf.data(), 0, buf.size());
+  KATANA_LOG_VASSERT(res, "reading {}: {}", copy_path, res.error());
+  AssertMatches(buf.data(), 0, kFileSize);
+}
+
+}  // namespace
+
+int
+main() {
+  // One I/O thread lets requests pile up in the queue so they are coalesced
+  setenv("KATANA_LOCAL_IO_THREADS", "1", 1);
+  setenv("KATANA_LOCAL_IO_QUEUE_DEPTH", "256", 1);
+  setenv(
+      "KATANA_LOCAL_IO_REQUEST_SIZE", std::to_string(kRequestSize).c_str(), 1);
+
+  katana::SharedMemSys sys;
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/localstorage");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string temp_dir(uri_res.value().path());  // path because local
+  file_path = temp_dir + "/data";
+
+  expected.resize(kFileSize);
+  for (uint64_t i = 0; i < kFileSize; ++i) {
+    expected[i] = i * 2654435761U >> 24;
+  }
+  if (auto res = tsuba::FileStore(file_path, expected.data(), kFileSize);
+      !res) {
+    KATANA_LOG_FATAL("could not write {}: {}", file_path, res.error());
+  }
+
+  TestSplit();
+  TestCoalesce();
+  TestShortRead();
+  TestWrite();
+
+  fs::remove_all(temp_dir);
+  return 0;
+}
@@ -0,0 +1,236 @@
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/ArrowInterchange.h"
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SetIntersection.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/LatentVectorKernels.h"
+#include "katana/analytics/matrix_completion/matrix_completion.h"
+
+namespace {
+
+using katana::analytics::MatrixCompletion;
+using katana::analytics::MatrixCompletionAssertValid;
+using katana::analytics::MatrixCompletionPlan;
+using katana::analytics::MatrixCompletionStatistics;
+using katana::analytics::ScalarKernel;
+
+constexpr unsigned kNumThreads = 4;
+constexpr uint32_t kNumItems = 200;
+constexpr uint32_t kNumUsers = 300;
+constexpr uint32_t kRank = 4;
+constexpr double kDensity = 0.2;
+
+/// A bipartite graph whose ratings are the dot products of random nonnegative
+/// vectors of rank kRank, with the edges of each item sorted by destination
+std::unique_ptr<katana::PropertyGraph>
+MakeRatingsGraph() {
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<float> dist(0, 1);
+
+  std::vector<std::vector<float>> factors(kNumItems + kNumUsers);
+  for (auto& f : factors) {
+    for (uint32_t i = 0; i < kRank; ++i) {
+      f.emplace_back(dist(gen));
+    }
+  }
+
+  std::vector<uint64_t> indices;
+  std::vector<uint32_t> dests;
+  std::vector<float> ratings;
+  for (uint32_t item = 0; item < kNumItems; ++item) {
+    for (uint32_t user = kNumItems; user < kNumItems + kNumUsers; ++user) {
+      if (dist(gen) >= kDensity) {
+        continue;
+      }
+      float rating = 0;
+      for (uint32_t i = 0; i < kRank; ++i) {
+        rating += factors[item][i] * factors[user][i];
+      }
+      dests.emplace_back(user);
+      ratings.emplace_back(rating);
+    }
+    indices.emplace_back(dests.size());
+  }
+  for (uint32_t user = 0; user < kNumUsers; ++user) {
+    indices.emplace_back(dests.size());
+  }
+
+  auto pg = std::make_unique<katana::PropertyGraph>();
+  auto res = pg->SetTopology(katana::GraphTopology{
+      .out_indices = std::static_pointer_cast<arrow::UInt64Array>(
+          katana::BuildArray(indices)),
+      .out_dests = std::static_pointer_cast<arrow::UInt32Array>(
+          katana::BuildArray(dests)),
+  });
+  KATANA_LOG_ASSERT(res);
+
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("rating", arrow::float32())}),
+      {katana::BuildArray(ratings)});
+  auto add_res = pg->AddEdgeProperties(table);
+  KATANA_LOG_ASSERT(add_res);
+  return pg;
+}
+
+void
+TestPlan(
+    katana::PropertyGraph* pg, const std::string& name,
+    const MatrixCompletionPlan& plan) {
+  auto res = MatrixCompletion(pg, "rating", name, plan);
+  KATANA_LOG_VASSERT(res, "{}: {}", name, res.error());
+  KATANA_LOG_ASSERT(MatrixCompletionAssertValid(pg, name));
+
+  auto type = pg->GetNodeProperty(name)->type();
+  KATANA_LOG_ASSERT(type->Equals(
+      arrow::fixed_size_list(arrow::float32(), plan.latent_vector_size())));
+
+  auto stats_res = MatrixCompletionStatistics::Compute(pg, "rating", name);
+  KATANA_LOG_ASSERT(stats_res);
+  auto stats = stats_res.value();
+  KATANA_LOG_ASSERT(stats.num_items == kNumItems);
+  KATANA_LOG_ASSERT(stats.num_users == kNumUsers);
+  // The ratings are about kRank / 4 on average
+  KATANA_LOG_VASSERT(stats.rmse < 0.3, "{}: rmse {}", name, stats.rmse);
+}
+
+std::vector<float>
+RandomVector(std::mt19937* gen, size_t size) {
+  std::uniform_real_distribution<float> dist(-1, 1);
+  std::vector<float> v;
+  for (size_t i = 0; i < size; ++i) {
+    v.emplace_back(dist(*gen));
+  }
+  return v;
+}
+
+/// Check that the results of Kernel match those of ScalarKernel up to the
+/// rounding error of summing in a different order and of fused multiply-adds
+template <typename Kernel>
+void
+TestKernel(const std::string& name, uint32_t size) {
+  std::mt19937 gen(size);
+  std::vector<float> a = RandomVector(&gen, size);
+  std::vector<float> b = RandomVector(&gen, size);
+
+  float magnitude = 1;
+  for (uint32_t i = 0; i < size; ++i) {
+    magnitude += std::abs(a[i] * b[i]);
+  }
+  float dot = Kernel::Dot(a.data(), b.data(), size);
+  float expected_dot = ScalarKernel<0>::Dot(a.data(), b.data(), size);
+  KATANA_LOG_VASSERT(
+      std::abs(dot - expected_dot) <= 1e-5 * magnitude,
+      "{} Dot of size {}: expected {} found {}", name, size, expected_dot, dot);
+
+  std::vector<float> item = a;
+  std::vector<float> user = b;
+  std::vector<float> expected_item = a;
+  std::vector<float> expected_user = b;
+  float error = Kernel::Sgd(item.data(), user.data(), 0.5, 0.01, 0.05, size);
+  float expected_error = ScalarKernel<0>::Sgd(
+      expected_item.data(), expected_user.data(), 0.5, 0.01, 0.05, size);
+  KATANA_LOG_VASSERT(
+      std::abs(error - expected_error) <= 1e-5 * magnitude,
+      "{} Sgd of size {}: expected error {} found {}", name, size,
+      expected_error, error);
+  for (uint32_t i = 0; i < size; ++i) {
+    KATANA_LOG_VASSERT(
+        std::abs(item[i] - expected_item[i]) <= 1e-5 &&
+            std::abs(user[i] - expected_user[i]) <= 1e-5,
+        "{} Sgd of size {}: element {} differs", name, size, i);
+  }
+
+  // AddOuter only updates the upper triangle, so the lower one must keep its
+  // values exactly
+  std::vector<float> gram = RandomVector(&gen, size * size);
+  std::vector<float> rhs = RandomVector(&gen, size);
+  std::vector<float> expected_gram = gram;
+  std::vector<float> expected_rhs = rhs;
+  Kernel::AddOuter(gram.data(), rhs.data(), a.data(), 0.5, size);
+  ScalarKernel<0>::AddOuter(
+      expected_gram.data(), expected_rhs.data(), a.data(), 0.5, size);
+  for (uint32_t r = 0; r < size; ++r) {
+    for (uint32_t c = 0; c < size; ++c) {
+      float found = gram[r * size + c];
+      float expected = expected_gram[r * size + c];
+      KATANA_LOG_VASSERT(
+          c < r ? found == expected : std::abs(found - expected) <= 1e-5,
+          "{} AddOuter of size {}: gram[{}][{}] expected {} found {}", name,
+          size, r, c, expected, found);
+    }
+    KATANA_LOG_VASSERT(
+        std::abs(rhs[r] - expected_rhs[r]) <= 1e-5,
+        "{} AddOuter of size {}: rhs[{}] expected {} found {}", name, size, r,
+        expected_rhs[r], rhs[r]);
+  }
+}
+
+/// Check the specialized kernels of each size that matrix completion uses and
+/// the kernel sized at run time, on the same sizes and on sizes that leave a
+/// partial vector
+template <template <uint32_t> class Kernel>
+void
+TestKernels(const std::string& name) {
+  TestKernel<Kernel<16>>(name, 16);
+  TestKernel<Kernel<32>>(name, 32);
+  TestKernel<Kernel<64>>(name, 64);
+  TestKernel<Kernel<128>>(name, 128);
+  for (uint32_t size : {1, 5, 16, 20, 32, 37, 64, 128}) {
+    TestKernel<Kernel<0>>(name, size);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(kNumThreads);
+
+  TestKernels<ScalarKernel>("Scalar");
+#if KATANA_LATENT_VECTOR_KERNELS_X86
+  katana::SimdLevel level = katana::GetSimdLevel();
+  if (level >= katana::SimdLevel::kAVX2 && __builtin_cpu_supports("fma")) {
+    TestKernels<katana::analytics::AVX2Kernel>("AVX2");
+  }
+  if (level == katana::SimdLevel::kAVX512) {
+    TestKernels<katana::analytics::AVX512Kernel>("AVX512");
+  }
+#endif
+
+  auto pg = MakeRatingsGraph();
+
+  // 16 takes the specialized kernels and 20 the ones sized at run time
+  for (uint32_t size : {16, 20}) {
+    std::string suffix = std::to_string(size);
+    TestPlan(
+        pg.get(), "sgd_by_edges" + suffix,
+        MatrixCompletionPlan::SGDByEdges(
+            size, 0.05, MatrixCompletionPlan::kDefaultDecayRate,
+            MatrixCompletionPlan::kDefaultLambda,
+            MatrixCompletionPlan::kDefaultStepFunction,
+            MatrixCompletionPlan::kDefaultTolerance,
+            MatrixCompletionPlan::kDefaultMaxRounds, 32, 64));
+    TestPlan(
+        pg.get(), "sgd_by_items" + suffix,
+        MatrixCompletionPlan::SGDByItems(size, 0.05));
+    TestPlan(pg.get(), "als" + suffix, MatrixCompletionPlan::ALS(size));
+  }
+
+  // Plans and properties that are not valid
+  auto res = MatrixCompletion(
+      pg.get(), "rating", "invalid", MatrixCompletionPlan::ALS(0));
+  KATANA_LOG_ASSERT(!res);
+  KATANA_LOG_ASSERT(!MatrixCompletionAssertValid(pg.get(), "rating"));
+
+  return 0;
+}
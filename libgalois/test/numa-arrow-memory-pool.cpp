@@ -0,0 +1,157 @@
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/ArrowInterchange.h"
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+#include "katana/NumaArrowMemoryPool.h"
+#include "katana/Properties.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+using Policy = katana::NumaArrowMemoryPool::Policy;
+
+constexpr int64_t kMinNumaSize = INT64_C(1) << 20;
+
+void
+TestReallocate(Policy policy) {
+  katana::NumaArrowMemoryPool::Options opts;
+  opts.policy = policy;
+  opts.min_numa_size = kMinNumaSize;
+  katana::NumaArrowMemoryPool pool(opts);
+  pool.Attach();
+
+  constexpr int64_t kPrefix = 512;
+  uint8_t* ptr = nullptr;
+  int64_t size = 1000;
+  KATANA_LOG_ASSERT(pool.Allocate(size, &ptr).ok());
+  for (int64_t i = 0; i < kPrefix; ++i) {
+    ptr[i] = i;
+  }
+
+  // Cross the threshold in both directions and grow within one mapping
+  for (int64_t new_size :
+       {INT64_C(5000), 3 * kMinNumaSize, 3 * kMinNumaSize + 7,
+        9 * kMinNumaSize, INT64_C(2000)}) {
+    KATANA_LOG_ASSERT(pool.Reallocate(size, new_size, &ptr).ok());
+    for (int64_t i = 0; i < kPrefix; ++i) {
+      KATANA_LOG_VASSERT(
+          ptr[i] == static_cast<uint8_t>(i), "lost data growing to {}",
+          new_size);
+    }
+    std::memset(ptr + kPrefix, 0xff, new_size - kPrefix);
+    size = new_size;
+    KATANA_LOG_ASSERT(pool.bytes_allocated() == size);
+  }
+
+  pool.Free(ptr, size);
+  KATANA_LOG_ASSERT(pool.bytes_allocated() == 0);
+  KATANA_LOG_ASSERT(pool.max_memory() >= 9 * kMinNumaSize);
+
+  // Allocations from inside a parallel loop fall back to first touch
+  katana::do_all(katana::iterate(0, 4), [&](int) {
+    uint8_t* p = nullptr;
+    KATANA_LOG_ASSERT(pool.Allocate(2 * kMinNumaSize, &p).ok());
+    p[0] = 1;
+    p[2 * kMinNumaSize - 1] = 1;
+    pool.Free(p, 2 * kMinNumaSize);
+  });
+  KATANA_LOG_ASSERT(pool.bytes_allocated() == 0);
+
+  pool.Detach();
+}
+
+void
+TestOutOfMemory(Policy policy) {
+  katana::NumaArrowMemoryPool::Options opts;
+  opts.policy = policy;
+  opts.min_numa_size = kMinNumaSize;
+  katana::NumaArrowMemoryPool pool(opts);
+  pool.Attach();
+
+  // No address space is large enough for this
+  constexpr int64_t kImpossible = std::numeric_limits<int64_t>::max();
+
+  uint8_t* ptr = nullptr;
+  arrow::Status status = pool.Allocate(kImpossible, &ptr);
+  KATANA_LOG_VASSERT(status.IsOutOfMemory(), "got {}", status.ToString());
+  KATANA_LOG_ASSERT(pool.bytes_allocated() == 0);
+
+  // A failed reallocation leaves the original buffer in place
+  int64_t size = 2 * kMinNumaSize;
+  KATANA_LOG_ASSERT(pool.Allocate(size, &ptr).ok());
+  ptr[0] = 42;
+  uint8_t* old_ptr = ptr;
+  status = pool.Reallocate(size, kImpossible, &ptr);
+  KATANA_LOG_VASSERT(status.IsOutOfMemory(), "got {}", status.ToString());
+  KATANA_LOG_ASSERT(ptr == old_ptr && ptr[0] == 42);
+  KATANA_LOG_ASSERT(pool.bytes_allocated() == size);
+
+  pool.Free(ptr, size);
+  KATANA_LOG_ASSERT(pool.bytes_allocated() == 0);
+
+  pool.Detach();
+}
+
+void
+TestBuilder() {
+  katana::NumaArrowMemoryPool::Options opts;
+  opts.min_numa_size = kMinNumaSize;
+  katana::NumaArrowMemoryPool pool(opts);
+  pool.Attach();
+
+  constexpr int64_t kLength = 1 << 20;
+  {
+    arrow::UInt64Builder builder(&pool);
+    for (int64_t i = 0; i < kLength; ++i) {
+      KATANA_LOG_ASSERT(builder.Append(i).ok());
+    }
+    std::shared_ptr<arrow::UInt64Array> array;
+    KATANA_LOG_ASSERT(builder.Finish(&array).ok());
+    KATANA_LOG_ASSERT(pool.bytes_allocated() >= kLength * 8);
+    for (int64_t i = 0; i < kLength; ++i) {
+      KATANA_LOG_ASSERT(array->Value(i) == static_cast<uint64_t>(i));
+    }
+  }
+  KATANA_LOG_ASSERT(pool.bytes_allocated() == 0);
+
+  pool.Detach();
+}
+
+void
+TestPropertyPool() {
+  // SharedMemSys installs the global pool unless KATANA_USE_NUMA_POOL=0
+  katana::NumaArrowMemoryPool* global = katana::GetNumaArrowMemoryPool();
+  if (katana::GetPropertyMemoryPool() != global) {
+    return;
+  }
+
+  int64_t before = global->bytes_allocated();
+  auto res = katana::AllocateTable<std::tuple<katana::UInt64Property>>(
+      1 << 20, {"value"});
+  KATANA_LOG_ASSERT(res);
+  KATANA_LOG_ASSERT(global->bytes_allocated() > before);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(4);
+
+  for (Policy policy :
+       {Policy::kInterleaved, Policy::kBlocked, Policy::kLocal}) {
+    TestReallocate(policy);
+    TestOutOfMemory(policy);
+  }
+  TestBuilder();
+  TestPropertyPool();
+
+  return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "TestOrderedSssp.h"
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+
+namespace {
+
+constexpr size_t kNumNodes = 1 << 18;
+constexpr size_t kDegree = 16;
+constexpr uint32_t kMaxWeight = 1000;
+
+SsspGraph&
+Graph() {
+  static SsspGraph g = MakeRandomSsspGraph(kNumNodes, kDegree, kMaxWeight);
+  return g;
+}
+
+void
+SerialPriorityQueue(benchmark::State& state) {
+  SsspGraph& g = Graph();
+  for (auto _ : state) {
+    std::vector<uint64_t> dist = SerialSssp(g, 0);
+    benchmark::DoNotOptimize(dist.data());
+  }
+}
+
+void
+ForEachOrdered(benchmark::State& state) {
+  katana::setActiveThreads(state.range(0));
+  SsspGraph& g = Graph();
+  for (auto _ : state) {
+    state.PauseTiming();
+    g.Reset();
+    state.ResumeTiming();
+    OrderedSssp(&g, 0);
+  }
+}
+
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  unsigned max_threads = katana::GetThreadPool().getMaxThreads();
+  for (unsigned t = 1; t < max_threads; t *= 2) {
+    b->Arg(t);
+  }
+  b->Arg(max_threads);
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  katana::SharedMemSys Katana_runtime;
+
+  // Registered here rather than with BENCHMARK because the thread counts
+  // depend on the thread pool.
+  benchmark::RegisterBenchmark("SerialPriorityQueue", SerialPriorityQueue)
+      ->Unit(benchmark::kMillisecond);
+  benchmark::RegisterBenchmark("ForEachOrdered", ForEachOrdered)
+      ->Apply(MakeArguments)
+      ->Unit(benchmark::kMillisecond)
+      ->UseRealTime();
+
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "TestOrderedSssp.h"
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+
+namespace {
+
+void
+TestOrderedSssp(unsigned num_threads) {
+  katana::setActiveThreads(num_threads);
+
+  SsspGraph g = MakeRandomSsspGraph(1 << 12, 8, 100);
+  std::vector<uint64_t> expected = SerialSssp(g, 0);
+
+  OrderedSssp(&g, 0);
+
+  for (size_t n = 0; n < g.num_nodes(); ++n) {
+    KATANA_LOG_VASSERT(
+        g.nodes[n].dist == expected[n], "node {}: expected {} found {}", n,
+        expected[n], g.nodes[n].dist.load());
+  }
+}
+
+void
+TestChain(unsigned num_threads) {
+  katana::setActiveThreads(num_threads);
+
+  // The tasks for u (5) and x (9) share a window and have disjoint
+  // neighborhoods, but the task for u leads to a shorter path to x (7)
+  // through v, so the task for x must not run in the same round.
+  enum : uint32_t { kSource, kU, kX, kV, kNumNodes };
+  SsspGraph g(kNumNodes);
+  g.indices = {0, 2, 3, 3, 4};
+  g.edges = {{kU, 5}, {kX, 9}, {kV, 1}, {kX, 1}};
+
+  OrderedSssp(&g, kSource);
+
+  std::vector<uint64_t> expected = SerialSssp(g, kSource);
+  KATANA_LOG_ASSERT(expected[kX] == 7);
+  for (size_t n = 0; n < g.num_nodes(); ++n) {
+    KATANA_LOG_VASSERT(
+        g.nodes[n].dist == expected[n], "node {}: expected {} found {}", n,
+        expected[n], g.nodes[n].dist.load());
+  }
+}
+
+void
+TestUnstableSources(unsigned num_threads) {
+  katana::setActiveThreads(num_threads);
+
+  // Tasks have no neighborhood, so every task is a source, but no source is
+  // stable. Only the earliest task of each window may run, so the log of
+  // executed tasks must be sorted.
+  std::vector<int> initial(1000);
+  for (size_t i = 0; i < initial.size(); ++i) {
+    initial[i] = (i * 7919) % initial.size();
+  }
+  std::vector<int> log;
+
+  katana::for_each_ordered(
+      initial.begin(), initial.end(), std::less<int>(),
+      [](int) {},
+      [&](int x, katana::UserContext<int>&) { log.push_back(x); },
+      [](int) { return false; }, "UnstableSources");
+
+  KATANA_LOG_ASSERT(log.size() == initial.size());
+  KATANA_LOG_ASSERT(std::is_sorted(log.begin(), log.end()));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys Katana_runtime;
+
+  for (unsigned num_threads :
+       {1U, 2U, katana::GetThreadPool().getMaxThreads()}) {
+    TestOrderedSssp(num_threads);
+    TestChain(num_threads);
+    TestUnstableSources(num_threads);
+  }
+
+  return 0;
+}
@@ -1,7 +1,10 @@
+#include <atomic>
+
 #include <arrow/api.h>
 #include <boost/filesystem.hpp>
 
 #include "TestTypedPropertyGraph.h"
+#include "katana/Galois.h"
 #include "katana/Logging.h"
 #include "katana/PropertyGraph.h"
 #include "katana/SharedMemSys.h"
@@ -239,6 +242,150 @@ TestTopologyAccess() {
   }
   KATANA_LOG_ASSERT(n_nodes == 10);
 }
+
+void
+TestInEdges() {
+  RandomPolicy policy{3};
+  auto g = MakeFileGraph<uint32_t>(100, 1, &policy);
+
+  KATANA_LOG_ASSERT(!g->has_in_edges());
+  auto build_result = g->BuildInEdges();
+  KATANA_LOG_ASSERT(build_result);
+  KATANA_LOG_ASSERT(g->has_in_edges());
+  KATANA_LOG_ASSERT(g->in_topology().num_nodes() == g->num_nodes());
+  KATANA_LOG_ASSERT(g->in_topology().num_edges() == g->num_edges());
+
+  // Every in-edge mirrors an out-edge with the same endpoints and every
+  // out-edge is mirrored exactly once.
+  std::vector<int> mirrored(g->num_edges());
+  for (katana::PropertyGraph::Node dst : *g) {
+    katana::PropertyGraph::Node prev_src = 0;
+    for (auto ie : g->in_edges(dst)) {
+      auto src = *g->GetInEdgeSource(ie);
+      auto e = g->InEdgeToOutEdge(ie);
+      KATANA_LOG_ASSERT(*g->GetEdgeDest(e) == dst);
+      KATANA_LOG_ASSERT(
+          *e >= *g->edges(src).begin() && *e < *g->edges(src).end());
+      KATANA_LOG_ASSERT(src >= prev_src);
+      prev_src = src;
+      mirrored[*e] += 1;
+    }
+  }
+  KATANA_LOG_ASSERT(std::all_of(
+      mirrored.begin(), mirrored.end(), [](int n) { return n == 1; }));
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/propertyfilegraph");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+
+  g->MarkAllPropertiesPersistent();
+  auto write_result = g->Write(rdg_dir, command_line);
+  if (!write_result) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", write_result.error());
+  }
+
+  auto make_result = katana::PropertyGraph::Make(rdg_dir);
+  fs::remove_all(rdg_dir);
+  if (!make_result) {
+    KATANA_LOG_FATAL("making result: {}", make_result.error());
+  }
+  std::unique_ptr<katana::PropertyGraph> g2 = std::move(make_result.value());
+
+  KATANA_LOG_ASSERT(g2->has_in_edges());
+  KATANA_LOG_ASSERT(g2->in_topology().Equals(g->in_topology()));
+
+  auto drop_result = g2->DropInEdges();
+  KATANA_LOG_ASSERT(drop_result);
+  KATANA_LOG_ASSERT(!g2->has_in_edges());
+}
+
+void
+TestWideTopology() {
+  constexpr size_t num_nodes = 10;
+  std::vector<uint64_t> indices;
+  std::vector<uint64_t> dests;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    dests.push_back((i + 1) % num_nodes);
+    dests.push_back((i + 2) % num_nodes);
+    indices.push_back(dests.size());
+  }
+
+  auto g = std::make_unique<katana::PropertyGraph>();
+  auto set_result = g->SetTopology(katana::WideGraphTopology{
+      .out_indices = std::static_pointer_cast<arrow::UInt64Array>(
+          katana::BuildArray(indices)),
+      .out_dests = std::static_pointer_cast<arrow::UInt64Array>(
+          katana::BuildArray(dests)),
+  });
+  KATANA_LOG_ASSERT(set_result);
+  KATANA_LOG_ASSERT(g->has_wide_node_ids());
+  KATANA_LOG_ASSERT(g->num_nodes() == num_nodes);
+  KATANA_LOG_ASSERT(g->num_edges() == dests.size());
+
+  using NodeData = std::tuple<>;
+  using EdgeData = std::tuple<>;
+  using Graph = katana::TypedPropertyGraph<NodeData, EdgeData>;
+  using WideGraph = katana::TypedPropertyGraph<NodeData, EdgeData, uint64_t>;
+
+  KATANA_LOG_ASSERT(!Graph::Make(g.get(), {}, {}));
+
+  auto wide_result = WideGraph::Make(g.get(), {}, {});
+  KATANA_LOG_ASSERT(wide_result);
+  WideGraph wide = wide_result.value();
+  for (WideGraph::Node n : wide) {
+    uint64_t expected = (n + 1) % num_nodes;
+    for (auto e : wide.edges(n)) {
+      KATANA_LOG_ASSERT(*wide.GetEdgeDest(e) == expected);
+      expected = (expected + 1) % num_nodes;
+    }
+  }
+
+  // The untyped accessors cover wide topologies whose ids fit in 32 bits
+  std::atomic<uint64_t> num_visited = 0;
+  std::atomic<uint64_t> num_mismatched = 0;
+  katana::do_all(katana::iterate(*g), [&](katana::PropertyGraph::Node n) {
+    num_visited.fetch_add(1);
+    uint64_t expected = (n + 1) % num_nodes;
+    for (auto e : g->edges(n)) {
+      if (*g->GetEdgeDest(e) != expected) {
+        num_mismatched.fetch_add(1);
+      }
+      expected = (expected + 1) % num_nodes;
+    }
+  });
+  KATANA_LOG_ASSERT(num_visited == num_nodes);
+  KATANA_LOG_ASSERT(num_mismatched == 0);
+
+  // A wide topology is written as a version 2 file; since its node ids fit
+  // in 32 bits, it is loaded back in the compact layout.
+  auto uri_res = katana::Uri::MakeRand("/tmp/propertyfilegraph");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+
+  auto write_result = g->Write(rdg_dir, command_line);
+  if (!write_result) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", write_result.error());
+  }
+
+  auto make_result = katana::PropertyGraph::Make(rdg_dir);
+  fs::remove_all(rdg_dir);
+  if (!make_result) {
+    KATANA_LOG_FATAL("making result: {}", make_result.error());
+  }
+  std::unique_ptr<katana::PropertyGraph> g2 = std::move(make_result.value());
+
+  KATANA_LOG_ASSERT(!g2->has_wide_node_ids());
+  KATANA_LOG_ASSERT(g2->num_nodes() == num_nodes);
+  KATANA_LOG_ASSERT(g2->num_edges() == dests.size());
+  for (katana::PropertyGraph::Node n : *g2) {
+    KATANA_LOG_ASSERT(g2->edges(n).size() == 2);
+    for (auto e : g2->edges(n)) {
+      KATANA_LOG_ASSERT(*g2->GetEdgeDest(e) == dests[*e]);
+    }
+  }
+}
 }  // namespace
 
 int
@@ -257,6 +404,8 @@ main(int argc, char** argv) {
   TestGarbageMetadata();
   TestSimplePGs();
   TestTopologyAccess();
+  TestInEdges();
+  TestWideTopology();
 
   return 0;
 }
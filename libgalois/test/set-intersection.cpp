@@ -0,0 +1,107 @@
+#include "katana/SetIntersection.h"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "katana/Logging.h"
+
+namespace {
+
+/// The largest range of values Check builds a bitmap for outside of the sets
+/// IntersectionBitmap::IsWorthwhile accepts
+constexpr uint32_t kMaxBitmapRange = 1 << 16;
+
+std::vector<uint32_t>
+MakeSet(std::mt19937& gen, uint64_t size, uint32_t max_value) {
+  std::uniform_int_distribution<uint32_t> dist(0, max_value);
+  std::vector<uint32_t> set;
+  for (uint64_t i = 0; i < size; ++i) {
+    set.emplace_back(dist(gen));
+  }
+  std::sort(set.begin(), set.end());
+  set.erase(std::unique(set.begin(), set.end()), set.end());
+  return set;
+}
+
+uint64_t
+Expected(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+  std::vector<uint32_t> out;
+  std::set_intersection(
+      a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+  return out.size();
+}
+
+void
+Check(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+  uint64_t expected = Expected(a, b);
+
+  uint64_t got =
+      katana::CountIntersection(a.data(), a.size(), b.data(), b.size());
+  KATANA_LOG_VASSERT(
+      got == expected, "sizes {} {}: expected {} found {}", a.size(), b.size(),
+      expected, got);
+
+  for (auto level :
+       {katana::SimdLevel::kScalar, katana::SimdLevel::kSSE2,
+        katana::SimdLevel::kAVX2, katana::SimdLevel::kAVX512}) {
+    if (level > katana::GetSimdLevel()) {
+      continue;
+    }
+    got = katana::CountIntersectionMerge(
+        a.data(), a.size(), b.data(), b.size(), level);
+    KATANA_LOG_VASSERT(
+        got == expected, "{} merge of sizes {} {}: expected {} found {}",
+        katana::SimdLevelName(level), a.size(), b.size(), expected, got);
+  }
+
+  got = katana::CountIntersectionGallop(a.data(), a.size(), b.data(), b.size());
+  KATANA_LOG_VASSERT(
+      got == expected, "gallop: expected {} found {}", expected, got);
+
+  // A bitmap spans the range of its values, so only build one where that
+  // stays small: for the sets it is meant for, and for small ranges to
+  // cover small and empty sets
+  if (!katana::IntersectionBitmap::IsWorthwhile(a.data(), a.size()) &&
+      !a.empty() && a.back() - a.front() > kMaxBitmapRange) {
+    return;
+  }
+  katana::IntersectionBitmap bitmap;
+  bitmap.Assign(a.data(), a.size());
+  got = bitmap.CountIntersection(b.data(), b.size());
+  KATANA_LOG_VASSERT(
+      got == expected, "bitmap: expected {} found {}", expected, got);
+}
+
+}  // namespace
+
+int
+main() {
+  std::mt19937 gen(42);
+
+  // Dense and sparse overlaps, sizes that are not multiples of any vector
+  // width and very skewed sizes
+  for (uint64_t a_size : {0, 1, 3, 7, 16, 33, 100, 1000}) {
+    for (uint64_t b_size : {0, 1, 5, 15, 64, 257, 5000}) {
+      for (uint32_t max_value : {UINT32_C(64), UINT32_C(5000), UINT32_MAX}) {
+        Check(MakeSet(gen, a_size, max_value), MakeSet(gen, b_size, max_value));
+      }
+    }
+  }
+
+  // Values at the ends of the range
+  Check({0, 1, UINT32_MAX - 1, UINT32_MAX}, {0, UINT32_MAX});
+  Check(
+      {UINT32_MAX - 100, UINT32_MAX - 1, UINT32_MAX},
+      {0, UINT32_MAX - 100, UINT32_MAX});
+
+  std::vector<uint32_t> hub(2000);
+  std::iota(hub.begin(), hub.end(), 100);
+  KATANA_LOG_ASSERT(
+      katana::IntersectionBitmap::IsWorthwhile(hub.data(), hub.size()));
+  Check(hub, MakeSet(gen, 500, 3000));
+
+  return 0;
+}
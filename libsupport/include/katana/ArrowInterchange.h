@@ -1,6 +1,7 @@
 #ifndef KATANA_LIBSUPPORT_KATANA_ARROWINTERCHANGE_H_
 #define KATANA_LIBSUPPORT_KATANA_ARROWINTERCHANGE_H_
 
+#include <arrow/memory_pool.h>
 #include <arrow/stl.h>
 #include <arrow/type_traits.h>
 
@@ -284,6 +285,16 @@ KATANA_EXPORT std::shared_ptr<arrow::Array> Unchunk(
 KATANA_EXPORT std::shared_ptr<arrow::ChunkedArray> Shuffle(
     const std::shared_ptr<arrow::ChunkedArray>& original);
 
+/// Return the pool that property data (loaded columns, analytics outputs) is
+/// allocated from. This is arrow::default_memory_pool() unless a pool has been
+/// installed with SetPropertyMemoryPool.
+KATANA_EXPORT arrow::MemoryPool* GetPropertyMemoryPool();
+
+/// Install pool as the property memory pool; nullptr restores the default.
+/// Buffers keep a pointer to the pool that allocated them, so pool must
+/// outlive every buffer allocated from it.
+KATANA_EXPORT void SetPropertyMemoryPool(arrow::MemoryPool* pool);
+
 }  // namespace katana
 
 #endif
@@ -0,0 +1,108 @@
+#ifndef KATANA_LIBSUPPORT_KATANA_TRACING_H_
+#define KATANA_LIBSUPPORT_KATANA_TRACING_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "katana/Result.h"
+#include "katana/config.h"
+
+/// \file Tracing.h
+///
+/// Tracing records a timeline of the intervals spent in parallel loops,
+/// StatTimers and storage requests, per thread, and writes it in the Chrome
+/// trace-event format understood by chrome://tracing and the Perfetto UI.
+///
+/// Tracing is off by default. SharedMemSys starts it when the environment
+/// variable KATANA_TRACE_FILE names an output file and writes the trace when it
+/// is destroyed.
+///
+/// Each thread appends events to its own buffer without taking locks. Events
+/// are only read when the trace is written, so recording costs little more
+/// than reading the clock twice per interval.
+
+namespace katana {
+
+namespace internal {
+
+KATANA_EXPORT extern std::atomic<bool> tracing_enabled;
+
+}  // namespace internal
+
+/// Return true if events are being recorded
+inline bool
+IsTracing() {
+  return internal::tracing_enabled.load(std::memory_order_relaxed);
+}
+
+/// Start recording events. They are written to path by StopTracing.
+KATANA_EXPORT void StartTracing(const std::string& path);
+
+/// Stop recording events and write every event recorded so far to the path
+/// given to StartTracing. Intervals that are still open are not written, so
+/// this should be called once parallel loops and I/O have finished.
+KATANA_EXPORT Result<void> StopTracing();
+
+/// Name the calling thread in the trace. The name applies to events the
+/// thread records from now on.
+KATANA_EXPORT void SetTraceThreadName(const std::string& name);
+
+/// The current time on the trace clock in nanoseconds
+KATANA_EXPORT int64_t TraceNow();
+
+/// Record that the calling thread spent [begin_ns, end_ns) in name. category
+/// must be a string literal. args, if not empty, is the body of a JSON object
+/// that is attached to the event, e.g., "\"bytes\": 4096".
+KATANA_EXPORT void TraceInterval(
+    const char* category, const std::string& name, int64_t begin_ns,
+    int64_t end_ns, const std::string& args = std::string());
+
+/// TraceScope records the interval from its construction to its destruction
+/// if tracing was on when it was constructed.
+class TraceScope {
+public:
+  /// category must be a string literal and name must outlive the scope. If
+  /// name is null, nothing is recorded.
+  TraceScope(const char* category, const char* name)
+      : category_(category), name_(name) {
+    if (name && IsTracing()) {
+      begin_ns_ = TraceNow();
+    }
+  }
+
+  ~TraceScope() {
+    if (begin_ns_ >= 0) {
+      TraceInterval(category_, name_, begin_ns_, TraceNow(), args_);
+    }
+  }
+
+  /// Attach a numeric argument to the event
+  void AddArg(const char* key, int64_t value) {
+    if (begin_ns_ < 0) {
+      return;
+    }
+    if (!args_.empty()) {
+      args_ += ", ";
+    }
+    args_ += "\"";
+    args_ += key;
+    args_ += "\": ";
+    args_ += std::to_string(value);
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+  TraceScope(TraceScope&&) = delete;
+  TraceScope& operator=(TraceScope&&) = delete;
+
+private:
+  const char* category_;
+  const char* name_;
+  int64_t begin_ns_{-1};
+  std::string args_;
+};
+
+}  // namespace katana
+
+#endif
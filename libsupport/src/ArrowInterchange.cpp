@@ -1,10 +1,14 @@
 #include "katana/ArrowInterchange.h"
 
+#include <atomic>
 #include <numeric>
 
 #include "katana/Random.h"
 
 namespace {
+
+std::atomic<arrow::MemoryPool*> property_memory_pool{nullptr};
+
 std::shared_ptr<arrow::ChunkedArray>
 IndexedTake(
     const std::shared_ptr<arrow::ChunkedArray>& original,
@@ -57,3 +61,14 @@ katana::Shuffle(const std::shared_ptr<arrow::ChunkedArray>& original) {
   KATANA_LOG_ASSERT(res.ok());
   return IndexedTake(original, indices);
 }
+
+arrow::MemoryPool*
+katana::GetPropertyMemoryPool() {
+  arrow::MemoryPool* pool = property_memory_pool.load();
+  return pool ? pool : arrow::default_memory_pool();
+}
+
+void
+katana::SetPropertyMemoryPool(arrow::MemoryPool* pool) {
+  property_memory_pool = pool;
+}
@@ -0,0 +1,245 @@
+#include "katana/Tracing.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include "katana/Logging.h"
+
+std::atomic<bool> katana::internal::tracing_enabled{false};
+
+namespace {
+
+struct Event {
+  const char* category{nullptr};
+  std::string name;
+  int64_t begin_ns{0};
+  int64_t end_ns{0};
+  std::string args;
+};
+
+/// Chunk is a block of events. Only the owning thread appends to a chunk and
+/// it publishes each event by incrementing size, so the writer of the trace
+/// may read events [0, size) while the owner keeps appending.
+struct Chunk {
+  static constexpr size_t kCapacity = 256;
+
+  std::array<Event, kCapacity> events;
+  std::atomic<size_t> size{0};
+  std::atomic<Chunk*> next{nullptr};
+};
+
+/// ThreadBuffer is the list of chunks of one thread. The owning thread only
+/// touches tail; the writer of the trace only touches head and consumed, and
+/// frees chunks once they are full and written.
+struct ThreadBuffer {
+  explicit ThreadBuffer(uint32_t tid_)
+      : tid(tid_), head(new Chunk()), tail(head) {}
+
+  ~ThreadBuffer() {
+    while (head) {
+      Chunk* next = head->next.load();
+      delete head;
+      head = next;
+    }
+  }
+
+  ThreadBuffer(const ThreadBuffer&) = delete;
+  ThreadBuffer& operator=(const ThreadBuffer&) = delete;
+  ThreadBuffer(ThreadBuffer&&) = delete;
+  ThreadBuffer& operator=(ThreadBuffer&&) = delete;
+
+  void Append(Event&& event) {
+    size_t size = tail->size.load(std::memory_order_relaxed);
+    if (size == Chunk::kCapacity) {
+      auto* chunk = new Chunk();
+      tail->next.store(chunk, std::memory_order_release);
+      tail = chunk;
+      size = 0;
+    }
+    tail->events[size] = std::move(event);
+    tail->size.store(size + 1, std::memory_order_release);
+  }
+
+  const uint32_t tid;
+  /// Guarded by the registry mutex
+  std::string name;
+  Chunk* head;
+  size_t consumed{0};
+  Chunk* tail;
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  uint32_t next_tid{1};
+  std::string path;
+};
+
+/// The registry is never destroyed so that threads that exit after static
+/// destruction can still release their buffers
+Registry&
+GetRegistry() {
+  static auto* registry = new Registry();
+  return *registry;
+}
+
+struct ThreadState {
+  std::shared_ptr<ThreadBuffer> buffer;
+  std::string name;
+};
+
+thread_local ThreadState thread_state;
+
+ThreadBuffer&
+LocalBuffer() {
+  if (!thread_state.buffer) {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    thread_state.buffer = std::make_shared<ThreadBuffer>(registry.next_tid++);
+    thread_state.buffer->name = thread_state.name;
+    registry.buffers.emplace_back(thread_state.buffer);
+  }
+  return *thread_state.buffer;
+}
+
+std::string
+Quote(const std::string& str) {
+  return nlohmann::json(str).dump(
+      -1, ' ', false, nlohmann::json::error_handler_t::replace);
+}
+
+void
+WriteEvent(FILE* out, int pid, uint32_t tid, const Event& event) {
+  fmt::print(
+      out,
+      ",\n{{\"ph\": \"X\", \"cat\": \"{}\", \"name\": {}, \"pid\": {}, "
+      "\"tid\": {}, \"ts\": {:.3f}, \"dur\": {:.3f}, \"args\": {{{}}}}}",
+      event.category, Quote(event.name), pid, tid, event.begin_ns / 1000.0,
+      (event.end_ns - event.begin_ns) / 1000.0, event.args);
+}
+
+/// Write the events of buffer that have not been written yet and free the
+/// chunks that have been filled
+void
+WriteBuffer(FILE* out, int pid, ThreadBuffer* buffer) {
+  if (!buffer->name.empty()) {
+    fmt::print(
+        out,
+        ",\n{{\"ph\": \"M\", \"name\": \"thread_name\", \"pid\": {}, "
+        "\"tid\": {}, \"args\": {{\"name\": {}}}}}",
+        pid, buffer->tid, Quote(buffer->name));
+  }
+  for (;;) {
+    Chunk* chunk = buffer->head;
+    // Load next before size: if next is set, the chunk is already full
+    Chunk* next = chunk->next.load(std::memory_order_acquire);
+    size_t size = chunk->size.load(std::memory_order_acquire);
+    for (size_t i = buffer->consumed; i < size; ++i) {
+      WriteEvent(out, pid, buffer->tid, chunk->events[i]);
+    }
+    buffer->consumed = size;
+    if (!next) {
+      return;
+    }
+    delete chunk;
+    buffer->head = next;
+    buffer->consumed = 0;
+  }
+}
+
+}  // namespace
+
+int64_t
+katana::TraceNow() {
+  static const auto epoch = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - epoch)
+      .count();
+}
+
+void
+katana::StartTracing(const std::string& path) {
+  Registry& registry = GetRegistry();
+  {
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.path = path;
+  }
+  // Fix the epoch before any event is recorded
+  TraceNow();
+  internal::tracing_enabled = true;
+}
+
+katana::Result<void>
+katana::StopTracing() {
+  internal::tracing_enabled = false;
+
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  FILE* out = std::fopen(registry.path.c_str(), "w");
+  if (!out) {
+    auto err = katana::ResultErrno();
+    KATANA_LOG_DEBUG("cannot open {}: {}", registry.path, err.message());
+    return err;
+  }
+
+  int pid = getpid();
+  fmt::print(
+      out,
+      "{{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n"
+      "{{\"ph\": \"M\", \"name\": \"process_name\", \"pid\": {}, "
+      "\"tid\": 0, \"args\": {{\"name\": \"katana\"}}}}",
+      pid);
+  for (const auto& buffer : registry.buffers) {
+    WriteBuffer(out, pid, buffer.get());
+  }
+  fmt::print(out, "\n]}}\n");
+
+  // Threads that have exited will not record anything more
+  auto& buffers = registry.buffers;
+  buffers.erase(
+      std::remove_if(
+          buffers.begin(), buffers.end(),
+          [](const auto& buffer) { return buffer.use_count() == 1; }),
+      buffers.end());
+
+  if (std::fclose(out) != 0) {
+    auto err = katana::ResultErrno();
+    KATANA_LOG_DEBUG("cannot write {}: {}", registry.path, err.message());
+    return err;
+  }
+  return katana::ResultSuccess();
+}
+
+void
+katana::SetTraceThreadName(const std::string& name) {
+  thread_state.name = name;
+  if (thread_state.buffer) {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    thread_state.buffer->name = name;
+  }
+}
+
+void
+katana::TraceInterval(
+    const char* category, const std::string& name, int64_t begin_ns,
+    int64_t end_ns, const std::string& args) {
+  Event event;
+  event.category = category;
+  event.name = name;
+  event.begin_ns = begin_ns;
+  event.end_ns = end_ns;
+  event.args = args;
+  LocalBuffer().Append(std::move(event));
+}
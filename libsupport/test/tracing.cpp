@@ -0,0 +1,128 @@
+#include "katana/Tracing.h"
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "katana/Logging.h"
+#include "katana/Uri.h"
+
+namespace {
+
+constexpr int kNumThreads = 4;
+// More than fit in one chunk of a thread buffer
+constexpr int kNumEvents = 1000;
+
+nlohmann::json
+ReadTrace(const std::string& path) {
+  std::ifstream in(path);
+  KATANA_LOG_ASSERT(in);
+  return nlohmann::json::parse(in);
+}
+
+void
+TestThreads(const std::string& path) {
+  katana::StartTracing(path);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([t] {
+      katana::SetTraceThreadName("worker " + std::to_string(t));
+      for (int i = 0; i < kNumEvents; ++i) {
+        katana::TraceScope outer("test", "outer");
+        outer.AddArg("iteration", i);
+        katana::TraceScope inner("test", "inner");
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  auto res = katana::StopTracing();
+  KATANA_LOG_VASSERT(res, "writing trace: {}", res.error());
+
+  // Recorded while tracing is off
+  { katana::TraceScope ignored("test", "ignored"); }
+
+  nlohmann::json trace = ReadTrace(path);
+  std::map<uint32_t, std::string> names;
+  std::map<std::string, int> counts;
+  std::map<uint32_t, double> last_outer;
+  for (const auto& event : trace["traceEvents"]) {
+    if (event["ph"] == "M") {
+      if (event["name"] == "thread_name") {
+        names[event["tid"]] = event["args"]["name"];
+      }
+      continue;
+    }
+    KATANA_LOG_ASSERT(event["ph"] == "X");
+    KATANA_LOG_ASSERT(event["cat"] == "test");
+    KATANA_LOG_ASSERT(event["dur"].get<double>() >= 0);
+    std::string name = event["name"];
+    counts[name] += 1;
+
+    uint32_t tid = event["tid"];
+    double ts = event["ts"];
+    if (name == "outer") {
+      // Events of one thread are written in the order they ended
+      KATANA_LOG_ASSERT(ts >= last_outer[tid]);
+      last_outer[tid] = ts;
+      KATANA_LOG_ASSERT(event["args"].contains("iteration"));
+    } else {
+      KATANA_LOG_ASSERT(event["args"].empty());
+    }
+  }
+
+  KATANA_LOG_ASSERT(counts["outer"] == kNumThreads * kNumEvents);
+  KATANA_LOG_ASSERT(counts["inner"] == kNumThreads * kNumEvents);
+  KATANA_LOG_ASSERT(counts.count("ignored") == 0);
+  KATANA_LOG_ASSERT(last_outer.size() == kNumThreads);
+  for (const auto& [tid, ts] : last_outer) {
+    KATANA_LOG_VASSERT(
+        names[tid].rfind("worker ", 0) == 0, "thread {} is unnamed", tid);
+  }
+}
+
+void
+TestRestart(const std::string& path) {
+  katana::StartTracing(path);
+  katana::TraceInterval("test", "explicit", 1000, 3000, "\"bytes\": 7");
+  auto res = katana::StopTracing();
+  KATANA_LOG_ASSERT(res);
+
+  // Only events recorded since the last trace was written are written
+  nlohmann::json trace = ReadTrace(path);
+  int num_intervals = 0;
+  for (const auto& event : trace["traceEvents"]) {
+    if (event["ph"] != "X") {
+      continue;
+    }
+    ++num_intervals;
+    KATANA_LOG_ASSERT(event["name"] == "explicit");
+    KATANA_LOG_ASSERT(event["ts"].get<double>() == 1.0);
+    KATANA_LOG_ASSERT(event["dur"].get<double>() == 2.0);
+    KATANA_LOG_ASSERT(event["args"]["bytes"] == 7);
+  }
+  KATANA_LOG_ASSERT(num_intervals == 1);
+}
+
+}  // namespace
+
+int
+main() {
+  auto uri_res = katana::Uri::MakeRand("/tmp/tracing");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string path(uri_res.value().path());  // path because local
+
+  TestThreads(path);
+  TestRestart(path);
+
+  std::remove(path.c_str());
+  return 0;
+}
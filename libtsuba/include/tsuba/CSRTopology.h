@@ -26,6 +26,20 @@ struct CSRTopologyPrefix {
   uint64_t out_indexes[];  // NOLINT needed for layout
 };
 
+/// The metadata block at the head of every compressed CSR file. The version
+/// of compressed files is kCompressedCSRTopologyVersion, which no
+/// uncompressed file uses. See katana::CompressedGraphTopology for the
+/// layout of the rest of the file.
+struct CompressedCSRTopologyHeader {
+  uint64_t version{0};
+  uint64_t block_size{0};
+  uint64_t num_nodes{0};
+  uint64_t num_edges{0};
+  uint64_t num_code_bytes{0};
+};
+
+constexpr uint64_t kCompressedCSRTopologyVersion = 3;
+
 constexpr uint64_t
 CSRTopologyFileSize(const CSRTopologyHeader& header) {
   uint64_t edge_size =
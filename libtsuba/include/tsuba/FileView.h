@@ -14,12 +14,45 @@
 namespace tsuba {
 
 class KATANA_EXPORT FileView : public arrow::io::RandomAccessFile {
+public:
+  /// Advice about how a FileView will be read, in the spirit of madvise(2)
+  enum class AccessPattern {
+    /// Detect sequential, strided and random reads and prefetch accordingly
+    kAdaptive,
+    /// Always read ahead, growing the window as reads continue
+    kSequential,
+    /// Never read ahead; only fetch what is read or hinted with WillNeed
+    kRandom,
+  };
+
+  struct Stats {
+    /// Bytes requested from storage, on demand or speculatively
+    uint64_t bytes_fetched{0};
+    /// Bytes requested by read-ahead or WillNeed
+    uint64_t bytes_prefetched{0};
+    /// Speculatively fetched bytes that no Read has used so far plus bytes
+    /// that were fetched more than once
+    uint64_t bytes_wasted{0};
+    /// Time spent blocked on outstanding fetches
+    uint64_t stall_ns{0};
+    uint64_t num_fetches{0};
+  };
+
+private:
   struct FillingRange {
     uint64_t first_page;
     uint64_t last_page;
     std::future<katana::Result<void>> work;
   };
 
+  struct ReadAhead {
+    AccessPattern pattern{AccessPattern::kAdaptive};
+    int64_t last_start{-1};
+    int64_t last_end{-1};
+    int64_t stride{0};
+    int64_t window{0};
+  };
+
   uint8_t* map_start_{nullptr};
   int64_t file_size_{0};
   uint8_t page_shift_{0};
@@ -29,6 +62,10 @@ class KATANA_EXPORT FileView : public arrow::io::RandomAccessFile {
   bool valid_{false};
   std::vector<uint64_t> filling_;
   std::unique_ptr<std::vector<FillingRange>> fetches_;
+  // pages fetched speculatively that no Read has touched yet
+  std::vector<uint64_t> speculative_;
+  ReadAhead read_ahead_;
+  Stats stats_;
 
 public:
   FileView() = default;
@@ -44,7 +81,10 @@ public:
         filename_(std::move(other.filename_)),
         valid_(other.valid_),
         filling_(std::move(other.filling_)),
-        fetches_(std::move(other.fetches_)) {
+        fetches_(std::move(other.fetches_)),
+        speculative_(std::move(other.speculative_)),
+        read_ahead_(other.read_ahead_),
+        stats_(other.stats_) {
     other.valid_ = false;
   }
 
@@ -63,6 +103,9 @@ public:
       filling_ = std::move(other.filling_);
       fetches_ =
           std::unique_ptr<std::vector<FillingRange>>(std::move(other.fetches_));
+      speculative_ = std::move(other.speculative_);
+      read_ahead_ = other.read_ahead_;
+      stats_ = other.stats_;
       other.valid_ = false;
     }
     return *this;
@@ -92,6 +135,18 @@ public:
 
   katana::Result<void> Fill(uint64_t begin, uint64_t end, bool resolve);
 
+  /// Tell the FileView that the bytes [begin, end) will be read soon so it can
+  /// start fetching them in the background. Hinted bytes are accounted as
+  /// prefetched in stats().
+  katana::Result<void> WillNeed(uint64_t begin, uint64_t end);
+
+  /// Set the read-ahead policy used by Read; the default is
+  /// AccessPattern::kAdaptive.
+  void Advise(AccessPattern pattern);
+
+  /// Counters describing how well fetches matched reads since Bind
+  Stats stats() const;
+
   bool Valid() const { return valid_; }
 
   katana::Result<void> Unbind();
@@ -144,7 +199,13 @@ public:
 
 private:
   // Given the size of some region, how many pages does it take up?
-  uint64_t page_number(uint64_t size);
+  uint64_t page_number(uint64_t size) const;
+
+  katana::Result<void> DoFill(
+      uint64_t begin, uint64_t end, bool resolve, bool speculative);
+
+  // Note that the bytes [start, start + size) have been used by a Read
+  void MarkRead(int64_t start, int64_t size);
 
   // helper functions for MustFill
   /// These functions do not validate their input. In particular, if
@@ -167,7 +228,9 @@ private:
   katana::Result<void> Resolve(int64_t start, int64_t size);
 
   // Start asynchronously fetching data that we think we might need from storage
-  // @start and @size give the location and range of the previous read
+  // @start and @size give the location and range of the previous read. The
+  // amount fetched depends on the access pattern observed so far (see
+  // ReadAhead).
   katana::Result<void> PreFetch(int64_t start, int64_t size);
 };
 }  // namespace tsuba
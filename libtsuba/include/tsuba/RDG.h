@@ -43,11 +43,13 @@ public:
   bool Equals(const RDG& other) const;
 
   /// Store this RDG at \param handle; if \param ff is not null, it is persisted
-  /// as the topology for this RDG. Add \param command_line to metadata to aid
-  /// in tracking lineage
+  /// as the topology for this RDG. Likewise, if \param in_ff is not null, it is
+  /// persisted as the in-edge topology. Add \param command_line to metadata to
+  /// aid in tracking lineage
   katana::Result<void> Store(
       RDGHandle handle, const std::string& command_line,
-      std::unique_ptr<FileFrame> ff = nullptr);
+      std::unique_ptr<FileFrame> ff = nullptr,
+      std::unique_ptr<FileFrame> in_ff = nullptr);
 
   katana::Result<void> AddNodeProperties(
       const std::shared_ptr<arrow::Table>& props);
@@ -86,6 +88,10 @@ public:
 
   katana::Result<void> UnbindTopologyFileStorage();
 
+  /// Forget the in-edge topology of this RDG, if any; it will not be
+  /// persisted by the next Store unless a new one is provided
+  katana::Result<void> DropInTopologyFile();
+
   /// Inform this RDG that it's topology is in storage at this location
   /// without loading it into memory. \param new_top must exist and be in
   /// the correct directory for this RDG
@@ -145,6 +151,9 @@ public:
 
   const FileView& topology_file_storage() const;
 
+  /// The in-edge topology; not Valid() if this RDG has none in storage
+  const FileView& in_topology_file_storage() const;
+
 private:
   RDG(std::unique_ptr<RDGCore>&& core);
 
@@ -1,7 +1,11 @@
 #include "AddProperties.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include <arrow/chunked_array.h>
 
+#include "katana/ArrowInterchange.h"
 #include "tsuba/Errors.h"
 #include "tsuba/FileView.h"
 
@@ -67,29 +71,74 @@ HandleBadParquetTypes(std::shared_ptr<arrow::ChunkedArray> old_array) {
   }
 }
 
+/// Tell fv which column chunks the reader is about to read so that they are
+/// fetched in the background while earlier ones are decoded
+katana::Result<void>
+WillNeedRowGroups(
+    tsuba::FileView* fv, const parquet::FileMetaData& md,
+    const std::vector<int>& row_groups) {
+  for (int rg : row_groups) {
+    auto rg_md = md.RowGroup(rg);
+    for (int i = 0, n = rg_md->num_columns(); i < n; ++i) {
+      auto col_md = rg_md->ColumnChunk(i);
+      int64_t begin = col_md->data_page_offset();
+      if (col_md->has_dictionary_page() &&
+          col_md->dictionary_page_offset() > 0) {
+        begin = std::min(begin, col_md->dictionary_page_offset());
+      }
+      int64_t end = begin + col_md->total_compressed_size();
+      if (auto res = fv->WillNeed(begin, end); !res) {
+        return res.error();
+      }
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+void
+LogFetchStats(const tsuba::FileView& fv, const katana::Uri& file_path) {
+  tsuba::FileView::Stats stats = fv.stats();
+  KATANA_LOG_DEBUG(
+      "{}: fetched {} bytes in {} requests, {} prefetched, {} wasted, "
+      "stalled {} ms",
+      file_path, stats.bytes_fetched, stats.num_fetches, stats.bytes_prefetched,
+      stats.bytes_wasted, stats.stall_ns / 1000000);
+}
+
 Result<std::shared_ptr<arrow::Table>>
 DoLoadProperties(
     const std::string& expected_name, const katana::Uri& file_path) {
+  // Only the footer is read synchronously; the column chunks it describes are
+  // requested up front with WillNeed
   auto fv = std::make_shared<tsuba::FileView>(tsuba::FileView());
-  if (auto res = fv->Bind(file_path.string(), false); !res) {
+  if (auto res = fv->Bind(file_path.string(), 0, 0, false); !res) {
     return res.error();
   }
 
   std::unique_ptr<parquet::arrow::FileReader> reader;
 
   auto open_file_result =
-      parquet::arrow::OpenFile(fv, arrow::default_memory_pool(), &reader);
+      parquet::arrow::OpenFile(fv, katana::GetPropertyMemoryPool(), &reader);
   if (!open_file_result.ok()) {
     KATANA_LOG_DEBUG("arrow error: {}", open_file_result);
     return tsuba::ErrorCode::ArrowError;
   }
 
+  std::vector<int> row_groups(reader->num_row_groups());
+  std::iota(row_groups.begin(), row_groups.end(), 0);
+  if (auto res = WillNeedRowGroups(
+          fv.get(), *reader->parquet_reader()->metadata(), row_groups);
+      !res) {
+    return res.error();
+  }
+
   std::shared_ptr<arrow::Table> out;
   auto read_result = reader->ReadTable(&out);
   if (!read_result.ok()) {
     KATANA_LOG_DEBUG("arrow error: {}", read_result);
     return tsuba::ErrorCode::ArrowError;
   }
+  LogFetchStats(*fv, file_path);
 
   auto fixed_column_res = HandleBadParquetTypes(out->column(0));
   if (!fixed_column_res) {
@@ -108,7 +157,7 @@ DoLoadProperties(
   // combined into a single chunk due to the fact the offset type for these
   // columns is int32_t and thus the maximum size of an arrow::Array for these
   // types is 2^31.
-  auto combine_result = out->CombineChunks(arrow::default_memory_pool());
+  auto combine_result = out->CombineChunks(katana::GetPropertyMemoryPool());
   if (!combine_result.ok()) {
     KATANA_LOG_DEBUG("arrow error: {}", combine_result.status());
     return tsuba::ErrorCode::ArrowError;
@@ -134,20 +183,16 @@ DoLoadProperties(
 
 Result<std::shared_ptr<arrow::Table>>
 DoLoadPropertySlice(
-    const std::string& expected_name, const katana::Uri& file_path,
+    const std::string& expected_name, std::shared_ptr<tsuba::FileView> fv,
     int64_t offset, int64_t length) {
   if (offset < 0 || length < 0) {
     return tsuba::ErrorCode::InvalidArgument;
   }
-  auto fv = std::make_shared<tsuba::FileView>(tsuba::FileView());
-  if (auto res = fv->Bind(file_path.string(), 0, 0, false); !res) {
-    return res.error();
-  }
 
   std::unique_ptr<parquet::arrow::FileReader> reader;
 
   auto open_file_result =
-      parquet::arrow::OpenFile(fv, arrow::default_memory_pool(), &reader);
+      parquet::arrow::OpenFile(fv, katana::GetPropertyMemoryPool(), &reader);
   if (!open_file_result.ok()) {
     KATANA_LOG_DEBUG("arrow error: {}", open_file_result);
     return tsuba::ErrorCode::ArrowError;
@@ -157,26 +202,26 @@ DoLoadPropertySlice(
   int rg_count = reader->num_row_groups();
   int64_t row_offset = 0;
   int64_t cumulative_rows = 0;
-  int64_t file_offset = 0;
-  int64_t cumulative_bytes = 0;
   for (int i = 0; cumulative_rows < offset + length && i < rg_count; ++i) {
     auto rg_md = reader->parquet_reader()->metadata()->RowGroup(i);
     int64_t new_rows = rg_md->num_rows();
-    int64_t new_bytes = rg_md->total_byte_size();
     if (offset < cumulative_rows + new_rows) {
       if (row_groups.empty()) {
         row_offset = offset - cumulative_rows;
-        file_offset = cumulative_bytes;
       }
       row_groups.push_back(i);
     }
     cumulative_rows += new_rows;
-    cumulative_bytes += new_bytes;
   }
 
-  if (auto res = fv->Fill(file_offset, cumulative_bytes, false); !res) {
+  if (auto res = WillNeedRowGroups(
+          fv.get(), *reader->parquet_reader()->metadata(), row_groups);
+      !res) {
     return res.error();
   }
+  // Every read below is covered by a hint, so read-ahead would only fetch
+  // row groups outside of the slice
+  fv->Advise(tsuba::FileView::AccessPattern::kRandom);
 
   std::shared_ptr<arrow::Table> out;
   auto read_result = reader->ReadRowGroups(row_groups, &out);
@@ -185,7 +230,7 @@ DoLoadPropertySlice(
     return tsuba::ErrorCode::ArrowError;
   }
 
-  auto combine_result = out->CombineChunks(arrow::default_memory_pool());
+  auto combine_result = out->CombineChunks(katana::GetPropertyMemoryPool());
   if (!combine_result.ok()) {
     KATANA_LOG_DEBUG("arrow error: {}", combine_result.status());
     return tsuba::ErrorCode::ArrowError;
@@ -209,6 +254,21 @@ DoLoadPropertySlice(
   return out->Slice(row_offset, length);
 }
 
+Result<std::shared_ptr<arrow::Table>>
+DoLoadPropertySlice(
+    const std::string& expected_name, const katana::Uri& file_path,
+    int64_t offset, int64_t length) {
+  auto fv = std::make_shared<tsuba::FileView>(tsuba::FileView());
+  if (auto res = fv->Bind(file_path.string(), 0, 0, false); !res) {
+    return res.error();
+  }
+  auto res = DoLoadPropertySlice(expected_name, fv, offset, length);
+  if (res) {
+    LogFetchStats(*fv, file_path);
+  }
+  return res;
+}
+
 }  // namespace
 
 Result<std::shared_ptr<arrow::Table>>
@@ -233,3 +293,15 @@ tsuba::LoadPropertySlice(
     return ErrorCode::ArrowError;
   }
 }
+
+katana::Result<std::shared_ptr<arrow::Table>>
+tsuba::LoadPropertySlice(
+    const std::string& expected_name, std::shared_ptr<FileView> fv,
+    int64_t offset, int64_t length) {
+  try {
+    return DoLoadPropertySlice(expected_name, std::move(fv), offset, length);
+  } catch (const std::exception& exp) {
+    KATANA_LOG_DEBUG("arrow exception: {}", exp.what());
+    return ErrorCode::ArrowError;
+  }
+}
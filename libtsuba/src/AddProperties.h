@@ -6,6 +6,7 @@
 #include "RDGPartHeader.h"
 #include "katana/Result.h"
 #include "katana/Uri.h"
+#include "tsuba/FileView.h"
 
 namespace tsuba {
 
@@ -16,6 +17,12 @@ KATANA_EXPORT katana::Result<std::shared_ptr<arrow::Table>> LoadPropertySlice(
     const std::string& expected_name, const katana::Uri& file_path,
     int64_t offset, int64_t length);
 
+/// Like LoadPropertySlice above but reads from a FileView the caller has
+/// already bound, so that its fetch statistics can be inspected afterwards
+KATANA_EXPORT katana::Result<std::shared_ptr<arrow::Table>> LoadPropertySlice(
+    const std::string& expected_name, std::shared_ptr<FileView> fv,
+    int64_t offset, int64_t length);
+
 template <typename AddFn>
 katana::Result<void>
 AddProperties(
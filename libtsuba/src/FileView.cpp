@@ -3,12 +3,14 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <string>
 
 #include "katana/Logging.h"
 #include "katana/Result.h"
+#include "katana/Tracing.h"
 #include "tsuba/Errors.h"
 #include "tsuba/file.h"
 
@@ -30,6 +32,35 @@
  * somehow and also tell users to not modify our files?
  */
 
+namespace {
+
+// Page sizes range from 64K for small files to 1M for large ones, aiming for
+// about 1024 pages per file
+constexpr uint8_t kMinPageShift = 16;
+constexpr uint8_t kMaxPageShift = 20;
+constexpr uint8_t kPagesPerFileShift = 10;
+
+// Upper bound on the sequential read-ahead window
+constexpr int64_t kMaxReadAhead = INT64_C(64) << 20;
+
+uint8_t
+PageShift(uint64_t file_size) {
+  uint8_t shift = kMinPageShift;
+  while (shift < kMaxPageShift &&
+         (file_size >> (shift + kPagesPerFileShift)) > 0) {
+    ++shift;
+  }
+  return shift;
+}
+
+// filling_ stores page i at bit (63 - i % 64) of word i / 64
+bool
+IsFilled(const std::vector<uint64_t>& bitmap, uint64_t page) {
+  return bitmap[page / 64] & (UINT64_C(1) << (63 - page % 64));
+}
+
+}  // namespace
+
 namespace tsuba {
 
 FileView::~FileView() {
@@ -70,12 +101,6 @@ FileView::Bind(
     return ErrorCode::InvalidArgument;
   }
 
-  // SCB 2020-07-23: Given that page_shift_ is treated as a compile-time
-  // constant, it seems silly to have it be a member of this class. But I can
-  // imagine one day wanting to set it dynamically based on file type, file
-  // size, type of backing storage, etc. So make it a class member and set it
-  // here.
-  page_shift_ = 20; /* 1M */
   void* tmp = nullptr;
 
   // Map enough virtual memory to hold entire file, but do not populate it
@@ -91,9 +116,13 @@ FileView::Bind(
 
   map_start_ = static_cast<uint8_t*>(tmp);
   mem_start_ = -1;
-  filling_.resize(page_number(buf.size) / 64 + 1, 0);
+  page_shift_ = PageShift(buf.size);
+  filling_.assign(page_number(buf.size) / 64 + 1, 0);
+  speculative_.assign(filling_.size(), 0);
   file_size_ = buf.size;
   fetches_ = std::make_unique<std::vector<FillingRange>>();
+  read_ahead_ = ReadAhead{.pattern = read_ahead_.pattern};
+  stats_ = Stats{};
   if (auto res = Fill(begin, in_end, resolve); !res) {
     return res.error();
   }
@@ -105,6 +134,41 @@ FileView::Bind(
 
 katana::Result<void>
 FileView::Fill(uint64_t begin, uint64_t end, bool resolve) {
+  return DoFill(begin, end, resolve, false);
+}
+
+katana::Result<void>
+FileView::WillNeed(uint64_t begin, uint64_t end) {
+  if (!valid_) {
+    return ErrorCode::InvalidArgument;
+  }
+  return DoFill(begin, end, false, true);
+}
+
+void
+FileView::Advise(AccessPattern pattern) {
+  read_ahead_.pattern = pattern;
+  read_ahead_.window = 0;
+}
+
+FileView::Stats
+FileView::stats() const {
+  Stats ret = stats_;
+  uint64_t page_size = UINT64_C(1) << page_shift_;
+  for (size_t i = 0; i < speculative_.size(); ++i) {
+    for (uint64_t bits = speculative_[i]; bits; bits &= bits - 1) {
+      uint64_t page = i * 64 + __builtin_ctzll(bits);
+      uint64_t page_begin = page * page_size;
+      ret.bytes_wasted +=
+          std::min(page_size, static_cast<uint64_t>(file_size_) - page_begin);
+    }
+  }
+  return ret;
+}
+
+katana::Result<void>
+FileView::DoFill(
+    uint64_t begin, uint64_t end, bool resolve, bool speculative) {
   uint64_t in_end = std::min<uint64_t>(end, file_size_);
   uint64_t in_begin = std::min<uint64_t>(begin, in_end);
   uint64_t first_page = 0;
@@ -119,8 +183,10 @@ FileView::Fill(uint64_t begin, uint64_t end, bool resolve) {
   }
   // Gracefully handle the fill zero case here to simplify Bind
   if (in_end != in_begin) {
-    if (auto opt =
-            MustFill(&filling_[0], page_number(in_begin), page_number(in_end));
+    // in_end is exclusive; a range ending on a page boundary does not need
+    // the page that starts there
+    if (auto opt = MustFill(
+            &filling_[0], page_number(in_begin), page_number(in_end - 1));
         opt.has_value()) {
       std::tie(first_page, last_page) = opt.value();
       found_empty = true;
@@ -131,6 +197,23 @@ FileView::Fill(uint64_t begin, uint64_t end, bool resolve) {
         (last_page + 1) * (1UL << page_shift_) - file_off,
         file_size_ - file_off);
     if (found_empty) {
+      uint64_t page_size = UINT64_C(1) << page_shift_;
+      for (uint64_t page = first_page; page <= last_page; ++page) {
+        uint64_t page_bytes =
+            std::min(page_size, file_off + map_size - page * page_size);
+        if (IsFilled(filling_, page)) {
+          // MustFill returns a span that may cover pages we already have
+          stats_.bytes_wasted += page_bytes;
+        } else if (speculative) {
+          speculative_[page / 64] |= UINT64_C(1) << (page % 64);
+        }
+      }
+      stats_.bytes_fetched += map_size;
+      stats_.num_fetches += 1;
+      if (speculative) {
+        stats_.bytes_prefetched += map_size;
+      }
+
       // Get physical pages for the region we are about to write
       int err =
           mprotect(map_start_ + file_off, map_size, PROT_READ | PROT_WRITE);
@@ -240,6 +323,7 @@ FileView::Read(int64_t nbytes) {
     return arrow::Status(
         arrow::StatusCode::IOError, "Resolving asynchronous reads");
   }
+  MarkRead(cursor_, nbytes_internal);
   // prefetch
   if (auto res = PreFetch(cursor_, nbytes_internal); !res) {
     // TODO (scober): Include res.error() as part of arrow Status
@@ -275,6 +359,7 @@ FileView::Read(int64_t nbytes, void* out) {
     return arrow::Status(
         arrow::StatusCode::IOError, "Resolving asynchronous reads");
   }
+  MarkRead(cursor_, nbytes_internal);
   // prefetch
   if (auto res = PreFetch(cursor_, nbytes_internal); !res) {
     // TODO (scober): Include res.error() as part of arrow Status
@@ -294,7 +379,7 @@ FileView::GetSize() {
 ///// End arrow::io::RandomAccessFile method definitions /////////
 
 uint64_t
-FileView::page_number(uint64_t size) {
+FileView::page_number(uint64_t size) const {
   return size >> page_shift_;
 }
 
@@ -404,7 +489,7 @@ FileView::MustFill(uint64_t* bitmap, uint64_t begin, uint64_t end) {
   // searching backward
   if (found_first && !found_last) {
     // search backward for last page, skip end_block
-    for (uint64_t i = end_block - 1; i > begin_block && !found_last; ++i) {
+    for (uint64_t i = end_block - 1; i > begin_block && !found_last; --i) {
       if (~bitmap[i]) {
         last_page = LastPage(bitmap, i, 0, 63);
         found_last = true;
@@ -458,11 +543,19 @@ FileView::Resolve(int64_t start, int64_t size) {
   // bottleneck
   for (auto it = fetches_->begin(); it != fetches_->end();) {
     auto fetch = it;
-    if (fetch->first_page <= page_number(start + size) ||
+    if (fetch->first_page <= page_number(start + size) &&
         fetch->last_page >= page_number(start)) {
       // Complete the remaining work if there is some
       if (fetch->work.valid()) {
-        if (auto res = fetch->work.get(); !res) {
+        int64_t stall_begin = katana::TraceNow();
+        auto res = fetch->work.get();
+        int64_t stall_end = katana::TraceNow();
+        stats_.stall_ns += stall_end - stall_begin;
+        if (katana::IsTracing()) {
+          katana::TraceInterval(
+              "tsuba", "FileView::Resolve", stall_begin, stall_end);
+        }
+        if (!res) {
           return res.error();
         }
       } else {
@@ -476,18 +569,70 @@ FileView::Resolve(int64_t start, int64_t size) {
   return katana::ResultSuccess();
 }
 
+void
+FileView::MarkRead(int64_t start, int64_t size) {
+  if (size <= 0) {
+    return;
+  }
+  uint64_t first = page_number(start);
+  uint64_t last = page_number(start + size - 1);
+  for (uint64_t page = first; page <= last; ++page) {
+    speculative_[page / 64] &= ~(UINT64_C(1) << (page % 64));
+  }
+}
+
 katana::Result<void>
 FileView::PreFetch(int64_t start, int64_t size) {
-  // Our highly sophisticated prefetching algorithm is to crudely approximate
-  // the size of the last read plus 10%. This is largely motivated by parquet
-  // files, which consecutively read row groups that are (in theory)
-  // approximately the same size.
-  int64_t fetch_size = (size / 10) * 11;
+  ReadAhead& ra = read_ahead_;
+  int64_t end = start + size;
+  int64_t stride = start - ra.last_start;
+  bool first_read = ra.last_start < 0;
+  bool sequential = start == ra.last_end;
+  bool strided = !first_read && stride > 0 && stride == ra.stride;
+
+  ra.stride = first_read ? 0 : stride;
+  ra.last_start = start;
+  ra.last_end = end;
+
+  uint64_t begin = 0;
+  uint64_t fetch_end = 0;
+  switch (ra.pattern) {
+  case AccessPattern::kRandom:
+    return katana::ResultSuccess();
+  case AccessPattern::kSequential:
+    sequential = true;
+    break;
+  case AccessPattern::kAdaptive:
+    break;
+  }
+
+  if (first_read || sequential) {
+    // Start with the size of the last read plus 10%, which suits parquet files
+    // that consecutively read row groups of about the same size, and double
+    // the window for as long as reads continue where the previous one ended.
+    int64_t min_window =
+        std::max<int64_t>((size / 10) * 11, INT64_C(1) << page_shift_);
+    if (first_read || ra.window == 0) {
+      ra.window = min_window;
+    } else {
+      ra.window = std::max(std::min(2 * ra.window, kMaxReadAhead), min_window);
+    }
+    begin = end;
+    fetch_end = end + ra.window;
+  } else if (strided) {
+    // Fetch the next record of a fixed stride scan
+    ra.window = 0;
+    begin = start + stride;
+    fetch_end = begin + size;
+  } else {
+    // Random access; don't speculate
+    ra.window = 0;
+    return katana::ResultSuccess();
+  }
+
   // Make sure we haven't overflown
-  KATANA_LOG_DEBUG_ASSERT(fetch_size >= 0);
-  uint64_t begin = static_cast<uint64_t>(start + size);
-  uint64_t end = static_cast<uint64_t>(start + size + fetch_size);
-  if (auto res = Fill(begin, end, false); !res) {
+  KATANA_LOG_DEBUG_ASSERT(fetch_end >= begin);
+  if (auto res = DoFill(begin, fetch_end, false, true); !res) {
     return res.error();
   }
   return katana::ResultSuccess();
@@ -0,0 +1,301 @@
+#include "LocalIOPool.h"
+
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+
+#include "katana/Env.h"
+#include "katana/Logging.h"
+#include "katana/Tracing.h"
+#include "tsuba/Errors.h"
+#include "tsuba/file.h"
+
+namespace {
+
+/// Upper bound on the number of queued requests folded into one vectored call
+constexpr size_t kMaxCoalesced = 16;
+
+}  // namespace
+
+/// Batch is the state shared by all the chunks of one Read or Write call
+struct tsuba::LocalIOPool::Batch {
+  int fd{-1};
+  dev_t dev{};
+  ino_t ino{};
+  bool is_write{false};
+
+  std::atomic<uint64_t> pending{0};
+  std::atomic<uint64_t> missing{0};
+  std::mutex error_mutex;
+  std::error_code error;
+  std::promise<katana::Result<void>> promise;
+
+  ~Batch() {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+
+  bool SameFile(const Batch& other) const {
+    return is_write == other.is_write && dev == other.dev && ino == other.ino;
+  }
+
+  void Complete(uint64_t missing_bytes, std::error_code err) {
+    if (err) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) {
+        error = err;
+      }
+    }
+    missing.fetch_add(missing_bytes);
+
+    if (pending.fetch_sub(1) != 1) {
+      return;
+    }
+
+    if (error) {
+      promise.set_value(error);
+      return;
+    }
+    // if the difference in what was read from what we wanted is less than a
+    // block it's because the file size isn't well aligned so don't complain.
+    if (missing.load() > kBlockSize) {
+      promise.set_value(ErrorCode::LocalStorageError);
+      return;
+    }
+    promise.set_value(katana::ResultSuccess());
+  }
+};
+
+tsuba::LocalIOPool::Options
+tsuba::LocalIOPool::DefaultOptions() {
+  Options opts;
+  int val = 0;
+  if (katana::GetEnv("KATANA_LOCAL_IO_THREADS", &val) && val >= 0) {
+    opts.num_threads = val;
+  }
+  if (katana::GetEnv("KATANA_LOCAL_IO_QUEUE_DEPTH", &val) && val > 0) {
+    opts.queue_depth = val;
+  }
+  if (katana::GetEnv("KATANA_LOCAL_IO_REQUEST_SIZE", &val) &&
+      val >= static_cast<int>(kBlockSize)) {
+    opts.max_request_size = RoundDownToBlock(static_cast<uint64_t>(val));
+  }
+  return opts;
+}
+
+tsuba::LocalIOPool::~LocalIOPool() { Stop(); }
+
+katana::Result<void>
+tsuba::LocalIOPool::Start(const Options& opts) {
+  if (!threads_.empty()) {
+    return ErrorCode::InvalidArgument;
+  }
+  if (opts.queue_depth == 0 || opts.max_request_size == 0) {
+    return ErrorCode::InvalidArgument;
+  }
+
+  opts_ = opts;
+  stopping_ = false;
+  for (uint32_t i = 0; i < opts_.num_threads; ++i) {
+    threads_.emplace_back([this] { Run(); });
+  }
+  return katana::ResultSuccess();
+}
+
+void
+tsuba::LocalIOPool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  not_empty_.notify_all();
+  for (std::thread& t : threads_) {
+    t.join();
+  }
+  threads_.clear();
+}
+
+std::future<katana::Result<void>>
+tsuba::LocalIOPool::Read(int fd, uint64_t start, uint64_t size, uint8_t* buf) {
+  return Submit(fd, false, start, size, buf);
+}
+
+std::future<katana::Result<void>>
+tsuba::LocalIOPool::Write(int fd, const uint8_t* data, uint64_t size) {
+  // The buffer is only ever read from on the write path
+  return Submit(fd, true, 0, size, const_cast<uint8_t*>(data));  // NOLINT
+}
+
+std::future<katana::Result<void>>
+tsuba::LocalIOPool::Submit(
+    int fd, bool is_write, uint64_t start, uint64_t size, uint8_t* buf) {
+  auto batch = std::make_shared<Batch>();
+  batch->fd = fd;
+  batch->is_write = is_write;
+  std::future<katana::Result<void>> future = batch->promise.get_future();
+
+  struct stat s_buf;
+  if (fstat(fd, &s_buf) != 0) {
+    batch->pending = 1;
+    batch->Complete(0, katana::ResultErrno());
+    return future;
+  }
+  batch->dev = s_buf.st_dev;
+  batch->ino = s_buf.st_ino;
+
+  uint64_t chunk_size = opts_.max_request_size;
+  uint64_t num_chunks =
+      std::max<uint64_t>(1, (size + chunk_size - 1) / chunk_size);
+  batch->pending = num_chunks;
+
+  for (uint64_t i = 0; i < num_chunks; ++i) {
+    uint64_t off = i * chunk_size;
+    Request req{
+        .batch = batch,
+        .offset = start + off,
+        .size = std::min(chunk_size, size - std::min(size, off)),
+        .buf = buf + off,
+    };
+
+    if (threads_.empty()) {
+      std::vector<Request> reqs;
+      reqs.emplace_back(std::move(req));
+      Execute(&reqs);
+    } else {
+      Push(std::move(req));
+    }
+  }
+
+  return future;
+}
+
+void
+tsuba::LocalIOPool::Push(Request&& req) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [this] { return queue_.size() < opts_.queue_depth; });
+    queue_.emplace_back(std::move(req));
+  }
+  not_empty_.notify_one();
+}
+
+void
+tsuba::LocalIOPool::PopCoalesced(std::vector<Request>* reqs) {
+  reqs->clear();
+  reqs->emplace_back(std::move(queue_.front()));
+  queue_.pop_front();
+
+  const Batch& first = *reqs->front().batch;
+  uint64_t end = reqs->front().offset + reqs->front().size;
+
+  bool found = true;
+  while (found && reqs->size() < kMaxCoalesced) {
+    found = false;
+    for (auto it = queue_.begin(); it != queue_.end(); ++it) {
+      if (it->offset != end || !first.SameFile(*it->batch)) {
+        continue;
+      }
+      end += it->size;
+      reqs->emplace_back(std::move(*it));
+      queue_.erase(it);
+      found = true;
+      break;
+    }
+  }
+}
+
+void
+tsuba::LocalIOPool::Run() {
+  katana::SetTraceThreadName("tsuba io");
+  std::vector<Request> reqs;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_empty_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      PopCoalesced(&reqs);
+    }
+    not_full_.notify_all();
+
+    Execute(&reqs);
+  }
+}
+
+/// Execute issues reqs, which cover one contiguous range of one file, as a
+/// single vectored call and completes each request with its share of the
+/// result.
+void
+tsuba::LocalIOPool::Execute(std::vector<Request>* reqs) {
+  const Batch& first = *reqs->front().batch;
+  int fd = first.fd;
+  bool is_write = first.is_write;
+  uint64_t offset = reqs->front().offset;
+
+  std::vector<iovec> iov;
+  uint64_t total = 0;
+  for (const Request& req : *reqs) {
+    if (req.size == 0) {
+      continue;
+    }
+    iov.push_back(iovec{.iov_base = req.buf, .iov_len = req.size});
+    total += req.size;
+  }
+
+  katana::TraceScope trace("tsuba", is_write ? "pwritev" : "preadv");
+  trace.AddArg("bytes", total);
+
+  uint64_t done = 0;
+  size_t idx = 0;
+  std::error_code err;
+  while (done < total) {
+    int count = std::min<size_t>(iov.size() - idx, IOV_MAX);
+    ssize_t n = is_write ? pwritev(fd, &iov[idx], count, offset + done)
+                         : preadv(fd, &iov[idx], count, offset + done);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      err = katana::ResultErrno();
+      KATANA_LOG_DEBUG(
+          "failed to {}: {}", is_write ? "write" : "read", err.message());
+      break;
+    }
+    if (n == 0) {
+      // end of file
+      if (is_write) {
+        err = ErrorCode::LocalStorageError;
+      }
+      break;
+    }
+
+    done += n;
+    for (auto left = static_cast<uint64_t>(n); left > 0;) {
+      if (left >= iov[idx].iov_len) {
+        left -= iov[idx].iov_len;
+        ++idx;
+      } else {
+        iov[idx].iov_base = static_cast<uint8_t*>(iov[idx].iov_base) + left;
+        iov[idx].iov_len -= left;
+        left = 0;
+      }
+    }
+  }
+
+  uint64_t prefix = 0;
+  for (Request& req : *reqs) {
+    uint64_t got = done > prefix ? std::min(req.size, done - prefix) : 0;
+    prefix += req.size;
+    req.batch->Complete(
+        req.size - got, got < req.size ? err : std::error_code());
+    req.batch.reset();
+  }
+  reqs->clear();
+}
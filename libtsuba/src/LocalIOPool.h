@@ -0,0 +1,98 @@
+#ifndef KATANA_LIBTSUBA_LOCALIOPOOL_H_
+#define KATANA_LIBTSUBA_LOCALIOPOOL_H_
+
+#include <sys/types.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "katana/Result.h"
+
+namespace tsuba {
+
+/// LocalIOPool executes positional reads and writes (pread/pwrite) against
+/// local file descriptors on a fixed set of I/O threads.
+///
+/// Large requests are split into chunks of at most max_request_size bytes so
+/// that a single big fetch is serviced by several threads. Pending requests
+/// wait in a queue bounded by queue_depth; submitters block when the queue is
+/// full. When a thread dequeues a request, it also takes any queued requests
+/// of the same kind that continue it in the same file and issues them as one
+/// vectored call (preadv/pwritev).
+class LocalIOPool {
+public:
+  struct Options {
+    uint32_t num_threads{4};
+    uint32_t queue_depth{64};
+    uint64_t max_request_size{UINT64_C(8) << 20};
+  };
+
+  /// Default options, overridden by the environment variables
+  /// KATANA_LOCAL_IO_THREADS, KATANA_LOCAL_IO_QUEUE_DEPTH and
+  /// KATANA_LOCAL_IO_REQUEST_SIZE (in bytes).
+  static Options DefaultOptions();
+
+  LocalIOPool() = default;
+  LocalIOPool(const LocalIOPool& no_copy) = delete;
+  LocalIOPool(LocalIOPool&& no_move) = delete;
+  LocalIOPool& operator=(const LocalIOPool& no_copy) = delete;
+  LocalIOPool& operator=(LocalIOPool&& no_move) = delete;
+  ~LocalIOPool();
+
+  /// Start the I/O threads. Requests submitted while the pool is stopped
+  /// run synchronously on the calling thread.
+  katana::Result<void> Start(const Options& opts);
+
+  /// Finish all queued requests and join the I/O threads
+  void Stop();
+
+  /// Read size bytes starting at offset start of fd into buf. The pool takes
+  /// ownership of fd and closes it once the read completes. Reads that come
+  /// up short by less than a block (because the file ends) are not errors.
+  std::future<katana::Result<void>> Read(
+      int fd, uint64_t start, uint64_t size, uint8_t* buf);
+
+  /// Write size bytes of data to fd starting at offset 0. The pool takes
+  /// ownership of fd. The caller must keep data live until the returned
+  /// future is ready.
+  std::future<katana::Result<void>> Write(
+      int fd, const uint8_t* data, uint64_t size);
+
+  uint32_t num_threads() const { return threads_.size(); }
+
+private:
+  struct Batch;
+
+  struct Request {
+    std::shared_ptr<Batch> batch;
+    uint64_t offset;
+    uint64_t size;
+    uint8_t* buf;
+  };
+
+  std::future<katana::Result<void>> Submit(
+      int fd, bool is_write, uint64_t start, uint64_t size, uint8_t* buf);
+  void Push(Request&& req);
+  void PopCoalesced(std::vector<Request>* reqs);
+  void Run();
+  static void Execute(std::vector<Request>* reqs);
+
+  Options opts_;
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::deque<Request> queue_;
+  bool stopping_{false};
+};
+
+}  // namespace tsuba
+
+#endif
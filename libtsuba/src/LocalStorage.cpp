@@ -29,7 +29,7 @@ tsuba::LocalStorage::CleanUri(std::string* uri) {
   *uri = std::string(uri->begin() + uri_scheme().size(), uri->end());
 }
 
-katana::Result<void>
+std::future<katana::Result<void>>
 tsuba::LocalStorage::WriteFile(
     std::string uri, const uint8_t* data, uint64_t size) {
   CleanUri(&uri);
@@ -37,19 +37,17 @@ tsuba::LocalStorage::WriteFile(
   fs::path dir = m_path.parent_path();
   if (boost::system::error_code err; !fs::create_directories(dir, err)) {
     if (err) {
-      return err;
+      return katana::AsyncError<void>(err);
     }
   }
 
-  std::ofstream ofile(uri);
-  if (!ofile.good()) {
-    return ErrorCode::LocalStorageError;
-  }
-  ofile.write(reinterpret_cast<const char*>(data), size); /* NOLINT */
-  if (!ofile.good()) {
-    return ErrorCode::LocalStorageError;
+  int fd = open(uri.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+  if (fd < 0) {
+    KATANA_LOG_DEBUG(
+        "failed to open {}: {}", uri, katana::ResultErrno().message());
+    return katana::AsyncError<void>(ErrorCode::LocalStorageError);
   }
-  return katana::ResultSuccess();
+  return pool_.Write(fd, data, size);
 }
 
 katana::Result<void>
@@ -78,30 +76,17 @@ tsuba::LocalStorage::RemoteCopyFile(
   return katana::ResultSuccess();
 }
 
-katana::Result<void>
+std::future<katana::Result<void>>
 tsuba::LocalStorage::ReadFile(
     std::string uri, uint64_t start, uint64_t size, uint8_t* data) {
   CleanUri(&uri);
-  std::ifstream ifile(uri);
-
-  ifile.seekg(start);
-  if (!ifile) {
-    KATANA_LOG_DEBUG("failed to seek");
-    return ErrorCode::LocalStorageError;
-  }
-
-  ifile.read(reinterpret_cast<char*>(data), size); /* NOLINT */
-  if (!ifile) {
-    KATANA_LOG_DEBUG("failed to read");
-    return ErrorCode::LocalStorageError;
-  }
-
-  // if the difference in what was read from what we wanted is less  than a
-  // block it's because the file size isn't well aligned so don't complain.
-  if (size - ifile.gcount() > kBlockSize) {
-    return ErrorCode::LocalStorageError;
+  int fd = open(uri.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    KATANA_LOG_DEBUG(
+        "failed to open {}: {}", uri, katana::ResultErrno().message());
+    return katana::AsyncError<void>(ErrorCode::LocalStorageError);
   }
-  return katana::ResultSuccess();
+  return pool_.Read(fd, start, size, data);
 }
 
 katana::Result<void>
@@ -8,18 +8,22 @@
 #include <string>
 #include <thread>
 
+#include "LocalIOPool.h"
 #include "katana/Result.h"
 #include "tsuba/FileStorage.h"
 
 namespace tsuba {
 
-/// Store byte arrays to the local file system; Provided as a convenience for
-/// testing only (un-optimized)
+/// Store byte arrays to the local file system. Reads and writes are
+/// positional (pread/pwrite) and run on a bounded pool of I/O threads; see
+/// LocalIOPool for the knobs.
 class LocalStorage : public FileStorage {
+  LocalIOPool pool_;
+
   void CleanUri(std::string* uri);
-  katana::Result<void> WriteFile(
+  std::future<katana::Result<void>> WriteFile(
       std::string, const uint8_t* data, uint64_t size);
-  katana::Result<void> ReadFile(
+  std::future<katana::Result<void>> ReadFile(
       std::string uri, uint64_t start, uint64_t size, uint8_t* data);
   katana::Result<void> RemoteCopyFile(
       std::string source_uri, std::string dest_uri, uint64_t begin,
@@ -28,8 +32,13 @@ class LocalStorage : public FileStorage {
 public:
   LocalStorage() : FileStorage("file://") {}
 
-  katana::Result<void> Init() override { return katana::ResultSuccess(); }
-  katana::Result<void> Fini() override { return katana::ResultSuccess(); }
+  katana::Result<void> Init() override {
+    return pool_.Start(LocalIOPool::DefaultOptions());
+  }
+  katana::Result<void> Fini() override {
+    pool_.Stop();
+    return katana::ResultSuccess();
+  }
   katana::Result<void> Stat(const std::string& uri, StatBuf* size) override;
 
   uint32_t Priority() const override { return 1; }
@@ -37,12 +46,12 @@ public:
   katana::Result<void> GetMultiSync(
       const std::string& uri, uint64_t start, uint64_t size,
       uint8_t* result_buf) override {
-    return ReadFile(uri, start, size, result_buf);
+    return ReadFile(uri, start, size, result_buf).get();
   }
 
   katana::Result<void> PutMultiSync(
       const std::string& uri, const uint8_t* data, uint64_t size) override {
-    return WriteFile(uri, data, size);
+    return WriteFile(uri, data, size).get();
   }
 
   katana::Result<void> RemoteCopy(
@@ -54,24 +63,12 @@ public:
   // get on future can potentially block (bulk synchronous parallel)
   std::future<katana::Result<void>> PutAsync(
       const std::string& uri, const uint8_t* data, uint64_t size) override {
-    // No need for AsyncPut to local storage right now
-    if (auto write_res = WriteFile(uri, data, size); !write_res) {
-      return std::async(
-          [=]() -> katana::Result<void> { return write_res.error(); });
-    }
-    return std::async(
-        []() -> katana::Result<void> { return katana::ResultSuccess(); });
+    return WriteFile(uri, data, size);
   }
   std::future<katana::Result<void>> GetAsync(
       const std::string& uri, uint64_t start, uint64_t size,
       uint8_t* result_buf) override {
-    // I suppose there is no need for AsyncGet to local storage either
-    if (auto read_res = ReadFile(uri, start, size, result_buf); !read_res) {
-      return std::async(
-          [=]() -> katana::Result<void> { return read_res.error(); });
-    }
-    return std::async(
-        []() -> katana::Result<void> { return katana::ResultSuccess(); });
+    return ReadFile(uri, start, size, result_buf);
   }
   std::future<katana::Result<void>> ListAsync(
       const std::string& uri, std::vector<std::string>* list,
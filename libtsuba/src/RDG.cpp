@@ -391,6 +391,21 @@ tsuba::RDG::DoStore(
     core_->part_header().set_topology_path(t_path.BaseName());
   }
 
+  if (core_->part_header().in_topology_path().empty() &&
+      core_->in_topology_file_storage().Valid()) {
+    katana::Uri t_path =
+        handle.impl_->rdg_meta().dir().RandFile("in_topology");
+
+    TSUBA_PTP(internal::FaultSensitivity::Normal);
+
+    // depends on `in_topology_file_storage_` outliving writes
+    write_group->StartStore(
+        t_path.string(), core_->in_topology_file_storage().ptr<uint8_t>(),
+        core_->in_topology_file_storage().size());
+    TSUBA_PTP(internal::FaultSensitivity::Normal);
+    core_->part_header().set_in_topology_path(t_path.BaseName());
+  }
+
   auto node_write_result = WriteProperties(
       *core_->node_properties(), core_->part_header().node_prop_info_list(),
       handle.impl_->rdg_meta().dir(), write_group.get());
@@ -482,6 +497,16 @@ tsuba::RDG::DoMake(const katana::Uri& metadata_dir) {
     return res.error();
   }
 
+  if (const auto& in_path = core_->part_header().in_topology_path();
+      !in_path.empty()) {
+    katana::Uri in_t_path = metadata_dir.Join(in_path);
+    if (auto res =
+            core_->in_topology_file_storage().Bind(in_t_path.string(), true);
+        !res) {
+      return res.error();
+    }
+  }
+
   rdg_dir_ = metadata_dir;
   return katana::ResultSuccess();
 }
@@ -561,7 +586,7 @@ tsuba::RDG::Make(
 katana::Result<void>
 tsuba::RDG::Store(
     RDGHandle handle, const std::string& command_line,
-    std::unique_ptr<FileFrame> ff) {
+    std::unique_ptr<FileFrame> ff, std::unique_ptr<FileFrame> in_ff) {
   if (!handle.impl_->AllowsWrite()) {
     KATANA_LOG_DEBUG("failed: handle does not allow write");
     return ErrorCode::InvalidArgument;
@@ -595,6 +620,17 @@ tsuba::RDG::Store(
     core_->part_header().set_topology_path(t_path.BaseName());
   }
 
+  if (in_ff) {
+    katana::Uri t_path =
+        handle.impl_->rdg_meta().dir().RandFile("in_topology");
+
+    in_ff->Bind(t_path.string());
+    TSUBA_PTP(internal::FaultSensitivity::Normal);
+    desc->StartStore(std::move(in_ff));
+    TSUBA_PTP(internal::FaultSensitivity::Normal);
+    core_->part_header().set_in_topology_path(t_path.BaseName());
+  }
+
   return DoStore(handle, command_line, std::move(desc));
 }
 
@@ -697,6 +733,17 @@ tsuba::RDG::UnbindTopologyFileStorage() {
   return core_->topology_file_storage().Unbind();
 }
 
+const tsuba::FileView&
+tsuba::RDG::in_topology_file_storage() const {
+  return core_->in_topology_file_storage();
+}
+
+katana::Result<void>
+tsuba::RDG::DropInTopologyFile() {
+  core_->part_header().set_in_topology_path("");
+  return core_->in_topology_file_storage().Unbind();
+}
+
 katana::Result<void>
 tsuba::RDG::SetTopologyFile(const katana::Uri& new_top) {
   katana::Uri dir = new_top.DirName();
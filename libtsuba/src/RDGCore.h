@@ -57,6 +57,11 @@ public:
     topology_file_storage_ = std::move(topology_file_storage);
   }
 
+  const FileView& in_topology_file_storage() const {
+    return in_topology_file_storage_;
+  }
+  FileView& in_topology_file_storage() { return in_topology_file_storage_; }
+
   const RDGPartHeader& part_header() const { return part_header_; }
   RDGPartHeader& part_header() { return part_header_; }
   void set_part_header(RDGPartHeader&& part_header) {
@@ -79,6 +84,7 @@ private:
   std::shared_ptr<arrow::Table> edge_properties_;
 
   FileView topology_file_storage_;
+  FileView in_topology_file_storage_;
 
   RDGPartHeader part_header_;
 };
@@ -24,6 +24,7 @@ const char* kPartPropertyPathKey = "kg.v1.part_property.path";
 const char* kPartPropertyNameKey = "kg.v1.part_property.name";
 const char* kPartOtherMetadataKey = "kg.v1.other_part_metadata.key";
 
+const char* kInTopologyPathKey = "kg.v1.in_topology.path";
 const char* kNodePropertyKey = "kg.v1.node_property";
 const char* kEdgePropertyKey = "kg.v1.edge_property";
 const char* kPartPropertyFilesKey = "kg.v1.part_property_files";
@@ -311,6 +312,12 @@ RDGPartHeader::Validate() const {
         topology_path_);
     return ErrorCode::InvalidArgument;
   }
+  if (in_topology_path_.find('/') != std::string::npos) {
+    KATANA_LOG_DEBUG(
+        "failed: in_topology_path doesn't contain a slash: \"{}\"",
+        in_topology_path_);
+    return ErrorCode::InvalidArgument;
+  }
   return katana::ResultSuccess();
 }
 
@@ -377,6 +384,7 @@ RDGPartHeader::UnbindFromStorage() {
     prop.path = "";
   }
   topology_path_ = "";
+  in_topology_path_ = "";
 }
 
 }  // namespace tsuba
@@ -396,6 +404,7 @@ void
 tsuba::to_json(json& j, const tsuba::RDGPartHeader& header) {
   j = json{
       {kTopologyPathKey, header.topology_path_},
+      {kInTopologyPathKey, header.in_topology_path_},
       {kNodePropertyKey, header.node_prop_info_list_},
       {kEdgePropertyKey, header.edge_prop_info_list_},
       {kPartPropertyFilesKey, header.part_prop_info_list_},
@@ -406,6 +415,10 @@ tsuba::to_json(json& j, const tsuba::RDGPartHeader& header) {
 void
 tsuba::from_json(const json& j, tsuba::RDGPartHeader& header) {
   j.at(kTopologyPathKey).get_to(header.topology_path_);
+  // Optional; absent in headers written before in-edges were persisted
+  if (auto it = j.find(kInTopologyPathKey); it != j.end()) {
+    it->get_to(header.in_topology_path_);
+  }
   j.at(kNodePropertyKey).get_to(header.node_prop_info_list_);
   j.at(kEdgePropertyKey).get_to(header.edge_prop_info_list_);
   j.at(kPartPropertyFilesKey).get_to(header.part_prop_info_list_);
@@ -78,6 +78,12 @@ public:
   const std::string& topology_path() const { return topology_path_; }
   void set_topology_path(std::string path) { topology_path_ = std::move(path); }
 
+  /// The in-edge topology is optional; an empty path means there is none.
+  const std::string& in_topology_path() const { return in_topology_path_; }
+  void set_in_topology_path(std::string path) {
+    in_topology_path_ = std::move(path);
+  }
+
   const std::vector<PropStorageInfo>& node_prop_info_list() const {
     return node_prop_info_list_;
   }
@@ -121,6 +127,7 @@ private:
   PartitionMetadata metadata_;
 
   std::string topology_path_;
+  std::string in_topology_path_;
 };
 
 void to_json(nlohmann::json& j, const RDGPartHeader& header);
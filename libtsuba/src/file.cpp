@@ -18,6 +18,7 @@
 #include "katana/Logging.h"
 #include "katana/Platform.h"
 #include "katana/Result.h"
+#include "katana/Tracing.h"
 #include "tsuba/Errors.h"
 
 katana::Result<void>
@@ -35,6 +36,8 @@ katana::Result<void>
 tsuba::FileGet(
     const std::string& uri, uint8_t* result_buffer, uint64_t begin,
     uint64_t size) {
+  katana::TraceScope trace("tsuba", "FileGet");
+  trace.AddArg("bytes", size);
   return FS(uri)->GetMultiSync(uri, begin, size, result_buffer);
 }
 
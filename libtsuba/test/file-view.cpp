@@ -0,0 +1,359 @@
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <boost/filesystem.hpp>
+#include <parquet/arrow/writer.h>
+#include <parquet/file_reader.h>
+
+#include "AddProperties.h"
+#include "katana/Logging.h"
+#include "katana/Result.h"
+#include "katana/Uri.h"
+#include "tsuba/FileView.h"
+#include "tsuba/file.h"
+#include "tsuba/tsuba.h"
+
+namespace {
+
+namespace fs = boost::filesystem;
+
+using Pattern = tsuba::FileView::AccessPattern;
+
+// Files of this size get the smallest page size and more than three words of
+// page bitmap
+constexpr uint64_t kPageSize = UINT64_C(64) << 10;
+constexpr uint64_t kNumPages = 256;
+constexpr uint64_t kFileSize = kNumPages * kPageSize;
+
+constexpr int64_t kRowsPerGroup = 32 << 10;
+constexpr int kNumRowGroups = 16;
+
+std::string temp_dir;
+std::string file_path;
+std::vector<uint8_t> expected;
+
+struct Counts {
+  uint64_t fetched;
+  uint64_t prefetched;
+  uint64_t wasted;
+  uint64_t num_fetches;
+};
+
+/// Compare the stats of fv with expected byte counts given in pages
+void
+AssertStats(const tsuba::FileView& fv, const Counts& pages) {
+  tsuba::FileView::Stats stats = fv.stats();
+  KATANA_LOG_VASSERT(
+      stats.bytes_fetched == pages.fetched * kPageSize,
+      "fetched {} bytes, expected {} pages", stats.bytes_fetched,
+      pages.fetched);
+  KATANA_LOG_VASSERT(
+      stats.bytes_prefetched == pages.prefetched * kPageSize,
+      "prefetched {} bytes, expected {} pages", stats.bytes_prefetched,
+      pages.prefetched);
+  KATANA_LOG_VASSERT(
+      stats.bytes_wasted == pages.wasted * kPageSize,
+      "wasted {} bytes, expected {} pages", stats.bytes_wasted, pages.wasted);
+  KATANA_LOG_VASSERT(
+      stats.num_fetches == pages.num_fetches, "{} fetches, expected {}",
+      stats.num_fetches, pages.num_fetches);
+}
+
+void
+AssertMatches(const uint8_t* buf, uint64_t start, uint64_t size) {
+  for (uint64_t i = 0; i < size; ++i) {
+    KATANA_LOG_VASSERT(
+        buf[i] == expected[start + i], "byte {} differs: {} != {}", start + i,
+        buf[i], expected[start + i]);
+  }
+}
+
+/// Bind fv to path without loading anything so that every fetch is made by
+/// the code under test
+void
+BindEmpty(tsuba::FileView* fv, const std::string& path) {
+  auto res = fv->Bind(path, 0, 0, false);
+  KATANA_LOG_VASSERT(res, "binding {}: {}", path, res.error());
+  KATANA_LOG_ASSERT(fv->size() == kFileSize);
+  KATANA_LOG_ASSERT(fv->stats().num_fetches == 0);
+}
+
+void
+ReadAt(tsuba::FileView* fv, uint64_t start, uint64_t size) {
+  std::vector<uint8_t> buf(size);
+  KATANA_LOG_ASSERT(fv->Seek(start).ok());
+  auto res = fv->Read(size, buf.data());
+  KATANA_LOG_VASSERT(res.ok(), "reading at {}: {}", start, res.status());
+  KATANA_LOG_ASSERT(static_cast<uint64_t>(res.ValueOrDie()) == size);
+  AssertMatches(buf.data(), start, size);
+}
+
+/// Reads that continue where the previous one ended double the read-ahead
+/// window each time
+void
+TestSequential() {
+  tsuba::FileView fv;
+  BindEmpty(&fv, file_path);
+
+  uint64_t size = kPageSize / 4;
+  uint64_t prefetched_pages[] = {1, 2, 4, 8};
+  for (uint64_t i = 0; i < 4; ++i) {
+    ReadAt(&fv, i * size, size);
+    // Only page 0 is ever read and it is fetched on demand
+    uint64_t prefetched = prefetched_pages[i];
+    AssertStats(fv, {prefetched + 1, prefetched, prefetched, i + 2});
+  }
+}
+
+/// A fixed stride is recognized on its third read; from then on each read
+/// is served by the fetch started for it by the previous one
+void
+TestStrided() {
+  tsuba::FileView fv;
+  BindEmpty(&fv, file_path);
+
+  uint64_t stride = 4 * kPageSize;
+  for (uint64_t i = 0; i < 5; ++i) {
+    ReadAt(&fv, i * stride, 1000);
+  }
+  // Demand fetches of pages 0, 4 and 8. Speculative fetches of page 1, on
+  // the first read, and of pages 12, 16 and 20, of which only 20 is unused.
+  AssertStats(fv, {7, 4, 2, 7});
+}
+
+/// Reads that are neither sequential nor strided do not speculate, except
+/// after the first read when there is no pattern yet
+void
+TestRandom() {
+  uint64_t pages[] = {0, 9, 3, 20};
+
+  tsuba::FileView adaptive;
+  BindEmpty(&adaptive, file_path);
+  for (uint64_t page : pages) {
+    ReadAt(&adaptive, page * kPageSize, 1000);
+  }
+  AssertStats(adaptive, {5, 1, 1, 5});
+
+  tsuba::FileView random;
+  BindEmpty(&random, file_path);
+  random.Advise(Pattern::kRandom);
+  for (uint64_t page : pages) {
+    ReadAt(&random, page * kPageSize, 1000);
+  }
+  AssertStats(random, {4, 0, 0, 4});
+}
+
+/// kSequential reads ahead even when reads are not contiguous
+void
+TestAdviseSequential() {
+  tsuba::FileView fv;
+  BindEmpty(&fv, file_path);
+  fv.Advise(Pattern::kSequential);
+
+  ReadAt(&fv, 0, 1000);
+  ReadAt(&fv, 9 * kPageSize, 1000);
+  // Page 1 after the first read and pages 10 and 11 after the second
+  AssertStats(fv, {5, 3, 3, 4});
+}
+
+void
+TestWillNeed() {
+  tsuba::FileView unbound;
+  KATANA_LOG_ASSERT(!unbound.WillNeed(0, kPageSize));
+
+  tsuba::FileView fv;
+  BindEmpty(&fv, file_path);
+  fv.Advise(Pattern::kRandom);
+
+  // Pages 2 to 4; the end is exclusive so page 5 is not needed
+  uint64_t begin = 2 * kPageSize + 100;
+  uint64_t end = 5 * kPageSize;
+  KATANA_LOG_ASSERT(fv.WillNeed(begin, end));
+  AssertStats(fv, {3, 3, 3, 1});
+
+  ReadAt(&fv, 3 * kPageSize, 1000);
+  AssertStats(fv, {3, 3, 2, 1});
+
+  // Hinting again fetches nothing
+  KATANA_LOG_ASSERT(fv.WillNeed(begin, end));
+  ReadAt(&fv, begin, end - begin);
+  AssertStats(fv, {3, 3, 0, 1});
+}
+
+/// Fill a hole with filled pages on both sides of it that spans several
+/// words of the page bitmap. Only the hole should be fetched, which requires
+/// searching backward from the end of the range for its last page.
+void
+TestFillHole() {
+  tsuba::FileView fv;
+  BindEmpty(&fv, file_path);
+
+  KATANA_LOG_ASSERT(fv.Fill(0, 64 * kPageSize, true));
+  KATANA_LOG_ASSERT(fv.Fill(128 * kPageSize, kFileSize, true));
+  AssertStats(fv, {192, 0, 0, 2});
+
+  KATANA_LOG_ASSERT(fv.Fill(0, kFileSize, true));
+  AssertStats(fv, {256, 0, 0, 3});
+  AssertMatches(fv.ptr<uint8_t>(), 0, kFileSize);
+}
+
+/// Reads only wait for the fetches that they overlap. A hinted fetch that
+/// fails does not affect reads elsewhere in the file.
+void
+TestResolve() {
+  std::string path = file_path + ".truncated";
+  KATANA_LOG_ASSERT(tsuba::FileStore(path, expected.data(), expected.size()));
+
+  tsuba::FileView fv;
+  BindEmpty(&fv, path);
+  fv.Advise(Pattern::kRandom);
+
+  // FileView still expects the original size, so this fetch reads past the
+  // end of the file and fails
+  fs::resize_file(path, kPageSize);
+  KATANA_LOG_ASSERT(fv.WillNeed(8 * kPageSize, 9 * kPageSize));
+
+  ReadAt(&fv, 0, 1000);
+  AssertStats(fv, {2, 1, 1, 2});
+
+  // Unbind waits for everything and reports the failed fetch
+  KATANA_LOG_ASSERT(!fv.Unbind());
+}
+
+int64_t
+ExpectedValue(int64_t row) {
+  // Runs of four equal values so that the file compresses
+  return (row / 4) * 2654435761 % 1000003;
+}
+
+std::string
+WriteParquet() {
+  arrow::Int64Builder builder;
+  for (int64_t i = 0; i < kRowsPerGroup * kNumRowGroups; ++i) {
+    KATANA_LOG_ASSERT(builder.Append(ExpectedValue(i)).ok());
+  }
+  std::shared_ptr<arrow::Array> array;
+  KATANA_LOG_ASSERT(builder.Finish(&array).ok());
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("value", arrow::int64())}), {array});
+
+  std::string path = temp_dir + "/value.parquet";
+  auto sink_res = arrow::io::FileOutputStream::Open(path);
+  KATANA_LOG_ASSERT(sink_res.ok());
+  auto sink = sink_res.ValueOrDie();
+
+  // Compressed so that row groups start well before the sum of the
+  // uncompressed sizes of the ones preceding them
+  auto props = parquet::WriterProperties::Builder()
+                   .compression(parquet::Compression::SNAPPY)
+                   ->disable_dictionary()
+                   ->build();
+  auto write_res = parquet::arrow::WriteTable(
+      *table, arrow::default_memory_pool(), sink, kRowsPerGroup, props);
+  KATANA_LOG_VASSERT(write_res.ok(), "writing {}: {}", path, write_res);
+  KATANA_LOG_ASSERT(sink->Close().ok());
+  return path;
+}
+
+/// A slice only fetches the column chunks of the row groups it covers, at
+/// the offsets recorded in the file metadata
+void
+TestPropertySlice() {
+  std::string path = WriteParquet();
+
+  auto md = parquet::ParquetFileReader::OpenFile(path)->metadata();
+  KATANA_LOG_ASSERT(md->num_row_groups() == kNumRowGroups);
+  auto chunk_range = [&md](int rg) {
+    auto rg_md = md->RowGroup(rg);
+    auto col_md = rg_md->ColumnChunk(0);
+    int64_t begin = col_md->data_page_offset();
+    if (col_md->has_dictionary_page() && col_md->dictionary_page_offset() > 0) {
+      begin = std::min(begin, col_md->dictionary_page_offset());
+    }
+    return std::make_pair(begin, begin + col_md->total_compressed_size());
+  };
+
+  // Rows from the middle of row group 2 to the middle of row group 4
+  int64_t offset = 2 * kRowsPerGroup + kRowsPerGroup / 2;
+  int64_t length = 2 * kRowsPerGroup;
+  uint64_t first_page = chunk_range(2).first / kPageSize;
+  uint64_t last_page = (chunk_range(4).second - 1) / kPageSize;
+
+  // Load the second half of the file, which holds the footer, up front so
+  // that what remains to be fetched is exactly the slice
+  uint64_t tail = chunk_range(kNumRowGroups / 2).first;
+  KATANA_LOG_ASSERT(last_page < tail / kPageSize);
+  auto fv = std::make_shared<tsuba::FileView>();
+  KATANA_LOG_ASSERT(fv->Bind(path, tail, UINT64_MAX, true));
+  KATANA_LOG_ASSERT(fv->size() < 1024 * kPageSize);
+  tsuba::FileView::Stats before = fv->stats();
+
+  auto res = tsuba::LoadPropertySlice("value", fv, offset, length);
+  KATANA_LOG_VASSERT(res, "loading slice: {}", res.error());
+  std::shared_ptr<arrow::Table> slice = res.value();
+  KATANA_LOG_ASSERT(slice->num_rows() == length);
+  KATANA_LOG_ASSERT(slice->column(0)->num_chunks() == 1);
+  auto values =
+      std::static_pointer_cast<arrow::Int64Array>(slice->column(0)->chunk(0));
+  for (int64_t i = 0; i < length; ++i) {
+    KATANA_LOG_VASSERT(
+        values->Value(i) == ExpectedValue(offset + i), "row {} differs",
+        offset + i);
+  }
+
+  tsuba::FileView::Stats after = fv->stats();
+  uint64_t slice_bytes = (last_page - first_page + 1) * kPageSize;
+  KATANA_LOG_VASSERT(
+      after.bytes_prefetched - before.bytes_prefetched == slice_bytes,
+      "prefetched {} bytes, expected {}",
+      after.bytes_prefetched - before.bytes_prefetched, slice_bytes);
+  KATANA_LOG_VASSERT(
+      after.bytes_fetched - before.bytes_fetched == slice_bytes,
+      "fetched {} bytes, expected {}",
+      after.bytes_fetched - before.bytes_fetched, slice_bytes);
+  KATANA_LOG_ASSERT(after.bytes_wasted == 0);
+}
+
+}  // namespace
+
+int
+main() {
+  if (auto res = tsuba::Init(); !res) {
+    KATANA_LOG_FATAL("tsuba::Init: {}", res.error());
+  }
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/fileview");
+  KATANA_LOG_ASSERT(uri_res);
+  temp_dir = uri_res.value().path();  // path because local
+  file_path = temp_dir + "/data";
+
+  expected.resize(kFileSize);
+  for (uint64_t i = 0; i < kFileSize; ++i) {
+    expected[i] = i * 2654435761U >> 24;
+  }
+  if (auto res = tsuba::FileStore(file_path, expected.data(), kFileSize);
+      !res) {
+    KATANA_LOG_FATAL("could not write {}: {}", file_path, res.error());
+  }
+
+  TestSequential();
+  TestStrided();
+  TestRandom();
+  TestAdviseSequential();
+  TestWillNeed();
+  TestFillHole();
+  TestResolve();
+  TestPropertySlice();
+
+  fs::remove_all(temp_dir);
+
+  if (auto res = tsuba::Fini(); !res) {
+    KATANA_LOG_FATAL("tsuba::Fini: {}", res.error());
+  }
+  return 0;
+}
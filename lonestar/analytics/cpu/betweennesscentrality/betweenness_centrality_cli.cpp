@@ -63,10 +63,26 @@ static cll::opt<BetweennessCentralityPlan::Algorithm> algo(
         // clEnumValN(BetweennessCentralityPlan::kAsynchronous, "Async", "Asynchronous"),
         clEnumValN(
             BetweennessCentralityPlan::kOuter, "Outer",
-            "Outer parallel algorithm")
+            "Outer parallel algorithm"),
+        clEnumValN(
+            BetweennessCentralityPlan::kMultiSource, "MultiSource",
+            "Level parallel algorithm for 64 sources at a time"),
+        clEnumValN(
+            BetweennessCentralityPlan::kApproximate, "Approximate",
+            "Approximation from sampled shortest paths")
         // clEnumValN(BetweennessCentralityPlan::kAutoAlgo, "Auto", "Auto: choose among the algorithms automatically")
         ),
     cll::init(BetweennessCentralityPlan::kLevel));
+static cll::opt<double> epsilon(
+    "epsilon",
+    cll::desc("Largest error of the Approximate algorithm as a fraction of "
+              "the number of node pairs (default 0.01)"),
+    cll::init(BetweennessCentralityPlan::kDefaultEpsilon));
+static cll::opt<double> delta(
+    "delta",
+    cll::desc("Probability that the Approximate algorithm exceeds -epsilon "
+              "(default 0.1)"),
+    cll::init(BetweennessCentralityPlan::kDefaultDelta));
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -91,6 +107,9 @@ main(int argc, char** argv) {
 
   BetweennessCentralityPlan plan =
       BetweennessCentralityPlan::FromAlgorithm(algo);
+  if (algo == BetweennessCentralityPlan::kApproximate) {
+    plan = BetweennessCentralityPlan::Approximate(epsilon, delta);
+  }
 
   BetweennessCentralitySources sources = kBetweennessCentralityAllNodes;
   uint32_t num_sources = pg->num_nodes();
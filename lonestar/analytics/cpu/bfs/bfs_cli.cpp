@@ -69,9 +69,30 @@ static cll::opt<BfsPlan::Algorithm> algo(
             BfsPlan::kAsynchronousTile, "AsyncTile", "Asynchronous tiled"),
         clEnumValN(BfsPlan::kAsynchronous, "Async", "Asynchronous"),
         clEnumValN(BfsPlan::kSynchronousTile, "SyncTile", "Synchronous tiled"),
-        clEnumValN(BfsPlan::kSynchronous, "Sync", "Synchronous")),
+        clEnumValN(BfsPlan::kSynchronous, "Sync", "Synchronous"),
+        clEnumValN(
+            BfsPlan::kDirectionOptimizing, "DirectionOpt",
+            "Direction-optimizing"),
+        clEnumValN(
+            BfsPlan::kAutomatic, "Automatic",
+            "Choose based on the degree distribution of the graph")),
     cll::init(BfsPlan::kSynchronousTile));
 
+static cll::opt<uint32_t> alpha(
+    "alpha",
+    cll::desc(
+        "Switch to bottom-up steps when the frontier has more than 1/alpha "
+        "of the unexplored edges; only used by DirectionOpt (default value "
+        "15)"),
+    cll::init(15));
+
+static cll::opt<uint32_t> beta(
+    "beta",
+    cll::desc(
+        "Switch back to top-down steps when the frontier has fewer than "
+        "1/beta of the nodes; only used by DirectionOpt (default value 18)"),
+    cll::init(18));
+
 std::string
 AlgorithmName(BfsPlan::Algorithm algorithm) {
   switch (algorithm) {
@@ -83,6 +104,10 @@ AlgorithmName(BfsPlan::Algorithm algorithm) {
     return "SyncTile";
   case BfsPlan::kSynchronous:
     return "Sync";
+  case BfsPlan::kDirectionOptimizing:
+    return "DirectionOpt";
+  case BfsPlan::kAutomatic:
+    return "Automatic";
   default:
     return "Unknown";
   }
@@ -143,6 +168,12 @@ main(int argc, char** argv) {
   case BfsPlan::kSynchronousTile:
     plan = BfsPlan::SynchronousTile();
     break;
+  case BfsPlan::kDirectionOptimizing:
+    plan = BfsPlan::DirectionOptimizing(alpha, beta);
+    break;
+  case BfsPlan::kAutomatic:
+    plan = BfsPlan::Automatic();
+    break;
   }
 
   for (auto startNode : startNodes) {
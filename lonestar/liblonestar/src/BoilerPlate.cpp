@@ -22,6 +22,7 @@
 #include <sstream>
 
 #include "katana/SharedMemSys.h"
+#include "katana/Tracing.h"
 
 //! standard global options to the benchmarks
 llvm::cl::opt<bool> skipVerify(
@@ -34,6 +35,12 @@ llvm::cl::opt<std::string> statFile(
     "statFile",
     llvm::cl::desc("ouput file to print stats to (default value empty)"),
     llvm::cl::init(""));
+llvm::cl::opt<std::string> traceFile(
+    "traceFile",
+    llvm::cl::desc(
+        "output file to write a Chrome trace-event timeline of loops, timers "
+        "and storage requests to (default value empty)"),
+    llvm::cl::init(""));
 
 //! Flag that forces user to be aware that they should be passing in a
 //! symmetric graph.
@@ -82,6 +89,9 @@ LonestarStart(
   numThreads = katana::setActiveThreads(numThreads);
 
   katana::SetStatFile(statFile);
+  if (!traceFile.empty()) {
+    katana::StartTracing(traceFile);
+  }
 
   LonestarPrintVersion(llvm::outs());
   llvm::outs() << "Copyright (C) " << katana::getCopyrightYear()
@@ -9,13 +9,78 @@ from katana.analytics._connected_components import (
     ConnectedComponentsPlan,
     ConnectedComponentsStatistics,
 )
-from katana.analytics._k_core import k_core, k_core_assert_valid, KCorePlan, KCoreStatistics
-from katana.analytics._k_truss import k_truss, k_truss_assert_valid, KTrussPlan, KTrussStatistics
-from katana.analytics._pagerank import pagerank, pagerank_assert_valid, PagerankPlan, PagerankStatistics
+from katana.analytics._graph_coloring import (
+    graph_coloring,
+    graph_coloring_assert_valid,
+    GraphColoringPlan,
+    GraphColoringStatistics,
+)
+from katana.analytics._k_core import (
+    k_core,
+    k_core_assert_valid,
+    k_core_decomposition,
+    k_core_decomposition_assert_valid,
+    KCoreDecompositionStatistics,
+    KCorePlan,
+    KCoreStatistics,
+)
+from katana.analytics._k_truss import (
+    k_truss,
+    k_truss_assert_valid,
+    k_truss_decomposition,
+    k_truss_decomposition_assert_valid,
+    KTrussDecompositionStatistics,
+    KTrussPlan,
+    KTrussStatistics,
+)
+from katana.analytics._louvain_clustering import (
+    louvain_clustering,
+    louvain_clustering_assert_valid,
+    LouvainClusteringPlan,
+    LouvainClusteringStatistics,
+)
+from katana.analytics._matrix_completion import (
+    matrix_completion,
+    matrix_completion_assert_valid,
+    MatrixCompletionPlan,
+    MatrixCompletionStatistics,
+)
+from katana.analytics._minimum_spanning_forest import (
+    minimum_spanning_forest,
+    minimum_spanning_forest_assert_valid,
+    MinimumSpanningForestPlan,
+    MinimumSpanningForestStatistics,
+)
+from katana.analytics._pagerank import (
+    pagerank,
+    pagerank_incremental,
+    pagerank_assert_valid,
+    PagerankPlan,
+    PagerankStatistics,
+)
+from katana.analytics._partition import (
+    partition,
+    partition_assert_valid,
+    PartitionPlan,
+    PartitionStatistics,
+)
+from katana.analytics._random_walks import (
+    random_walks,
+    random_walks_assert_valid,
+    random_walks_to_parquet,
+    RandomWalksPlan,
+)
 from katana.analytics._triangle_count import triangle_count, TriangleCountPlan
-from katana.analytics._bfs import bfs, bfs_assert_valid, BfsPlan, BfsStatistics
+from katana.analytics._bfs import bfs, bfs_assert_valid, bfs_batch, bfs_batch_reduce, BfsPlan, BfsStatistics
 from katana.analytics._sssp import sssp, sssp_assert_valid, SsspPlan, SsspStatistics
+from katana.analytics._strongly_connected_components import (
+    strongly_connected_components,
+    strongly_connected_components_assert_valid,
+    StronglyConnectedComponentsPlan,
+    StronglyConnectedComponentsStatistics,
+)
 from katana.analytics._wrappers import find_edge_sorted_by_dest, sort_all_edges_by_dest, sort_nodes_by_degree
+from katana.analytics._wrappers import reorder_graph, ReorderPlan
 from katana.analytics._wrappers import jaccard, jaccard_assert_valid, JaccardPlan, JaccardStatistics
 from katana.analytics._independent_set import (
     independent_set,
@@ -1,6 +1,6 @@
 from libcpp.vector cimport vector
 from libcpp.string cimport string
-from libc.stdint cimport uint32_t
+from libc.stdint cimport uint32_t, uint64_t
 
 from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
 from katana.cpp.libstd.iostream cimport ostringstream, ostream
@@ -19,8 +19,12 @@ cdef extern from "katana/analytics/betweenness_centrality/betweenness_centrality
         enum Algorithm:
             kOuter "katana::analytics::BetweennessCentralityPlan::kOuter"
             kLevel "katana::analytics::BetweennessCentralityPlan::kLevel"
+            kMultiSource "katana::analytics::BetweennessCentralityPlan::kMultiSource"
+            kApproximate "katana::analytics::BetweennessCentralityPlan::kApproximate"
 
         _BetweennessCentralityPlan.Algorithm algorithm() const
+        double epsilon() const
+        double delta() const
 
         BetweennessCentralityPlan()
 
@@ -29,8 +33,15 @@ cdef extern from "katana/analytics/betweenness_centrality/betweenness_centrality
         @staticmethod
         _BetweennessCentralityPlan Outer()
         @staticmethod
+        _BetweennessCentralityPlan MultiSource()
+        @staticmethod
+        _BetweennessCentralityPlan Approximate(double epsilon, double delta)
+        @staticmethod
         _BetweennessCentralityPlan FromAlgorithm(_BetweennessCentralityPlan.Algorithm algo)
 
+    double kDefaultEpsilon "katana::analytics::BetweennessCentralityPlan::kDefaultEpsilon"
+    double kDefaultDelta "katana::analytics::BetweennessCentralityPlan::kDefaultDelta"
+
     BetweennessCentralitySources kBetweennessCentralityAllNodes;
 
     std_result[void] BetweennessCentrality(_PropertyGraph* pg, string output_property_name, const BetweennessCentralitySources& sources, _BetweennessCentralityPlan plan)
@@ -41,6 +52,7 @@ cdef extern from "katana/analytics/betweenness_centrality/betweenness_centrality
         float max_centrality
         float min_centrality
         float average_centrality
+        uint64_t num_samples
 
         void Print(ostream os)
 
@@ -64,6 +76,8 @@ cdef extern from * nogil:
 class _BetweennessCentralityPlanAlgorithm(Enum):
     Outer = _BetweennessCentralityPlan.Algorithm.kOuter
     Level = _BetweennessCentralityPlan.Algorithm.kLevel
+    MultiSource = _BetweennessCentralityPlan.Algorithm.kMultiSource
+    Approximate = _BetweennessCentralityPlan.Algorithm.kApproximate
 
 
 cdef class BetweennessCentralityPlan(Plan):
@@ -85,6 +99,14 @@ cdef class BetweennessCentralityPlan(Plan):
     def algorithm(self) -> _BetweennessCentralityPlanAlgorithm:
         return _BetweennessCentralityPlanAlgorithm(self.underlying_.algorithm())
 
+    @property
+    def epsilon(self) -> double:
+        return self.underlying_.epsilon()
+
+    @property
+    def delta(self) -> double:
+        return self.underlying_.delta()
+
     @staticmethod
     def outer():
         return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.Outer())
@@ -93,6 +115,18 @@ cdef class BetweennessCentralityPlan(Plan):
     def level():
         return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.Level())
 
+    @staticmethod
+    def multi_source():
+        return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.MultiSource())
+
+    @staticmethod
+    def approximate(double epsilon = kDefaultEpsilon, double delta = kDefaultDelta):
+        """
+        Approximate the centrality from sampled shortest paths. With probability at least 1 - delta, every node is
+        within epsilon * n * (n - 1) of its exact centrality.
+        """
+        return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.Approximate(epsilon, delta))
+
 
 def betweenness_centrality(PropertyGraph pg, str output_property_name, sources = None,
              BetweennessCentralityPlan plan = BetweennessCentralityPlan()):
@@ -146,6 +180,10 @@ cdef class BetweennessCentralityStatistics:
     def average_centrality(self) -> float:
         return self.underlying.average_centrality
 
+    @property
+    def num_samples(self) -> int:
+        return self.underlying.num_samples
+
     def __str__(self) -> str:
         cdef ostringstream ss
         self.underlying.Print(ss)
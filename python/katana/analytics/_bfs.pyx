@@ -1,6 +1,7 @@
 from libc.stddef cimport ptrdiff_t
 from libc.stdint cimport uint64_t, uint32_t
 from libcpp.string cimport string
+from libcpp.vector cimport vector
 
 from katana.cpp.libstd.boost cimport std_result, handle_result_void, handle_result_assert, raise_error_code
 from katana.cpp.libstd.iostream cimport ostream, ostringstream
@@ -17,9 +18,16 @@ cdef extern from "katana/Analytics.h" namespace "katana::analytics" nogil:
             kAsynchronous "katana::analytics::BfsPlan::kAsynchronous"
             kSynchronousTile "katana::analytics::BfsPlan::kSynchronousTile"
             kSynchronous "katana::analytics::BfsPlan::kSynchronous"
+            kDirectionOptimizing "katana::analytics::BfsPlan::kDirectionOptimizing"
+            kAutomatic "katana::analytics::BfsPlan::kAutomatic"
+
+        _BfsPlan()
+        _BfsPlan(const _PropertyGraph * pg)
 
         _BfsPlan.Algorithm algorithm() const
         ptrdiff_t edge_tile_size() const
+        uint32_t alpha() const
+        uint32_t beta() const
 
         @staticmethod
         _BfsPlan AsynchronousTile(ptrdiff_t edge_tile_size)
@@ -33,7 +41,15 @@ cdef extern from "katana/Analytics.h" namespace "katana::analytics" nogil:
         @staticmethod
         _BfsPlan Synchronous()
 
+        @staticmethod
+        _BfsPlan DirectionOptimizing(uint32_t alpha, uint32_t beta)
+
+        @staticmethod
+        _BfsPlan Automatic()
+
     ptrdiff_t kDefaultEdgeTileSize "katana::analytics::BfsPlan::kDefaultEdgeTileSize"
+    uint32_t kDefaultAlpha "katana::analytics::BfsPlan::kDefaultAlpha"
+    uint32_t kDefaultBeta "katana::analytics::BfsPlan::kDefaultBeta"
 
     std_result[void] Bfs(_PropertyGraph * pg,
                          size_t start_node,
@@ -57,11 +73,20 @@ cdef extern from "katana/Analytics.h" namespace "katana::analytics" nogil:
         std_result[_BfsStatistics] Compute(_PropertyGraph* pg,
                                            string property_name);
 
+    std_result[void] BfsBatch(_PropertyGraph* pg,
+                              const vector[uint32_t]& sources,
+                              const vector[string]& output_property_names)
+
+    std_result[vector[_BfsStatistics]] BfsBatchReduce(_PropertyGraph* pg,
+                                                      const vector[uint32_t]& sources)
+
 class _BfsAlgorithm(Enum):
     AsynchronousTile = _BfsPlan.Algorithm.kAsynchronousTile
     Asynchronous = _BfsPlan.Algorithm.kAsynchronous
     SynchronousTile = _BfsPlan.Algorithm.kSynchronousTile
     Synchronous = _BfsPlan.Algorithm.kSynchronous
+    DirectionOptimizing = _BfsPlan.Algorithm.kDirectionOptimizing
+    Automatic = _BfsPlan.Algorithm.kAutomatic
 
 
 cdef class BfsPlan(Plan):
@@ -77,6 +102,14 @@ cdef class BfsPlan(Plan):
         f.underlying_ = u
         return f
 
+    def __init__(self, graph = None):
+        if graph is None:
+            self.underlying_ = _BfsPlan()
+        else:
+            if not isinstance(graph, PropertyGraph):
+                raise TypeError(graph)
+            self.underlying_ = _BfsPlan((<PropertyGraph>graph).underlying.get())
+
     Algorithm = _BfsAlgorithm
 
     @property
@@ -87,6 +120,14 @@ cdef class BfsPlan(Plan):
     def edge_tile_size(self) -> int:
         return self.underlying_.edge_tile_size()
 
+    @property
+    def alpha(self) -> int:
+        return self.underlying_.alpha()
+
+    @property
+    def beta(self) -> int:
+        return self.underlying_.beta()
+
     @staticmethod
     def asynchronous_tile(edge_tile_size=kDefaultEdgeTileSize):
         return BfsPlan.make(_BfsPlan.AsynchronousTile(edge_tile_size))
@@ -103,6 +144,14 @@ cdef class BfsPlan(Plan):
     def synchronous():
         return BfsPlan.make(_BfsPlan.Synchronous())
 
+    @staticmethod
+    def direction_optimizing(uint32_t alpha=kDefaultAlpha, uint32_t beta=kDefaultBeta):
+        return BfsPlan.make(_BfsPlan.DirectionOptimizing(alpha, beta))
+
+    @staticmethod
+    def automatic():
+        return BfsPlan.make(_BfsPlan.Automatic())
+
 
 def bfs(PropertyGraph pg, size_t start_node, str output_property_name, BfsPlan plan = BfsPlan()):
     output_property_name_bytes = bytes(output_property_name, "utf-8")
@@ -131,6 +180,12 @@ cdef class BfsStatistics:
         with nogil:
             self.underlying = handle_result_BfsStatistics(_BfsStatistics.Compute(pg.underlying.get(), output_property_name_cstr))
 
+    @staticmethod
+    cdef BfsStatistics make(_BfsStatistics u):
+        f = <BfsStatistics>BfsStatistics.__new__(BfsStatistics)
+        f.underlying = u
+        return f
+
     @property
     def source_node(self):
         return self.underlying.source_node
@@ -155,3 +210,30 @@ cdef class BfsStatistics:
         cdef ostringstream ss
         self.underlying.Print(ss)
         return str(ss.str(), "ascii")
+
+def bfs_batch(PropertyGraph pg, sources, output_property_names):
+    """
+    Compute the BFS level of every node from each of sources together, storing the levels from sources[i] in the
+    property output_property_names[i]. The levels are the same as bfs produces.
+    """
+    cdef vector[uint32_t] sources_vec = sources
+    cdef vector[string] output_property_names_vec = [bytes(name, "utf-8") for name in output_property_names]
+    with nogil:
+        handle_result_void(BfsBatch(pg.underlying.get(), sources_vec, output_property_names_vec))
+
+cdef vector[_BfsStatistics] handle_result_BfsStatistics_vector(std_result[vector[_BfsStatistics]] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+def bfs_batch_reduce(PropertyGraph pg, sources) -> list:
+    """
+    Search from each of sources together like bfs_batch, but only return the BfsStatistics of each search instead
+    of storing its levels.
+    """
+    cdef vector[uint32_t] sources_vec = sources
+    cdef vector[_BfsStatistics] statistics
+    with nogil:
+        statistics = handle_result_BfsStatistics_vector(BfsBatchReduce(pg.underlying.get(), sources_vec))
+    return [BfsStatistics.make(s) for s in statistics]
@@ -0,0 +1,130 @@
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp.string cimport string
+from libcpp.vector cimport vector
+
+from katana.analytics.plan cimport Plan, _Plan
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/graph_coloring/graph_coloring.h" namespace "katana::analytics" nogil:
+    cppclass _GraphColoringPlan "katana::analytics::GraphColoringPlan"(_Plan):
+        enum Algorithm:
+            kSpeculative "katana::analytics::GraphColoringPlan::kSpeculative"
+            kJonesPlassmann "katana::analytics::GraphColoringPlan::kJonesPlassmann"
+            kLargestDegreeFirst "katana::analytics::GraphColoringPlan::kLargestDegreeFirst"
+
+        _GraphColoringPlan.Algorithm algorithm() const
+
+        GraphColoringPlan()
+
+        @staticmethod
+        _GraphColoringPlan Speculative()
+
+        @staticmethod
+        _GraphColoringPlan JonesPlassmann()
+
+        @staticmethod
+        _GraphColoringPlan LargestDegreeFirst()
+
+    std_result[void] GraphColoring(_PropertyGraph*pg, string output_property_name, _GraphColoringPlan plan)
+
+    std_result[void] GraphColoringAssertValid(_PropertyGraph*pg, string property_name)
+
+    cppclass _GraphColoringStatistics "katana::analytics::GraphColoringStatistics":
+        uint32_t num_colors
+        vector[uint64_t] color_class_sizes
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_GraphColoringStatistics] Compute(_PropertyGraph*pg, string property_name)
+
+
+class _GraphColoringPlanAlgorithm(Enum):
+    Speculative = _GraphColoringPlan.Algorithm.kSpeculative
+    JonesPlassmann = _GraphColoringPlan.Algorithm.kJonesPlassmann
+    LargestDegreeFirst = _GraphColoringPlan.Algorithm.kLargestDegreeFirst
+
+
+cdef class GraphColoringPlan(Plan):
+    cdef:
+        _GraphColoringPlan underlying_
+
+    cdef _Plan*underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _GraphColoringPlanAlgorithm
+
+    @staticmethod
+    cdef GraphColoringPlan make(_GraphColoringPlan u):
+        f = <GraphColoringPlan> GraphColoringPlan.__new__(GraphColoringPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _GraphColoringPlanAlgorithm:
+        return _GraphColoringPlanAlgorithm(self.underlying_.algorithm())
+
+    @staticmethod
+    def speculative() -> GraphColoringPlan:
+        return GraphColoringPlan.make(_GraphColoringPlan.Speculative())
+
+    @staticmethod
+    def jones_plassmann() -> GraphColoringPlan:
+        return GraphColoringPlan.make(_GraphColoringPlan.JonesPlassmann())
+
+    @staticmethod
+    def largest_degree_first() -> GraphColoringPlan:
+        return GraphColoringPlan.make(_GraphColoringPlan.LargestDegreeFirst())
+
+
+def graph_coloring(PropertyGraph pg, str output_property_name, GraphColoringPlan plan = GraphColoringPlan()):
+    """
+    Color the nodes of the symmetric graph pg so that no two neighbors have the same color, and store the color of
+    each node, numbered from 0, in the new uint32 node property output_property_name. Self loops are ignored.
+    """
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        handle_result_void(GraphColoring(pg.underlying.get(), output_property_name_str, plan.underlying_))
+
+
+def graph_coloring_assert_valid(PropertyGraph pg, str property_name):
+    cdef string property_name_str = property_name.encode("utf-8")
+    with nogil:
+        handle_result_assert(GraphColoringAssertValid(pg.underlying.get(), property_name_str))
+
+
+cdef _GraphColoringStatistics handle_result_GraphColoringStatistics(
+        std_result[_GraphColoringStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class GraphColoringStatistics:
+    cdef _GraphColoringStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str property_name):
+        cdef string property_name_str = property_name.encode("utf-8")
+        with nogil:
+            self.underlying = handle_result_GraphColoringStatistics(
+                _GraphColoringStatistics.Compute(pg.underlying.get(), property_name_str))
+
+    @property
+    def num_colors(self) -> uint32_t:
+        return self.underlying.num_colors
+
+    @property
+    def color_class_sizes(self) -> list:
+        return self.underlying.color_class_sizes
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
@@ -1,5 +1,6 @@
 from libc.stdint cimport uint32_t, uint64_t
 from libcpp.string cimport string
+from libcpp.vector cimport vector
 
 from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
 from katana.cpp.libstd.iostream cimport ostream, ostringstream
@@ -38,6 +39,21 @@ cdef extern from "katana/analytics/k_core/k_core.h" namespace "katana::analytics
         @staticmethod
         std_result[_KCoreStatistics] Compute(_PropertyGraph* pg, uint32_t k_core_number, string output_property_name)
 
+    std_result[void] KCoreDecomposition(_PropertyGraph* pg, string output_property_name, _KCorePlan plan)
+
+    std_result[void] KCoreDecompositionAssertValid(_PropertyGraph* pg, string output_property_name)
+
+    cppclass _KCoreDecompositionStatistics "katana::analytics::KCoreDecompositionStatistics":
+        uint32_t max_core_number
+        vector[uint64_t] core_number_histogram
+
+        uint64_t CoreSize(uint32_t k) const
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_KCoreDecompositionStatistics] Compute(_PropertyGraph* pg, string output_property_name)
+
 
 class _KCorePlanAlgorithm(Enum):
     Synchronous = _KCorePlan.Algorithm.kSynchronous
@@ -108,3 +124,55 @@ cdef class KCoreStatistics:
         cdef ostringstream ss
         self.underlying.Print(ss)
         return str(ss.str(), "ascii")
+
+
+def k_core_decomposition(PropertyGraph pg, str output_property_name, KCorePlan plan = KCorePlan()) -> int:
+    """
+    Compute the core number of every node of pg, i.e., the largest k such that the node is in the k-core, and store
+    it in the uint32 property output_property_name. The graph must be symmetric.
+    """
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        v = handle_result_void(KCoreDecomposition(pg.underlying.get(), output_property_name_str, plan.underlying_))
+    return v
+
+
+def k_core_decomposition_assert_valid(PropertyGraph pg, str output_property_name):
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        handle_result_assert(KCoreDecompositionAssertValid(pg.underlying.get(), output_property_name_str))
+
+
+cdef _KCoreDecompositionStatistics handle_result_KCoreDecompositionStatistics(
+        std_result[_KCoreDecompositionStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class KCoreDecompositionStatistics:
+    cdef _KCoreDecompositionStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str output_property_name):
+        cdef string output_property_name_str = output_property_name.encode("utf-8")
+        with nogil:
+            self.underlying = handle_result_KCoreDecompositionStatistics(_KCoreDecompositionStatistics.Compute(
+                pg.underlying.get(), output_property_name_str))
+
+    @property
+    def max_core_number(self) -> uint32_t:
+        return self.underlying.max_core_number
+
+    @property
+    def core_number_histogram(self) -> list:
+        return list(self.underlying.core_number_histogram)
+
+    def core_size(self, uint32_t k) -> uint64_t:
+        """The number of nodes in the k-core"""
+        return self.underlying.CoreSize(k)
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
@@ -1,5 +1,6 @@
 from libc.stdint cimport uint32_t, uint64_t
 from libcpp.string cimport string
+from libcpp.vector cimport vector
 
 from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
 from katana.cpp.libstd.iostream cimport ostream, ostringstream
@@ -42,6 +43,21 @@ cdef extern from "katana/analytics/k_truss/k_truss.h" namespace "katana::analyti
         std_result[_KTrussStatistics] Compute(_PropertyGraph* pg, uint32_t k_truss_number,
                                              string output_property_name)
 
+    std_result[void] KTrussDecomposition(_PropertyGraph* pg, string output_property_name)
+
+    std_result[void] KTrussDecompositionAssertValid(_PropertyGraph* pg, string output_property_name)
+
+    cppclass _KTrussDecompositionStatistics "katana::analytics::KTrussDecompositionStatistics":
+        uint32_t max_trussness
+        vector[uint64_t] trussness_histogram
+
+        uint64_t TrussSize(uint32_t k) const
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_KTrussDecompositionStatistics] Compute(_PropertyGraph* pg, string output_property_name)
+
 
 class _KTrussPlanAlgorithm(Enum):
     Bsp = _KTrussPlan.Algorithm.kBsp
@@ -116,3 +132,56 @@ cdef class KTrussStatistics:
         cdef ostringstream ss
         self.underlying.Print(ss)
         return str(ss.str(), "ascii")
+
+
+def k_truss_decomposition(PropertyGraph pg, str output_property_name) -> int:
+    """
+    Compute the trussness of every edge of pg, i.e., the largest k such that the edge is in the k-truss, and store it
+    in the uint32 edge property output_property_name. The graph must be symmetric. Like k_truss, this sorts the edges
+    of pg by destination.
+    """
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        v = handle_result_void(KTrussDecomposition(pg.underlying.get(), output_property_name_str))
+    return v
+
+
+def k_truss_decomposition_assert_valid(PropertyGraph pg, str output_property_name):
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        handle_result_assert(KTrussDecompositionAssertValid(pg.underlying.get(), output_property_name_str))
+
+
+cdef _KTrussDecompositionStatistics handle_result_KTrussDecompositionStatistics(
+        std_result[_KTrussDecompositionStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class KTrussDecompositionStatistics:
+    cdef _KTrussDecompositionStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str output_property_name):
+        cdef string output_property_name_str = output_property_name.encode("utf-8")
+        with nogil:
+            self.underlying = handle_result_KTrussDecompositionStatistics(_KTrussDecompositionStatistics.Compute(
+                pg.underlying.get(), output_property_name_str))
+
+    @property
+    def max_trussness(self) -> uint32_t:
+        return self.underlying.max_trussness
+
+    @property
+    def trussness_histogram(self) -> list:
+        return list(self.underlying.trussness_histogram)
+
+    def truss_size(self, uint32_t k) -> uint64_t:
+        """The number of edges in the k-truss, counting each edge once"""
+        return self.underlying.TrussSize(k)
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
@@ -0,0 +1,181 @@
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp.string cimport string
+
+from katana.analytics.plan cimport Plan, _Plan
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/louvain_clustering/louvain_clustering.h" namespace "katana::analytics" nogil:
+    cppclass _LouvainClusteringPlan "katana::analytics::LouvainClusteringPlan"(_Plan):
+        enum Algorithm:
+            kDoAll "katana::analytics::LouvainClusteringPlan::kDoAll"
+            kLeiden "katana::analytics::LouvainClusteringPlan::kLeiden"
+
+        _LouvainClusteringPlan.Algorithm algorithm() const
+        double resolution() const
+        uint32_t max_levels() const
+        uint32_t max_iterations() const
+        double min_modularity_gain() const
+        double randomness() const
+
+        LouvainClusteringPlan()
+
+        @staticmethod
+        _LouvainClusteringPlan DoAll(double resolution, uint32_t max_levels, uint32_t max_iterations,
+                                     double min_modularity_gain)
+
+        @staticmethod
+        _LouvainClusteringPlan Leiden(double resolution, uint32_t max_levels, uint32_t max_iterations,
+                                      double min_modularity_gain, double randomness)
+
+    double kDefaultResolution "katana::analytics::LouvainClusteringPlan::kDefaultResolution"
+    uint32_t kDefaultMaxLevels "katana::analytics::LouvainClusteringPlan::kDefaultMaxLevels"
+    uint32_t kDefaultMaxIterations "katana::analytics::LouvainClusteringPlan::kDefaultMaxIterations"
+    double kDefaultMinModularityGain "katana::analytics::LouvainClusteringPlan::kDefaultMinModularityGain"
+    double kDefaultRandomness "katana::analytics::LouvainClusteringPlan::kDefaultRandomness"
+
+    std_result[void] LouvainClustering(_PropertyGraph*pg, string edge_weight_property_name,
+                                       string output_property_name, _LouvainClusteringPlan plan)
+
+    std_result[void] LouvainClusteringAssertValid(_PropertyGraph*pg, string output_property_name)
+
+    cppclass _LouvainClusteringStatistics "katana::analytics::LouvainClusteringStatistics":
+        uint64_t n_clusters
+        uint64_t n_non_trivial_clusters
+        uint64_t largest_cluster_size
+        double largest_cluster_proportion
+        double modularity
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_LouvainClusteringStatistics] Compute(_PropertyGraph*pg, string edge_weight_property_name,
+                                                         string output_property_name)
+
+
+class _LouvainClusteringPlanAlgorithm(Enum):
+    DoAll = _LouvainClusteringPlan.Algorithm.kDoAll
+    Leiden = _LouvainClusteringPlan.Algorithm.kLeiden
+
+
+cdef class LouvainClusteringPlan(Plan):
+    cdef:
+        _LouvainClusteringPlan underlying_
+
+    cdef _Plan*underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _LouvainClusteringPlanAlgorithm
+
+    @staticmethod
+    cdef LouvainClusteringPlan make(_LouvainClusteringPlan u):
+        f = <LouvainClusteringPlan> LouvainClusteringPlan.__new__(LouvainClusteringPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _LouvainClusteringPlanAlgorithm:
+        return _LouvainClusteringPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def resolution(self) -> double:
+        return self.underlying_.resolution()
+
+    @property
+    def max_levels(self) -> uint32_t:
+        return self.underlying_.max_levels()
+
+    @property
+    def max_iterations(self) -> uint32_t:
+        return self.underlying_.max_iterations()
+
+    @property
+    def min_modularity_gain(self) -> double:
+        return self.underlying_.min_modularity_gain()
+
+    @property
+    def randomness(self) -> double:
+        return self.underlying_.randomness()
+
+    @staticmethod
+    def do_all(double resolution = kDefaultResolution, uint32_t max_levels = kDefaultMaxLevels,
+               uint32_t max_iterations = kDefaultMaxIterations,
+               double min_modularity_gain = kDefaultMinModularityGain) -> LouvainClusteringPlan:
+        return LouvainClusteringPlan.make(_LouvainClusteringPlan.DoAll(
+            resolution, max_levels, max_iterations, min_modularity_gain))
+
+    @staticmethod
+    def leiden(double resolution = kDefaultResolution, uint32_t max_levels = kDefaultMaxLevels,
+               uint32_t max_iterations = kDefaultMaxIterations,
+               double min_modularity_gain = kDefaultMinModularityGain,
+               double randomness = kDefaultRandomness) -> LouvainClusteringPlan:
+        return LouvainClusteringPlan.make(_LouvainClusteringPlan.Leiden(
+            resolution, max_levels, max_iterations, min_modularity_gain, randomness))
+
+
+def louvain_clustering(PropertyGraph pg, str edge_weight_property_name, str output_property_name,
+                       LouvainClusteringPlan plan = LouvainClusteringPlan()) -> int:
+    """
+    Cluster the nodes of the symmetric graph pg to maximize modularity and number the cluster of each node from 0 in
+    the uint64 property output_property_name. The edge weights are in edge_weight_property_name, or are all 1 if it is
+    empty.
+    """
+    cdef string edge_weight_property_name_str = edge_weight_property_name.encode("utf-8")
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        v = handle_result_void(LouvainClustering(pg.underlying.get(), edge_weight_property_name_str,
+                                                 output_property_name_str, plan.underlying_))
+    return v
+
+def louvain_clustering_assert_valid(PropertyGraph pg, str output_property_name):
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        handle_result_assert(LouvainClusteringAssertValid(pg.underlying.get(), output_property_name_str))
+
+cdef _LouvainClusteringStatistics handle_result_LouvainClusteringStatistics(
+        std_result[_LouvainClusteringStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+cdef class LouvainClusteringStatistics:
+    cdef _LouvainClusteringStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str edge_weight_property_name, str output_property_name):
+        cdef string edge_weight_property_name_str = edge_weight_property_name.encode("utf-8")
+        cdef string output_property_name_str = output_property_name.encode("utf-8")
+        with nogil:
+            self.underlying = handle_result_LouvainClusteringStatistics(
+                _LouvainClusteringStatistics.Compute(pg.underlying.get(), edge_weight_property_name_str,
+                                                     output_property_name_str))
+
+    @property
+    def n_clusters(self) -> uint64_t:
+        return self.underlying.n_clusters
+
+    @property
+    def n_non_trivial_clusters(self) -> uint64_t:
+        return self.underlying.n_non_trivial_clusters
+
+    @property
+    def largest_cluster_size(self) -> uint64_t:
+        return self.underlying.largest_cluster_size
+
+    @property
+    def largest_cluster_proportion(self) -> double:
+        return self.underlying.largest_cluster_proportion
+
+    @property
+    def modularity(self) -> double:
+        return self.underlying.modularity
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
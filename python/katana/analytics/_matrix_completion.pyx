@@ -0,0 +1,246 @@
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp.string cimport string
+
+from katana.analytics.plan cimport Plan, _Plan
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/matrix_completion/matrix_completion.h" namespace "katana::analytics" nogil:
+    cppclass _MatrixCompletionPlan "katana::analytics::MatrixCompletionPlan"(_Plan):
+        enum Algorithm:
+            kSGDByEdges "katana::analytics::MatrixCompletionPlan::kSGDByEdges"
+            kSGDByItems "katana::analytics::MatrixCompletionPlan::kSGDByItems"
+            kALS "katana::analytics::MatrixCompletionPlan::kALS"
+
+        enum StepFunction:
+            kBottou "katana::analytics::MatrixCompletionPlan::kBottou"
+            kIntel "katana::analytics::MatrixCompletionPlan::kIntel"
+            kInverse "katana::analytics::MatrixCompletionPlan::kInverse"
+            kPurdue "katana::analytics::MatrixCompletionPlan::kPurdue"
+
+        _MatrixCompletionPlan.Algorithm algorithm() const
+        uint32_t latent_vector_size() const
+        double learning_rate() const
+        double decay_rate() const
+        double lambda_ "lambda"() const
+        _MatrixCompletionPlan.StepFunction step_function() const
+        double tolerance() const
+        uint32_t max_rounds() const
+        uint32_t items_per_block() const
+        uint32_t users_per_block() const
+        uint64_t seed() const
+
+        MatrixCompletionPlan()
+
+        @staticmethod
+        _MatrixCompletionPlan SGDByEdges(uint32_t latent_vector_size, double learning_rate, double decay_rate,
+                                         double lambda_, _MatrixCompletionPlan.StepFunction step_function,
+                                         double tolerance, uint32_t max_rounds, uint32_t items_per_block,
+                                         uint32_t users_per_block, uint64_t seed)
+
+        @staticmethod
+        _MatrixCompletionPlan SGDByItems(uint32_t latent_vector_size, double learning_rate, double decay_rate,
+                                         double lambda_, _MatrixCompletionPlan.StepFunction step_function,
+                                         double tolerance, uint32_t max_rounds, uint64_t seed)
+
+        @staticmethod
+        _MatrixCompletionPlan ALS(uint32_t latent_vector_size, double lambda_, double tolerance, uint32_t max_rounds,
+                                  uint64_t seed)
+
+    uint32_t kDefaultLatentVectorSize "katana::analytics::MatrixCompletionPlan::kDefaultLatentVectorSize"
+    double kDefaultLearningRate "katana::analytics::MatrixCompletionPlan::kDefaultLearningRate"
+    double kDefaultDecayRate "katana::analytics::MatrixCompletionPlan::kDefaultDecayRate"
+    double kDefaultLambda "katana::analytics::MatrixCompletionPlan::kDefaultLambda"
+    double kDefaultTolerance "katana::analytics::MatrixCompletionPlan::kDefaultTolerance"
+    uint32_t kDefaultMaxRounds "katana::analytics::MatrixCompletionPlan::kDefaultMaxRounds"
+    uint32_t kDefaultItemsPerBlock "katana::analytics::MatrixCompletionPlan::kDefaultItemsPerBlock"
+    uint32_t kDefaultUsersPerBlock "katana::analytics::MatrixCompletionPlan::kDefaultUsersPerBlock"
+    uint64_t kDefaultSeed "katana::analytics::MatrixCompletionPlan::kDefaultSeed"
+
+    std_result[void] MatrixCompletion(_PropertyGraph*pg, string edge_rating_property_name,
+                                      string output_property_name, _MatrixCompletionPlan plan)
+
+    std_result[void] MatrixCompletionAssertValid(_PropertyGraph*pg, string property_name)
+
+    cppclass _MatrixCompletionStatistics "katana::analytics::MatrixCompletionStatistics":
+        uint64_t num_items
+        uint64_t num_users
+        double rmse
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_MatrixCompletionStatistics] Compute(_PropertyGraph*pg, string edge_rating_property_name,
+                                                        string property_name)
+
+
+class _MatrixCompletionPlanAlgorithm(Enum):
+    SGDByEdges = _MatrixCompletionPlan.Algorithm.kSGDByEdges
+    SGDByItems = _MatrixCompletionPlan.Algorithm.kSGDByItems
+    ALS = _MatrixCompletionPlan.Algorithm.kALS
+
+
+class _MatrixCompletionPlanStepFunction(Enum):
+    Bottou = _MatrixCompletionPlan.StepFunction.kBottou
+    Intel = _MatrixCompletionPlan.StepFunction.kIntel
+    Inverse = _MatrixCompletionPlan.StepFunction.kInverse
+    Purdue = _MatrixCompletionPlan.StepFunction.kPurdue
+
+
+cdef _MatrixCompletionPlan.StepFunction _step_function_to_cpp(step_function) except *:
+    cdef int value = _MatrixCompletionPlanStepFunction(step_function).value
+    return <_MatrixCompletionPlan.StepFunction> value
+
+
+cdef class MatrixCompletionPlan(Plan):
+    cdef:
+        _MatrixCompletionPlan underlying_
+
+    cdef _Plan*underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _MatrixCompletionPlanAlgorithm
+    StepFunction = _MatrixCompletionPlanStepFunction
+
+    @staticmethod
+    cdef MatrixCompletionPlan make(_MatrixCompletionPlan u):
+        f = <MatrixCompletionPlan> MatrixCompletionPlan.__new__(MatrixCompletionPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _MatrixCompletionPlanAlgorithm:
+        return _MatrixCompletionPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def latent_vector_size(self) -> uint32_t:
+        return self.underlying_.latent_vector_size()
+
+    @property
+    def learning_rate(self) -> double:
+        return self.underlying_.learning_rate()
+
+    @property
+    def decay_rate(self) -> double:
+        return self.underlying_.decay_rate()
+
+    @property
+    def lambda_(self) -> double:
+        return self.underlying_.lambda_()
+
+    @property
+    def step_function(self) -> _MatrixCompletionPlanStepFunction:
+        return _MatrixCompletionPlanStepFunction(self.underlying_.step_function())
+
+    @property
+    def tolerance(self) -> double:
+        return self.underlying_.tolerance()
+
+    @property
+    def max_rounds(self) -> uint32_t:
+        return self.underlying_.max_rounds()
+
+    @property
+    def items_per_block(self) -> uint32_t:
+        return self.underlying_.items_per_block()
+
+    @property
+    def users_per_block(self) -> uint32_t:
+        return self.underlying_.users_per_block()
+
+    @property
+    def seed(self) -> uint64_t:
+        return self.underlying_.seed()
+
+    @staticmethod
+    def sgd_by_edges(uint32_t latent_vector_size = kDefaultLatentVectorSize,
+                     double learning_rate = kDefaultLearningRate, double decay_rate = kDefaultDecayRate,
+                     double lambda_ = kDefaultLambda, step_function = _MatrixCompletionPlanStepFunction.Purdue,
+                     double tolerance = kDefaultTolerance, uint32_t max_rounds = kDefaultMaxRounds,
+                     uint32_t items_per_block = kDefaultItemsPerBlock,
+                     uint32_t users_per_block = kDefaultUsersPerBlock,
+                     uint64_t seed = kDefaultSeed) -> MatrixCompletionPlan:
+        return MatrixCompletionPlan.make(_MatrixCompletionPlan.SGDByEdges(
+            latent_vector_size, learning_rate, decay_rate, lambda_, _step_function_to_cpp(step_function), tolerance,
+            max_rounds, items_per_block, users_per_block, seed))
+
+    @staticmethod
+    def sgd_by_items(uint32_t latent_vector_size = kDefaultLatentVectorSize,
+                     double learning_rate = kDefaultLearningRate, double decay_rate = kDefaultDecayRate,
+                     double lambda_ = kDefaultLambda, step_function = _MatrixCompletionPlanStepFunction.Purdue,
+                     double tolerance = kDefaultTolerance, uint32_t max_rounds = kDefaultMaxRounds,
+                     uint64_t seed = kDefaultSeed) -> MatrixCompletionPlan:
+        return MatrixCompletionPlan.make(_MatrixCompletionPlan.SGDByItems(
+            latent_vector_size, learning_rate, decay_rate, lambda_, _step_function_to_cpp(step_function), tolerance,
+            max_rounds, seed))
+
+    @staticmethod
+    def als(uint32_t latent_vector_size = kDefaultLatentVectorSize, double lambda_ = kDefaultLambda,
+            double tolerance = kDefaultTolerance, uint32_t max_rounds = kDefaultMaxRounds,
+            uint64_t seed = kDefaultSeed) -> MatrixCompletionPlan:
+        return MatrixCompletionPlan.make(_MatrixCompletionPlan.ALS(
+            latent_vector_size, lambda_, tolerance, max_rounds, seed))
+
+
+def matrix_completion(PropertyGraph pg, str edge_rating_property_name, str output_property_name,
+                      MatrixCompletionPlan plan = MatrixCompletionPlan()):
+    """
+    Factor the ratings of the bipartite graph pg, in the numeric edge property edge_rating_property_name, into a
+    latent vector for every node, such that the dot product of the vectors of an item and a user approximates the
+    rating of their edge. Items are the nodes up to the last node with edges and every edge goes from an item to a
+    user. The vectors are stored in the new node property output_property_name as fixed size lists of
+    plan.latent_vector_size floats.
+    """
+    cdef string edge_rating_property_name_str = edge_rating_property_name.encode("utf-8")
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        handle_result_void(MatrixCompletion(pg.underlying.get(), edge_rating_property_name_str,
+                                            output_property_name_str, plan.underlying_))
+
+
+def matrix_completion_assert_valid(PropertyGraph pg, str property_name):
+    cdef string property_name_str = property_name.encode("utf-8")
+    with nogil:
+        handle_result_assert(MatrixCompletionAssertValid(pg.underlying.get(), property_name_str))
+
+
+cdef _MatrixCompletionStatistics handle_result_MatrixCompletionStatistics(
+        std_result[_MatrixCompletionStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class MatrixCompletionStatistics:
+    cdef _MatrixCompletionStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str edge_rating_property_name, str property_name):
+        cdef string edge_rating_property_name_str = edge_rating_property_name.encode("utf-8")
+        cdef string property_name_str = property_name.encode("utf-8")
+        with nogil:
+            self.underlying = handle_result_MatrixCompletionStatistics(
+                _MatrixCompletionStatistics.Compute(pg.underlying.get(), edge_rating_property_name_str,
+                                                    property_name_str))
+
+    @property
+    def num_items(self) -> uint64_t:
+        return self.underlying.num_items
+
+    @property
+    def num_users(self) -> uint64_t:
+        return self.underlying.num_users
+
+    @property
+    def rmse(self) -> double:
+        return self.underlying.rmse
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
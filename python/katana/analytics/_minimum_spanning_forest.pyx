@@ -0,0 +1,140 @@
+from libc.stdint cimport uint64_t
+from libcpp.string cimport string
+
+from katana.analytics.plan cimport Plan, _Plan
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/minimum_spanning_forest/minimum_spanning_forest.h" namespace "katana::analytics" nogil:
+    cppclass _MinimumSpanningForestPlan "katana::analytics::MinimumSpanningForestPlan"(_Plan):
+        enum Algorithm:
+            kBoruvka "katana::analytics::MinimumSpanningForestPlan::kBoruvka"
+            kFilterKruskal "katana::analytics::MinimumSpanningForestPlan::kFilterKruskal"
+
+        _MinimumSpanningForestPlan.Algorithm algorithm() const
+        uint64_t base_case_size() const
+
+        MinimumSpanningForestPlan()
+
+        @staticmethod
+        _MinimumSpanningForestPlan Boruvka()
+
+        @staticmethod
+        _MinimumSpanningForestPlan FilterKruskal(uint64_t base_case_size)
+
+    uint64_t kDefaultBaseCaseSize "katana::analytics::MinimumSpanningForestPlan::kDefaultBaseCaseSize"
+
+    std_result[void] MinimumSpanningForest(_PropertyGraph*pg, string edge_weight_property_name,
+                                           string output_property_name, _MinimumSpanningForestPlan plan)
+
+    std_result[void] MinimumSpanningForestAssertValid(_PropertyGraph*pg, string property_name)
+
+    cppclass _MinimumSpanningForestStatistics "katana::analytics::MinimumSpanningForestStatistics":
+        uint64_t num_edges
+        uint64_t num_trees
+        double total_weight
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_MinimumSpanningForestStatistics] Compute(_PropertyGraph*pg, string edge_weight_property_name,
+                                                             string property_name)
+
+
+class _MinimumSpanningForestPlanAlgorithm(Enum):
+    Boruvka = _MinimumSpanningForestPlan.Algorithm.kBoruvka
+    FilterKruskal = _MinimumSpanningForestPlan.Algorithm.kFilterKruskal
+
+
+cdef class MinimumSpanningForestPlan(Plan):
+    cdef:
+        _MinimumSpanningForestPlan underlying_
+
+    cdef _Plan*underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _MinimumSpanningForestPlanAlgorithm
+
+    @staticmethod
+    cdef MinimumSpanningForestPlan make(_MinimumSpanningForestPlan u):
+        f = <MinimumSpanningForestPlan> MinimumSpanningForestPlan.__new__(MinimumSpanningForestPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _MinimumSpanningForestPlanAlgorithm:
+        return _MinimumSpanningForestPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def base_case_size(self) -> uint64_t:
+        return self.underlying_.base_case_size()
+
+    @staticmethod
+    def boruvka() -> MinimumSpanningForestPlan:
+        return MinimumSpanningForestPlan.make(_MinimumSpanningForestPlan.Boruvka())
+
+    @staticmethod
+    def filter_kruskal(uint64_t base_case_size = kDefaultBaseCaseSize) -> MinimumSpanningForestPlan:
+        return MinimumSpanningForestPlan.make(_MinimumSpanningForestPlan.FilterKruskal(base_case_size))
+
+
+def minimum_spanning_forest(PropertyGraph pg, str edge_weight_property_name, str output_property_name,
+                            MinimumSpanningForestPlan plan = MinimumSpanningForestPlan()):
+    """
+    Find a minimum spanning forest of the symmetric graph pg and mark its edges with 1 in the new uint8 edge property
+    output_property_name. Only one of the two edges between a pair of nodes is marked. The edge weights are in
+    edge_weight_property_name, or are all 1 if it is empty.
+    """
+    cdef string edge_weight_property_name_str = edge_weight_property_name.encode("utf-8")
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        handle_result_void(MinimumSpanningForest(pg.underlying.get(), edge_weight_property_name_str,
+                                                 output_property_name_str, plan.underlying_))
+
+
+def minimum_spanning_forest_assert_valid(PropertyGraph pg, str property_name):
+    cdef string property_name_str = property_name.encode("utf-8")
+    with nogil:
+        handle_result_assert(MinimumSpanningForestAssertValid(pg.underlying.get(), property_name_str))
+
+
+cdef _MinimumSpanningForestStatistics handle_result_MinimumSpanningForestStatistics(
+        std_result[_MinimumSpanningForestStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class MinimumSpanningForestStatistics:
+    cdef _MinimumSpanningForestStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str edge_weight_property_name, str property_name):
+        cdef string edge_weight_property_name_str = edge_weight_property_name.encode("utf-8")
+        cdef string property_name_str = property_name.encode("utf-8")
+        with nogil:
+            self.underlying = handle_result_MinimumSpanningForestStatistics(
+                _MinimumSpanningForestStatistics.Compute(pg.underlying.get(), edge_weight_property_name_str,
+                                                         property_name_str))
+
+    @property
+    def num_edges(self) -> uint64_t:
+        return self.underlying.num_edges
+
+    @property
+    def num_trees(self) -> uint64_t:
+        return self.underlying.num_trees
+
+    @property
+    def total_weight(self) -> double:
+        return self.underlying.total_weight
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
@@ -1,4 +1,7 @@
+from libc.stdint cimport uint32_t
 from libcpp.string cimport string
+from libcpp.utility cimport pair
+from libcpp.vector cimport vector
 
 from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
 from katana.cpp.libstd.iostream cimport ostringstream, ostream
@@ -38,6 +41,13 @@ cdef extern from "katana/analytics/pagerank/pagerank.h" namespace "katana::analy
 
     std_result[void] Pagerank(_PropertyGraph* pg, string output_property_name, _PagerankPlan plan)
 
+    cppclass _PagerankUpdate "katana::analytics::PagerankUpdate":
+        vector[pair[uint32_t, uint32_t]] inserted_edges
+        vector[pair[uint32_t, uint32_t]] deleted_edges
+
+    std_result[void] PagerankIncremental(_PropertyGraph* pg, string previous_property_name, _PagerankUpdate update,
+                                         string output_property_name, _PagerankPlan plan)
+
     std_result[void] PagerankAssertValid(_PropertyGraph* pg, string output_property_name)
 
     cppclass _PagerankStatistics "katana::analytics::PagerankStatistics":
@@ -118,6 +128,25 @@ def pagerank(PropertyGraph pg, str output_property_name,
         handle_result_void(Pagerank(pg.underlying.get(), output_property_name_cstr, plan.underlying_))
 
 
+def pagerank_incremental(PropertyGraph pg, str previous_property_name, inserted_edges, deleted_edges,
+                         str output_property_name, PagerankPlan plan = PagerankPlan()):
+    """
+    Update the ranks in previous_property_name, computed before inserted_edges and deleted_edges (sequences of
+    (source, destination) node id pairs) were applied to pg, and store them in output_property_name. The two names
+    may be the same to update the ranks in place.
+    """
+    cdef _PagerankUpdate update
+    update.inserted_edges = [(src, dst) for src, dst in inserted_edges]
+    update.deleted_edges = [(src, dst) for src, dst in deleted_edges]
+    previous_property_name_bytes = bytes(previous_property_name, "utf-8")
+    previous_property_name_cstr = <string>previous_property_name_bytes
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(PagerankIncremental(pg.underlying.get(), previous_property_name_cstr, update,
+                                               output_property_name_cstr, plan.underlying_))
+
+
 def pagerank_assert_valid(PropertyGraph pg, str output_property_name):
     output_property_name_bytes = bytes(output_property_name, "utf-8")
     output_property_name_cstr = <string>output_property_name_bytes
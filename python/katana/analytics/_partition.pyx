@@ -0,0 +1,143 @@
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp.string cimport string
+from libcpp.vector cimport vector
+
+from katana.analytics.plan cimport Plan, _Plan
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/partition/partition.h" namespace "katana::analytics" nogil:
+    cppclass _PartitionPlan "katana::analytics::PartitionPlan"(_Plan):
+        enum Algorithm:
+            kMultilevelKWay "katana::analytics::PartitionPlan::kMultilevelKWay"
+
+        _PartitionPlan.Algorithm algorithm() const
+        double imbalance() const
+        uint32_t coarsen_to() const
+        uint32_t max_refinement_rounds() const
+
+        PartitionPlan()
+
+        @staticmethod
+        _PartitionPlan MultilevelKWay(double imbalance, uint32_t coarsen_to, uint32_t max_refinement_rounds)
+
+    double kDefaultImbalance "katana::analytics::PartitionPlan::kDefaultImbalance"
+    uint32_t kDefaultCoarsenTo "katana::analytics::PartitionPlan::kDefaultCoarsenTo"
+    uint32_t kDefaultMaxRefinementRounds "katana::analytics::PartitionPlan::kDefaultMaxRefinementRounds"
+
+    std_result[void] Partition(_PropertyGraph*pg, uint32_t num_parts, string output_property_name,
+                               _PartitionPlan plan)
+
+    std_result[void] PartitionAssertValid(_PropertyGraph*pg, uint32_t num_parts, string property_name)
+
+    cppclass _PartitionStatistics "katana::analytics::PartitionStatistics":
+        uint32_t num_parts
+        vector[uint64_t] part_sizes
+        uint64_t edge_cut
+        double imbalance
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_PartitionStatistics] Compute(_PropertyGraph*pg, string property_name)
+
+
+class _PartitionPlanAlgorithm(Enum):
+    MultilevelKWay = _PartitionPlan.Algorithm.kMultilevelKWay
+
+
+cdef class PartitionPlan(Plan):
+    cdef:
+        _PartitionPlan underlying_
+
+    cdef _Plan*underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _PartitionPlanAlgorithm
+
+    @staticmethod
+    cdef PartitionPlan make(_PartitionPlan u):
+        f = <PartitionPlan> PartitionPlan.__new__(PartitionPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _PartitionPlanAlgorithm:
+        return _PartitionPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def imbalance(self) -> double:
+        return self.underlying_.imbalance()
+
+    @property
+    def coarsen_to(self) -> uint32_t:
+        return self.underlying_.coarsen_to()
+
+    @property
+    def max_refinement_rounds(self) -> uint32_t:
+        return self.underlying_.max_refinement_rounds()
+
+    @staticmethod
+    def multilevel_k_way(double imbalance = kDefaultImbalance, uint32_t coarsen_to = kDefaultCoarsenTo,
+                         uint32_t max_refinement_rounds = kDefaultMaxRefinementRounds) -> PartitionPlan:
+        return PartitionPlan.make(_PartitionPlan.MultilevelKWay(imbalance, coarsen_to, max_refinement_rounds))
+
+
+def partition(PropertyGraph pg, uint32_t num_parts, str output_property_name, PartitionPlan plan = PartitionPlan()):
+    """
+    Split the nodes of pg into num_parts parts of about the same size with few edges between different parts, and
+    store the part of each node, numbered from 0, in the new uint32 node property output_property_name. Edges are
+    treated as undirected.
+    """
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        handle_result_void(Partition(pg.underlying.get(), num_parts, output_property_name_str, plan.underlying_))
+
+
+def partition_assert_valid(PropertyGraph pg, uint32_t num_parts, str property_name):
+    cdef string property_name_str = property_name.encode("utf-8")
+    with nogil:
+        handle_result_assert(PartitionAssertValid(pg.underlying.get(), num_parts, property_name_str))
+
+
+cdef _PartitionStatistics handle_result_PartitionStatistics(std_result[_PartitionStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class PartitionStatistics:
+    cdef _PartitionStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str property_name):
+        cdef string property_name_str = property_name.encode("utf-8")
+        with nogil:
+            self.underlying = handle_result_PartitionStatistics(
+                _PartitionStatistics.Compute(pg.underlying.get(), property_name_str))
+
+    @property
+    def num_parts(self) -> uint32_t:
+        return self.underlying.num_parts
+
+    @property
+    def part_sizes(self) -> list:
+        return self.underlying.part_sizes
+
+    @property
+    def edge_cut(self) -> uint64_t:
+        return self.underlying.edge_cut
+
+    @property
+    def imbalance(self) -> double:
+        return self.underlying.imbalance
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
@@ -0,0 +1,165 @@
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp.memory cimport shared_ptr, static_pointer_cast
+from libcpp.string cimport string
+
+from pyarrow.lib cimport CArray, CFixedSizeListArray, pyarrow_unwrap_array, pyarrow_wrap_array
+
+from katana.analytics.plan cimport Plan, _Plan
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/random_walks/random_walks.h" namespace "katana::analytics" nogil:
+    cppclass _RandomWalksPlan "katana::analytics::RandomWalksPlan"(_Plan):
+        enum Algorithm:
+            kNode2vec "katana::analytics::RandomWalksPlan::kNode2vec"
+            kEdge2vec "katana::analytics::RandomWalksPlan::kEdge2vec"
+
+        _RandomWalksPlan.Algorithm algorithm() const
+        uint32_t walk_length() const
+        uint32_t number_of_walks() const
+        double backward_probability() const
+        double forward_probability() const
+        uint32_t max_iterations() const
+        uint64_t seed() const
+
+        RandomWalksPlan()
+
+        @staticmethod
+        _RandomWalksPlan Node2vec(uint32_t walk_length, uint32_t number_of_walks, double backward_probability,
+                                  double forward_probability, uint64_t seed)
+
+        @staticmethod
+        _RandomWalksPlan Edge2vec(uint32_t walk_length, uint32_t number_of_walks, double backward_probability,
+                                  double forward_probability, uint32_t max_iterations, uint64_t seed)
+
+    uint32_t kDefaultWalkLength "katana::analytics::RandomWalksPlan::kDefaultWalkLength"
+    uint32_t kDefaultNumberOfWalks "katana::analytics::RandomWalksPlan::kDefaultNumberOfWalks"
+    double kDefaultBackwardProbability "katana::analytics::RandomWalksPlan::kDefaultBackwardProbability"
+    double kDefaultForwardProbability "katana::analytics::RandomWalksPlan::kDefaultForwardProbability"
+    uint32_t kDefaultMaxIterations "katana::analytics::RandomWalksPlan::kDefaultMaxIterations"
+    uint64_t kDefaultSeed "katana::analytics::RandomWalksPlan::kDefaultSeed"
+
+    std_result[shared_ptr[CFixedSizeListArray]] RandomWalks(_PropertyGraph*pg, string edge_weight_property_name,
+                                                            string edge_type_property_name, _RandomWalksPlan plan)
+
+    std_result[void] RandomWalksToParquet(_PropertyGraph*pg, string edge_weight_property_name,
+                                          string edge_type_property_name, string path, uint64_t batch_size,
+                                          _RandomWalksPlan plan)
+
+    std_result[void] RandomWalksAssertValid(_PropertyGraph*pg, shared_ptr[CFixedSizeListArray] walks)
+
+
+cdef shared_ptr[CFixedSizeListArray] handle_result_shared_cfixedsizelistarray(
+        std_result[shared_ptr[CFixedSizeListArray]] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+class _RandomWalksPlanAlgorithm(Enum):
+    Node2vec = _RandomWalksPlan.Algorithm.kNode2vec
+    Edge2vec = _RandomWalksPlan.Algorithm.kEdge2vec
+
+
+cdef class RandomWalksPlan(Plan):
+    cdef:
+        _RandomWalksPlan underlying_
+
+    cdef _Plan*underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _RandomWalksPlanAlgorithm
+
+    @staticmethod
+    cdef RandomWalksPlan make(_RandomWalksPlan u):
+        f = <RandomWalksPlan> RandomWalksPlan.__new__(RandomWalksPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _RandomWalksPlanAlgorithm:
+        return _RandomWalksPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def walk_length(self) -> uint32_t:
+        return self.underlying_.walk_length()
+
+    @property
+    def number_of_walks(self) -> uint32_t:
+        return self.underlying_.number_of_walks()
+
+    @property
+    def backward_probability(self) -> double:
+        return self.underlying_.backward_probability()
+
+    @property
+    def forward_probability(self) -> double:
+        return self.underlying_.forward_probability()
+
+    @property
+    def max_iterations(self) -> uint32_t:
+        return self.underlying_.max_iterations()
+
+    @property
+    def seed(self) -> uint64_t:
+        return self.underlying_.seed()
+
+    @staticmethod
+    def node2vec(uint32_t walk_length = kDefaultWalkLength, uint32_t number_of_walks = kDefaultNumberOfWalks,
+                 double backward_probability = kDefaultBackwardProbability,
+                 double forward_probability = kDefaultForwardProbability,
+                 uint64_t seed = kDefaultSeed) -> RandomWalksPlan:
+        return RandomWalksPlan.make(_RandomWalksPlan.Node2vec(
+            walk_length, number_of_walks, backward_probability, forward_probability, seed))
+
+    @staticmethod
+    def edge2vec(uint32_t walk_length = kDefaultWalkLength, uint32_t number_of_walks = kDefaultNumberOfWalks,
+                 double backward_probability = kDefaultBackwardProbability,
+                 double forward_probability = kDefaultForwardProbability,
+                 uint32_t max_iterations = kDefaultMaxIterations,
+                 uint64_t seed = kDefaultSeed) -> RandomWalksPlan:
+        return RandomWalksPlan.make(_RandomWalksPlan.Edge2vec(
+            walk_length, number_of_walks, backward_probability, forward_probability, max_iterations, seed))
+
+
+def random_walks(PropertyGraph pg, str edge_weight_property_name, str edge_type_property_name = "",
+                 RandomWalksPlan plan = RandomWalksPlan()):
+    """
+    Generate plan.number_of_walks random walks from every node of pg and return them as a pyarrow FixedSizeListArray
+    with one list of plan.walk_length node ids per walk; a walk that stops early is padded with nulls. The edge weights
+    are in edge_weight_property_name, or are all 1 if it is empty. Edge2vec reads edge types from the integer property
+    edge_type_property_name.
+    """
+    cdef string edge_weight_property_name_str = edge_weight_property_name.encode("utf-8")
+    cdef string edge_type_property_name_str = edge_type_property_name.encode("utf-8")
+    cdef shared_ptr[CFixedSizeListArray] res
+    with nogil:
+        res = handle_result_shared_cfixedsizelistarray(RandomWalks(
+            pg.underlying.get(), edge_weight_property_name_str, edge_type_property_name_str, plan.underlying_))
+    return pyarrow_wrap_array(static_pointer_cast[CArray, CFixedSizeListArray](res))
+
+
+def random_walks_to_parquet(PropertyGraph pg, str edge_weight_property_name, str edge_type_property_name, str path,
+                            uint64_t batch_size, RandomWalksPlan plan = RandomWalksPlan()):
+    """
+    Stream the walks of random_walks to a new Parquet file at the local path, with one row group per batch_size walks.
+    """
+    cdef string edge_weight_property_name_str = edge_weight_property_name.encode("utf-8")
+    cdef string edge_type_property_name_str = edge_type_property_name.encode("utf-8")
+    cdef string path_str = path.encode("utf-8")
+    with nogil:
+        handle_result_void(RandomWalksToParquet(
+            pg.underlying.get(), edge_weight_property_name_str, edge_type_property_name_str, path_str, batch_size,
+            plan.underlying_))
+
+
+def random_walks_assert_valid(PropertyGraph pg, walks):
+    cdef shared_ptr[CFixedSizeListArray] walks_array = static_pointer_cast[CFixedSizeListArray, CArray](
+        pyarrow_unwrap_array(walks))
+    with nogil:
+        handle_result_assert(RandomWalksAssertValid(pg.underlying.get(), walks_array))
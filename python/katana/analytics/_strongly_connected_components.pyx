@@ -0,0 +1,137 @@
+from libc.stdint cimport uint64_t
+from libcpp.string cimport string
+
+from katana.analytics.plan cimport Plan, _Plan
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/strongly_connected_components/strongly_connected_components.h" namespace "katana::analytics" nogil:
+    cppclass _StronglyConnectedComponentsPlan "katana::analytics::StronglyConnectedComponentsPlan"(_Plan):
+        enum Algorithm:
+            kSerial "katana::analytics::StronglyConnectedComponentsPlan::kSerial"
+            kColoring "katana::analytics::StronglyConnectedComponentsPlan::kColoring"
+            kForwardBackward "katana::analytics::StronglyConnectedComponentsPlan::kForwardBackward"
+
+        _StronglyConnectedComponentsPlan.Algorithm algorithm() const
+
+        StronglyConnectedComponentsPlan()
+
+        @staticmethod
+        _StronglyConnectedComponentsPlan Serial()
+
+        @staticmethod
+        _StronglyConnectedComponentsPlan Coloring()
+
+        @staticmethod
+        _StronglyConnectedComponentsPlan ForwardBackward()
+
+    std_result[void] StronglyConnectedComponents(_PropertyGraph*pg, string output_property_name,
+                                                 _StronglyConnectedComponentsPlan plan)
+
+    std_result[void] StronglyConnectedComponentsAssertValid(_PropertyGraph*pg, string output_property_name)
+
+    cppclass _StronglyConnectedComponentsStatistics "katana::analytics::StronglyConnectedComponentsStatistics":
+        uint64_t total_components
+        uint64_t total_non_trivial_components
+        uint64_t largest_component_size
+        double largest_component_ratio
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_StronglyConnectedComponentsStatistics] Compute(_PropertyGraph*pg, string output_property_name)
+
+
+class _StronglyConnectedComponentsPlanAlgorithm(Enum):
+    Serial = _StronglyConnectedComponentsPlan.Algorithm.kSerial
+    Coloring = _StronglyConnectedComponentsPlan.Algorithm.kColoring
+    ForwardBackward = _StronglyConnectedComponentsPlan.Algorithm.kForwardBackward
+
+
+cdef class StronglyConnectedComponentsPlan(Plan):
+    cdef:
+        _StronglyConnectedComponentsPlan underlying_
+
+    cdef _Plan*underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _StronglyConnectedComponentsPlanAlgorithm
+
+    @staticmethod
+    cdef StronglyConnectedComponentsPlan make(_StronglyConnectedComponentsPlan u):
+        f = <StronglyConnectedComponentsPlan> StronglyConnectedComponentsPlan.__new__(StronglyConnectedComponentsPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _StronglyConnectedComponentsPlanAlgorithm:
+        return self.underlying_.algorithm()
+
+    @staticmethod
+    def serial() -> StronglyConnectedComponentsPlan:
+        return StronglyConnectedComponentsPlan.make(_StronglyConnectedComponentsPlan.Serial())
+    @staticmethod
+    def coloring() -> StronglyConnectedComponentsPlan:
+        return StronglyConnectedComponentsPlan.make(_StronglyConnectedComponentsPlan.Coloring())
+    @staticmethod
+    def forward_backward() -> StronglyConnectedComponentsPlan:
+        return StronglyConnectedComponentsPlan.make(_StronglyConnectedComponentsPlan.ForwardBackward())
+
+def strongly_connected_components(PropertyGraph pg, str output_property_name,
+                                  StronglyConnectedComponentsPlan plan = StronglyConnectedComponentsPlan()) -> int:
+    """
+    Compute the strongly connected components of pg and label each node with the smallest node id in its component
+    in the uint64 property output_property_name.
+    """
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        v = handle_result_void(StronglyConnectedComponents(pg.underlying.get(), output_property_name_str,
+                                                           plan.underlying_))
+    return v
+
+def strongly_connected_components_assert_valid(PropertyGraph pg, str output_property_name):
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    with nogil:
+        handle_result_assert(StronglyConnectedComponentsAssertValid(pg.underlying.get(), output_property_name_str))
+
+cdef _StronglyConnectedComponentsStatistics handle_result_StronglyConnectedComponentsStatistics(
+        std_result[_StronglyConnectedComponentsStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+cdef class StronglyConnectedComponentsStatistics:
+    cdef _StronglyConnectedComponentsStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str output_property_name):
+        cdef string output_property_name_str = output_property_name.encode("utf-8")
+        with nogil:
+            self.underlying = handle_result_StronglyConnectedComponentsStatistics(
+                _StronglyConnectedComponentsStatistics.Compute(pg.underlying.get(), output_property_name_str))
+
+    @property
+    def total_components(self) -> uint64_t:
+        return self.underlying.total_components
+
+    @property
+    def total_non_trivial_components(self) -> uint64_t:
+        return self.underlying.total_non_trivial_components
+
+    @property
+    def largest_component_size(self) -> uint64_t:
+        return self.underlying.largest_component_size
+
+    @property
+    def largest_component_ratio(self) -> double:
+        return self.underlying.largest_component_ratio
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
@@ -55,6 +55,96 @@ def sort_nodes_by_degree(PropertyGraph pg):
         handle_result_void(SortNodesByDegree(pg.underlying.get()))
 
 
+cdef extern from "katana/ReorderGraph.h" namespace "katana" nogil:
+    cppclass _ReorderPlan "katana::ReorderPlan":
+        enum Algorithm:
+            kDegreeSort "katana::ReorderPlan::kDegreeSort"
+            kHubCluster "katana::ReorderPlan::kHubCluster"
+            kReverseCuthillMcKee "katana::ReorderPlan::kReverseCuthillMcKee"
+            kGorder "katana::ReorderPlan::kGorder"
+
+        _ReorderPlan.Algorithm algorithm() const
+        uint32_t num_groups() const
+        uint32_t window_size() const
+
+        _ReorderPlan()
+
+        @staticmethod
+        _ReorderPlan DegreeSort()
+
+        @staticmethod
+        _ReorderPlan HubCluster(uint32_t num_groups)
+
+        @staticmethod
+        _ReorderPlan ReverseCuthillMcKee()
+
+        @staticmethod
+        _ReorderPlan Gorder(uint32_t window_size)
+
+    uint32_t kDefaultNumGroups "katana::ReorderPlan::kDefaultNumGroups"
+    uint32_t kDefaultWindowSize "katana::ReorderPlan::kDefaultWindowSize"
+
+    std_result[void] ReorderGraph(_PropertyGraph* pg, string original_id_property_name, _ReorderPlan plan)
+
+
+class _ReorderPlanAlgorithm(Enum):
+    DegreeSort = _ReorderPlan.Algorithm.kDegreeSort
+    HubCluster = _ReorderPlan.Algorithm.kHubCluster
+    ReverseCuthillMcKee = _ReorderPlan.Algorithm.kReverseCuthillMcKee
+    Gorder = _ReorderPlan.Algorithm.kGorder
+
+
+cdef class ReorderPlan:
+    cdef:
+        _ReorderPlan underlying_
+
+    Algorithm = _ReorderPlanAlgorithm
+
+    @staticmethod
+    cdef ReorderPlan make(_ReorderPlan u):
+        f = <ReorderPlan>ReorderPlan.__new__(ReorderPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _ReorderPlanAlgorithm:
+        return _ReorderPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def num_groups(self) -> uint32_t:
+        return self.underlying_.num_groups()
+
+    @property
+    def window_size(self) -> uint32_t:
+        return self.underlying_.window_size()
+
+    @staticmethod
+    def degree_sort() -> ReorderPlan:
+        return ReorderPlan.make(_ReorderPlan.DegreeSort())
+
+    @staticmethod
+    def hub_cluster(uint32_t num_groups = kDefaultNumGroups) -> ReorderPlan:
+        return ReorderPlan.make(_ReorderPlan.HubCluster(num_groups))
+
+    @staticmethod
+    def reverse_cuthill_mckee() -> ReorderPlan:
+        return ReorderPlan.make(_ReorderPlan.ReverseCuthillMcKee())
+
+    @staticmethod
+    def gorder(uint32_t window_size = kDefaultWindowSize) -> ReorderPlan:
+        return ReorderPlan.make(_ReorderPlan.Gorder(window_size))
+
+
+def reorder_graph(PropertyGraph pg, str original_id_property_name, ReorderPlan plan = ReorderPlan()):
+    """
+    Relabel the nodes of pg in the order computed by plan, permuting every node and edge property along with the
+    topology. If original_id_property_name is not empty, that property holds the id of each node before reordering.
+    """
+    cdef string original_id_property_name_str = original_id_property_name.encode("utf-8")
+    with nogil:
+        handle_result_void(ReorderGraph(pg.underlying.get(), original_id_property_name_str, plan.underlying_))
+
+
 # Jaccard
 
 
@@ -118,6 +118,7 @@ cdef extern from "katana/Graph.h" namespace "katana" nogil:
         std_result[void] Commit(string command_line)
 
         GraphTopology& topology()
+        std_result[void] SetTopology(const GraphTopology&)
 
         shared_ptr[CSchema] node_schema()
         shared_ptr[CSchema] edge_schema()
@@ -1,4 +1,7 @@
+import math
+
 import numpy as np
+import pyarrow.parquet
 from pyarrow import Schema, table
 from pytest import approx, raises
 
@@ -6,6 +9,7 @@ from katana import GaloisError
 from katana.analytics import *
 from katana.property_graph import PropertyGraph
 from katana.example_utils import get_input
+from katana.galois import setActiveThreads
 from katana.lonestar.analytics.bfs import verify_bfs
 from katana.lonestar.analytics.sssp import verify_sssp
 
@@ -58,6 +62,75 @@ def test_sort_nodes_by_degree(property_graph: PropertyGraph):
         last_node_n_edges = v
 
 
+def hub_cluster_group(degree, average, num_groups):
+    level = -1
+    if degree > 0 and degree >= average:
+        level = math.floor(math.log2(degree / average))
+    return min(max(num_groups - 2 - level, 0), num_groups - 1)
+
+
+def test_reorder_graph():
+    for plan in [
+        ReorderPlan.degree_sort(),
+        ReorderPlan.hub_cluster(),
+        ReorderPlan.reverse_cuthill_mckee(),
+        ReorderPlan.gorder(),
+    ]:
+        property_graph = PropertyGraph(get_input("propertygraphs/ldbc_003"))
+        num_nodes = property_graph.num_nodes()
+        num_edges = property_graph.num_edges()
+        degrees = np.array([len(property_graph.edges(n)) for n in range(num_nodes)])
+        original_edges = [
+            (n, property_graph.get_edge_dst(e)) for n in range(num_nodes) for e in property_graph.edges(n)
+        ]
+        original_dests = sorted(original_edges)
+        property_graph.add_node_property(table({"OldId": np.arange(num_nodes, dtype=np.uint64)}))
+        property_graph.add_edge_property(table({"OldEdgeId": np.arange(num_edges, dtype=np.uint64)}))
+
+        reorder_graph(property_graph, "OriginalId", plan)
+
+        assert property_graph.num_nodes() == num_nodes
+        assert property_graph.num_edges() == num_edges
+        original_id = property_graph.get_node_property("OriginalId").to_numpy()
+        assert sorted(original_id) == list(range(num_nodes))
+        assert (property_graph.get_node_property("OldId").to_numpy() == original_id).all()
+        new_degrees = np.array([len(property_graph.edges(n)) for n in range(num_nodes)])
+        assert (new_degrees == degrees[original_id]).all()
+        new_dests = sorted(
+            (original_id[n], original_id[property_graph.get_edge_dst(e)])
+            for n in range(num_nodes)
+            for e in property_graph.edges(n)
+        )
+        assert new_dests == original_dests
+
+        # Each edge property follows its edge, and the edges of a node keep their order
+        old_edge_id = property_graph.get_edge_property("OldEdgeId").to_numpy()
+        for n in range(num_nodes):
+            edges = property_graph.edges(n)
+            first = int(old_edge_id[edges.start]) if len(edges) > 0 else 0
+            assert list(old_edge_id[edges.start : edges.stop]) == list(range(first, first + len(edges)))
+            for e in edges:
+                assert original_edges[old_edge_id[e]] == (
+                    original_id[n],
+                    original_id[property_graph.get_edge_dst(e)],
+                )
+
+        # Both orders break ties by original id
+        if plan.algorithm == ReorderPlan.Algorithm.DegreeSort:
+            assert (np.diff(new_degrees) <= 0).all()
+            keys = [(-new_degrees[n], original_id[n]) for n in range(num_nodes)]
+            assert keys == sorted(keys)
+        if plan.algorithm == ReorderPlan.Algorithm.HubCluster:
+            average = num_edges / num_nodes
+            groups = [hub_cluster_group(d, average, plan.num_groups) for d in new_degrees]
+            assert groups[0] < groups[-1]
+            keys = [(groups[n], original_id[n]) for n in range(num_nodes)]
+            assert keys == sorted(keys)
+
+    with raises(GaloisError):
+        reorder_graph(property_graph, "OriginalId", ReorderPlan.hub_cluster(0))
+
+
 def test_bfs(property_graph: PropertyGraph):
     property_name = "NewProp"
     start_node = 0
@@ -82,6 +155,77 @@ def test_bfs(property_graph: PropertyGraph):
     verify_bfs(property_graph, start_node, new_property_id)
 
 
+def test_bfs_direction_optimizing(property_graph: PropertyGraph):
+    property_name = "NewProp"
+    start_node = 0
+
+    bfs(property_graph, start_node, property_name, BfsPlan.direction_optimizing())
+
+    assert property_graph.get_node_property(property_name)[start_node].as_py() == 0
+
+    bfs_assert_valid(property_graph, property_name)
+
+    stats = BfsStatistics(property_graph, property_name)
+
+    assert stats.source_node == start_node
+    assert stats.max_distance == 7
+
+    with raises(GaloisError):
+        bfs(property_graph, start_node, "ZeroAlpha", BfsPlan.direction_optimizing(alpha=0))
+    with raises(GaloisError):
+        bfs(property_graph, start_node, "ZeroBeta", BfsPlan.direction_optimizing(beta=0))
+
+
+def test_bfs_batch(property_graph: PropertyGraph):
+    sources = [0, 1, 2, 0, 100]
+    batch_names = [f"Batch{i}" for i in range(len(sources))]
+
+    bfs_batch(property_graph, sources, batch_names)
+    reduced = bfs_batch_reduce(property_graph, sources)
+
+    for i, source in enumerate(sources):
+        bfs(property_graph, source, f"Single{i}")
+        assert property_graph.get_node_property(batch_names[i]) == property_graph.get_node_property(f"Single{i}")
+
+        stats = BfsStatistics(property_graph, batch_names[i])
+        assert reduced[i].source_node == source
+        assert reduced[i].max_distance == stats.max_distance
+        assert reduced[i].total_distance == stats.total_distance
+        assert reduced[i].n_reached_nodes == stats.n_reached_nodes
+
+    with raises(GaloisError):
+        bfs_batch(property_graph, [0, 1], ["Mismatched"])
+
+
+def test_bfs_batch_wide(property_graph: PropertyGraph):
+    # The first 100 and 200 sources run in 128 and 256 bit wide batches, and
+    # all 700 in two 512 bit wide batches
+    num_nodes = property_graph.num_nodes()
+    sources = [(i * 7919) % num_nodes for i in range(700)]
+
+    expected = {}
+    for source in set(sources):
+        bfs(property_graph, source, f"Single{source}")
+        expected[source] = (
+            property_graph.get_node_property(f"Single{source}"),
+            BfsStatistics(property_graph, f"Single{source}"),
+        )
+
+    for n in [100, 200, 700]:
+        batch_names = [f"Batch{n}_{i}" for i in range(n)]
+        bfs_batch(property_graph, sources[:n], batch_names)
+        reduced = bfs_batch_reduce(property_graph, sources[:n])
+        assert len(reduced) == n
+
+        for i, source in enumerate(sources[:n]):
+            distances, stats = expected[source]
+            assert property_graph.get_node_property(batch_names[i]) == distances
+            assert reduced[i].source_node == source
+            assert reduced[i].max_distance == stats.max_distance
+            assert reduced[i].total_distance == stats.total_distance
+            assert reduced[i].n_reached_nodes == stats.n_reached_nodes
+
+
 def test_sssp(property_graph: PropertyGraph):
     property_name = "NewProp"
     weight_name = "workFrom"
@@ -167,6 +311,70 @@ def test_pagerank(property_graph: PropertyGraph):
     assert stats.average_rank == approx(0.5205338001251221, abs=0.001)
 
 
+def test_pagerank_incremental(property_graph: PropertyGraph):
+    plan = PagerankPlan.push_asynchronous(0.000001, 0.85)
+    pagerank(property_graph, "Rank", plan)
+
+    # An empty update must leave the ranks as they were
+    pagerank_incremental(property_graph, "Rank", [], [], "UpdatedRank", plan)
+    assert np.allclose(
+        property_graph.get_node_property("Rank").to_numpy(), property_graph.get_node_property("UpdatedRank").to_numpy()
+    )
+
+    # Deleting and reinserting the same edge is a no-op as well
+    dst = property_graph.get_edge_dst(property_graph.edges(0)[0])
+    pagerank_incremental(property_graph, "UpdatedRank", [(0, dst)], [(0, dst)], "UpdatedRank", plan)
+    assert np.allclose(
+        property_graph.get_node_property("Rank").to_numpy(),
+        property_graph.get_node_property("UpdatedRank").to_numpy(),
+        atol=0.001,
+    )
+
+    with raises(GaloisError):
+        pagerank_incremental(property_graph, "Rank", [(len(property_graph), 0)], [], "Rank", plan)
+
+
+def csr_from_edge_set(num_nodes, edges):
+    edges = sorted(edges)
+    indices = np.cumsum(np.bincount([src for src, _ in edges], minlength=num_nodes)).astype(np.uint64)
+    return PropertyGraph.from_csr(indices, [dst for _, dst in edges])
+
+
+def test_pagerank_incremental_updates():
+    rng = np.random.default_rng(42)
+    num_nodes = 1000
+    edges = set()
+    while len(edges) < 8 * num_nodes:
+        src, dst = rng.integers(num_nodes, size=2)
+        if src != dst:
+            edges.add((int(src), int(dst)))
+
+    plan = PagerankPlan.push_asynchronous(0.000001, 0.85)
+    graph = csr_from_edge_set(num_nodes, edges)
+    pagerank(graph, "Rank", plan)
+
+    # Delete some existing edges, including every out-edge of node 0, and insert new ones
+    deleted = set(sorted(edges)[::50]) | {e for e in edges if e[0] == 0}
+    inserted = set()
+    while len(inserted) < 200:
+        src, dst = rng.integers(num_nodes, size=2)
+        if src != dst and (src, dst) not in edges:
+            inserted.add((int(src), int(dst)))
+    updated_graph = csr_from_edge_set(num_nodes, (edges - deleted) | inserted)
+    assert updated_graph.num_edges() == len(edges) - len(deleted) + len(inserted)
+
+    updated_graph.add_node_property(table({"Rank": graph.get_node_property("Rank")}))
+    pagerank_incremental(updated_graph, "Rank", list(inserted), list(deleted), "UpdatedRank", plan)
+    pagerank(updated_graph, "ExpectedRank", plan)
+
+    previous = graph.get_node_property("Rank").to_numpy()
+    updated = updated_graph.get_node_property("UpdatedRank").to_numpy()
+    expected = updated_graph.get_node_property("ExpectedRank").to_numpy()
+    # The update must actually change the ranks for this test to mean anything
+    assert not np.allclose(previous, expected, atol=0.01)
+    assert np.allclose(updated, expected, atol=0.001)
+
+
 def test_betweenness_centrality_outer(property_graph: PropertyGraph):
     property_name = "NewProp"
 
@@ -201,6 +409,48 @@ def test_betweenness_centrality_level(property_graph: PropertyGraph):
     assert stats.average_centrality == approx(1.3645)
 
 
+def test_betweenness_centrality_multi_source(property_graph: PropertyGraph):
+    property_name = "NewProp"
+
+    betweenness_centrality(property_graph, property_name, 16, BetweennessCentralityPlan.multi_source())
+
+    stats = BetweennessCentralityStatistics(property_graph, property_name)
+
+    assert stats.min_centrality == 0
+    assert stats.max_centrality == approx(8210.38)
+    assert stats.average_centrality == approx(1.3645)
+
+    betweenness_centrality(property_graph, "Level", 16, BetweennessCentralityPlan.level())
+    np.testing.assert_allclose(
+        property_graph.get_node_property(property_name).to_numpy(),
+        property_graph.get_node_property("Level").to_numpy(),
+        rtol=1e-4,
+        atol=1e-3,
+    )
+
+
+def test_betweenness_centrality_approximate():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+    n = property_graph.num_nodes()
+    epsilon = 0.02
+
+    betweenness_centrality(
+        property_graph, "Approximate", plan=BetweennessCentralityPlan.approximate(epsilon, delta=0.001)
+    )
+    betweenness_centrality(property_graph, "Exact", plan=BetweennessCentralityPlan.level())
+
+    stats = BetweennessCentralityStatistics(property_graph, "Approximate")
+    assert stats.num_samples > 0
+    assert BetweennessCentralityStatistics(property_graph, "Exact").num_samples == 0
+
+    approximate = property_graph.get_node_property("Approximate").to_numpy()
+    exact = property_graph.get_node_property("Exact").to_numpy()
+    assert np.all(np.abs(approximate - exact) <= epsilon * n * (n - 1))
+
+    with raises(GaloisError):
+        betweenness_centrality(property_graph, "Invalid", plan=BetweennessCentralityPlan.approximate(0))
+
+
 def test_triangle_count():
     property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
     original_first_edge_list = [property_graph.get_edge_dst(e) for e in property_graph.edges(0)]
@@ -259,6 +509,42 @@ def test_connected_components():
     connected_components_assert_valid(property_graph, "output")
 
 
+def test_strongly_connected_components(property_graph: PropertyGraph):
+    strongly_connected_components(property_graph, "output")
+    strongly_connected_components_assert_valid(property_graph, "output")
+
+    stats = StronglyConnectedComponentsStatistics(property_graph, "output")
+    assert stats.total_components > 0
+    assert stats.largest_component_size <= len(property_graph)
+
+    # All algorithms label nodes with the smallest node id in their component
+    expected = property_graph.get_node_property("output").to_numpy()
+    for i, plan in enumerate(
+        [StronglyConnectedComponentsPlan.serial(), StronglyConnectedComponentsPlan.coloring()]
+    ):
+        strongly_connected_components(property_graph, f"output{i}", plan)
+        assert np.array_equal(property_graph.get_node_property(f"output{i}").to_numpy(), expected)
+
+
+def test_strongly_connected_components_symmetric():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    # In a symmetric graph, strongly connected components are connected
+    # components
+    strongly_connected_components(property_graph, "output")
+    strongly_connected_components_assert_valid(property_graph, "output")
+    connected_components(property_graph, "cc")
+
+    scc = property_graph.get_node_property("output").to_numpy()
+    cc = property_graph.get_node_property("cc").to_numpy()
+    num_components = len(np.unique(cc))
+    assert len(np.unique(scc)) == num_components
+    assert np.unique(np.stack([scc, cc]), axis=1).shape[1] == num_components
+
+    stats = StronglyConnectedComponentsStatistics(property_graph, "output")
+    assert stats.total_components == num_components
+
+
 def test_k_core():
     property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
 
@@ -271,6 +557,28 @@ def test_k_core():
     k_core_assert_valid(property_graph, 10, "output")
 
 
+def test_k_core_decomposition():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    k_core_decomposition(property_graph, "output")
+    k_core_decomposition_assert_valid(property_graph, "output")
+
+    stats = KCoreDecompositionStatistics(property_graph, "output")
+
+    # Agrees with computing the 10-core alone
+    assert stats.core_size(10) == 438
+    assert stats.core_size(0) == len(property_graph)
+    assert sum(stats.core_number_histogram) == len(property_graph)
+    assert stats.core_number_histogram[stats.max_core_number] > 0
+
+    k_core_decomposition(property_graph, "output_async", KCorePlan.asynchronous())
+    k_core_decomposition_assert_valid(property_graph, "output_async")
+
+    synchronous = property_graph.get_node_property("output").to_numpy()
+    asynchronous = property_graph.get_node_property("output_async").to_numpy()
+    assert np.array_equal(synchronous, asynchronous)
+
+
 def test_k_truss():
     property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
 
@@ -283,6 +591,39 @@ def test_k_truss():
     k_truss_assert_valid(property_graph, 10, "output")
 
 
+def test_k_truss_decomposition():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    k_truss_decomposition(property_graph, "output")
+    k_truss_decomposition_assert_valid(property_graph, "output")
+
+    stats = KTrussDecompositionStatistics(property_graph, "output")
+
+    assert stats.trussness_histogram[stats.max_trussness] > 0
+    assert stats.truss_size(0) == sum(stats.trussness_histogram)
+    assert stats.truss_size(stats.max_trussness + 1) == 0
+
+    # k_truss counts triangles through self loops, so compare the two on a
+    # copy of the graph without them
+    edges = set()
+    for src in property_graph:
+        for e in property_graph.edges(src):
+            dst = property_graph.get_edge_dst(e)
+            if dst != src:
+                edges.add((src, dst))
+    graph = csr_from_edge_set(property_graph.num_nodes(), edges)
+
+    k_truss_decomposition(graph, "output")
+    k_truss_decomposition_assert_valid(graph, "output")
+    stats = KTrussDecompositionStatistics(graph, "output")
+    assert stats.max_trussness > 2
+
+    for k in range(3, stats.max_trussness + 2):
+        k_truss(graph, k, f"output_{k}")
+        k_truss_stats = KTrussStatistics(graph, k, f"output_{k}")
+        assert k_truss_stats.number_of_edges_left == stats.truss_size(k)
+
+
 def test_k_truss_fail():
     property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
 
@@ -291,3 +632,262 @@ def test_k_truss_fail():
 
     with raises(GaloisError):
         k_truss(property_graph, 1, "output2")
+
+
+def test_louvain_clustering():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    louvain_clustering(property_graph, "", "output")
+    louvain_clustering_assert_valid(property_graph, "output")
+
+    stats = LouvainClusteringStatistics(property_graph, "", "output")
+    assert 1 < stats.n_clusters < len(property_graph)
+    assert stats.modularity > 0
+
+    # Leiden clusters at least as well
+    louvain_clustering(property_graph, "", "output_leiden", LouvainClusteringPlan.leiden())
+    louvain_clustering_assert_valid(property_graph, "output_leiden")
+
+    leiden_stats = LouvainClusteringStatistics(property_graph, "", "output_leiden")
+    assert leiden_stats.modularity > 0
+    assert leiden_stats.modularity >= stats.modularity - 0.05
+
+    # A larger resolution favors smaller clusters
+    louvain_clustering(property_graph, "", "output_fine", LouvainClusteringPlan.do_all(resolution=4))
+    fine_stats = LouvainClusteringStatistics(property_graph, "", "output_fine")
+    assert fine_stats.largest_cluster_size <= stats.largest_cluster_size
+
+    with raises(GaloisError):
+        louvain_clustering(property_graph, "", "output_invalid", LouvainClusteringPlan.do_all(max_levels=0))
+
+
+def test_matrix_completion():
+    # Ratings from 200 items to 300 users that are the dot products of random
+    # nonnegative vectors of rank 4
+    rng = np.random.default_rng(1)
+    num_items = 200
+    num_users = 300
+    factors = rng.random((num_items + num_users, 4), dtype=np.float32)
+    items, users = np.nonzero(rng.random((num_items, num_users)) < 0.2)
+    users += num_items
+    indices = np.cumsum(np.bincount(items, minlength=num_items + num_users)).astype(np.uint64)
+    graph = PropertyGraph.from_csr(indices, users.astype(np.uint32))
+    graph.add_edge_property(table({"rating": np.sum(factors[items] * factors[users], axis=1)}))
+
+    plans = {
+        "sgd_by_edges": MatrixCompletionPlan.sgd_by_edges(
+            latent_vector_size=16, learning_rate=0.05, items_per_block=32, users_per_block=64
+        ),
+        "sgd_by_items": MatrixCompletionPlan.sgd_by_items(latent_vector_size=16, learning_rate=0.05),
+        "als": MatrixCompletionPlan.als(latent_vector_size=16),
+    }
+    for name, plan in plans.items():
+        matrix_completion(graph, "rating", name, plan)
+        matrix_completion_assert_valid(graph, name)
+
+        stats = MatrixCompletionStatistics(graph, "rating", name)
+        assert stats.num_items == num_items
+        assert stats.num_users == num_users
+        # The ratings are about 1 on average
+        assert stats.rmse < 0.3, name
+        assert "RMSE" in str(stats)
+
+
+def test_matrix_completion_fail():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    # Symmetric graphs have edges into items, so they are not ratings
+    with raises(GaloisError):
+        matrix_completion(property_graph, "value", "output")
+
+    with raises(GaloisError):
+        matrix_completion(property_graph, "value", "output", MatrixCompletionPlan.als(latent_vector_size=0))
+
+    plan = MatrixCompletionPlan.sgd_by_items(
+        latent_vector_size=32, step_function=MatrixCompletionPlan.StepFunction.Bottou
+    )
+    assert plan.algorithm == MatrixCompletionPlan.Algorithm.SGDByItems
+    assert plan.latent_vector_size == 32
+    assert plan.step_function == MatrixCompletionPlan.StepFunction.Bottou
+
+
+def test_minimum_spanning_forest():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    minimum_spanning_forest(property_graph, "", "output")
+    minimum_spanning_forest_assert_valid(property_graph, "output")
+
+    # With unit weights, any spanning forest has a tree per connected component
+    stats = MinimumSpanningForestStatistics(property_graph, "", "output")
+    assert stats.num_trees == 69
+    assert stats.num_edges == len(property_graph) - 69
+    assert stats.total_weight == approx(stats.num_edges)
+
+    # Symmetric weights, so that both edges between a pair of nodes agree
+    weights = [(n * property_graph.get_edge_dst(e)) % 7 for n in property_graph for e in property_graph.edges(n)]
+    property_graph.add_edge_property(table(dict(weight=weights)))
+
+    minimum_spanning_forest(property_graph, "weight", "boruvka", MinimumSpanningForestPlan.boruvka())
+    minimum_spanning_forest_assert_valid(property_graph, "boruvka")
+    boruvka_stats = MinimumSpanningForestStatistics(property_graph, "weight", "boruvka")
+    assert boruvka_stats.num_trees == 69
+    # No heavier than the forest found with unit weights
+    unit_stats = MinimumSpanningForestStatistics(property_graph, "weight", "output")
+    assert boruvka_stats.total_weight <= unit_stats.total_weight
+
+    minimum_spanning_forest(
+        property_graph, "weight", "kruskal", MinimumSpanningForestPlan.filter_kruskal(base_case_size=100)
+    )
+    minimum_spanning_forest_assert_valid(property_graph, "kruskal")
+    kruskal_stats = MinimumSpanningForestStatistics(property_graph, "weight", "kruskal")
+    assert kruskal_stats.num_edges == boruvka_stats.num_edges
+    assert kruskal_stats.total_weight == approx(boruvka_stats.total_weight)
+
+    with raises(GaloisError):
+        minimum_spanning_forest(property_graph, "weight", "invalid", MinimumSpanningForestPlan.filter_kruskal(0))
+
+
+def test_graph_coloring():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    plans = dict(
+        speculative=GraphColoringPlan.speculative(),
+        jones_plassmann=GraphColoringPlan.jones_plassmann(),
+        largest_degree_first=GraphColoringPlan.largest_degree_first(),
+    )
+    max_degree = max(len(property_graph.edges(n)) for n in property_graph)
+    for name, plan in plans.items():
+        graph_coloring(property_graph, name, plan)
+        graph_coloring_assert_valid(property_graph, name)
+
+        stats = GraphColoringStatistics(property_graph, name)
+        assert 1 < stats.num_colors <= max_degree + 1
+        assert len(stats.color_class_sizes) == stats.num_colors
+        assert sum(stats.color_class_sizes) == len(property_graph)
+        # First-fit gives every color but the first a neighbor of each smaller color
+        assert all(size > 0 for size in stats.color_class_sizes)
+
+    # Jones-Plassmann does not depend on the schedule
+    setActiveThreads(1)
+    graph_coloring(property_graph, "jones_plassmann_again", GraphColoringPlan.jones_plassmann())
+    assert property_graph.get_node_property("jones_plassmann_again").equals(
+        property_graph.get_node_property("jones_plassmann")
+    )
+
+    property_graph.add_node_property(table(dict(all_zero=np.zeros(len(property_graph), dtype=np.uint32))))
+    with raises(AssertionError):
+        graph_coloring_assert_valid(property_graph, "all_zero")
+
+    with raises(GaloisError):
+        graph_coloring(property_graph, "speculative")
+
+
+def test_partition():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+    num_edges = sum(len(property_graph.edges(n)) for n in property_graph)
+
+    partition(property_graph, 4, "output")
+    partition_assert_valid(property_graph, 4, "output")
+
+    stats = PartitionStatistics(property_graph, "output")
+    assert stats.num_parts == 4
+    assert sum(stats.part_sizes) == len(property_graph)
+    assert max(stats.part_sizes) <= math.ceil(len(property_graph) * (1 + PartitionPlan().imbalance) / 4)
+    # Far fewer edges between parts than with parts chosen at random
+    assert stats.edge_cut < 0.75 * num_edges
+
+    # The parts do not depend on the number of threads
+    setActiveThreads(1)
+    partition(property_graph, 4, "again", PartitionPlan.multilevel_k_way())
+    assert property_graph.get_node_property("again").equals(property_graph.get_node_property("output"))
+
+    with raises(AssertionError):
+        partition_assert_valid(property_graph, 2, "output")
+
+    with raises(GaloisError):
+        partition(property_graph, 0, "invalid")
+
+
+def test_random_walks():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    plan = RandomWalksPlan.node2vec(walk_length=5, number_of_walks=2, seed=3)
+    walks = random_walks(property_graph, "", plan=plan)
+    assert len(walks) == 2 * len(property_graph)
+    assert walks.type.list_size == 5
+    random_walks_assert_valid(property_graph, walks)
+
+    # Walks depend only on the seed, not on the number of threads
+    assert random_walks(property_graph, "", plan=plan).equals(walks)
+    setActiveThreads(1)
+    assert random_walks(property_graph, "", plan=plan).equals(walks)
+    setActiveThreads(4)
+
+    biased_plan = RandomWalksPlan.node2vec(walk_length=5, backward_probability=0.5, forward_probability=2)
+    biased_walks = random_walks(property_graph, "", plan=biased_plan)
+    random_walks_assert_valid(property_graph, biased_walks)
+
+    with raises(GaloisError):
+        random_walks(property_graph, "", plan=RandomWalksPlan.node2vec(walk_length=0))
+
+
+def test_random_walks_weighted():
+    # A star whose center has edges of weight 0, 1, 2 and 5 to its leaves
+    num_leaves = 4
+    weights = [0, 1, 2, 5]
+    graph = PropertyGraph.from_csr(
+        np.arange(num_leaves, 2 * num_leaves + 1, dtype=np.uint64), list(range(1, num_leaves + 1)) + [0] * num_leaves
+    )
+    graph.add_edge_property(table({"weight": np.array(weights + [1] * num_leaves, dtype=np.uint32)}))
+
+    number_of_walks = 20000
+    plan = RandomWalksPlan.node2vec(walk_length=2, number_of_walks=number_of_walks, seed=7)
+    walks = random_walks(graph, "weight", plan=plan)
+    random_walks_assert_valid(graph, walks)
+
+    steps = walks.flatten().to_numpy().reshape(-1, 2)
+    from_center = steps[steps[:, 0] == 0, 1]
+    assert len(from_center) == number_of_walks
+    counts = np.bincount(from_center, minlength=num_leaves + 1)
+    assert counts[0] == 0
+    assert counts[1] == 0
+    for leaf, weight in enumerate(weights[1:], start=2):
+        assert counts[leaf] / len(from_center) == approx(weight / sum(weights), rel=0.1)
+
+
+def test_random_walks_edge2vec():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+    num_edges = property_graph.num_edges()
+    property_graph.add_edge_property(table({"type": (np.arange(num_edges) % 3).astype(np.uint16)}))
+
+    plan = RandomWalksPlan.edge2vec(walk_length=5, number_of_walks=2, max_iterations=2, seed=3)
+    walks = random_walks(property_graph, "", "type", plan=plan)
+    assert len(walks) == 2 * len(property_graph)
+    assert walks.type.list_size == 5
+    random_walks_assert_valid(property_graph, walks)
+    assert random_walks(property_graph, "", "type", plan=plan).equals(walks)
+
+    property_graph.add_edge_property(table({"bad_type": np.full(num_edges, 1024, dtype=np.uint16)}))
+    with raises(GaloisError):
+        random_walks(property_graph, "", "bad_type", plan=plan)
+
+
+def test_random_walks_to_parquet(tmp_path):
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+    plan = RandomWalksPlan.node2vec(walk_length=5, number_of_walks=3, seed=11)
+    walks = random_walks(property_graph, "", plan=plan)
+
+    # Each row group holds one batch of RandomWalksInBatches, so reading them
+    # back in order checks that the batches concatenate to the walks
+    batch_size = 1000
+    path = str(tmp_path / "walks.parquet")
+    random_walks_to_parquet(property_graph, "", "", path, batch_size, plan=plan)
+
+    parquet_file = pyarrow.parquet.ParquetFile(path)
+    assert parquet_file.num_row_groups == math.ceil(len(walks) / batch_size)
+    read_walks = []
+    for i in range(parquet_file.num_row_groups):
+        row_group = parquet_file.read_row_group(i).column("walk").to_pylist()
+        assert len(row_group) == min(batch_size, len(walks) - i * batch_size)
+        read_walks.extend(row_group)
+    assert read_walks == walks.to_pylist()
@@ -1,10 +1,13 @@
+#include <algorithm>
 #include <iostream>
 
+#include <boost/filesystem.hpp>
 #include <llvm/Support/CommandLine.h>
 
 #include "Transforms.h"
 #include "graph-properties-convert-graphml.h"
 #include "graph-properties-convert-schema.h"
+#include "katana/EdgeListImport.h"
 #include "katana/ErrorCode.h"
 #include "katana/Galois.h"
 #include "katana/Logging.h"
@@ -35,7 +38,10 @@ cll::opt<katana::SourceType> type(
             "source file is of type GraphML"),
         clEnumValN(
             katana::SourceType::kKatana, "katana",
-            "source file is of type Katana")),
+            "source file is of type Katana"),
+        clEnumValN(
+            katana::SourceType::kEdgeList, "edgelist",
+            "source is a delimited edge list file or a directory of them")),
     cll::init(katana::SourceType::kGraphml));
 cll::opt<katana::SourceDatabase> database(
     cll::desc("Database the data is from:"),
@@ -83,6 +89,34 @@ cll::opt<std::string> user(
     cll::desc("Username for the target database if needed, default is root"),
     cll::init("root"));
 
+cll::opt<char> delimiter(
+    "delimiter",
+    cll::desc("Field separator of edge lists; use ' ' for runs of blanks "
+              "(default ',')"),
+    cll::init(','));
+cll::opt<bool> has_header(
+    "header", cll::desc("Edge list files start with a header line"),
+    cll::init(false));
+cll::opt<int> weight_column(
+    "weight-column",
+    cll::desc("Zero-based field of edge lists holding a double edge weight; "
+              "-1 for none (default -1)"),
+    cll::init(-1));
+cll::opt<bool> numeric_ids(
+    "numeric-ids",
+    cll::desc("Edge list node ids are unsigned integers rather than strings"),
+    cll::init(false));
+cll::opt<uint64_t> memory_budget(
+    "memory-budget",
+    cll::desc("Edge list inputs larger than this many bytes are imported in "
+              "waves and staged on disk; 0 for no limit (default 0)"),
+    cll::init(0));
+cll::opt<std::string> spill_dir(
+    "spill-dir",
+    cll::desc("Directory for temporary files of edge list imports "
+              "(default /tmp)"),
+    cll::init("/tmp"));
+
 cll::opt<bool> export_graphml(
     "export",
     cll::desc("Exports a Katana graph to graphml format\n"
@@ -133,6 +167,38 @@ ConvertKatana(const std::string& rdg_file) {
   return katana::PropertyGraph(std::move(*graph));
 }
 
+katana::GraphComponents
+ConvertEdgeList(const std::string& input) {
+  std::vector<std::string> paths;
+  if (boost::filesystem::is_directory(input)) {
+    for (const auto& entry : boost::filesystem::directory_iterator(input)) {
+      if (boost::filesystem::is_regular_file(entry.status())) {
+        paths.emplace_back(entry.path().string());
+      }
+    }
+    // Node ids are assigned in order of appearance, so fix the file order
+    std::sort(paths.begin(), paths.end());
+  } else {
+    paths.emplace_back(input);
+  }
+
+  katana::EdgeListImportOptions opts;
+  opts.delimiter = delimiter;
+  opts.has_header = has_header;
+  if (weight_column >= 0) {
+    opts.weight_column = weight_column;
+  }
+  opts.numeric_ids = numeric_ids;
+  opts.memory_budget = memory_budget;
+  opts.spill_dir = spill_dir;
+
+  auto result = katana::ImportEdgeList(paths, opts);
+  if (!result) {
+    KATANA_LOG_FATAL("failed to import {}: {}", input, result.error());
+  }
+  return std::move(result.value());
+}
+
 void
 ParseWild() {
   switch (type) {
@@ -142,6 +208,9 @@ ParseWild() {
   case katana::SourceType::kKatana:
     return katana::WritePropertyGraph(
         ConvertKatana(input_filename), output_directory);
+  case katana::SourceType::kEdgeList:
+    return katana::WritePropertyGraph(
+        ConvertEdgeList(input_filename), output_directory);
   default:
     KATANA_LOG_ERROR("Unsupported input type {}", type);
   }